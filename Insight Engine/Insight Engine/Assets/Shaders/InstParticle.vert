@@ -0,0 +1,31 @@
+#version 450 core
+layout(location = 0)  in vec2  aVertexPosition;
+layout(location = 1)  in vec2  aVertexTexCoord;
+layout(location = 2)  in vec4  aVertexColor;
+layout(location = 3)  in float aTexLayer;    // texture atlas layer, -1 if untextured
+layout(location = 4)  in vec2  aPosition;    // world position of the particle
+layout(location = 5)  in vec2  aSize;        // full width and height
+layout(location = 6)  in float aRotation;    // degrees
+layout(location = 8)  in vec4  aTexRect;     // uv offset (xy) and size (zw) in the atlas layer
+
+layout(location = 0) out vec4  vColor;
+layout(location = 1) out vec2  vTexCoord;
+layout(location = 2) out flat float vTexLayer;
+layout(location = 3) out vec2  vTexSize;
+layout(location = 5) out flat float vEntityID;
+
+uniform mat4 uViewProj;
+
+void main()
+{
+    // the quad spans [-1, 1], so scale by half the size
+    float angle = radians(aRotation);
+    vec2 local = aVertexPosition * aSize * 0.5;
+    vec2 world_position = mat2(cos(angle), sin(angle), -sin(angle), cos(angle)) * local + aPosition;
+    gl_Position = uViewProj * vec4(world_position, 1.0, 1.0);
+    vColor = aVertexColor;
+    vTexCoord = aTexRect.xy + aTexRect.zw * aVertexTexCoord;
+    vTexLayer = aTexLayer;
+    vTexSize = aTexRect.zw;
+    vEntityID = -1.0; // particles are not entities, nothing to pick
+}
\ No newline at end of file
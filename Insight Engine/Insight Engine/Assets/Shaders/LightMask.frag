@@ -0,0 +1,18 @@
+#version 450 core
+layout(location = 0) in vec2 vWorldPosition;
+layout(location = 1) in flat vec2 vLightCenter;
+layout(location = 2) in flat vec4 vLightColor;
+layout(location = 3) in flat float vLightRadius;
+
+layout(location = 0) out vec4 fFragColor;
+
+void main()
+{
+    float distance = length(vWorldPosition - vLightCenter);
+    if (distance >= vLightRadius)
+        discard;
+
+    float attenuation = pow(1.0 - (distance / vLightRadius), 2.0); // Squared falloff attenuation
+    float intensity = vLightColor.a; // Intensity from alpha
+    fFragColor = vec4(vLightColor.rgb * attenuation * intensity, distance / vLightRadius);
+}
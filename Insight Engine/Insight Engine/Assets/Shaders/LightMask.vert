@@ -0,0 +1,21 @@
+#version 450 core
+layout(location = 0) in vec2  aWorldPosition;
+layout(location = 1) in vec2  aLightCenter;  // world position of the light
+layout(location = 2) in vec4  aLightColor;   // light color + intensity (as alpha value)
+layout(location = 3) in float aLightRadius;
+
+layout(location = 0) out vec2 vWorldPosition;
+layout(location = 1) out flat vec2 vLightCenter;
+layout(location = 2) out flat vec4 vLightColor;
+layout(location = 3) out flat float vLightRadius;
+
+uniform mat4 uViewProj;
+
+void main()
+{
+    gl_Position = uViewProj * vec4(aWorldPosition, 1.0, 1.0);
+    vWorldPosition = aWorldPosition;
+    vLightCenter = aLightCenter;
+    vLightColor = aLightColor;
+    vLightRadius = aLightRadius;
+}
@@ -4,15 +4,13 @@ out vec4 color;
 
 in VS_OUT{
     vec2 TexCoords;
-    flat int index;
+    vec4 Color;
 } fs_in;
 
-uniform sampler2DArray text; // texture array
-uniform int letterMap[128];
-uniform vec4 textColor;
+uniform sampler2D atlas; // glyph atlas
 
 void main()
 {    
-    vec4 sampled = vec4(1.0, 1.0, 1.0, texture(text, vec3(fs_in.TexCoords.xy,letterMap[fs_in.index])).r);
-    color = textColor * sampled;
+    vec4 sampled = vec4(1.0, 1.0, 1.0, texture(atlas, fs_in.TexCoords).r);
+    color = fs_in.Color * sampled;
 }
\ No newline at end of file
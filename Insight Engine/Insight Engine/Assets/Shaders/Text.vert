@@ -1,18 +1,19 @@
 #version 450 core
-layout (location = 0) in vec2 vertex;
+layout (location = 0) in vec2 vertex;   // unit quad
+layout (location = 1) in vec4 aRect;    // glyph corner and size, in window pixels
+layout (location = 2) in vec4 aTexRect; // glyph offset and size in the atlas
+layout (location = 3) in vec4 aColor;
 
 out VS_OUT{
     vec2 TexCoords;
-    flat int index;
+    vec4 Color;
 } vs_out;
 
-uniform mat4 transforms[128]; // 400 chars per render
 uniform mat4 projection;
 
 void main()
 {
-    gl_Position = projection * transforms[gl_InstanceID] * vec4(vertex.xy, 0.0, 1.0);
-    vs_out.index = gl_InstanceID; // get index to feed to frag shader
-    vs_out.TexCoords = vertex.xy;
-    vs_out.TexCoords.y = 1.0f-vs_out.TexCoords.y; // flip
+    gl_Position = projection * vec4(aRect.xy + vertex.xy * aRect.zw, 0.0, 1.0);
+    vs_out.TexCoords = aTexRect.xy + vec2(vertex.x, 1.0 - vertex.y) * aTexRect.zw; // flip, bitmap rows go down
+    vs_out.Color = aColor;
 }
\ No newline at end of file
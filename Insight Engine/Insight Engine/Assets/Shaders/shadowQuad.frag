@@ -5,14 +5,7 @@ layout(location = 0) in vec2 vTexCoord;
 layout(location = 0) out vec4 fFragColor;
 layout(location = 1) out int fEntityID;
 
-uniform vec4 uLightColors[128]; // light color + intensity (as alpha value)
-uniform float uLightRadius[128]; // light radiuses
-uniform vec2 uLightWorldPos[128]; // light world positions
-uniform int uNoOfWorldLights; // light count
-uniform vec4 uLineSegments[512]; // line segment world positions (x,y) to (z,w)
-uniform int uNoOfLineSegments; // line segment count
 uniform vec2 uResolution; // resolution of game
-uniform mat4 uInverseVP; // Inverse of View-Projection Matrix
 uniform int uShaderEffect;
 uniform float uTimeElapsed;
 uniform float uShaderEffectTimer;
@@ -20,20 +13,7 @@ uniform float uShaderIntensity;
 
 uniform sampler2D bg_tex; // background framebuffer texture
 uniform isampler2D id_tex; // ID framebuffer texture
-
-// Function to check if two line segments intersect
-bool doLineSegmentsIntersect(vec2 p0, vec2 p1, vec2 q0, vec2 q1) {
-    vec2 r = p1 - p0;
-    vec2 s = q1 - q0;
-
-    float crossProduct = r.x * s.y - r.y * s.x;
-    vec2 qMinusP = q0 - p0;
-
-    float t = (qMinusP.x * s.y - qMinusP.y * s.x) / crossProduct;
-    float u = (qMinusP.x * r.y - qMinusP.y * r.x) / crossProduct;
-
-    return (crossProduct != 0.0) && (t >= 0.0) && (t <= 1.0) && (u >= 0.0) && (u <= 1.0);
-}
+uniform sampler2D light_tex; // light mask, lit color (rgb) and distance to the nearest light over its radius (a)
 
 vec3 blendLight(vec3 base, vec3 added) {
     // Simple additive blend mode with a safeguard against overexposure
@@ -65,49 +45,11 @@ float filmReelNoise(vec2 uv, float time) {
 void main() {
 
     vec4 final_frag_clr = texture(bg_tex, vTexCoord); // Base color from background texture
-    vec4 ndcPos = vec4(2.0 * (gl_FragCoord.xy / uResolution) - 1.0, 0.0, 1.0); // Pixel position to NDC
-    vec4 worldPos = uInverseVP * ndcPos; // NDC to world coordinates
-    vec2 current_pixel = worldPos.xy / worldPos.w; // Correct by perspective division
-    float dist = 1.0;
 
-    for (int i = 0; i < uNoOfWorldLights; ++i) 
-    {
-        vec2 lightDirection = uLightWorldPos[i] - current_pixel;
-        float distance = length(lightDirection);
-        float radius = uLightRadius[i];
-
-        // tutorial shader effect
-        if (uShaderEffect == 1){
-            radius = radius * 1;
-        }
-
-        if (distance < radius) {
-            float attenuation = pow(1.0 - (distance / radius), 2.0); // Squared falloff attenuation
-            float intensity = uLightColors[i].a; // Intensity from alpha
-            vec3 lightContribution = uLightColors[i].rgb * attenuation * intensity; // Apply attenuation and intensity
-
-            bool inShadow = false;
-            for (int j = 0; j < uNoOfLineSegments && !inShadow; ++j) 
-            {
-                vec2 p0 = vec2(uLineSegments[j].x, uLineSegments[j].y);
-                vec2 p1 = vec2(uLineSegments[j].z, uLineSegments[j].w);
-                if (doLineSegmentsIntersect(uLightWorldPos[i], current_pixel, p0, p1)) {
-
-                    if (uShaderEffect==0) {
-                        lightContribution *= 0.0; // Shadow attenuation
-                    }
-                    else {
-                        lightContribution *= 0.0;
-                    }
-                    inShadow = true;
-                }
-            }
-
-            // Blend light contribution using custom blend function
-            final_frag_clr.rgb = blendLight(final_frag_clr.rgb, lightContribution);
-            if ((distance / radius) < dist) dist = distance / radius;
-        }
-    }
+    // lights and their shadows are already in the mask, additive blending with a safeguard against overexposure
+    vec4 light = texture(light_tex, gl_FragCoord.xy / uResolution);
+    final_frag_clr.rgb = blendLight(final_frag_clr.rgb, light.rgb);
+    float dist = light.a;
     
     if (uShaderEffect == 0)
     {
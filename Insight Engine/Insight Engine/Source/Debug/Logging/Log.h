@@ -86,20 +86,23 @@ namespace IS {
 
 } // end namespace IS
 
+// Logs a message if its level is compiled in, the arguments are not evaluated otherwise
+#define IS_LOG_COMPILED(level, call) (::IS::IsLogLevelCompiled(::IS::aLogLevel::level) ? call : void())
+
 // Core log macros
-#define IS_CORE_TRACE(...) ::IS::Log::GetCoreLogger()->Trace(__VA_ARGS__)
-#define IS_CORE_DEBUG(...) ::IS::Log::GetCoreLogger()->Debug(__VA_ARGS__)
-#define IS_CORE_INFO(...) ::IS::Log::GetCoreLogger()->Info(__VA_ARGS__)
-#define IS_CORE_WARN(...) ::IS::Log::GetCoreLogger()->Warn(__VA_ARGS__)
-#define IS_CORE_ERROR(...) ::IS::Log::GetCoreLogger()->Error(__VA_ARGS__)
-#define IS_CORE_CRITICAL(...) ::IS::Log::GetCoreLogger()->Critical(__VA_ARGS__)
+#define IS_CORE_TRACE(...) IS_LOG_COMPILED(LOGLEVEL_TRACE, ::IS::Log::GetCoreLogger()->Trace(__VA_ARGS__))
+#define IS_CORE_DEBUG(...) IS_LOG_COMPILED(LOGLEVEL_DEBUG, ::IS::Log::GetCoreLogger()->Debug(__VA_ARGS__))
+#define IS_CORE_INFO(...) IS_LOG_COMPILED(LOGLEVEL_INFO, ::IS::Log::GetCoreLogger()->Info(__VA_ARGS__))
+#define IS_CORE_WARN(...) IS_LOG_COMPILED(LOGLEVEL_WARNING, ::IS::Log::GetCoreLogger()->Warn(__VA_ARGS__))
+#define IS_CORE_ERROR(...) IS_LOG_COMPILED(LOGLEVEL_ERROR, ::IS::Log::GetCoreLogger()->Error(__VA_ARGS__))
+#define IS_CORE_CRITICAL(...) IS_LOG_COMPILED(LOGLEVEL_CRITICAL, ::IS::Log::GetCoreLogger()->Critical(__VA_ARGS__))
 
 // Client log macros
-#define IS_TRACE(...) ::IS::Log::GetClientLogger()->Trace(__VA_ARGS__)
-#define IS_DEBUG(...) ::IS::Log::GetClientLogger()->Debug(__VA_ARGS__)
-#define IS_INFO(...) ::IS::Log::GetClientLogger()->Info(__VA_ARGS__)
-#define IS_WARN(...) ::IS::Log::GetClientLogger()->Warn(__VA_ARGS__)
-#define IS_ERROR(...) ::IS::Log::GetClientLogger()->Error(__VA_ARGS__)
-#define IS_CRITICAL(...) ::IS::Log::GetClientLogger()->Critical(__VA_ARGS__)
+#define IS_TRACE(...) IS_LOG_COMPILED(LOGLEVEL_TRACE, ::IS::Log::GetClientLogger()->Trace(__VA_ARGS__))
+#define IS_DEBUG(...) IS_LOG_COMPILED(LOGLEVEL_DEBUG, ::IS::Log::GetClientLogger()->Debug(__VA_ARGS__))
+#define IS_INFO(...) IS_LOG_COMPILED(LOGLEVEL_INFO, ::IS::Log::GetClientLogger()->Info(__VA_ARGS__))
+#define IS_WARN(...) IS_LOG_COMPILED(LOGLEVEL_WARNING, ::IS::Log::GetClientLogger()->Warn(__VA_ARGS__))
+#define IS_ERROR(...) IS_LOG_COMPILED(LOGLEVEL_ERROR, ::IS::Log::GetClientLogger()->Error(__VA_ARGS__))
+#define IS_CRITICAL(...) IS_LOG_COMPILED(LOGLEVEL_CRITICAL, ::IS::Log::GetClientLogger()->Critical(__VA_ARGS__))
 
 #endif // GAM200_INSIGHT_ENGINE_SOURCE_DEBUG_LOG_H
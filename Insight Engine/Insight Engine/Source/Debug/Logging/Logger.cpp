@@ -20,6 +20,7 @@
 #include "Pch.h"
 #include "Logger.h"
 #include "Editor/Utils/EditorUtils.h"
+#include "Debug/Profiling/Profiler.h"
 
 // STL
 #include <chrono>
@@ -62,6 +63,244 @@ namespace IS {
         return aLogLevel::LOGLEVEL_TRACE; // default to TRACE if unknown
     }
 
+    /*
+     * LogRecord
+     * ---------------------------------------------------------------------------------------------------------------------------------
+     */
+
+    void LogRecord::SetText(const char* text)
+    {
+        // a message with a lone brace would fail to format and is written as is, like FormatTo does
+        std::string_view source(text);
+        bool escaped = true;
+        for (size_t i = 0; i < source.size() && escaped; ++i)
+        {
+            if (source[i] != '{' && source[i] != '}')
+                continue;
+            escaped = i + 1 < source.size() && source[i + 1] == source[i];
+            ++i;
+        }
+
+        auto copy = [&source, escaped](char* out)
+        {
+            size_t length = 0;
+            for (size_t i = 0; i < source.size(); ++i)
+            {
+                out[length++] = source[i];
+                if (escaped && (source[i] == '{' || source[i] == '}'))
+                    ++i;
+            }
+            return length;
+        };
+
+        if (source.size() <= DATA_SIZE)
+        {
+            mLength = static_cast<uint32_t>(copy(mData));
+        }
+        else
+        {
+            mOverflow = new std::string(source.size(), '\0');
+            mOverflow->resize(copy(mOverflow->data()));
+        }
+    }
+
+    void LogRecord::Format(const char* fmt, std::format_args args)
+    {
+        // formatted into a buffer of the thread, which keeps its capacity between messages
+        thread_local std::string buffer;
+        buffer.clear();
+        FormatTo(buffer, fmt, args);
+        if (buffer.size() <= DATA_SIZE)
+        {
+            std::memcpy(mData, buffer.data(), buffer.size());
+            mLength = static_cast<uint32_t>(buffer.size());
+        }
+        else
+        {
+            mOverflow = new std::string(buffer);
+        }
+    }
+
+    void LogRecord::FormatTo(std::string& out, const char* fmt, std::format_args args)
+    {
+        const char* format = fmt ? fmt : "{}";
+        try {
+            std::vformat_to(std::back_inserter(out), format, args);
+        } catch (std::format_error const&) {
+            out += format;
+        }
+    }
+
+    void LogRecord::AppendMessage(std::string& out) const
+    {
+        if (mDeferred)
+            mDeferred(out, mFormat, mData);
+        else if (mOverflow)
+            out += *mOverflow;
+        else
+            out.append(mData, mLength);
+    }
+
+    void LogRecord::Release()
+    {
+        delete mOverflow;
+        mOverflow = nullptr;
+        mDeferred = nullptr;
+        mFormat = nullptr;
+        mLength = 0;
+    }
+
+    /*
+     * LogQueue
+     * ---------------------------------------------------------------------------------------------------------------------------------
+     */
+
+    LogQueue::LogQueue() : mCells(std::make_unique<Cell[]>(CAPACITY))
+    {
+        static_assert((CAPACITY & (CAPACITY - 1)) == 0, "The capacity of the log queue must be a power of two");
+        for (size_t i = 0; i < CAPACITY; ++i)
+            mCells[i].mSequence.store(i, std::memory_order_relaxed);
+#ifdef USING_IMGUI
+        // created first so it is destroyed after the queue, which may still write to it
+        LoggerGUI::Instance();
+#endif // USING_IMGUI
+        mThread = std::thread(&LogQueue::Work, this);
+    }
+
+    LogQueue::~LogQueue()
+    {
+        // logs from here on are written at once, the writer drains the ones already submitting
+        mClosed.store(true, std::memory_order_seq_cst);
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mQuit = true;
+        }
+        mWake.notify_all();
+        mThread.join();
+    }
+
+    LogQueue& LogQueue::Instance()
+    {
+        static LogQueue queue;
+        return queue;
+    }
+
+    LogRecord* LogQueue::Claim(aLogLevel level, size_t& position)
+    {
+        position = mEnqueue.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Cell& cell = mCells[position & (CAPACITY - 1)];
+            size_t sequence = cell.mSequence.load(std::memory_order_acquire);
+            auto difference = static_cast<std::ptrdiff_t>(sequence - position);
+            if (difference == 0)
+            {
+                if (mEnqueue.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    return &cell.mRecord;
+            }
+            else if (difference < 0)
+            {
+                // full, the writer is a whole queue behind
+                if (level < aLogLevel::LOGLEVEL_ERROR)
+                {
+                    mDropped.fetch_add(1, std::memory_order_relaxed);
+                    return nullptr;
+                }
+                mWake.notify_one();
+                std::this_thread::yield();
+                position = mEnqueue.load(std::memory_order_relaxed);
+            }
+            else
+            {
+                position = mEnqueue.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void LogQueue::Publish(size_t position)
+    {
+        mCells[position & (CAPACITY - 1)].mSequence.store(position + 1, std::memory_order_seq_cst);
+        if (mWriterIdle.load(std::memory_order_seq_cst))
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mWake.notify_one();
+        }
+    }
+
+    void LogQueue::Flush()
+    {
+        if (mClosed.load(std::memory_order_acquire))
+            return;
+
+        LogQueue& queue = Instance();
+        size_t target = queue.mEnqueue.load(std::memory_order_acquire);
+        queue.mFlushing.fetch_add(1);
+        {
+            std::unique_lock<std::mutex> lock(queue.mMutex);
+            queue.mWake.notify_one();
+            queue.mDrained.wait(lock, [&queue, target] { return queue.mDequeue.load(std::memory_order_acquire) >= target; });
+        }
+        queue.mFlushing.fetch_sub(1);
+    }
+
+    void LogQueue::WriteNow(LogRecord& record)
+    {
+        std::string message, line;
+        record.mLogger->Write(record, message, line);
+        record.Release();
+    }
+
+    bool LogQueue::IsSubmitting() const
+    {
+        // a record claimed before the queue closed is published shortly after
+        return mSubmitting.load(std::memory_order_seq_cst) > 0 ||
+               mDequeue.load(std::memory_order_relaxed) != mEnqueue.load(std::memory_order_seq_cst);
+    }
+
+    bool LogQueue::HasPending() const
+    {
+        size_t position = mDequeue.load(std::memory_order_relaxed);
+        return mCells[position & (CAPACITY - 1)].mSequence.load(std::memory_order_seq_cst) == position + 1;
+    }
+
+    void LogQueue::Work()
+    {
+        IS_PROFILE_THREAD("Log Writer");
+        std::string message, line;
+
+        while (true)
+        {
+            // write everything published so far
+            while (HasPending())
+            {
+                size_t position = mDequeue.load(std::memory_order_relaxed);
+                Cell& cell = mCells[position & (CAPACITY - 1)];
+                cell.mRecord.mLogger->Write(cell.mRecord, message, line);
+                cell.mRecord.Release();
+                cell.mSequence.store(position + CAPACITY, std::memory_order_release);
+                mDequeue.store(position + 1, std::memory_order_release);
+
+                if (mFlushing.load(std::memory_order_relaxed) > 0)
+                {
+                    std::lock_guard<std::mutex> lock(mMutex);
+                    mDrained.notify_all();
+                }
+            }
+
+            if (size_t dropped = mDropped.exchange(0, std::memory_order_relaxed); dropped > 0)
+                IS_CORE_WARN("{} log messages were dropped, the log queue was full", dropped);
+
+            // sleep until a record is published, the timeout covers a wake up missed by Publish
+            std::unique_lock<std::mutex> lock(mMutex);
+            mDrained.notify_all();
+            if (mQuit && !IsSubmitting() && !HasPending())
+                return;
+            mWriterIdle.store(true, std::memory_order_seq_cst);
+            mWake.wait_for(lock, std::chrono::milliseconds(50), [this] { return mQuit || HasPending(); });
+            mWriterIdle.store(false, std::memory_order_seq_cst);
+        }
+    }
+
     /*
      * Logger
      * ---------------------------------------------------------------------------------------------------------------------------------
@@ -72,7 +311,12 @@ namespace IS {
 
     Logger::Logger(std::string const& name) : mLoggerName(name) {}
 
-    Logger::~Logger() { CloseFile(); }
+    Logger::~Logger()
+    {
+        // the queue may still hold records of this logger
+        LogQueue::Flush();
+        CloseFile();
+    }
 
     void Logger::SetLoggerName(std::string const& new_logger_name) { mLoggerName = new_logger_name; }
 
@@ -109,9 +353,47 @@ namespace IS {
 
     std::string Logger::GetTimestampFormat() const { return mTimestampFormat; }
 
-    std::string Logger::GetTimestamp(std::string const& ts_format) const
+    void Logger::Write(LogRecord const& record, std::string& message, std::string& line)
+    {
+        std::scoped_lock lock(mLogMutex);
+
+        message.clear();
+        record.AppendMessage(message);
+        std::string timestamp = GetTimestamp(mTimestampFormat, record.mTime);
+
+        line.clear();
+        line += timestamp;
+        if (!mLoggerName.empty())
+            line.append(1, '[').append(mLoggerName).append(1, ']');
+        line.append(1, ' ').append(message).append(1, '\n');
+
+        // Print to console
+#ifdef _DEBUG
+        SetColor(record.mLevel);
+        std::clog << line << RESET;
+#endif
+
+#ifdef USING_IMGUI
+        LoggerGUI::Instance().AddLog(record.mLevel, line.c_str());
+#endif // USING_IMGUI
+
+        // Write to file
+        if (!mLogFile.is_open())
+            return;
+
+        line.clear();
+        line += timestamp;
+        if (!mLoggerName.empty())
+            line.append(1, '[').append(mLoggerName).append(1, ']');
+        std::string loglevel = '[' + LogLevelToString(record.mLevel) + ']';
+        line.append(loglevel).append(loglevel.size() < 9 ? 9 - loglevel.size() : 0, ' ');
+        line.append(1, ' ').append(message).append(1, '\n');
+        mLogFile << line;
+    }
+
+    std::string Logger::GetTimestamp(std::string const& ts_format, std::chrono::system_clock::time_point time) const
     {
-        auto now = std::chrono::system_clock::now();
+        auto now = time;
         long long milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
         std::time_t current_time = std::chrono::system_clock::to_time_t(now);
         std::ostringstream timestamp;
@@ -149,6 +431,8 @@ namespace IS {
 
     void LoggerGUI::AddLog(aLogLevel level, const char* message)
     {
+        std::scoped_lock lock(mEntriesMutex);
+
         // Store log messages with their log levels
         mLogEntries.emplace_back(level, message);
 
@@ -212,6 +496,7 @@ namespace IS {
         ImGui::BeginChild("Log Entries", { 0, 0 }, false, child_window_flags);
         if (clear_flag)
             Clear();
+        std::unique_lock lock(mEntriesMutex);
         for (auto const& [level, message] : mLogEntries)
         {
             const bool filtered = !(mSelectedFilter == aLogLevel::LOGLEVEL_ALL || level == mSelectedFilter);
@@ -227,6 +512,7 @@ namespace IS {
             ImGui::TextColored(GetLogLevelColor(level), message.c_str());
             ImGui::PopFont();
         }
+        lock.unlock();
 
         if (mAutoScroll && ImGui::GetScrollY() >= ImGui::GetScrollMaxY())
             ImGui::SetScrollHereY(1.0f);
@@ -238,7 +524,11 @@ namespace IS {
         ImGui::End(); // end main window
     }
 
-    void LoggerGUI::Clear() { mLogEntries.clear(); }
+    void LoggerGUI::Clear()
+    {
+        std::scoped_lock lock(mEntriesMutex);
+        mLogEntries.clear();
+    }
 
     LoggerGUI& LoggerGUI::Instance() { static LoggerGUI gui; return gui; }
 
@@ -24,6 +24,10 @@
  ----------------------------------------------------------------------------- */
 #include "Math/ISMath.h"
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
 #include <mutex>
 #include <string>
 #include <sstream>
@@ -31,6 +35,10 @@
 #include <fstream>
 #include <format>
 #include <deque>
+#include <memory>
+#include <thread>
+#include <tuple>
+#include <type_traits>
 
 #ifdef USING_IMGUI
 
@@ -61,6 +69,27 @@ namespace IS {
         LOGLEVEL_CRITICAL
     };
 
+    /*!
+     * \brief Lowest log level compiled in, as an int. The log macros below it compile to nothing.
+     *
+     * Editor builds keep every level, GameRelease drops trace and debug logs.
+     */
+#ifndef IS_LOG_LEVEL
+#ifdef USING_IMGUI
+#define IS_LOG_LEVEL 1 // LOGLEVEL_TRACE
+#else
+#define IS_LOG_LEVEL 3 // LOGLEVEL_INFO
+#endif // USING_IMGUI
+#endif // !IS_LOG_LEVEL
+
+    /*!
+     * \brief Whether logs of a level are compiled in.
+     *
+     * \param level The log level.
+     * \return True if the level is at least IS_LOG_LEVEL.
+     */
+    constexpr bool IsLogLevelCompiled(aLogLevel level) { return static_cast<int>(level) >= IS_LOG_LEVEL; }
+
     /*!
      * \brief Get an int representation of a log level.
      *
@@ -151,6 +180,7 @@ namespace IS {
         ImGuiTextFilter mFilter; ///< Text filter
         aLogLevel mSelectedFilter = aLogLevel::LOGLEVEL_ALL; ///< Selected filter
         std::deque<LogEntry> mLogEntries; ///< The log entries displayed
+        std::mutex mEntriesMutex; ///< Guards the entries, which are added by the log writer thread
         bool mAutoScroll = true; ///< Boolean flag indicating auto scroll
         Vec2 mPanelSize; ///< Size of the panel.
 
@@ -166,6 +196,191 @@ namespace IS {
 
 #endif // USING_IMGUI
 
+    class Logger;
+
+    /*!
+     * \brief A log message as queued for the log writer thread.
+     *
+     * The message is either formatted into the record on the calling thread, or, when every
+     * argument is a number, the arguments are copied into the record and formatted by the
+     * writer. Deferred messages keep a pointer to the format string, which must be a literal.
+     * Messages that do not fit in the record are moved to the heap.
+     */
+    struct LogRecord {
+        static constexpr size_t DATA_SIZE = 384; ///< Bytes of text or arguments held in place.
+
+        using DeferredFormat = void (*)(std::string& out, const char* fmt, void const* args);
+
+        std::chrono::system_clock::time_point mTime; ///< Time the message was logged.
+        Logger* mLogger{};                      ///< Logger the message was logged with.
+        aLogLevel mLevel{};                     ///< Severity of the message.
+        uint32_t mLength{};                     ///< Length of the text in mData.
+        const char* mFormat{};                  ///< Format string of deferred arguments.
+        DeferredFormat mDeferred{};             ///< Formats the deferred arguments, null for text.
+        std::string* mOverflow{};               ///< Text that did not fit in mData.
+        alignas(std::max_align_t) char mData[DATA_SIZE]; ///< Text or deferred arguments.
+
+        /*!
+         * \brief Whether arguments of the types can be copied into a record and formatted later.
+         */
+        template<typename... T>
+        static constexpr bool IsDeferrable()
+        {
+            return (std::is_arithmetic_v<T> && ...) && sizeof(std::tuple<T...>) <= DATA_SIZE &&
+                   alignof(std::tuple<T...>) <= alignof(std::max_align_t);
+        }
+
+        /*!
+         * \brief Copies a message without arguments, with {{ and }} unescaped as std::format does.
+         *
+         * \param text The message.
+         */
+        void SetText(const char* text);
+
+        /*!
+         * \brief Formats a message into the record.
+         *
+         * \param fmt The format string, null formats the arguments as "{}".
+         * \param args The arguments.
+         */
+        void Format(const char* fmt, std::format_args args);
+
+        /*!
+         * \brief Copies numeric arguments into the record, to be formatted by the writer.
+         *
+         * \param fmt The format string, must outlive the record.
+         * \param values The arguments.
+         */
+        template<typename... T>
+        void Defer(const char* fmt, T const&... values)
+        {
+            new (mData) std::tuple<T...>(values...);
+            mFormat = fmt ? fmt : "{}";
+            mDeferred = &FormatDeferred<T...>;
+        }
+
+        /*!
+         * \brief Appends the message to a string.
+         *
+         * \param out The string to append to.
+         */
+        void AppendMessage(std::string& out) const;
+
+        /*!
+         * \brief Frees the heap text, the record can then be reused.
+         */
+        void Release();
+
+        /*!
+         * \brief Formats arguments into a string, writing the format string as is if it is invalid.
+         */
+        static void FormatTo(std::string& out, const char* fmt, std::format_args args);
+
+    private:
+        template<typename... T>
+        static void FormatDeferred(std::string& out, const char* fmt, void const* data)
+        {
+            auto const& values = *std::launder(static_cast<std::tuple<T...> const*>(data));
+            std::apply([&](T const&... value) { FormatTo(out, fmt, std::make_format_args(value...)); }, values);
+        }
+    };
+
+    /*!
+     * \class LogQueue
+     * \brief Bounded queue of log records, written out by a background thread.
+     *
+     * Any thread claims a record with a compare-and-swap on the enqueue position and
+     * publishes it with the sequence number of its cell, so logging takes no lock. The
+     * writer thread prints the records to the console, the editor and the log files in
+     * order. When the queue is full, messages below Error are dropped and counted, while
+     * Error and Critical wait for room. Error and Critical also wait until they are
+     * written, so they are not lost if the program stops right after them. On shutdown
+     * the writer drains every record submitted before the queue closed, and records
+     * submitted later are written at once on the calling thread.
+     */
+    class LogQueue {
+    public:
+        static constexpr size_t CAPACITY = 2048; ///< Records in the queue, a power of two.
+
+        /*!
+         * \brief Queues a message, or writes it at once if the queue was already destroyed.
+         *
+         * \param logger The logger of the message.
+         * \param level The severity of the message.
+         * \param fill Fills the message into a record.
+         */
+        template<typename Fill>
+        static void Submit(Logger& logger, aLogLevel level, Fill&& fill);
+
+        /*!
+         * \brief Waits until the messages queued so far are written.
+         */
+        static void Flush();
+
+        ~LogQueue();
+
+    private:
+        /*!
+         * \brief A record and the sequence number telling whose turn it is.
+         */
+        struct Cell {
+            std::atomic<size_t> mSequence;
+            LogRecord mRecord;
+        };
+
+        LogQueue();
+
+        /*!
+         * \brief Gets the queue, starting the writer thread on first use.
+         */
+        static LogQueue& Instance();
+
+        /*!
+         * \brief Claims a record, null if the message is dropped.
+         */
+        LogRecord* Claim(aLogLevel level, size_t& position);
+
+        /*!
+         * \brief Hands a claimed record to the writer.
+         */
+        void Publish(size_t position);
+
+        /*!
+         * \brief Writes a record on the calling thread.
+         */
+        static void WriteNow(LogRecord& record);
+
+        /*!
+         * \brief Whether a thread is still submitting a record or publishing one it claimed.
+         */
+        bool IsSubmitting() const;
+
+        /*!
+         * \brief Whether the next record to write was published.
+         */
+        bool HasPending() const;
+
+        /*!
+         * \brief Body of the writer thread.
+         */
+        void Work();
+
+        std::unique_ptr<Cell[]> mCells;
+        std::atomic<size_t> mEnqueue{};               ///< Next position to claim.
+        std::atomic<size_t> mDequeue{};               ///< Next position to write, advanced by the writer.
+        std::atomic<size_t> mDropped{};               ///< Messages dropped to a full queue.
+        std::atomic<bool> mWriterIdle{};
+        std::atomic<int> mFlushing{};                 ///< Threads waiting in Flush.
+        std::mutex mMutex;                            ///< Guards the waits, not the records.
+        std::condition_variable mWake;
+        std::condition_variable mDrained;
+        bool mQuit{};
+        std::thread mThread;
+
+        static inline std::atomic<bool> mClosed{};    ///< Set once the queue starts shutting down.
+        static inline std::atomic<int> mSubmitting{}; ///< Threads between the closed check and the publish.
+    };
+
 
     /*!
      * \class Logger
@@ -319,7 +534,9 @@ namespace IS {
         std::string mTimestampFormat = "%H:%M:%S"; ///< Timestamp format to display log with.
         std::string mLogFilenameTimestampFormat = "%Y%m%d %H-%M-%S"; ///< Timestamp format for the log file name.
         std::ofstream mLogFile; ///< The output log file.
-        static std::mutex mLogMutex; ///< Mutex of the logger.
+        static std::mutex mLogMutex; ///< Mutex of the outputs of the loggers.
+
+        friend class LogQueue;
 
         /*!
          * \brief Log a message with the specified log level.
@@ -331,13 +548,24 @@ namespace IS {
         template<typename... Args>
         void Log(aLogLevel level, const char* fmt, Args&&... args);
 
+        /*!
+         * \brief Write a record to the console, the editor and the log file.
+         *
+         * \param record The record.
+         * \param message Scratch string for the message.
+         * \param line Scratch string for the lines written.
+         */
+        void Write(LogRecord const& record, std::string& message, std::string& line);
+
         /*!
          * \brief Get a timestamp with the specified format.
          *
          * \param ts_format The timestamp format.
+         * \param time The time to format.
          * \return The formatted timestamp.
          */
-        std::string GetTimestamp(std::string const& ts_format) const;
+        std::string GetTimestamp(std::string const& ts_format,
+                                 std::chrono::system_clock::time_point time = std::chrono::system_clock::now()) const;
 
         /*!
          * \brief Close the log file (if open).
@@ -370,40 +598,49 @@ namespace IS {
         if (level < mMinLogLevel)
             return;
 
-        std::scoped_lock lock(mLogMutex);
-
-    #ifdef _DEBUG
-        SetColor(level);
-    #endif
-
-        // Construct log
-        std::ostringstream log;
-        std::string timestamp = GetTimestamp(mTimestampFormat);
-        std::string name = !mLoggerName.empty() ? '[' + mLoggerName + ']' : "";
-        std::string all_args = std::vformat(fmt, std::make_format_args(args...));
-
-        log << timestamp << name << ' ' << all_args << '\n';
-
-        // Print to console
-    #ifdef _DEBUG
-            std::clog << log.str() << RESET;
-    #endif
+        // Only the message is built here, the writer thread adds the timestamp and writes it out
+        LogQueue::Submit(*this, level, [&](LogRecord& record) {
+            if constexpr (sizeof...(Args) == 0)
+                record.SetText(fmt ? fmt : "");
+            else if constexpr (LogRecord::IsDeferrable<std::decay_t<Args>...>())
+                record.Defer<std::decay_t<Args>...>(fmt, args...);
+            else
+                record.Format(fmt, std::make_format_args(args...));
+        });
+    }
 
-    #ifdef USING_IMGUI
-            LoggerGUI::Instance().AddLog(level, log.str().c_str());
-    #endif // USING_IMGUI
+    template<typename Fill>
+    inline void LogQueue::Submit(Logger& logger, aLogLevel level, Fill&& fill) {
+        auto stamp = [&](LogRecord& record) {
+            record.mTime = std::chrono::system_clock::now();
+            record.mLogger = &logger;
+            record.mLevel = level;
+            fill(record);
+        };
 
-        // Write to file
-        if (!mLogFile.is_open())
+        // Logs made while the program exits are written at once
+        mSubmitting.fetch_add(1, std::memory_order_seq_cst);
+        if (mClosed.load(std::memory_order_seq_cst)) {
+            mSubmitting.fetch_sub(1, std::memory_order_release);
+            LogRecord record;
+            stamp(record);
+            WriteNow(record);
+            return;
+        }
+
+        LogQueue& queue = Instance();
+        size_t position{};
+        LogRecord* record = queue.Claim(level, position);
+        if (record) {
+            stamp(*record);
+            queue.Publish(position);
+        }
+        mSubmitting.fetch_sub(1, std::memory_order_release);
+        if (!record)
             return;
 
-        std::string loglevel = '[' + LogLevelToString(level) + ']';
-        log.str("");
-        log.clear();
-        log << timestamp << name;
-        log << std::setw(9) << std::left << loglevel << ' ';
-        log << all_args << '\n';
-        mLogFile << log.str();
+        if (level >= aLogLevel::LOGLEVEL_ERROR)
+            Flush();
     }
 
 } // end namespace IS
@@ -0,0 +1,310 @@
+/*!
+ * \file Profiler.cpp
+ * \author Guo Yiming, yiming.guo@digipen.edu
+ * \par Course: CSD2451
+ * \date 19-10-2026
+ * \brief
+ * This source file defines the implementation for class Profiler, which records
+ * nested zones, counters and frame markers from every thread into per-thread
+ * buffers and exports them as Chrome traces.
+ *
+ * \copyright
+ * All content (C) 2024 DigiPen Institute of Technology Singapore.
+ * All rights reserved.
+ * Reproduction or disclosure of this file or its contents without the prior written
+ * consent of DigiPen Institute of Technology is prohibited.
+ *____________________________________________________________________________*/
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include "Pch.h"
+#include "Profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace IS {
+
+    namespace {
+        // Nanoseconds of the steady clock
+        uint64_t Now()
+        {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+        // Writes a string as a JSON string
+        void WriteJsonString(std::ostream& stream, const char* text)
+        {
+            stream << '"';
+            for (const char* c = text ? text : ""; *c; ++c)
+            {
+                if (*c == '"' || *c == '\\')
+                    stream << '\\';
+                stream << *c;
+            }
+            stream << '"';
+        }
+    }
+
+    Profiler& Profiler::Instance()
+    {
+        static Profiler instance;
+        return instance;
+    }
+
+    Profiler::ThreadBuffer& Profiler::GetThreadBuffer()
+    {
+        // hands the buffer back when the thread exits
+        struct Owner {
+            ThreadBuffer* mBuffer{};
+            ~Owner()
+            {
+                if (mBuffer)
+                {
+                    mBuffer->mName.store(nullptr, std::memory_order_relaxed);
+                    mBuffer->mInUse.store(false, std::memory_order_release);
+                }
+            }
+        };
+        thread_local Owner owner;
+
+        if (!owner.mBuffer)
+        {
+            Profiler& profiler = Instance();
+            std::lock_guard<std::mutex> lock(profiler.mBuffersMutex);
+            for (auto& buffer : profiler.mBuffers)
+            {
+                if (!buffer->mInUse.load(std::memory_order_acquire))
+                {
+                    owner.mBuffer = buffer.get();
+                    break;
+                }
+            }
+            if (!owner.mBuffer)
+            {
+                profiler.mBuffers.push_back(std::make_unique<ThreadBuffer>());
+                owner.mBuffer = profiler.mBuffers.back().get();
+                owner.mBuffer->mIndex = static_cast<uint32_t>(profiler.mBuffers.size() - 1);
+            }
+            owner.mBuffer->mInUse.store(true, std::memory_order_relaxed);
+        }
+        return *owner.mBuffer;
+    }
+
+    void Profiler::Record(EventType type, const char* name, double value)
+    {
+        ThreadBuffer& buffer = GetThreadBuffer();
+        uint64_t head = buffer.mHead.load(std::memory_order_relaxed);
+        if (head - buffer.mTail.load(std::memory_order_acquire) >= THREAD_BUFFER_SIZE)
+        {
+            buffer.mDropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        buffer.mEvents[head % THREAD_BUFFER_SIZE] = { name, Now(), value, type };
+        buffer.mHead.store(head + 1, std::memory_order_release);
+    }
+
+    void Profiler::BeginZone(const char* name)
+    {
+        if (mEnabled.load(std::memory_order_relaxed))
+            Record(EventType::ZoneBegin, name, 0.0);
+    }
+
+    void Profiler::EndZone(const char* name)
+    {
+        if (mEnabled.load(std::memory_order_relaxed))
+            Record(EventType::ZoneEnd, name, 0.0);
+    }
+
+    void Profiler::Counter(const char* name, double value)
+    {
+        if (mEnabled.load(std::memory_order_relaxed))
+            Record(EventType::Counter, name, value);
+    }
+
+    void Profiler::SetThreadName(const char* name)
+    {
+        GetThreadBuffer().mName.store(name, std::memory_order_relaxed);
+    }
+
+    const char* Profiler::GetThreadName(uint32_t thread) const
+    {
+        std::lock_guard<std::mutex> lock(mBuffersMutex);
+        const char* name = thread < mBuffers.size() ? mBuffers[thread]->mName.load(std::memory_order_relaxed) : nullptr;
+        return name ? name : "Thread";
+    }
+
+    void Profiler::EndFrame()
+    {
+        if (mEnabled.load(std::memory_order_relaxed))
+            Record(EventType::Frame, "Frame", 0.0);
+        Drain();
+    }
+
+    void Profiler::Drain()
+    {
+        uint64_t frame_end = Now();
+        mFrameZones.clear();
+
+        std::lock_guard<std::mutex> lock(mBuffersMutex);
+        for (auto& buffer : mBuffers)
+        {
+            uint64_t tail = buffer->mTail.load(std::memory_order_relaxed);
+            uint64_t head = buffer->mHead.load(std::memory_order_acquire);
+            for (; tail != head; ++tail)
+            {
+                Event const& event = buffer->mEvents[tail % THREAD_BUFFER_SIZE];
+                if (mCapturing && event.mTime >= mCaptureStart && mCapture.size() < MAX_CAPTURE_EVENTS)
+                    mCapture.push_back({ event, buffer->mIndex });
+
+                switch (event.mType)
+                {
+                case EventType::ZoneBegin:
+                    buffer->mOpenZones.emplace_back(event.mName, event.mTime);
+                    break;
+                case EventType::ZoneEnd:
+                {
+                    // close the innermost matching zone, zones left open by dropped events are closed with it
+                    auto& open = buffer->mOpenZones;
+                    auto zone = std::find_if(open.rbegin(), open.rend(), [&event](auto const& entry) { return entry.first == event.mName; });
+                    if (zone == open.rend())
+                        break;
+                    size_t depth = static_cast<size_t>(std::distance(zone, open.rend())) - 1;
+                    uint64_t start = zone->second;
+                    mFrameZones.push_back({ event.mName, buffer->mIndex, static_cast<uint32_t>(depth),
+                                            start > mFrameStart ? start - mFrameStart : 0, event.mTime - start });
+                    open.resize(depth);
+                    break;
+                }
+                case EventType::Counter:
+                    mCounters[event.mName] = event.mValue;
+                    break;
+                case EventType::Frame:
+                    break;
+                }
+            }
+            buffer->mTail.store(head, std::memory_order_release);
+        }
+
+        std::sort(mFrameZones.begin(), mFrameZones.end(), [](Zone const& lhs, Zone const& rhs) {
+            return lhs.mThread != rhs.mThread ? lhs.mThread < rhs.mThread : lhs.mStart < rhs.mStart;
+        });
+        mFrameStart = frame_end;
+    }
+
+    void Profiler::BeginCapture()
+    {
+        if (mCapturing)
+            return;
+
+        mCapture.clear();
+        mCapture.reserve(THREAD_BUFFER_SIZE);
+        mCaptureStart = Now();
+        mCapturing = true;
+    }
+
+    std::string Profiler::EndCapture(std::string const& filepath)
+    {
+        if (!mCapturing)
+            return {};
+
+        Drain();
+        mCapturing = false;
+
+        std::string path = filepath;
+        if (path.empty())
+        {
+            // name the trace after the time it was saved
+            std::time_t now = std::time(nullptr);
+            std::tm local_time{};
+#ifdef _WIN32
+            localtime_s(&local_time, &now);
+#else
+            localtime_r(&now, &local_time);
+#endif
+            std::ostringstream stream;
+            stream << PROFILE_DIRECTORY << "trace" << std::put_time(&local_time, "_%Y%m%d_%H%M%S") << ".json";
+            path = stream.str();
+        }
+        if (std::filesystem::path parent = std::filesystem::path(path).parent_path(); !parent.empty())
+            std::filesystem::create_directories(parent);
+
+        uint64_t dropped{};
+        {
+            std::lock_guard<std::mutex> lock(mBuffersMutex);
+            for (auto const& buffer : mBuffers)
+                dropped += buffer->mDropped.load(std::memory_order_relaxed);
+        }
+
+        bool written = WriteTrace(path);
+        size_t events = mCapture.size();
+        mCapture.clear();
+        mCapture.shrink_to_fit();
+        if (!written)
+        {
+            IS_CORE_ERROR("Failed to write profiler capture {}", path);
+            return {};
+        }
+
+        IS_CORE_INFO("Saved profiler capture {} ({} events)", path, events);
+        if (dropped > 0)
+            IS_CORE_WARN("Profiler dropped {} events to full thread buffers", dropped);
+        if (events >= MAX_CAPTURE_EVENTS)
+            IS_CORE_WARN("Profiler capture reached its limit of {} events", MAX_CAPTURE_EVENTS);
+        return path;
+    }
+
+    bool Profiler::WriteTrace(std::string const& filepath) const
+    {
+        std::ofstream file(filepath);
+        if (!file)
+            return false;
+
+        file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        file << std::fixed << std::setprecision(3);
+
+        bool first = true;
+        auto separate = [&file, &first]() {
+            if (!first)
+                file << ",\n";
+            first = false;
+        };
+
+        {
+            std::lock_guard<std::mutex> lock(mBuffersMutex);
+            for (auto const& buffer : mBuffers)
+            {
+                const char* name = buffer->mName.load(std::memory_order_relaxed);
+                separate();
+                file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->mIndex << ",\"args\":{\"name\":";
+                WriteJsonString(file, name ? name : "Thread");
+                file << "}}";
+            }
+        }
+
+        for (auto const& [event, thread] : mCapture)
+        {
+            separate();
+            file << "{\"name\":";
+            WriteJsonString(file, event.mName);
+            file << ",\"ts\":" << static_cast<double>(event.mTime - mCaptureStart) / 1000.0 << ",\"pid\":1,\"tid\":" << thread;
+            switch (event.mType)
+            {
+            case EventType::ZoneBegin: file << ",\"ph\":\"B\"}"; break;
+            case EventType::ZoneEnd:   file << ",\"ph\":\"E\"}"; break;
+            case EventType::Counter:   file << ",\"ph\":\"C\",\"args\":{\"value\":" << event.mValue << "}}"; break;
+            case EventType::Frame:     file << ",\"ph\":\"i\",\"s\":\"g\"}"; break;
+            }
+        }
+
+        file << "\n]}\n";
+        return static_cast<bool>(file);
+    }
+
+} // end namespace IS
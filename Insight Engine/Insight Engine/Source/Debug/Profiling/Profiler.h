@@ -0,0 +1,248 @@
+/*!
+ * \file Profiler.h
+ * \author Guo Yiming, yiming.guo@digipen.edu
+ * \par Course: CSD2451
+ * \date 19-10-2026
+ * \brief
+ * This header file declares the interface for class Profiler, which records
+ * nested zones, counters and frame markers from every thread into per-thread
+ * buffers, and the profiling macros built on it.
+ *
+ * \copyright
+ * All content (C) 2024 DigiPen Institute of Technology Singapore.
+ * All rights reserved.
+ * Reproduction or disclosure of this file or its contents without the prior written
+ * consent of DigiPen Institute of Technology is prohibited.
+ *____________________________________________________________________________*/
+
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+#ifndef GAM200_INSIGHT_ENGINE_DEBUG_PROFILING_PROFILER_H
+#define GAM200_INSIGHT_ENGINE_DEBUG_PROFILING_PROFILER_H
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace IS {
+
+    /*!
+     * \brief The Profiler class records zones, counters and frame markers.
+     *
+     * Each thread appends its events to its own ring buffer, which only that thread
+     * writes and only the main thread reads, so recording takes no lock. Zone names are
+     * not copied, they must outlive the profiler (string literals, or names owned by a
+     * system). Once per frame the main thread drains the buffers, keeping the zones of
+     * the frame for the editor and, while capturing, every event for a Chrome trace
+     * (chrome://tracing or ui.perfetto.dev).
+     *
+     * The macros below compile to nothing unless IS_PROFILER is defined.
+     */
+    class Profiler {
+    public:
+        static constexpr const char* PROFILE_DIRECTORY = "Assets/Profiles/"; ///< Directory where captures are saved.
+        static constexpr size_t THREAD_BUFFER_SIZE = 1 << 14;                 ///< Events a thread can record between two frames.
+        static constexpr size_t MAX_CAPTURE_EVENTS = 1 << 22;                 ///< Events kept by a capture.
+
+        /*!
+         * \brief A zone of the last frame, as shown in the editor.
+         */
+        struct Zone {
+            const char* mName{};    ///< Name of the zone.
+            uint32_t mThread{};     ///< Index of the thread the zone ran on.
+            uint32_t mDepth{};      ///< Number of zones it is nested in.
+            uint64_t mStart{};      ///< Start in nanoseconds, relative to the frame marker before it.
+            uint64_t mDuration{};   ///< Duration in nanoseconds.
+        };
+
+        /*!
+         * \brief Gets the singleton instance of the profiler.
+         *
+         * \return Reference to the profiler.
+         */
+        static Profiler& Instance();
+
+        /*!
+         * \brief Opens a zone on the calling thread.
+         *
+         * \param name Name of the zone, not copied.
+         */
+        static void BeginZone(const char* name);
+
+        /*!
+         * \brief Closes the innermost zone of the calling thread.
+         *
+         * \param name Name of the zone.
+         */
+        static void EndZone(const char* name);
+
+        /*!
+         * \brief Records the value of a counter.
+         *
+         * \param name Name of the counter, not copied.
+         * \param value Value of the counter.
+         */
+        static void Counter(const char* name, double value);
+
+        /*!
+         * \brief Names the calling thread in the editor and in captures.
+         *
+         * \param name Name of the thread, not copied.
+         */
+        static void SetThreadName(const char* name);
+
+        /*!
+         * \brief Marks the end of a frame and drains the buffers of every thread, on the main thread.
+         */
+        void EndFrame();
+
+        /*!
+         * \brief Starts keeping every event for a capture.
+         */
+        void BeginCapture();
+
+        /*!
+         * \brief Stops the capture and writes it as a Chrome trace.
+         *
+         * \param filepath Path of the trace, empty to save it to the profile directory.
+         * \return Path of the trace, empty if it could not be written.
+         */
+        std::string EndCapture(std::string const& filepath = {});
+
+        bool IsCapturing() const { return mCapturing; }
+
+        /*!
+         * \brief Gets the zones that ended in the last frame, ordered by thread then start.
+         */
+        std::vector<Zone> const& GetFrameZones() const { return mFrameZones; }
+
+        /*!
+         * \brief Gets the last value of each counter.
+         */
+        std::unordered_map<const char*, double> const& GetCounters() const { return mCounters; }
+
+        /*!
+         * \brief Gets the name of a thread.
+         *
+         * \param thread Index of the thread.
+         */
+        const char* GetThreadName(uint32_t thread) const;
+
+        static inline std::atomic<bool> mEnabled{ true }; ///< Whether events are recorded.
+
+    private:
+        enum class EventType : uint8_t { ZoneBegin, ZoneEnd, Counter, Frame };
+
+        /*!
+         * \brief An event as recorded by a thread.
+         */
+        struct Event {
+            const char* mName;
+            uint64_t mTime;     ///< Nanoseconds of the steady clock.
+            double mValue;      ///< Value of a counter.
+            EventType mType;
+        };
+
+        /*!
+         * \brief An event kept by a capture.
+         */
+        struct CapturedEvent {
+            Event mEvent;
+            uint32_t mThread;
+        };
+
+        /*!
+         * \brief Ring buffer of the events of a thread.
+         *
+         * The owning thread advances mHead and the main thread advances mTail.
+         */
+        struct ThreadBuffer {
+            std::array<Event, THREAD_BUFFER_SIZE> mEvents{};
+            std::atomic<uint64_t> mHead{};
+            std::atomic<uint64_t> mTail{};
+            std::atomic<uint64_t> mDropped{};       ///< Events lost to a full buffer.
+            std::atomic<const char*> mName{};
+            std::atomic<bool> mInUse{};             ///< Whether a thread owns the buffer, buffers of exited threads are reused.
+            uint32_t mIndex{};
+
+            // Read by the main thread only
+            std::vector<std::pair<const char*, uint64_t>> mOpenZones; ///< Names and starts of the zones not closed yet.
+        };
+
+        Profiler() = default;
+
+        /*!
+         * \brief Gets the buffer of the calling thread, taking a free one or registering a new one on first use.
+         */
+        static ThreadBuffer& GetThreadBuffer();
+
+        /*!
+         * \brief Appends an event to the buffer of the calling thread.
+         */
+        static void Record(EventType type, const char* name, double value);
+
+        /*!
+         * \brief Reads the events recorded since the last drain, on the main thread.
+         */
+        void Drain();
+
+        /*!
+         * \brief Writes the captured events as a Chrome trace.
+         */
+        bool WriteTrace(std::string const& filepath) const;
+
+        mutable std::mutex mBuffersMutex;                   ///< Guards the list of buffers, not their events.
+        std::vector<std::unique_ptr<ThreadBuffer>> mBuffers;
+        std::vector<Zone> mFrameZones;
+        std::unordered_map<const char*, double> mCounters;
+        uint64_t mFrameStart{};
+
+        bool mCapturing{};
+        uint64_t mCaptureStart{};
+        std::vector<CapturedEvent> mCapture;
+    };
+
+    /*!
+     * \brief Opens a zone for the lifetime of the object.
+     */
+    class ProfileZone {
+    public:
+        explicit ProfileZone(const char* name) : mName(name) { Profiler::BeginZone(name); }
+        ~ProfileZone() { Profiler::EndZone(mName); }
+
+        ProfileZone(ProfileZone const&) = delete;
+        ProfileZone& operator=(ProfileZone const&) = delete;
+
+    private:
+        const char* mName;
+    };
+
+} // end namespace IS
+
+/*                                                                     macros
+----------------------------------------------------------------------------- */
+#define IS_PROFILE_CONCAT_IMPL(a, b) a##b
+#define IS_PROFILE_CONCAT(a, b) IS_PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef IS_PROFILER
+#define IS_PROFILE_SCOPE(name) IS::ProfileZone IS_PROFILE_CONCAT(profile_zone_, __LINE__)(name) // zone within a scope
+#define IS_PROFILE_FUNCTION() IS_PROFILE_SCOPE(__FUNCTION__)                                   // zone within a function
+#define IS_PROFILE_COUNTER(name, value) IS::Profiler::Counter(name, static_cast<double>(value)) // value of a counter
+#define IS_PROFILE_FRAME() IS::Profiler::Instance().EndFrame()                                 // end of a frame
+#define IS_PROFILE_THREAD(name) IS::Profiler::SetThreadName(name)                              // name of this thread
+#else
+#define IS_PROFILE_SCOPE(name)
+#define IS_PROFILE_FUNCTION()
+#define IS_PROFILE_COUNTER(name, value)
+#define IS_PROFILE_FRAME()
+#define IS_PROFILE_THREAD(name)
+#endif // IS_PROFILER
+
+#endif // !GAM200_INSIGHT_ENGINE_DEBUG_PROFILING_PROFILER_H
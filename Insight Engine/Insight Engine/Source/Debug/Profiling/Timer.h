@@ -76,9 +76,4 @@ namespace IS {
 
 } // end namespace IS
 
-/*                                                                     macros
------------------------------------------------------------------------------ */
-#define IS_PROFILE_SCOPE(name) IS::Timer timer##__LINE__(name) // time within a scope
-#define IS_PROFILE_FUNCTION() IS_PROFILE_SCOPE(__FUNCTION__)   // time within a function
-
 #endif // !GAM200_INSIGHT_ENGINE_DEBUG_PROFILING_TIMER_H
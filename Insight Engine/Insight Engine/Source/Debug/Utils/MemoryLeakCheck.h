@@ -6,7 +6,9 @@
  * \brief
  * This header file defines new as DEBUG_NEW which tracks the normal block,
  * file and line of where it was used, as well as setting debug flags.
- * 
+ * The CRT leak check only exists with the MSVC debug runtime, elsewhere the
+ * MemoryTracker reports the blocks left at shutdown.
+ *
  * \copyright
  * All content (C) 2024 DigiPen Institute of Technology Singapore.
  * All rights reserved.
@@ -21,14 +23,17 @@
 
 /*                                                                   includes
 ----------------------------------------------------------------------------- */
-#define _CRTDBG_MAP_ALLOC
-#include <crtdbg.h>
-#ifdef _DEBUG
-    #define DEBUG_NEW new(_NORMAL_BLOCK, __FILE__, __LINE__)
-    #define new DEBUG_NEW
+#if defined(_MSC_VER) && defined(_DEBUG)
+    #define _CRTDBG_MAP_ALLOC
+    #include <crtdbg.h>
+    // DEBUG_NEW allocates from the CRT directly, which the tracker's operator delete cannot free
+    #ifndef IS_MEMORY_TRACKING
+        #define DEBUG_NEW new(_NORMAL_BLOCK, __FILE__, __LINE__)
+        #define new DEBUG_NEW
+    #endif
     #define ENABLE_MEMORY_CHECK() _CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF | _CRTDBG_LEAK_CHECK_DF)
 #else
-    #define ENABLE_MEMORY_CHECK __noop
+    #define ENABLE_MEMORY_CHECK() ((void)0)
 #endif
 
 
@@ -0,0 +1,424 @@
+/*!
+ * \file MemoryTracker.cpp
+ * \author Guo Yiming, yiming.guo@digipen.edu
+ * \par Course: CSD2451
+ * \date 19-10-2026
+ * \brief
+ * This source file defines the implementation for class MemoryTracker, which
+ * counts the heap allocations of the engine per subsystem tag, and the global
+ * operator new and delete it replaces.
+ *
+ * \copyright
+ * All content (C) 2024 DigiPen Institute of Technology Singapore.
+ * All rights reserved.
+ * Reproduction or disclosure of this file or its contents without the prior written
+ * consent of DigiPen Institute of Technology is prohibited.
+ *____________________________________________________________________________*/
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include "Pch.h"
+#include "MemoryTracker.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <thread>
+#include <unordered_map>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace IS {
+
+    namespace {
+        // Counters of a tag, the last entry holds the totals
+        struct Counters {
+            std::atomic<uint64_t> mLiveBytes;
+            std::atomic<uint64_t> mPeakBytes;
+            std::atomic<uint64_t> mLiveBlocks;
+            std::atomic<uint64_t> mAllocations;
+            std::atomic<uint64_t> mAllocatedBytes;
+        };
+        std::array<Counters, MemoryTracker::TAG_COUNT + 1> gCounters{};
+
+        thread_local MemoryTag tThreadTag = MemoryTag::General;
+
+        // Alignment malloc guarantees, larger alignments go through the aligned allocator
+        constexpr size_t BASE_ALIGNMENT = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+        // Size and tag of a tracked block, kept outside the block so blocks from other modules can be freed here
+        struct BlockRecord {
+            uintptr_t mAddress;     ///< Address of the block, EMPTY or TOMBSTONE for a free slot.
+            uint64_t mSize;         ///< Size requested.
+            MemoryTag mTag;
+            bool mAligned;          ///< Allocated with the aligned allocator.
+        };
+        constexpr uintptr_t EMPTY = 0;
+        constexpr uintptr_t TOMBSTONE = 1;
+
+        // Open addressing table of the blocks hashing to it, allocated with calloc so it never calls operator new
+        struct BlockShard {
+            std::atomic_flag mLock;
+            BlockRecord* mRecords;
+            size_t mCapacity;       ///< Power of two, 0 until the first block.
+            size_t mUsed;           ///< Slots holding a record or a tombstone.
+            size_t mLive;           ///< Slots holding a record.
+        };
+        constexpr size_t SHARD_BITS = 6;
+        constexpr size_t MIN_SHARD_CAPACITY = 1024;
+        std::array<BlockShard, size_t{ 1 } << SHARD_BITS> gShards{};
+
+        class ShardLock {
+        public:
+            explicit ShardLock(BlockShard& shard) : mShard(shard)
+            {
+                while (mShard.mLock.test_and_set(std::memory_order_acquire))
+                    std::this_thread::yield();
+            }
+            ~ShardLock() { mShard.mLock.clear(std::memory_order_release); }
+
+            ShardLock(ShardLock const&) = delete;
+            ShardLock& operator=(ShardLock const&) = delete;
+
+        private:
+            BlockShard& mShard;
+        };
+
+        uint64_t HashAddress(uintptr_t address)
+        {
+            return (static_cast<uint64_t>(address) >> 4) * 0x9E3779B97F4A7C15ull;
+        }
+
+        BlockShard& GetShard(uintptr_t address)
+        {
+            return gShards[HashAddress(address) >> (64 - SHARD_BITS)];
+        }
+
+        // Places a record in a table with a free slot, the address is not in the table
+        void Place(BlockRecord* records, size_t capacity, BlockRecord const& record)
+        {
+            size_t mask = capacity - 1;
+            size_t slot = HashAddress(record.mAddress) & mask;
+            while (records[slot].mAddress != EMPTY)
+                slot = (slot + 1) & mask;
+            records[slot] = record;
+        }
+
+        // Rebuilds the table of a shard without tombstones, doubling it when half of it is live
+        bool Rehash(BlockShard& shard)
+        {
+            size_t capacity = MIN_SHARD_CAPACITY;
+            while (capacity < (shard.mLive + 1) * 4)
+                capacity *= 2;
+
+            auto* records = static_cast<BlockRecord*>(std::calloc(capacity, sizeof(BlockRecord)));
+            if (!records)
+                return false;
+            for (size_t i = 0; i < shard.mCapacity; ++i) {
+                if (shard.mRecords[i].mAddress > TOMBSTONE)
+                    Place(records, capacity, shard.mRecords[i]);
+            }
+            std::free(shard.mRecords);
+            shard.mRecords = records;
+            shard.mCapacity = capacity;
+            shard.mUsed = shard.mLive;
+            return true;
+        }
+
+        // Finds the slot of an address, or -1
+        ptrdiff_t Find(BlockShard const& shard, uintptr_t address)
+        {
+            if (shard.mCapacity == 0)
+                return -1;
+            size_t mask = shard.mCapacity - 1;
+            for (size_t slot = HashAddress(address) & mask; shard.mRecords[slot].mAddress != EMPTY; slot = (slot + 1) & mask) {
+                if (shard.mRecords[slot].mAddress == address)
+                    return static_cast<ptrdiff_t>(slot);
+            }
+            return -1;
+        }
+
+        void RaisePeak(std::atomic<uint64_t>& peak, uint64_t live)
+        {
+            uint64_t current = peak.load(std::memory_order_relaxed);
+            while (live > current && !peak.compare_exchange_weak(current, live, std::memory_order_relaxed)) {}
+        }
+
+        void CountAllocation(Counters& counters, uint64_t size)
+        {
+            counters.mAllocations.fetch_add(1, std::memory_order_relaxed);
+            counters.mAllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+            counters.mLiveBlocks.fetch_add(1, std::memory_order_relaxed);
+            RaisePeak(counters.mPeakBytes, counters.mLiveBytes.fetch_add(size, std::memory_order_relaxed) + size);
+        }
+
+        void CountFree(Counters& counters, uint64_t size)
+        {
+            counters.mLiveBlocks.fetch_sub(1, std::memory_order_relaxed);
+            counters.mLiveBytes.fetch_sub(size, std::memory_order_relaxed);
+        }
+
+        void CountFree(BlockRecord const& record)
+        {
+            CountFree(gCounters[static_cast<size_t>(record.mTag)], record.mSize);
+            CountFree(gCounters[MemoryTracker::TAG_COUNT], record.mSize);
+        }
+
+        // Records a block, a stale record of the same address was freed by another module and is dropped
+        bool Track(BlockRecord const& record)
+        {
+            BlockShard& shard = GetShard(record.mAddress);
+            ShardLock lock(shard);
+            if (ptrdiff_t slot = Find(shard, record.mAddress); slot >= 0) {
+                CountFree(shard.mRecords[slot]);
+                shard.mRecords[slot] = record;
+                return true;
+            }
+            if ((shard.mUsed + 1) * 2 > shard.mCapacity && !Rehash(shard))
+                return false;
+
+            size_t mask = shard.mCapacity - 1;
+            size_t slot = HashAddress(record.mAddress) & mask;
+            while (shard.mRecords[slot].mAddress > TOMBSTONE)
+                slot = (slot + 1) & mask;
+            shard.mUsed += shard.mRecords[slot].mAddress == EMPTY;
+            ++shard.mLive;
+            shard.mRecords[slot] = record;
+            return true;
+        }
+
+        // Removes the record of a block, false if the block was not allocated here
+        bool Untrack(uintptr_t address, BlockRecord& record)
+        {
+            BlockShard& shard = GetShard(address);
+            ShardLock lock(shard);
+            ptrdiff_t slot = Find(shard, address);
+            if (slot < 0)
+                return false;
+            record = shard.mRecords[slot];
+            shard.mRecords[slot].mAddress = TOMBSTONE;
+            --shard.mLive;
+            return true;
+        }
+
+        void* AlignedMalloc(size_t size, size_t alignment)
+        {
+#ifdef _WIN32
+            return _aligned_malloc(size, alignment);
+#else
+            return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+#endif
+        }
+
+        void AlignedFree(void* block)
+        {
+#ifdef _WIN32
+            _aligned_free(block);
+#else
+            std::free(block);
+#endif
+        }
+
+        // Reports the blocks still held once everything destroyed before it is gone
+        void ReportLeaksAtExit()
+        {
+            MemoryTracker::Instance().ReportLeaks();
+        }
+    }
+
+    MemoryTracker& MemoryTracker::Instance()
+    {
+        static MemoryTracker instance;
+        return instance;
+    }
+
+    void* MemoryTracker::Allocate(size_t size, size_t alignment) noexcept
+    {
+        // size 0 still gets a unique block
+        bool aligned = alignment > BASE_ALIGNMENT;
+        size_t bytes = size ? size : 1;
+        void* block = aligned ? AlignedMalloc(bytes, alignment) : std::malloc(bytes);
+        if (!block)
+            return nullptr;
+
+        MemoryTag tag = tThreadTag;
+        if (!Track({ reinterpret_cast<uintptr_t>(block), size, tag, aligned })) {
+            aligned ? AlignedFree(block) : std::free(block);
+            return nullptr;
+        }
+        CountAllocation(gCounters[static_cast<size_t>(tag)], size);
+        CountAllocation(gCounters[TAG_COUNT], size);
+        return block;
+    }
+
+    void MemoryTracker::Free(void* block, bool aligned) noexcept
+    {
+        if (!block)
+            return;
+
+        // blocks from other modules are not tracked, they are freed as the delete called asked
+        BlockRecord record{};
+        if (Untrack(reinterpret_cast<uintptr_t>(block), record)) {
+            CountFree(record);
+            aligned = record.mAligned;
+        }
+        aligned ? AlignedFree(block) : std::free(block);
+    }
+
+    MemoryTag MemoryTracker::SetThreadTag(MemoryTag tag) noexcept
+    {
+        MemoryTag previous = tThreadTag;
+        tThreadTag = tag;
+        return previous;
+    }
+
+    MemoryTracker::Stats MemoryTracker::GetStats(MemoryTag tag)
+    {
+        Counters const& counters = gCounters[static_cast<size_t>(tag)];
+        return { counters.mLiveBytes.load(std::memory_order_relaxed),
+                 counters.mPeakBytes.load(std::memory_order_relaxed),
+                 counters.mLiveBlocks.load(std::memory_order_relaxed),
+                 counters.mAllocations.load(std::memory_order_relaxed),
+                 counters.mAllocatedBytes.load(std::memory_order_relaxed) };
+    }
+
+    void MemoryTracker::ResetPeaks()
+    {
+        for (Counters& counters : gCounters)
+            counters.mPeakBytes.store(counters.mLiveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    const char* MemoryTracker::GetTagName(MemoryTag tag)
+    {
+        switch (tag)
+        {
+        case MemoryTag::General:   return "General";
+        case MemoryTag::ECS:       return "ECS";
+        case MemoryTag::Physics:   return "Physics";
+        case MemoryTag::Graphics:  return "Graphics";
+        case MemoryTag::Audio:     return "Audio";
+        case MemoryTag::Scripting: return "Scripting";
+        case MemoryTag::Editor:    return "Editor";
+        case MemoryTag::Assets:    return "Assets";
+        default:                   return "Total";
+        }
+    }
+
+    MemoryTag MemoryTracker::GetSystemTag(std::string const& system_name)
+    {
+        static const std::unordered_map<std::string, MemoryTag> system_tags{
+            { "Physics",         MemoryTag::Physics },
+            { "CollisionSystem", MemoryTag::Physics },
+            { "Rewinder",        MemoryTag::Physics },
+            { "Graphics",        MemoryTag::Graphics },
+            { "Particle",        MemoryTag::Graphics },
+            { "Audio",           MemoryTag::Audio },
+            { "AudioEmitter",    MemoryTag::Audio },
+            { "ScriptManager",   MemoryTag::Scripting },
+            { "StateManager",    MemoryTag::Scripting },
+            { "AIFSM",           MemoryTag::Scripting },
+            { "Asset",           MemoryTag::Assets }
+        };
+        auto tag = system_tags.find(system_name);
+        return tag != system_tags.end() ? tag->second : MemoryTag::General;
+    }
+
+    void MemoryTracker::EndFrame()
+    {
+        for (size_t i = 0; i <= TAG_COUNT; ++i)
+        {
+            Stats stats = GetStats(static_cast<MemoryTag>(i));
+            mFrameStats[i] = { stats.mAllocations - mLastFrame[i].mAllocations, stats.mAllocatedBytes - mLastFrame[i].mAllocatedBytes };
+            mLastFrame[i] = stats;
+        }
+
+        IS_PROFILE_COUNTER("Heap Live (KB)", mLastFrame[TAG_COUNT].mLiveBytes / 1024);
+        IS_PROFILE_COUNTER("Heap Allocations", mFrameStats[TAG_COUNT].mAllocations);
+    }
+
+    void MemoryTracker::MarkBaseline()
+    {
+        for (size_t i = 0; i <= TAG_COUNT; ++i)
+            mBaseline[i] = GetStats(static_cast<MemoryTag>(i));
+
+        // atexit handlers and statics are torn down in reverse order, registering now runs the
+        // report after the engine, its systems and every singleton created from here on are destroyed
+        static bool registered = false;
+        if (!registered)
+            registered = std::atexit(ReportLeaksAtExit) == 0;
+    }
+
+    void MemoryTracker::ReportLeaks() const
+    {
+        // the logger is destroyed by now, write straight to stderr
+        bool leaked = false;
+        for (size_t i = 0; i < TAG_COUNT; ++i)
+        {
+            Stats stats = GetStats(static_cast<MemoryTag>(i));
+            int64_t blocks = static_cast<int64_t>(stats.mLiveBlocks - mBaseline[i].mLiveBlocks);
+            int64_t bytes = static_cast<int64_t>(stats.mLiveBytes - mBaseline[i].mLiveBytes);
+            if (blocks <= 0 && bytes <= 0)
+                continue;
+
+            std::fprintf(stderr, "[Memory] %s still holds %lld blocks (%lld bytes) allocated since startup\n",
+                         GetTagName(static_cast<MemoryTag>(i)), static_cast<long long>(blocks), static_cast<long long>(bytes));
+            leaked = true;
+        }
+        if (!leaked)
+            std::fprintf(stderr, "[Memory] No memory allocated since startup is still held\n");
+
+        Stats total = GetStats(MemoryTag::Count);
+        std::fprintf(stderr, "[Memory] Peak heap usage %llu bytes over %llu allocations\n",
+                     static_cast<unsigned long long>(total.mPeakBytes), static_cast<unsigned long long>(total.mAllocations));
+    }
+
+} // end namespace IS
+
+#ifdef IS_MEMORY_TRACKING
+
+/*                                                         operator new/delete
+----------------------------------------------------------------------------- */
+namespace {
+    // Allocates like the standard operator new, calling the new handler until it succeeds
+    void* AllocateOrThrow(std::size_t size, std::size_t alignment)
+    {
+        for (;;)
+        {
+            if (void* block = IS::MemoryTracker::Allocate(size, alignment))
+                return block;
+            std::new_handler handler = std::get_new_handler();
+            if (!handler)
+                throw std::bad_alloc();
+            handler();
+        }
+    }
+}
+
+void* operator new(std::size_t size) { return AllocateOrThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new[](std::size_t size) { return AllocateOrThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return AllocateOrThrow(size, static_cast<std::size_t>(alignment)); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return AllocateOrThrow(size, static_cast<std::size_t>(alignment)); }
+
+void* operator new(std::size_t size, std::nothrow_t const&) noexcept { return IS::MemoryTracker::Allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new[](std::size_t size, std::nothrow_t const&) noexcept { return IS::MemoryTracker::Allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new(std::size_t size, std::align_val_t alignment, std::nothrow_t const&) noexcept { return IS::MemoryTracker::Allocate(size, static_cast<std::size_t>(alignment)); }
+void* operator new[](std::size_t size, std::align_val_t alignment, std::nothrow_t const&) noexcept { return IS::MemoryTracker::Allocate(size, static_cast<std::size_t>(alignment)); }
+
+// The block table knows the size and allocator of tracked blocks, the aligned overloads only matter for foreign ones
+void operator delete(void* block) noexcept { IS::MemoryTracker::Free(block, false); }
+void operator delete[](void* block) noexcept { IS::MemoryTracker::Free(block, false); }
+void operator delete(void* block, std::size_t) noexcept { IS::MemoryTracker::Free(block, false); }
+void operator delete[](void* block, std::size_t) noexcept { IS::MemoryTracker::Free(block, false); }
+void operator delete(void* block, std::align_val_t) noexcept { IS::MemoryTracker::Free(block, true); }
+void operator delete[](void* block, std::align_val_t) noexcept { IS::MemoryTracker::Free(block, true); }
+void operator delete(void* block, std::size_t, std::align_val_t) noexcept { IS::MemoryTracker::Free(block, true); }
+void operator delete[](void* block, std::size_t, std::align_val_t) noexcept { IS::MemoryTracker::Free(block, true); }
+void operator delete(void* block, std::nothrow_t const&) noexcept { IS::MemoryTracker::Free(block, false); }
+void operator delete[](void* block, std::nothrow_t const&) noexcept { IS::MemoryTracker::Free(block, false); }
+void operator delete(void* block, std::align_val_t, std::nothrow_t const&) noexcept { IS::MemoryTracker::Free(block, true); }
+void operator delete[](void* block, std::align_val_t, std::nothrow_t const&) noexcept { IS::MemoryTracker::Free(block, true); }
+
+#endif // IS_MEMORY_TRACKING
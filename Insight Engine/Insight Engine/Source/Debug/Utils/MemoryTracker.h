@@ -0,0 +1,208 @@
+/*!
+ * \file MemoryTracker.h
+ * \author Guo Yiming, yiming.guo@digipen.edu
+ * \par Course: CSD2451
+ * \date 19-10-2026
+ * \brief
+ * This header file declares the interface for class MemoryTracker, which counts
+ * the heap allocations of the engine per subsystem tag, and the macros used to
+ * tag allocations.
+ *
+ * \copyright
+ * All content (C) 2024 DigiPen Institute of Technology Singapore.
+ * All rights reserved.
+ * Reproduction or disclosure of this file or its contents without the prior written
+ * consent of DigiPen Institute of Technology is prohibited.
+ *____________________________________________________________________________*/
+
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+#ifndef GAM200_INSIGHT_ENGINE_DEBUG_UTILS_MEMORY_TRACKER_H
+#define GAM200_INSIGHT_ENGINE_DEBUG_UTILS_MEMORY_TRACKER_H
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace IS {
+
+    /*!
+     * \brief Subsystem an allocation is charged to.
+     */
+    enum class MemoryTag : uint8_t {
+        General,
+        ECS,
+        Physics,
+        Graphics,
+        Audio,
+        Scripting,
+        Editor,
+        Assets,
+        Count   ///< Number of tags, also stands for the totals of every tag.
+    };
+
+    /*!
+     * \brief The MemoryTracker class counts heap allocations per subsystem.
+     *
+     * With IS_MEMORY_TRACKING defined, the global operator new and delete are replaced
+     * so that every block is recorded in a side table with its size and the tag of the
+     * thread that allocated it. The tag of a thread is set by IS_MEMORY_SCOPE, the
+     * engine sets it around each system, the editor and the entity functions. Frees
+     * are charged to the tag of the block, whichever thread frees it.
+     *
+     * Blocks are plain malloc blocks with nothing in front of them, so a block a DLL
+     * allocated from the shared CRT heap can still be deleted here. Such blocks are
+     * not in the table and are freed without being counted.
+     *
+     * Counters are relaxed atomics and the table is split into spin locked shards, so
+     * threads rarely wait on each other. Memory the C libraries get from malloc
+     * directly is not counted.
+     */
+    class MemoryTracker {
+    public:
+        static constexpr size_t TAG_COUNT = static_cast<size_t>(MemoryTag::Count); ///< Number of tags.
+
+        /*!
+         * \brief Counters of a tag since startup.
+         */
+        struct Stats {
+            uint64_t mLiveBytes{};      ///< Bytes allocated and not freed yet.
+            uint64_t mPeakBytes{};      ///< Highest live bytes since startup or the last reset.
+            uint64_t mLiveBlocks{};     ///< Blocks allocated and not freed yet.
+            uint64_t mAllocations{};    ///< Blocks allocated.
+            uint64_t mAllocatedBytes{}; ///< Bytes allocated.
+        };
+
+        /*!
+         * \brief Allocations of a tag during the last frame.
+         */
+        struct FrameStats {
+            uint64_t mAllocations{};
+            uint64_t mBytes{};
+        };
+
+        /*!
+         * \brief Gets the singleton instance of the memory tracker.
+         *
+         * \return Reference to the memory tracker.
+         */
+        static MemoryTracker& Instance();
+
+        /*!
+         * \brief Allocates a block charged to the tag of the calling thread.
+         *
+         * \param size Size of the block in bytes.
+         * \param alignment Alignment of the block, a power of two.
+         * \return Pointer to the block, nullptr if the heap is exhausted.
+         */
+        static void* Allocate(size_t size, size_t alignment) noexcept;
+
+        /*!
+         * \brief Frees a block returned by Allocate, or a block another module allocated.
+         *
+         * \param block Pointer to the block, may be nullptr.
+         * \param aligned Whether an aligned delete was called, only used for blocks not allocated here.
+         */
+        static void Free(void* block, bool aligned) noexcept;
+
+        /*!
+         * \brief Sets the tag allocations of the calling thread are charged to.
+         *
+         * \param tag The new tag.
+         * \return The previous tag.
+         */
+        static MemoryTag SetThreadTag(MemoryTag tag) noexcept;
+
+        /*!
+         * \brief Gets the counters of a tag.
+         *
+         * \param tag The tag, MemoryTag::Count for the totals.
+         */
+        static Stats GetStats(MemoryTag tag);
+
+        /*!
+         * \brief Sets the peak of every tag to its live bytes.
+         */
+        static void ResetPeaks();
+
+        /*!
+         * \brief Gets the name of a tag.
+         */
+        static const char* GetTagName(MemoryTag tag);
+
+        /*!
+         * \brief Gets the tag the updates of a system are charged to.
+         *
+         * \param system_name Name of the system.
+         */
+        static MemoryTag GetSystemTag(std::string const& system_name);
+
+        /*!
+         * \brief Computes the allocations of the frame that ended, on the main thread.
+         */
+        void EndFrame();
+
+        /*!
+         * \brief Gets the allocations of a tag during the last frame.
+         *
+         * \param tag The tag, MemoryTag::Count for the totals.
+         */
+        FrameStats const& GetFrameStats(MemoryTag tag) const { return mFrameStats[static_cast<size_t>(tag)]; }
+
+        /*!
+         * \brief Remembers the live blocks of every tag, which the leak report leaves out.
+         *
+         * The first call registers the leak report with std::atexit, so it runs after
+         * every function local static first used after the call is destroyed.
+         */
+        void MarkBaseline();
+
+        /*!
+         * \brief Writes the blocks of every tag still allocated since the baseline to stderr.
+         */
+        void ReportLeaks() const;
+
+    private:
+        MemoryTracker() = default;
+
+        std::array<FrameStats, TAG_COUNT + 1> mFrameStats{};
+        std::array<Stats, TAG_COUNT + 1> mLastFrame{};  ///< Counters at the end of the last frame.
+        std::array<Stats, TAG_COUNT + 1> mBaseline{};   ///< Counters when the baseline was marked.
+    };
+
+    /*!
+     * \brief Charges the allocations of the calling thread to a tag for the lifetime of the object.
+     */
+    class MemoryScope {
+    public:
+        explicit MemoryScope(MemoryTag tag) : mPrevious(MemoryTracker::SetThreadTag(tag)) {}
+        ~MemoryScope() { MemoryTracker::SetThreadTag(mPrevious); }
+
+        MemoryScope(MemoryScope const&) = delete;
+        MemoryScope& operator=(MemoryScope const&) = delete;
+
+    private:
+        MemoryTag mPrevious;
+    };
+
+} // end namespace IS
+
+/*                                                                     macros
+----------------------------------------------------------------------------- */
+#define IS_MEMORY_CONCAT_IMPL(a, b) a##b
+#define IS_MEMORY_CONCAT(a, b) IS_MEMORY_CONCAT_IMPL(a, b)
+
+#ifdef IS_MEMORY_TRACKING
+#define IS_MEMORY_SCOPE(tag) IS::MemoryScope IS_MEMORY_CONCAT(memory_scope_, __LINE__)(tag) // tag within a scope
+#define IS_MEMORY_THREAD(tag) IS::MemoryTracker::SetThreadTag(tag)                         // tag of this thread
+#define IS_MEMORY_FRAME() IS::MemoryTracker::Instance().EndFrame()                         // end of a frame
+#else
+#define IS_MEMORY_SCOPE(tag)
+#define IS_MEMORY_THREAD(tag)
+#define IS_MEMORY_FRAME()
+#endif // IS_MEMORY_TRACKING
+
+#endif // !GAM200_INSIGHT_ENGINE_DEBUG_UTILS_MEMORY_TRACKER_H
@@ -120,6 +120,7 @@ namespace IS {
                 Transform& transform = engine.GetComponent<Transform>(prefab);
                 transform.world_position = { static_cast<float>(Transform::GetMousePosition().first),
                                              static_cast<float>(Transform::GetMousePosition().second) };
+                transform.MarkDirty();
             }
             ValidateTempDirectory();
             engine.SaveEntityToJson(mEntity, mFileName);
@@ -164,6 +165,7 @@ namespace IS {
             transform.scaling = { static_cast<float>(sprite.img.width), static_cast<float>(sprite.img.height) };
             transform.world_position = { static_cast<float>(Transform::GetMousePosition().first),
                                          static_cast<float>(Transform::GetMousePosition().second) };
+            transform.MarkDirty();
 
             ValidateTempDirectory();
             engine.SaveEntityToJson(mEntity, mFileName);
@@ -33,6 +33,8 @@
 #include "Physics/Collision/Collider.h"
 #include "Graphics/Core/Graphics.h"
 #include "Graphics/System/Light.h"
+#include "Engine/Systems/Replay/Replay.h"
+#include "Engine/Systems/Rewinder/Rewinder.h"
 
 // Dependencies
 #include <ranges>
@@ -291,6 +293,30 @@ namespace IS {
                     ImGui::EndMenu();
                 } // end menu Create Entity
 
+                // Record and replay sessions deterministically
+                if (ImGui::BeginMenu(ICON_LC_HISTORY "  Replay"))
+                {
+                    ReplayManager& replay = ReplayManager::Instance();
+                    const bool idle = replay.GetState() == ReplayState::None;
+
+                    if (ImGui::MenuItem(ICON_LC_CIRCLE_DOT "  Start Recording", nullptr, false, idle && SceneManager::Instance().GetSceneCount() > 0))
+                        replay.StartRecording();
+                    if (ImGui::MenuItem(ICON_LC_SQUARE "  Stop Recording", nullptr, false, replay.IsRecording()))
+                        replay.StopRecording();
+
+                    ImGui::Separator();
+
+                    if (ImGui::MenuItem(ICON_LC_PLAY "  Play Replay...", nullptr, false, idle))
+                    {
+                        if (std::filesystem::path filepath(FileUtils::OpenFile("Insight Replay (*.isreplay)\0*.isreplay\0", "Assets\\Replays")); !filepath.empty())
+                            replay.StartReplay(std::filesystem::relative(filepath).string());
+                    }
+                    if (ImGui::MenuItem(ICON_LC_SQUARE "  Stop Replay", nullptr, false, replay.IsReplaying()))
+                        replay.StopReplay();
+
+                    ImGui::EndMenu();
+                } // end menu Replay
+
                 ImGui::EndMenu();
             } // end menu Testing
 
@@ -441,7 +467,8 @@ namespace IS {
             engine.HasComponent<RigidBody>(entity)          && engine.HasComponent<Collider>(entity) &&
             engine.HasComponent<ScriptComponent>(entity)    && engine.HasComponent<AudioListener>(entity) &&
             engine.HasComponent<AudioEmitter>(entity)       && engine.HasComponent<Light>(entity) &&
-            engine.HasComponent<ButtonComponent>(entity)    && engine.HasComponent<StateComponent>(entity))
+            engine.HasComponent<ButtonComponent>(entity)    && engine.HasComponent<StateComponent>(entity) &&
+            engine.HasComponent<RewinderComponent>(entity))
         {
             if (ImGui::MenuItem("Already have all components"))
                 ImGui::CloseCurrentPopup();
@@ -553,6 +580,16 @@ namespace IS {
             }
         }
 
+        // Add Rewinder Component
+        if (!engine.HasComponent<RewinderComponent>(entity))
+        {
+            if (ImGui::MenuItem(ICON_LC_HISTORY "  Rewinder"))
+            {
+                CommandHistory::AddCommand<AddComponentCommand<RewinderComponent>>(entity);
+                ImGui::CloseCurrentPopup();
+            }
+        }
+
         // Add Button Component
         if (!engine.HasComponent<ButtonComponent>(entity))
         {
@@ -30,6 +30,7 @@
 #include "Engine/Systems/Asset/Asset.h"
 #include "Engine/Systems/Category/Category.h"
 #include "Engine/Systems/FSM/FSM.h"
+#include "Engine/Systems/Rewinder/Rewinder.h"
 #include "Physics/Dynamics/Body.h"
 #include "Physics/Collision/Collider.h"
 #include "Physics/System/CollisionSystem.h"
@@ -107,7 +108,7 @@ namespace IS {
             ImGui::SetNextItemWidth(100.f);
             auto const asset = engine.GetSystem<AssetManager>("Asset");
             auto const& prefab_list = asset->mPrefabList;
-            bool is_prefab = prefab_list.find(name) != prefab_list.end();
+            bool is_prefab = prefab_list.Contains(name);
             if (ImGui::BeginCombo("##Prefabs", is_prefab ? name.c_str() : "None"))
             {
                 for (auto const& [prefab_name, prefab] : prefab_list)
@@ -217,7 +218,10 @@ namespace IS {
             EditorUtils::WidgetState trans_state = EditorUtils::RenderControlVec2("Translation", position);
             if (trans_state.mIsModified)
             {
-                CommandHistory::AddCommand<ChangeCommand<Vector2D>>(transform.world_position, position);
+                // the whole transform is changed so its version changes with it, on undo too
+                Transform changed = transform;
+                changed.setWorldPosition(position.x, position.y);
+                CommandHistory::AddCommand<ChangeCommand<Transform>>(transform, changed);
             }
             CommandHistory::SetNoMergeMostRecent(trans_state.mIsDeactivatedAfterEdit);
 
@@ -230,7 +234,9 @@ namespace IS {
                 // Apply modification
                 if (float rotation = transform.rotation; ImGui::DragFloat("##Rotation", &rotation, 1.f, 0.f, 360.f, "%.f deg"))
                 {
-                    CommandHistory::AddCommand<ChangeCommand<float>>(transform.rotation, rotation);
+                    Transform changed = transform;
+                    changed.setRotation(rotation, transform.angle_speed);
+                    CommandHistory::AddCommand<ChangeCommand<Transform>>(transform, changed);
                 }
                 CommandHistory::SetNoMergeMostRecent(ImGui::IsItemDeactivatedAfterEdit());
             });
@@ -241,7 +247,9 @@ namespace IS {
             if (scale_state.mIsModified)
             {
                 scaling = { abs(scaling.x), abs(scaling.y) };
-                CommandHistory::AddCommand<ChangeCommand<Vector2D>>(transform.scaling, scaling);
+                Transform changed = transform;
+                changed.setScaling(scaling);
+                CommandHistory::AddCommand<ChangeCommand<Transform>>(transform, changed);
             }
             CommandHistory::SetNoMergeMostRecent(scale_state.mIsDeactivatedAfterEdit);
 
@@ -1220,6 +1228,51 @@ namespace IS {
             
         });
 
+        // Rewinder Component
+        RenderComponent<RewinderComponent>(ICON_LC_HISTORY "  Rewinder", entity, [](RewinderComponent& rewinder)
+        {
+            EditorUtils::RenderTableFixedWidth("Rewinder Table", 2, [&]()
+            {
+                EditorUtils::RenderTableLabel("Recording");
+                ImGui::TableNextColumn();
+                EditorUtils::RenderToggleButton("Rewinder Recording", rewinder.mIsRecording);
+
+                EditorUtils::RenderTableLabel("Record Physics", "Also record rigidbody velocities.");
+                ImGui::TableNextColumn();
+                EditorUtils::RenderToggleButton("Rewinder Record Physics", rewinder.mRecordPhysics);
+
+                EditorUtils::RenderTableLabel("Record Animations", "Also record the sprite animation frame.");
+                ImGui::TableNextColumn();
+                EditorUtils::RenderToggleButton("Rewinder Record Animations", rewinder.mRecordAnimations);
+
+                EditorUtils::RenderTableLabel("Time to Save", "Seconds of history kept in the rewind buffer.");
+                ImGui::TableNextColumn();
+                if (float time = rewinder.time_to_save; ImGui::DragFloat("##RewinderTimeToSave", &time, .1f, 0.f, 60.f, "%.1fs"))
+                {
+                    CommandHistory::AddCommand<ChangeCommand<float>>(rewinder.time_to_save, time);
+                }
+                CommandHistory::SetNoMergeMostRecent(ImGui::IsItemDeactivatedAfterEdit());
+            });
+
+            // Buffer stats and rewind controls are shared by every recorded entity
+            auto rewinder_system = InsightEngine::Instance().GetSystem<Rewinder>("Rewinder");
+            ImGui::Text("Buffered: %zu/%zu frames (%.1f KB)", rewinder_system->GetRewindableFrames(), rewinder_system->GetCapacity(),
+                        static_cast<float>(rewinder_system->GetEncodedSize()) / 1024.f);
+
+            static int frames = 60;
+            size_t rewindable = rewinder_system->GetRewindableFrames();
+            ImGui::BeginDisabled(!InsightEngine::Instance().mRuntime || rewindable == 0);
+            ImGui::SetNextItemWidth(ImGui::GetContentRegionAvail().x * .5f);
+            ImGui::SliderInt("##RewindFrames", &frames, 1, std::max(1, static_cast<int>(rewinder_system->GetCapacity())));
+            ImGui::SameLine();
+            if (ImGui::Button(ICON_LC_REWIND "  Rewind"))
+            {
+                rewinder_system->Rewind(std::min(static_cast<size_t>(frames), rewindable - 1));
+            }
+            ImGui::EndDisabled();
+
+        }); // end render Rewinder Component
+
         // Audio Listener Component
         RenderComponent<AudioListener>(ICON_LC_EAR "  Audio Listener", entity, [entity, FONT_BOLD](AudioListener& listener)
         {
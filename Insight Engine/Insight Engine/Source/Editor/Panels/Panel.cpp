@@ -24,8 +24,10 @@
 #include "Editor/Utils/FileUtils.h"
 #include "Physics/System/Physics.h"
 #include "Physics/Collision/Grid.h"
+#include "Physics/Collision/StaticGeometry.h"
 #include "Graphics/Core/Graphics.h"
 #include "Graphics/System/Camera3D.h"
+#include "Debug/Profiling/Profiler.h"
 
 // Dependencies
 #include <imgui.h>
@@ -208,6 +210,107 @@ namespace IS {
                 }
             }, flags);
 
+#ifdef IS_PROFILER
+            ImGui::SeparatorText("Zones");
+            ImGui::SetItemTooltip("Zones that ended in the last frame, by thread");
+
+            Profiler& profiler = Profiler::Instance();
+            bool recording = Profiler::mEnabled.load();
+            if (ImGui::Checkbox("Record", &recording))
+                Profiler::mEnabled = recording;
+            ImGui::SameLine();
+            if (profiler.IsCapturing() ? ImGui::Button("Stop Capture") : ImGui::Button("Start Capture"))
+            {
+                if (profiler.IsCapturing())
+                    profiler.EndCapture();
+                else
+                    profiler.BeginCapture();
+            }
+            ImGui::SetItemTooltip("Captures every zone into a Chrome trace, open it in ui.perfetto.dev");
+
+            for (auto const& [counter, value] : profiler.GetCounters())
+            {
+                ImGui::TextUnformatted(counter);
+                ImGui::SameLine();
+                ImGui::Text("%g", value);
+            }
+
+            EditorUtils::RenderTable("Zones", 2, [&]()
+            {
+                uint32_t thread = UINT32_MAX;
+                for (auto const& zone : profiler.GetFrameZones())
+                {
+                    // Thread header
+                    if (zone.mThread != thread)
+                    {
+                        thread = zone.mThread;
+                        ImGui::TableNextColumn();
+                        ImGui::SeparatorText(profiler.GetThreadName(thread));
+                        ImGui::TableNextColumn();
+                    }
+
+                    float ms = static_cast<float>(zone.mDuration) / 1'000'000.f;
+                    text_color = ms < 1'000.f / 60.f ? IM_COL32_WHITE : ms < 1'000.f / 30.f ? YELLOW_COLOR : RED_COLOR;
+
+                    float indent = static_cast<float>(zone.mDepth) * ImGui::GetStyle().IndentSpacing;
+                    ImGui::TableNextColumn();
+                    if (indent > 0.f)
+                        ImGui::Indent(indent);
+                    ImGui::TextColored(ImColor(text_color), "%s", zone.mName);
+                    if (indent > 0.f)
+                        ImGui::Unindent(indent);
+
+                    ImGui::TableNextColumn();
+                    ImGui::TextColored(ImColor(text_color), "%.3f ms", ms);
+                }
+            }, flags);
+#endif // IS_PROFILER
+
+#ifdef IS_MEMORY_TRACKING
+            ImGui::SeparatorText("Memory");
+            ImGui::SetItemTooltip("Heap held and allocated by each subsystem, per frame for the last frame");
+
+            if (ImGui::Button("Reset Peaks"))
+                MemoryTracker::ResetPeaks();
+
+            MemoryTracker& tracker = MemoryTracker::Instance();
+            EditorUtils::RenderTable("Memory", 5, [&]()
+            {
+                ImGui::TableSetupColumn("Tag");
+                ImGui::TableSetupColumn("Live");
+                ImGui::TableSetupColumn("Peak");
+                ImGui::TableSetupColumn("Allocs / Frame");
+                ImGui::TableSetupColumn("KB / Frame");
+                ImGui::TableHeadersRow();
+
+                for (size_t i = 0; i <= MemoryTracker::TAG_COUNT; ++i)
+                {
+                    MemoryTag tag = static_cast<MemoryTag>(i);
+                    MemoryTracker::Stats stats = MemoryTracker::GetStats(tag);
+                    if (stats.mAllocations == 0)
+                        continue;
+
+                    // Churn of a frame, white below 100 allocations
+                    MemoryTracker::FrameStats const& frame = tracker.GetFrameStats(tag);
+                    text_color = frame.mAllocations < 100 ? IM_COL32_WHITE : frame.mAllocations < 1'000 ? YELLOW_COLOR : RED_COLOR;
+
+                    ImGui::TableNextColumn();
+                    if (tag == MemoryTag::Count)
+                        ImGui::SeparatorText(MemoryTracker::GetTagName(tag));
+                    else
+                        ImGui::TextUnformatted(MemoryTracker::GetTagName(tag));
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.1f KB", static_cast<double>(stats.mLiveBytes) / 1'024.0);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.1f KB", static_cast<double>(stats.mPeakBytes) / 1'024.0);
+                    ImGui::TableNextColumn();
+                    ImGui::TextColored(ImColor(text_color), "%llu", static_cast<unsigned long long>(frame.mAllocations));
+                    ImGui::TableNextColumn();
+                    ImGui::TextColored(ImColor(text_color), "%.1f", static_cast<double>(frame.mBytes) / 1'024.0);
+                }
+            }, flags);
+#endif // IS_MEMORY_TRACKING
+
             ImGui::PopStyleVar();
         }
 
@@ -249,6 +352,10 @@ namespace IS {
                     EditorUtils::RenderTableLabel("Show Velocity");
                     ImGui::TableNextColumn();
                     EditorUtils::RenderToggleButton("ShowVelocity", Physics::mShowVelocity);
+
+                    EditorUtils::RenderTableLabel("Deterministic");
+                    ImGui::TableNextColumn();
+                    EditorUtils::RenderToggleButton("Deterministic", Physics::mDeterministic);
                 });
 
                 ImGui::TreePop(); // end tree Table
@@ -291,9 +398,56 @@ namespace IS {
                     });
                 }
 
+                ImGui::SeparatorText(ICON_LC_HAMMER "  Static Geometry");
+
+                StaticGeometry& static_geometry = StaticGeometry::Instance();
+                EditorUtils::RenderTableFixedWidth("Static Geometry Table", 2, [&]()
+                {
+                    EditorUtils::RenderTableLabel("Show Chains");
+                    ImGui::TableNextColumn();
+                    EditorUtils::RenderToggleButton("ShowChains", StaticGeometry::mShowChains);
+
+                    EditorUtils::RenderTableLabel("Snap Tolerance");
+                    ImGui::TableNextColumn();
+                    if (ImGui::DragFloat("##SnapTolerance", &StaticGeometry::mSnapTolerance, 0.05f, 0.f, 10.f, "%.2f"))
+                        StaticGeometry::mSnapTolerance = std::max(StaticGeometry::mSnapTolerance, 0.f);
+
+                    EditorUtils::RenderTableLabel("Merged Boxes");
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%zu", static_geometry.GetBoxCount());
+
+                    EditorUtils::RenderTableLabel("Chains");
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%zu (%zu segments)", static_geometry.GetChains().size(), static_geometry.GetSegmentCount());
+                });
+
+                if (ImGui::Button(ICON_LC_HAMMER "  Bake Static Geometry"))
+                    static_geometry.Bake();
+
                 ImGui::TreePop(); // end tree Collision
             }
 
+            if (ImGui::TreeNodeEx(ICON_LC_IMAGE "  Graphics", tree_flags))
+            {
+                EditorUtils::RenderTableFixedWidth("GraphicsTable", 2, [&]()
+                {
+                    EditorUtils::RenderTableLabel("Frustum Culling", "Skip sprites outside the active camera's view.");
+                    ImGui::TableNextColumn();
+                    EditorUtils::RenderToggleButton("FrustumCulling", ISGraphics::mCullingEnabled);
+
+                    EditorUtils::RenderTableLabel("Cell Size", "World size of the culling grid cells.");
+                    ImGui::TableNextColumn();
+                    if (ImGui::DragFloat("##CullingCellSize", &SpatialGrid::mCellSize, 8.f, 32.f, 4096.f, "%.0f"))
+                        SpatialGrid::mCellSize = std::clamp(SpatialGrid::mCellSize, 32.f, 4096.f);
+
+                    EditorUtils::RenderTableLabel("Visible Sprites");
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%zu / %zu", ISGraphics::mVisibleSprites, ISGraphics::mTotalSprites);
+                });
+
+                ImGui::TreePop(); // end tree Graphics
+            }
+
             ImGui::PopStyleVar();
         }
         
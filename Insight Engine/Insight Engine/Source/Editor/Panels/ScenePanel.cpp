@@ -102,6 +102,34 @@ namespace IS {
             mHoveredEntity.reset();
         }
 
+        // Mouse picking - resolve the entity IDs read back in earlier frames
+        uint64_t pick_request{};
+        int pixel_data{};
+        if (ISGraphics::mFramebuffer->PollPixel(pick_request, pixel_data))
+        {
+            auto picked = (pixel_data < 0 || pixel_data > MAX_ENTITIES) ? nullptr : std::make_shared<Entity>(pixel_data);
+
+            // Reads lag a few frames, so one finishing after the mouse left the viewport is stale
+            if (mHovered)
+            {
+                mHoveredEntity = picked;
+            }
+
+            // Set the clicked entity as the selected entity once the click is resolved
+            if (mPendingPick && pick_request >= mPendingPick)
+            {
+                mPendingPick = 0;
+                mHoveredEntity = picked;
+                mEditorLayer.SetSelectedEntity(mHoveredEntity);
+
+                // Set inspect mode to inspect entity
+                if (mEditorLayer.IsAnyEntitySelected())
+                {
+                    mEditorLayer.SetInspectMode(InspectorPanel::aInspectMode::INSPECT_ENTITY);
+                }
+            }
+        }
+
         if (!mEditorLayer.IsGamePanelFocused())
         {
             // Check if mouse is within bounds of the scene panel
@@ -112,18 +140,12 @@ namespace IS {
                 MoveCamera(10.f);
                 RotateCamera();
 
-                // Mouse picking - set hovered entity as the selected entity
+                // Mouse picking - read back the entity under the mouse without waiting on the GPU
+                auto [mouse_x, mouse_y] = GetMousePos();
+                uint64_t request = ISGraphics::mFramebuffer->RequestPixel(mouse_x, mouse_y);
                 if (ImGui::IsMouseReleased(ImGuiMouseButton_Left) && !ImGuizmo::IsOver())
                 {
-                    int pixel_data = ISGraphics::mFramebuffer->ReadPixel(GetMousePos().first, GetMousePos().second);
-                    mHoveredEntity = (pixel_data < 0 || pixel_data > MAX_ENTITIES) ? nullptr : std::make_shared<Entity>(pixel_data);
-                    mEditorLayer.SetSelectedEntity(mHoveredEntity);
-
-                    // Set inspect mode to inspect entity
-                    if (mEditorLayer.IsAnyEntitySelected())
-                    {
-                        mEditorLayer.SetInspectMode(InspectorPanel::aInspectMode::INSPECT_ENTITY);
-                    }
+                    mPendingPick = request;
                 }
             }
         }
@@ -79,6 +79,7 @@ namespace IS {
 
     private:
         std::shared_ptr<Entity> mHoveredEntity; ///< Entity hovered.
+        uint64_t mPendingPick{}; ///< Pixel request of the last click, 0 once resolved.
         aGizmoType mGizmoType; ///< Type gizmo used.
         bool mGizmoInUse; ///< Boolean flag indicating if Gizmo is in use.
         bool mSnap; ///< Boolean flag indicating if gizmo snapping is enabled.
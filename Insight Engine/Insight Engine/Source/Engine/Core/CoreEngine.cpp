@@ -26,11 +26,15 @@
 #include "Editor/Layers/EditorLayer.h"
 #include "Physics/Dynamics/Body.h"
 #include "Physics/Collision/Collider.h"
+#include "Physics/Collision/StaticGeometry.h"
+#include "Engine/Systems/Replay/Replay.h"
+#include "Engine/Systems/Benchmark/Benchmark.h"
 #include "Graphics/Core/Graphics.h"
 #include "Graphics/System/Light.h"
 #include "Graphics/System/Camera3D.h"
 #include "../Engine/Scripting/Filewatcher.h"
 #include "../Systems/Category/Category.h"
+#include "../Systems/Rewinder/Rewinder.h"
 
 #include <iostream>
 #include <thread>
@@ -74,7 +78,9 @@ namespace IS {
 		InitializeAllSystems();
 
 #ifdef USING_IMGUI
-		PushImGuiLayers();
+		// the editor needs a window to draw in
+		if (!mHeadless)
+			PushImGuiLayers();
 #endif
 
 		auto window = GetSystem<WindowSystem>("Window");
@@ -92,6 +98,14 @@ namespace IS {
 		//auto frameStart = std::chrono::high_resolution_clock::now();
 		double frameStart = glfwGetTime();
 
+		// record or apply the inputs and step count of this frame
+		ReplayManager& replay = ReplayManager::Instance();
+		replay.BeginFrame();
+
+		// a benchmark forces one fixed step per frame and measures it
+		BenchmarkManager& benchmark = BenchmarkManager::Instance();
+		benchmark.BeginFrame();
+
 		// Update System deltas every 1s
 		static const float UPDATE_FREQUENCY = 1.f;
 		static float elapsed_time = 0.f;
@@ -110,16 +124,20 @@ namespace IS {
 		if (currentNumberOfSteps > 0) {
 
 			// Update all systems
-			for (const auto& system : mSystemList)
+			float& engine_delta = mSystemDeltas["Engine"];
+			for (size_t i = 0; i < mSystemList.size(); ++i)
 			{
-				Timer timer(system->GetName() + " System", false);
+				auto const& system = mSystemList[i];
+				IS_PROFILE_SCOPE(mSystemTimings[i].mName);
+				IS_MEMORY_SCOPE(mSystemTimings[i].mTag);
+				auto start = std::chrono::steady_clock::now();
 
 				system->Update(static_cast<float>(mFixedDeltaTime));
 				system->Draw(static_cast<float>(mFixedDeltaTime));
 
-				timer.Stop();
-				mSystemDeltas[system->GetName()] = timer.GetDeltaTime();
-				mSystemDeltas["Engine"] += timer.GetDeltaTime();
+				float& delta = *mSystemTimings[i].mDelta;
+				delta = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+				engine_delta += delta;
 
 				//if (to_update && currentNumberOfSteps == 1) {
 
@@ -140,6 +158,8 @@ namespace IS {
 	// Update and render GUI
 		if (mRenderGUI)
 		{
+			IS_PROFILE_SCOPE("Editor");
+			IS_MEMORY_SCOPE(MemoryTag::Editor);
 			mImGuiLayer->Begin();
 			mLayers.Update(1.f / 60.f);
 			mLayers.Render();
@@ -147,7 +167,10 @@ namespace IS {
 		}
 #endif // USING_IMGUI
 
-		mDeltaTime = LimitFPS(frameStart) - frameStart;
+		benchmark.EndFrame();
+
+		// replays and benchmarks run as fast as possible, the step count comes from the log or the benchmark
+		mDeltaTime = (replay.IsReplaying() || benchmark.IsRunning() ? glfwGetTime() : LimitFPS(frameStart)) - frameStart;
 
 		currentNumberOfSteps = 0;
 		double min_delta = 1.0 / 800.0;
@@ -163,6 +186,10 @@ namespace IS {
 
 		++mFrameCount;
 
+		IS_PROFILE_COUNTER("Entities", EntitiesAlive());
+		IS_MEMORY_FRAME();
+		IS_PROFILE_FRAME();
+
 		
 
 	}
@@ -183,7 +210,7 @@ namespace IS {
 #ifdef USING_IMGUI  // dont hot reload without engine
 			std::string directory_to_watch = "Assets/Scripts";
 			std::string shader_to_watch = "Assets/Shaders";
-			fw.Start(directory_to_watch,shader_to_watch); //we watch for changes
+			fw.Start(directory_to_watch,shader_to_watch, AssetManager::PARTICLE_DIRECTORY); //we watch for changes
 #endif
 			ProcessEntityDeletion(); // destroy deleted entities
 			SceneManager::Instance().UpdateActiveScene(); // update active scene
@@ -209,6 +236,8 @@ namespace IS {
 		// adding all of them to the different system maps and system manager
 		mAllSystems[systemName] = system;
 		mSystemList.emplace_back(system);
+		auto& [name, delta] = *mSystemDeltas.try_emplace(systemName, 0.f).first;
+		mSystemTimings.push_back({ name.c_str(), &delta, MemoryTracker::GetSystemTag(systemName) });
 		mSystemManager->RegisterSystem(system);
 		mSystemManager->SetSignature(systemName, signature);
 	}
@@ -225,6 +254,7 @@ namespace IS {
 		for (auto& system : mSystemList) {
 			if (system == it->second) {
 				mSystemList.erase(mSystemList.begin() + i);
+				mSystemTimings.erase(mSystemTimings.begin() + i);
 			}
 			i++;
 		}
@@ -235,21 +265,20 @@ namespace IS {
 	void InsightEngine::DestroyAllSystems() {
 		IS_PROFILE_FUNCTION();
 		mSystemList.clear();  // Clear the vector
+		mSystemTimings.clear();
 		mAllSystems.clear();  // Clear the map
 		IS_CORE_WARN("All systems terminated!");
 	}
 
-#pragma warning(push)
-#pragma warning(disable: 4456) // concatnating __LINE__ for variable name in macro
 	//loop through all the systems stored
 	void InsightEngine::InitializeAllSystems() {
 		IS_PROFILE_FUNCTION();
-		for (auto const& system : mSystemList) {
-			IS_PROFILE_SCOPE(system->GetName());
-			system->Initialize();
+		for (size_t i = 0; i < mSystemList.size(); ++i) {
+			IS_PROFILE_SCOPE(mSystemTimings[i].mName);
+			IS_MEMORY_SCOPE(mSystemTimings[i].mTag);
+			mSystemList[i]->Initialize();
 		}
 	}
-#pragma warning(pop)
 
 	// Accessor for system deltas
 	std::unordered_map<std::string, float> const& InsightEngine::GetSystemDeltas() const {
@@ -317,15 +346,17 @@ namespace IS {
 
 	// These functions involve creating entities and destroying them
 	Entity InsightEngine::CreateEntity(std::string name) {
+		IS_MEMORY_SCOPE(MemoryTag::ECS);
 		return mEntityManager->CreateEntity(name);
 	}
 
 	// When destroying the entity, every ECS must know of it
 	void InsightEngine::DestroyEntity(Entity entity) {
+		IS_MEMORY_SCOPE(MemoryTag::ECS);
 		mComponentManager->EntityDestroyed(entity);
 		mEntityManager->DestroyEntity(entity);
 		mSystemManager->EntityDestroyed(entity);
-		IS_CORE_WARN("Entity {} completely destroyed!", entity);
+		IS_CORE_TRACE("Entity {} completely destroyed!", entity);
 	}
 
 	// Creates a random entity for demo testing
@@ -409,6 +440,7 @@ namespace IS {
 		DeserializeComponent<AudioEmitter>(entity, loaded, "AudioEmitter");
 		DeserializeComponent<Light>(entity, loaded, "Light");
 		DeserializeComponent<Category>(entity, loaded, "Category");
+		DeserializeComponent<RewinderComponent>(entity, loaded, "Rewinder");
 	}
 
 	void InsightEngine::DeserializeAllComponentsPrefab(Entity entity, Json::Value& loaded) {
@@ -422,6 +454,7 @@ namespace IS {
 		DeserializeComponent<AudioEmitter>(entity, loaded, "AudioEmitter");
 		DeserializeComponent<Light>(entity, loaded, "Light");
 		DeserializeComponent<Category>(entity, loaded, "Category");
+		DeserializeComponent<RewinderComponent>(entity, loaded, "Rewinder");
 	}
 
 	void InsightEngine::SerializeAllComponents(Entity entity, Json::Value& saved_entity) {
@@ -435,6 +468,7 @@ namespace IS {
 		SerializeComponent<AudioEmitter>(entity, saved_entity, "AudioEmitter");
 		SerializeComponent<Light>(entity, saved_entity, "Light");
 		SerializeComponent<Category>(entity, saved_entity, "Category");
+		SerializeComponent<RewinderComponent>(entity, saved_entity, "Rewinder");
 	}
 
 	/* This will save the entity to a string file.The string file is not defined with a path so it can save it
@@ -511,7 +545,7 @@ namespace IS {
 	}
 
 	//creating an entity from prefab
-	Entity InsightEngine::LoadFromPrefab(Prefab prefab, Entity entity) {
+	Entity InsightEngine::LoadFromPrefab(Prefab const& prefab, Entity entity) {
 		LoadEntityFromJsonPrefab("Assets/Prefabs/" + prefab.mName + ".json", entity);
 		return entity;
 	}
@@ -566,6 +600,9 @@ namespace IS {
 
 		}
 		scene["Layers"] = layers;
+		if (StaticGeometry::Instance().IsBaked()) {
+			scene["StaticGeometry"] = StaticGeometry::Instance().Serialize();
+		}
 
 
 		if (SaveJsonToFile(scene, file_path))
@@ -618,6 +655,11 @@ namespace IS {
 			ISGraphics::mLayers[i].Deserialize(layer_data);
 		}
 
+		// baked chains are relinked after the entities exist
+		if (sceneRoot.isMember("StaticGeometry")) {
+			StaticGeometry::Instance().Deserialize(sceneRoot["StaticGeometry"]);
+		}
+
 		IS_CORE_INFO("Loading scene {} successful!", filepath.string());
 		IS_CORE_INFO("{} entities loaded", EntitiesAlive);
 		return true;
@@ -635,6 +677,9 @@ namespace IS {
 
 		//Clear layers
 		ISGraphics::ClearLayers();
+
+		//Clear baked static geometry
+		StaticGeometry::Instance().Clear();
 	}
 
 	// Abstracted functions for window getters/setters
@@ -72,6 +72,7 @@ namespace IS {
 
         bool mUsingGUI = false; ///< Flag indicating if using GUI.
         bool mRenderGUI = false; ///< Flag indicating if render GUI.
+        bool mHeadless = false; ///< Flag indicating if running without a window or graphics context.
 
         /*!
          * \brief Handles incoming messages for the core engine.
@@ -306,7 +307,7 @@ namespace IS {
          * \param prefab The prefab to load the entity from.
          * \return The loaded entity.
          */
-        Entity LoadFromPrefab(Prefab prefab, Entity entity);
+        Entity LoadFromPrefab(Prefab const& prefab, Entity entity);
 
         /**
          * \brief Loads a prefab from a specified file.
@@ -423,6 +424,7 @@ namespace IS {
                 SendMessage(mSpriteAdded);
             }
 
+            IS_MEMORY_SCOPE(MemoryTag::ECS);
             mComponentManager->AddComponent<T>(entity, component);
 
             auto signature = mEntityManager->GetSignature(entity);
@@ -448,6 +450,7 @@ namespace IS {
 
             if (GetComponentType<T>() == GetComponentType<Sprite>()) {}
 
+            IS_MEMORY_SCOPE(MemoryTag::ECS);
             if (InsightEngine::Instance().HasComponent<T>(entity)) {
                 mComponentManager->RemoveComponent<T>(entity);
             }
@@ -732,6 +735,22 @@ namespace IS {
          */
         std::unordered_map<std::string, float> mSystemDeltas;
 
+        /**
+         * \brief Name, delta time slot and memory tag of a system.
+         *
+         * The names are the keys of mSystemDeltas, so they name profiler zones without a copy.
+         */
+        struct SystemTiming {
+            const char* mName;
+            float* mDelta;
+            MemoryTag mTag;     ///< Tag the allocations of the system are charged to.
+        };
+
+        /**
+         * \brief Timing of each system in mSystemList, in the same order.
+         */
+        std::vector<SystemTiming> mSystemTimings;
+
         /**
          * \brief Vector to store delta times of every engine frame.
          */
@@ -0,0 +1,97 @@
+/*!
+ * \file ThreadPool.cpp
+ * \author Tan Zheng Xun, t.zhengxun@digipen.edu
+ * \par Course: CSD2451
+ * \date 19-10-2026
+ * \brief
+ * This source file defines the ThreadPool class, a fixed set of worker threads
+ * running jobs from a shared queue.
+ *
+ * \copyright
+ * All content (C) 2024 DigiPen Institute of Technology Singapore.
+ * All rights reserved.
+ * Reproduction or disclosure of this file or its contents without the prior written
+ * consent of DigiPen Institute of Technology is prohibited.
+ *____________________________________________________________________________*/
+
+ /*                                                                   includes
+ ----------------------------------------------------------------------------- */
+#include "Pch.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+namespace IS {
+
+    ThreadPool::ThreadPool(size_t thread_count) {
+        if (thread_count == 0) {
+            thread_count = DefaultThreadCount();
+        }
+        mThreads.reserve(thread_count);
+        for (size_t i = 0; i < thread_count; ++i) {
+            mThreads.emplace_back(&ThreadPool::WorkerLoop, this);
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStopping = true;
+            mJobs.clear();
+            mHighPriorityJobs.clear();
+        }
+        mJobAdded.notify_all();
+        for (auto& thread : mThreads) {
+            thread.join();
+        }
+    }
+
+    std::future<void> ThreadPool::Submit(std::function<void()> job, Priority priority) {
+        std::packaged_task<void()> task(std::move(job));
+        std::future<void> result = task.get_future();
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            (priority == Priority::High ? mHighPriorityJobs : mJobs).emplace_back(std::move(task));
+        }
+        mJobAdded.notify_one();
+        return result;
+    }
+
+    void ThreadPool::Wait() {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mJobDone.wait(lock, [this] { return mJobs.empty() && mHighPriorityJobs.empty() && mRunning == 0; });
+    }
+
+    size_t ThreadPool::DefaultThreadCount() {
+        // hardware_concurrency may report 0 when it cannot tell
+        size_t cores = std::thread::hardware_concurrency();
+        return std::max<size_t>(cores, 2) - 1;
+    }
+
+    void ThreadPool::WorkerLoop() {
+        for (;;) {
+            std::packaged_task<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mJobAdded.wait(lock, [this] { return mStopping || !mJobs.empty() || !mHighPriorityJobs.empty(); });
+                if (mStopping) {
+                    return;
+                }
+                auto& jobs = mHighPriorityJobs.empty() ? mJobs : mHighPriorityJobs;
+                task = std::move(jobs.front());
+                jobs.pop_front();
+                ++mRunning;
+            }
+
+            // exceptions end up in the future instead of terminating the worker
+            task();
+
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                --mRunning;
+            }
+            mJobDone.notify_all();
+        }
+    }
+
+} // end namespace IS
@@ -0,0 +1,105 @@
+/*!
+ * \file ThreadPool.h
+ * \author Tan Zheng Xun, t.zhengxun@digipen.edu
+ * \par Course: CSD2451
+ * \date 19-10-2026
+ * \brief
+ * This header file declares the ThreadPool class, a fixed set of worker threads
+ * running jobs from a shared queue.
+ *
+ * \copyright
+ * All content (C) 2024 DigiPen Institute of Technology Singapore.
+ * All rights reserved.
+ * Reproduction or disclosure of this file or its contents without the prior written
+ * consent of DigiPen Institute of Technology is prohibited.
+ *____________________________________________________________________________*/
+
+ /*                                                                   guard
+ ----------------------------------------------------------------------------- */
+#ifndef GAM200_INSIGHT_ENGINE_CORE_THREADPOOL_H_
+#define GAM200_INSIGHT_ENGINE_CORE_THREADPOOL_H_
+
+ /*                                                                   includes
+ ----------------------------------------------------------------------------- */
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace IS {
+
+    /*!
+     * \brief Fixed number of worker threads sharing a FIFO job queue per priority.
+     *
+     * High priority jobs all run before any normal one, so jobs someone blocks on
+     * are not stuck behind background work submitted earlier. Jobs must not touch OpenGL or the ECS, results that need the main thread
+     * should be handed back through a queue the main thread drains. Jobs still
+     * queued when the pool is destroyed are dropped, running ones are waited on.
+     */
+    class ThreadPool {
+    public:
+        /*!
+         * \brief Starts the worker threads.
+         * \param thread_count The number of workers, DefaultThreadCount() if 0.
+         */
+        explicit ThreadPool(size_t thread_count = 0);
+
+        /*!
+         * \brief Drops the queued jobs and joins the workers.
+         */
+        ~ThreadPool();
+
+        ThreadPool(ThreadPool const&) = delete;
+        ThreadPool& operator=(ThreadPool const&) = delete;
+
+        /*!
+         * \brief Lane a job is queued in.
+         */
+        enum class Priority {
+            Normal,     // Background work
+            High        // Work something is waiting on
+        };
+
+        /*!
+         * \brief Queues a job.
+         * \param job The job to run on a worker.
+         * \param priority The lane to queue the job in.
+         * \return A future that is ready once the job has run.
+         */
+        std::future<void> Submit(std::function<void()> job, Priority priority = Priority::Normal);
+
+        /*!
+         * \brief Blocks until the queue is empty and no job is running.
+         */
+        void Wait();
+
+        size_t GetThreadCount() const { return mThreads.size(); }
+
+        /*!
+         * \brief Gets the number of workers that leaves a core for the main thread.
+         * \return The number of workers, at least 1.
+         */
+        static size_t DefaultThreadCount();
+
+    private:
+        /*!
+         * \brief Runs jobs until the pool is destroyed.
+         */
+        void WorkerLoop();
+
+        std::vector<std::thread> mThreads;
+        std::deque<std::packaged_task<void()>> mJobs;
+        std::deque<std::packaged_task<void()>> mHighPriorityJobs;  // Taken before mJobs
+        std::mutex mMutex;
+        std::condition_variable mJobAdded;      // Wakes workers
+        std::condition_variable mJobDone;       // Wakes Wait()
+        size_t mRunning{};                      // Jobs taken off the queue and not finished
+        bool mStopping{};
+    };
+
+} // end namespace IS
+
+#endif // !GAM200_INSIGHT_ENGINE_CORE_THREADPOOL_H_
@@ -126,7 +126,7 @@ namespace IS {
 			// Decrement the count of living entities
 			//--mEntitiesAlive;
 
-			IS_CORE_WARN("Entity {} destroyed!", entity);
+			IS_CORE_TRACE("Entity {} destroyed!", entity);
 		}
 
 		/**
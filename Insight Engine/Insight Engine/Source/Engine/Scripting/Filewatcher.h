@@ -30,6 +30,7 @@
 #include <cstdlib>
 #include "ScriptEngine.h"
 #include "../Engine/Scripting/Filewatcher.h"
+#include "Engine/Systems/Asset/Asset.h"
 
 namespace IS {
 
@@ -50,7 +51,7 @@ namespace IS {
         }
 
         // Start monitoring files (single-threaded)
-        void Start(std::string& directory , std::string &directory2) {
+        void Start(std::string& directory , std::string &directory2, std::string const& particle_directory) {
 
             if (!initial_scan_complete_) {
                 for (const auto& file : std::filesystem::directory_iterator(directory)) {
@@ -74,6 +75,13 @@ namespace IS {
                     
                 }
 
+                //particle presets
+                for (const auto& file : std::filesystem::directory_iterator(particle_directory)) {
+                    if (std::filesystem::is_regular_file(file.path()) && file.path().extension() == ".txt") {
+                        mPaths[file.path().string()] = std::filesystem::last_write_time(file);
+                    }
+                }
+
             }
 
             initial_scan_complete_ = true;  // Set the flag to indicate the initial scan is complete
@@ -117,6 +125,19 @@ namespace IS {
                     
                 }
 
+                // presets reload in place, their handles stay valid
+                for (const auto& file : std::filesystem::directory_iterator(particle_directory)) {
+                    if (std::filesystem::is_regular_file(file.path()) && file.path().extension() == ".txt") {
+                        std::string file_path = file.path().string();
+                        auto current_time = std::filesystem::last_write_time(file_path);
+                        if (mPaths.find(file_path) != mPaths.end() && mPaths[file_path] != current_time) {
+                            mPaths[file_path] = current_time;
+                            InsightEngine::Instance().GetSystem<AssetManager>("Asset")->LoadParticle(file_path);
+                            IS_CORE_INFO("Reloaded Particle: {}", file_path);
+                        }
+                    }
+                }
+
             }
 
 
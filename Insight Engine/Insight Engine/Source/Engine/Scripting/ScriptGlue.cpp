@@ -195,30 +195,26 @@ namespace IS {
     static void TransformSetPosition(float x, float y) {
         auto& engine = InsightEngine::Instance();
         auto& trans_component = engine.GetComponent<Transform>(engine.GetScriptCaller());
-        trans_component.world_position.x=x;
-        trans_component.world_position.y = y;
+        trans_component.setWorldPosition(x, y);
     }
 
     static void TransformSetPositionEntity(float x, float y, int entity) {
         auto& engine = InsightEngine::Instance();
         auto& trans_component = engine.GetComponent<Transform>(entity);
-        trans_component.world_position.x = x;
-        trans_component.world_position.y = y;
+        trans_component.setWorldPosition(x, y);
     }
 
 
     static void TransformSetScale(float x, float y) {
         auto& engine = InsightEngine::Instance();
         auto& trans_component = engine.GetComponent<Transform>(engine.GetScriptCaller());
-        trans_component.scaling.x = x;
-        trans_component.scaling.y = y;
+        trans_component.setScaling(x, y);
     }
 
     static void TransformSetScaleEntity(float x, float y,int entity) {
         auto& engine = InsightEngine::Instance();
         auto& trans_component = engine.GetComponent<Transform>(entity);
-        trans_component.scaling.x = x;
-        trans_component.scaling.y = y;
+        trans_component.setScaling(x, y);
     }
 
     static void TransformSetRotation(float angle,float angle_speed) {
@@ -419,9 +415,9 @@ namespace IS {
     static void AudioPlaySound(MonoString* name,bool loop=0,float volume=1.f) {
         auto asset = InsightEngine::Instance().GetSystem<AssetManager>("Asset");
         char* c_str = mono_string_to_utf8(name); // Convert Mono string to char*
-        std::string str(c_str);
+        SoundHandle sound = asset->mSoundList.Find(c_str); // no std::string needed for the lookup
         mono_free(c_str);
-        asset->PlaySoundByName(str,loop,volume);
+        asset->PlaySound(sound,loop,volume);
     }    
     
     static void AudioStopAllSounds() {
@@ -443,9 +439,9 @@ namespace IS {
 
         auto asset = InsightEngine::Instance().GetSystem<AssetManager>("Asset");
         char* c_str = mono_string_to_utf8(name); // Convert Mono string to char*
-        std::string str(c_str);
+        SoundHandle sound = asset->mSoundList.Find(c_str);
         mono_free(c_str);
-        asset->PlaySoundByName(str, loop, volume* AUDIO_MANAGER->mAudioConfig.mBGMControl.mVolume);
+        asset->PlaySound(sound, loop, volume* AUDIO_MANAGER->mAudioConfig.mBGMControl.mVolume);
     }
 
     static void AudioPlaySoundSFX(MonoString* name, bool loop = 0, float volume = 1.f) {
@@ -454,10 +450,10 @@ namespace IS {
 
         auto asset = InsightEngine::Instance().GetSystem<AssetManager>("Asset");
         char* c_str = mono_string_to_utf8(name); // Convert Mono string to char*
-        std::string str(c_str);
+        SoundHandle sound = asset->mSoundList.Find(c_str);
         mono_free(c_str);
         // std::cout << "SFX AUDIO : " << AUDIO_MANAGER->SFXAudioLevel << std::endl;
-        asset->PlaySoundByName(str, loop, volume * AUDIO_MANAGER->mAudioConfig.mSFXControl.mVolume);
+        asset->PlaySound(sound, loop, volume * AUDIO_MANAGER->mAudioConfig.mSFXControl.mVolume);
     }
 
     static void AudioPlayMusicBGM(MonoString* name, float volume) {
@@ -877,9 +873,9 @@ namespace IS {
 
     static void DrawDarkCircle(float pos_x, float pos_y, float scale_x, float scale_y)
     {
-        glLineWidth(200.f);
+        ISGraphics::setLineWidth(200.f);
         Sprite::drawDebugCircle(Vector2D(pos_x, pos_y), Vector2D(scale_x, scale_y), { 0.f,0.f,0.f });
-        glLineWidth(2.f);
+        ISGraphics::setLineWidth(2.f);
     }
 
     static bool GetCollidingEntityCheck(int entity ,int entityToCheckAgainst) {
@@ -1135,6 +1131,7 @@ namespace IS {
         particle.mLifespan = lifespan;
         particle.mVelocity = Vector2D(speed, speed);
         particle.mParticleType = pt_texture;
+        particle.mImage = assey_sys->mImageList.Find(part_image_name);
         particle.mImageName = part_image_name;
         system->SpawnParticles(particle);
     }
@@ -1576,8 +1573,8 @@ namespace IS {
         if (auto& engine = InsightEngine::Instance(); engine.HasComponent<Transform>(entity))
         {
             auto& transform = engine.GetComponent<Transform>(entity);
-            transform.world_position.x = static_cast<float>(Transform::GetMousePosition().first);
-            transform.world_position.y = static_cast<float>(Transform::GetMousePosition().second);
+            transform.setWorldPosition(static_cast<float>(Transform::GetMousePosition().first),
+                                       static_cast<float>(Transform::GetMousePosition().second));
         }
     }
 
@@ -20,6 +20,8 @@ consent of DigiPen Institute of Technology is prohibited.
 #include "Engine/Core/CoreEngine.h"
 #include "Engine/Systems/Window/WindowSystem.h"
 #include "Graphics/Core/Graphics.h"
+#include "Engine/Systems/Asset/TextureCache.h"
+#include "Engine/Systems/Asset/ParticleCache.h"
 
 #pragma warning(push)
 #pragma warning(disable: 4244)
@@ -47,16 +49,16 @@ namespace IS {
         auto const window = engine.GetSystem<WindowSystem>("Window");
         namespace fs = std::filesystem;
         std::string path = TEXTURE_DIRECTORY; // Path to the Assets directory
+        std::vector<std::future<void>> jobs; // Assets that must be in before the first scene loads
 
+        std::vector<std::string> image_paths;
         for (const auto& entry : fs::directory_iterator(path)) {
             std::string file_path = entry.path().string();
             std::string extension = entry.path().extension().string();
 
             // Check image extensions
             if (extension == ".png" || extension == ".jpg" || extension == ".jpeg") {
-                mThreads.emplace_back([file_path]() {
-                    ASSET_MANAGER->WorkerLoadImageData(file_path);
-                    });
+                image_paths.emplace_back(file_path);
             }
             else if (!entry.is_directory())
             {
@@ -64,6 +66,26 @@ namespace IS {
             }
         }
 
+        // the image headers are enough to size the texture atlas before anything is decoded
+        std::sort(image_paths.begin(), image_paths.end());
+        size_t total_area{};
+        for (auto const& file_path : image_paths) {
+            int width{}, height{}, channels{};
+            if (stbi_info(file_path.c_str(), &width, &height, &channels)) {
+                total_area += static_cast<size_t>(TextureAtlas::PaddedSize(width)) * TextureAtlas::PaddedSize(height);
+            }
+        }
+        if (ISGraphics::HasContext()) {
+            ISGraphics::textureAtlas.Reserve(TextureAtlas::EstimateLayers(total_area));
+
+            // workers compare cache files against the cooked format, probe it while on the main thread
+            TextureAtlas::GetCookedFormat();
+        }
+        for (auto const& file_path : image_paths) {
+            StreamImage(file_path);
+        }
+        mTrimAtlas = mPendingImages > 0;
+
         for (const auto& entry : fs::directory_iterator(ICON_DIRECTORY)) {
             std::string file_path = entry.path().string();
             std::string extension = entry.path().extension().string();
@@ -88,10 +110,7 @@ namespace IS {
             // Check for json extensions
             if (extension == ".json")
             {
-                mThreads.emplace_back([file_path]() {
-                    ASSET_MANAGER->LoadPrefab(file_path);
-                    });
-                IS_CORE_INFO("Loaded Prefab: {} ", file_path);
+                jobs.emplace_back(mWorkers.Submit([this, file_path] { LoadPrefab(file_path); }, ThreadPool::Priority::High));
             }
             else if (!entry.is_directory())
             {
@@ -121,10 +140,7 @@ namespace IS {
             std::string file_path = entry.path().string();
             std::string extension = entry.path().extension().string();
             if (extension == ".txt") {
-                mThreads.emplace_back([file_path]() {
-                    ASSET_MANAGER->LoadParticle(file_path);
-                    });
-                IS_CORE_INFO("Loaded Particle: {} ", file_path);
+                jobs.emplace_back(mWorkers.Submit([this, file_path] { LoadParticle(file_path); }, ThreadPool::Priority::High));
             }
             else if (!entry.is_directory())
             {
@@ -151,7 +167,6 @@ namespace IS {
 
         // loads all audio and store it
         path = SOUND_DIRECTORY;
-        auto audio = engine.GetSystem<ISAudio>("Audio");
         for (const auto& entry : fs::directory_iterator(path)) {
             auto const& filepath = entry.path();
             std::string extension = entry.path().extension().string();
@@ -159,7 +174,7 @@ namespace IS {
             // Check audio extensions (assuming mp3 and wav for this example, add more if needed)
             if (extension == ".MP3" || extension == ".WAV" || extension == ".wav" || extension == ".mp3")
             {
-                LoadAudio(filepath);
+                jobs.emplace_back(mWorkers.Submit([this, filepath] { LoadAudio(filepath); }, ThreadPool::Priority::High));
             }
             else if (!entry.is_directory())
             {
@@ -187,36 +202,137 @@ namespace IS {
         }
 
 
-        //mThreads.emplace_back(std::thread(LoadEverythingButImages));
+        // images keep streaming in through ProcessUploads(), everything else is waited on
+        // and was queued ahead of the image jobs, so this does not wait for the images
+        for (auto& job : jobs) {
+            job.get();
+        }
+    }
 
-        // Wait for all threads to finish and then join them
-        for (auto& thread : mThreads) {
-            if (thread.joinable()) { // Check if the thread is joinable
-                thread.join(); // Join the thread if it's joinable
-            }
+    void AssetManager::StreamImage(std::string const& filepath) {
+        std::string file_name = std::filesystem::path(filepath).filename().string();
+        if (mImageList.Contains(file_name)) {
+            IS_CORE_WARN("Image already loaded: {}", file_name);
+            return;
         }
 
-        for (auto& [name,data] : mImageData) {
-            LoadImage(name, data);
+        // the texture object exists from the start so copies of the Image keep a valid id
+        Image image;
+        image.mFileName = file_name;
+        image.texture_index = mCurrentTexId++;
+
+        // headless runs never draw the pixels, the name and index are enough
+        if (!ISGraphics::HasContext()) {
+            SaveImageData(image);
+            return;
         }
 
-        mImageData.clear();
-        mThreads.clear();
+        glCreateTextures(GL_TEXTURE_2D, 1, &image.texture_id);
+        SaveImageData(image);
 
+        ++mPendingImages;
+        mWorkers.Submit([this, filepath] { WorkerLoadImageData(filepath); });
     }
 
     void AssetManager::WorkerLoadImageData(const std::string& filepath) {
-        ImageData imageData = ISGraphics::loadImageData(filepath);
-       
-            std::lock_guard<std::mutex> lock(mImageDataMutex);
-            mImageData.emplace_back(filepath, imageData);
+        auto cooked = std::make_shared<TextureAtlas::CookedImage>();
+        if (TextureCache::Load(filepath, *cooked) && cooked->format == TextureAtlas::GetCookedFormat()) {
+            QueueUpload([this, filepath, cooked] { FinishImage(filepath, *cooked); });
+            return;
+        }
 
+        // decoding and padding need no context, only encoding is left to the main thread
+        ImageData image_data = ISGraphics::loadImageData(filepath);
+        auto padded = std::make_shared<TextureAtlas::CookedImage>();
+        bool decoded = TextureAtlas::Pad(image_data.data, image_data.width, image_data.height, image_data.channels, *padded);
+        stbi_image_free(image_data.data);
+
+        if (!decoded || padded->format == TextureAtlas::GetCookedFormat()) {
+            if (decoded) {
+                TextureCache::Save(filepath, *padded);
+            }
+            QueueUpload([this, filepath, padded] { FinishImage(filepath, *padded); });
+            return;
+        }
+        QueueUpload([this, filepath, padded, cooked] { EncodeImage(filepath, padded, cooked, 0); });
     }
 
-    Prefab AssetManager::GetPrefab(std::string name) { return mPrefabList[name]; }
+    void AssetManager::EncodeImage(std::string const& filepath, std::shared_ptr<TextureAtlas::CookedImage const> padded,
+                                   std::shared_ptr<TextureAtlas::CookedImage> cooked, GLsizei first_row) {
+        // a strip of whole blocks per upload, ProcessUploads() checks its budget between strips
+        GLsizei strip_rows = ENCODE_STRIP_TEXELS / padded->padded_width / TextureAtlas::BLOCK_SIZE * TextureAtlas::BLOCK_SIZE;
+        GLsizei row_count = std::min(std::max(strip_rows, TextureAtlas::BLOCK_SIZE), padded->padded_height - first_row);
+        if (!TextureAtlas::EncodeRows(*padded, first_row, row_count, cooked->data)) {
+            cooked->data.clear();
+            FinishImage(filepath, *cooked);
+            return;
+        }
+
+        first_row += row_count;
+        if (first_row < padded->padded_height) {
+            QueueUpload([this, filepath, padded, cooked, first_row] { EncodeImage(filepath, padded, cooked, first_row); });
+            return;
+        }
+
+        cooked->width = padded->width;
+        cooked->height = padded->height;
+        cooked->channels = padded->channels;
+        cooked->padded_width = padded->padded_width;
+        cooked->padded_height = padded->padded_height;
+        cooked->format = TextureAtlas::GetCookedFormat();
+        mWorkers.Submit([filepath, cooked] { TextureCache::Save(filepath, *cooked); });
+        FinishImage(filepath, *cooked);
+    }
+
+    void AssetManager::FinishImage(std::string const& filepath, TextureAtlas::CookedImage const& cooked) {
+        if (cooked.data.empty()) {
+            IS_CORE_ERROR("Failed to load image: {}", filepath);
+        }
+        else {
+            LoadImage(filepath, cooked);
+        }
+
+        // the initial load is in, drop the atlas layers the estimate reserved but did not need
+        // images streamed later grow the atlas as needed, trimming after each would shrink it again
+        if (--mPendingImages == 0 && mTrimAtlas) {
+            mTrimAtlas = false;
+            ISGraphics::textureAtlas.Trim();
+        }
+    }
+
+    void AssetManager::QueueUpload(std::function<void()> upload) {
+        std::lock_guard<std::mutex> lock(mUploadMutex);
+        mUploads.emplace_back(std::move(upload));
+    }
+
+    void AssetManager::ProcessUploads(double budget) {
+        double start = glfwGetTime();
+        do {
+            std::function<void()> upload;
+            {
+                std::lock_guard<std::mutex> lock(mUploadMutex);
+                if (mUploads.empty()) {
+                    return;
+                }
+                upload = std::move(mUploads.front());
+                mUploads.pop_front();
+            }
+            upload();
+        } while (glfwGetTime() - start < budget);
+    }
+
+    Prefab const& AssetManager::GetPrefab(std::string const& name) {
+        static Prefab const empty_prefab;
+        Prefab const* prefab = mPrefabList.Get(mPrefabList.Find(name));
+        return prefab ? *prefab : empty_prefab;
+    }
 
     FMOD::Channel* AssetManager::PlaySoundByName(const std::string& sound_name, bool loop, float volume, float pitch) {
-        FMOD::Sound* sound = GetSound(sound_name);
+        return PlaySound(mSoundList.Find(sound_name), loop, volume, pitch);
+    }
+
+    FMOD::Channel* AssetManager::PlaySound(SoundHandle sound_handle, bool loop, float volume, float pitch) {
+        FMOD::Sound* sound = GetSound(sound_handle);
         if (!sound) {
             // Handle error: sound not found
             return nullptr;
@@ -312,7 +428,7 @@ namespace IS {
     }
 
     void AssetManager::Update([[maybe_unused]] float deltaTime) {//every frame
-         
+        ProcessUploads(UPLOAD_BUDGET);
     }    
 
     std::string AssetManager::GetName() { return "Asset"; }
@@ -324,13 +440,34 @@ namespace IS {
         }
     }
     
-    void AssetManager::LoadImage(std::string const& filepath , ImageData image_data)
+    Particle AssetManager::LoadParticleFromFile(const std::string& filename) {
+        Particle particle;
+        if (ParticleCache::Load(filename, particle)) {
+            return particle;
+        }
+
+        std::ifstream file(filename);
+        if (!file.is_open()) {
+            IS_CORE_WARN("Failed to open particle: {}", filename);
+            return particle;
+        }
+        std::stringstream data;
+        data << file.rdbuf();
+        file.close();
+
+        particle = Particle::Deserialize(data.str());
+        ParticleCache::Save(filename, particle);
+        return particle;
+    }
+
+    void AssetManager::LoadImage(std::string const& filepath, TextureAtlas::CookedImage const& cooked)
     {
-        ImageLoad(filepath,image_data);
         Image* img = GetImage(std::filesystem::path(filepath).filename().string());
-        img->texture_index = mCurrentTexId;
-        img->mFileName = std::filesystem::path(filepath).filename().string();
-        mCurrentTexId++;
+        if (!img) {
+            return;
+        }
+        ISGraphics::textureAtlas.Add(img->texture_index, cooked);
+        ImageLoad(filepath, cooked);
         ISGraphics::textures.emplace_back(*img);
     }
 
@@ -342,8 +479,11 @@ namespace IS {
         FMOD::Channel* channel = audio->ISAudioLoadSound(filepath.c_str());
         FMOD::Sound* sound = audio->ISAudioLoadSoundS(filepath.c_str());
         std::string sound_name = path.filename().string();
-        SaveSound(sound_name, sound);
-        SaveChannel(sound_name, channel);
+        {
+            std::lock_guard<std::mutex> lock(mListMutex);
+            SaveSound(sound_name, sound);
+            SaveChannel(sound_name, channel);
+        }
         IS_CORE_INFO("Loaded Sound: {} ", sound_name);
     }
 
@@ -351,7 +491,8 @@ namespace IS {
     {
         auto& engine = InsightEngine::Instance();
         Prefab to_list = engine.LoadPrefabFromFile(filepath);
-        mPrefabList[to_list.mName] = to_list;
+        std::lock_guard<std::mutex> lock(mListMutex);
+        mPrefabList.Add(to_list.mName, to_list);
         IS_CORE_INFO("Loaded Prefab: {} ", filepath);
     }
 
@@ -362,11 +503,7 @@ namespace IS {
     }
 
     Image* AssetManager::GetImage(const std::string& file_name)  {
-        auto iter = mImageList.find(file_name);
-        if (iter != mImageList.end()) {
-            return &(iter->second);
-        }
-        return nullptr;
+        return mImageList.Get(mImageList.Find(file_name));
     }
 
     Image* AssetManager::GetIcon(const std::string& file_name) {
@@ -377,12 +514,11 @@ namespace IS {
         throw std::runtime_error("Image not found.");
     }
 
-    void AssetManager::ImageLoad(const std::string& filepath, ImageData image_data) {
-        Image new_image;
+    void AssetManager::ImageLoad(const std::string& filepath, TextureAtlas::CookedImage const& cooked) {
+        Image* image = GetImage(std::filesystem::path(filepath).filename().string());
         std::shared_ptr<ISGraphics> graphics = InsightEngine::Instance().GetSystem<ISGraphics>("Graphics");
-        graphics->initTextures(filepath,new_image,image_data);
-        SaveImageData(new_image);
-        IS_CORE_INFO("Using Texture: {} \"{}\"", new_image.texture_id, filepath.substr(7));
+        graphics->initCookedTexture(filepath, *image, cooked);
+        IS_CORE_INFO("Using Texture: {} \"{}\"", image->texture_id, filepath.substr(7));
     }
 
     void AssetManager::IconLoad(const std::string& filepath) {
@@ -400,15 +536,16 @@ namespace IS {
     }
 
     void AssetManager::SaveImageData(const Image image_data) {
-        mImageList[image_data.mFileName] = image_data;
+        mImageList.Add(image_data.mFileName, image_data);
         mImageNames.emplace_back(image_data.mFileName);
     }
 
     void AssetManager::RemoveImageData(const std::string& file_name) {
-        auto iter = mImageList.find(file_name);
-        if (iter != mImageList.end()) {
-            mImageList.erase(iter);
+        ImageHandle image = mImageList.Find(file_name);
+        if (mImageList.GetRefCount(image) > 0) {
+            IS_CORE_WARN("Removing image {} that is still referenced {} times", file_name, mImageList.GetRefCount(image));
         }
+        mImageList.Remove(image);
         mImageNames.erase(std::remove(mImageNames.begin(), mImageNames.end(), file_name), mImageNames.end());
     }
 
@@ -479,22 +616,25 @@ namespace IS {
         //IS_CORE_DEBUG("SIZE OF mSceneList: {}", mSceneList.size());
         //IS_CORE_DEBUG("SIZE OF mScriptList: {}", mScriptList.size());
         //IS_CORE_DEBUG("SIZE OF mParticleList: {}", mParticleList.size());
-        //IS_CORE_DEBUG("SIZE OF mImageData: {}", mImageData.size());
-        //IS_CORE_DEBUG("SIZE OF mThreads: {}", mThreads.size());
+        //IS_CORE_DEBUG("SIZE OF mUploads: {}", mUploads.size());
         //IS_CORE_DEBUG("VALUE OF mCurrentTexId: {}", mCurrentTexId);
 
 
         IS_PROFILE_FUNCTION();
+        // nothing may still be decoding into the lists below, queued uploads are dropped
+        mWorkers.Wait();
+
         std::shared_ptr<ISGraphics> graphics = InsightEngine::Instance().GetSystem<ISGraphics>("Graphics");
         for (auto& img : mIconList) {
             graphics->deleteTexture(img.second);
             IS_CORE_DEBUG("DELETED TEXTURE:{} {}", img.second.texture_id,img.first);
         }
-        for (auto& img : mImageList) {
-            graphics->deleteTexture(img.second);
-            IS_CORE_DEBUG("DELETED TEXTURE:{} {}", img.second.texture_id, img.first);
+        for (auto const& [name, image] : mImageList) {
+            graphics->deleteTexture(image);
+            IS_CORE_DEBUG("DELETED TEXTURE:{} {}", image.texture_id, name);
         }
         ISGraphics::textures.clear();
+        ISGraphics::textureAtlas.Clear();
 
         mSoundList.clear();
         mChannelList.clear();
@@ -506,8 +646,9 @@ namespace IS {
         mSceneList.clear();
         mScriptList.clear();
         mParticleList.clear();
-        mImageData.clear();
-        mThreads.clear();
+        mUploads.clear();
+        mPendingImages = 0;
+        mTrimAtlas = false;
         mCurrentTexId = 0;
 
 
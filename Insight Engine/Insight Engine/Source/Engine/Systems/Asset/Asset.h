@@ -24,11 +24,17 @@
 #include "Engine/JSON/Prefab.h"
 #include "Engine/Systems/Particle/Particle.h"
 #include "Scene/SceneManager.h"
+#include "Graphics/System/TextureAtlas.h"
+#include "Engine/Systems/Asset/AssetRegistry.h"
+#include "Engine/Core/ThreadPool.h"
 
 #include <stdlib.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include <filesystem>
+#include <deque>
+#include <functional>
+#include <mutex>
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
@@ -182,10 +188,13 @@ namespace IS {
          */
         ~AssetManager()
         { 
+            // let running jobs finish before the lists they write to go away
+            mWorkers.Wait();
+
             // Release memory for images
-            for (auto& imagePair : mImageList) {
-                if (imagePair.second.texture_id) {
-                    glDeleteTextures(1, &imagePair.second.texture_id); // release OpenGL texture
+            for (auto const& [name, image] : mImageList) {
+                if (image.texture_id) {
+                    glDeleteTextures(1, &image.texture_id); // release OpenGL texture
                 }
             }
             mImageList.clear();
@@ -202,12 +211,36 @@ namespace IS {
         }
 
         /*!
-         * \brief Loads an image from a file and stores it in the AssetManager.
+         * \brief Uploads a cooked image into its registered Image.
+         *
+         * \param filepath The path to the source image file.
+         * \param cooked The image cooked to the texture atlas format.
+         */
+        void LoadImage(std::string const& filepath, TextureAtlas::CookedImage const& cooked);
+
+        /*!
+         * \brief Registers an image and streams it in the background.
+         *
+         * The Image is usable right away: its texture index resolves in the texture
+         * atlas once the upload lands, until then sprites using it draw untextured.
          *
          * \param filepath The path to the image file.
-         * \param image_data The ImageData structure to store the loaded image data.
          */
-        void LoadImage(std::string const& filepath, ImageData image_data);
+        void StreamImage(std::string const& filepath);
+
+        /*!
+         * \brief Runs queued main thread uploads until the time budget is used up.
+         *
+         * \param budget The time budget in seconds, at least one upload always runs.
+         */
+        void ProcessUploads(double budget);
+
+        /*!
+         * \brief Checks if images are still streaming in.
+         *
+         * \return True if some registered images have not been uploaded.
+         */
+        bool IsStreaming() const { return mPendingImages > 0; }
 
         /*!
          * \brief Loads an audio file and stores it in the AssetManager.
@@ -238,6 +271,14 @@ namespace IS {
          */
         Image* GetImage(const std::string& file_name);
 
+        /*!
+         * \brief Retrieves image data by handle.
+         *
+         * \param image The handle of the image.
+         * \return A pointer to the Image, nullptr if the handle is stale.
+         */
+        Image* GetImage(ImageHandle image) { return mImageList.Get(image); }
+
         /*!
          * \brief Retrieves icon image data by file name.
          *
@@ -247,11 +288,12 @@ namespace IS {
         Image* GetIcon(const std::string& file_name);
 
         /*!
-         * \brief Loads image data from a file.
+         * \brief Creates the texture of a cooked image.
          *
          * \param file_path The file path to the image.
+         * \param cooked The image cooked to the texture atlas format.
          */
-        void ImageLoad(const std::string& file_path,ImageData image_data);
+        void ImageLoad(const std::string& file_path, TextureAtlas::CookedImage const& cooked);
 
         /*!
          * \brief Loads an icon image from a file.
@@ -289,12 +331,40 @@ namespace IS {
         void ImageFree(const std::string& file_name);
 
         /*!
-         * \brief Loads image data from a file in a separate worker thread.
+         * \brief Loads the cooked image from the texture cache, or decodes and pads the
+         * image data if the cache is stale, then queues its upload. Runs on a worker.
          *
          * \param filepath The path to the image file.
          */
         void WorkerLoadImageData(const std::string& filepath);
 
+        /*!
+         * \brief Encodes a strip of a padded image and queues the next strip, or
+         * finishes the image once every strip is encoded. Runs as an upload.
+         *
+         * \param filepath The path to the image file.
+         * \param padded The padded image.
+         * \param cooked The image being encoded.
+         * \param first_row The first texel row of the strip.
+         */
+        void EncodeImage(std::string const& filepath, std::shared_ptr<TextureAtlas::CookedImage const> padded,
+                         std::shared_ptr<TextureAtlas::CookedImage> cooked, GLsizei first_row);
+
+        /*!
+         * \brief Uploads a cooked image, or reports it failed if it has no data. Runs as an upload.
+         *
+         * \param filepath The path to the image file.
+         * \param cooked The cooked image.
+         */
+        void FinishImage(std::string const& filepath, TextureAtlas::CookedImage const& cooked);
+
+        /*!
+         * \brief Queues work that needs the main thread, safe to call from workers.
+         *
+         * \param upload The work, run by ProcessUploads().
+         */
+        void QueueUpload(std::function<void()> upload);
+
         /*!
          * \brief Converts an image to grayscale.
          *
@@ -313,9 +383,20 @@ namespace IS {
          * \brief Retrieves a Prefab object by name.
          *
          * \param name The name of the Prefab to retrieve.
-         * \return The Prefab object.
+         * \return The Prefab object, an empty Prefab if none is loaded with the name.
+         */
+        Prefab const& GetPrefab(std::string const& name);
+
+        /*!
+         * \brief Plays a sound by handle.
+         *
+         * \param sound The handle of the sound to play.
+         * \param loop Specifies whether the sound should loop (default is false).
+         * \param volume The volume at which to play the sound (default is 1.0f).
+         * \param pitch The pitch at which to play the sound (default is 1.0f).
+         * \return A pointer to the FMOD::Channel playing the sound.
          */
-        Prefab GetPrefab(std::string name);
+        FMOD::Channel* PlaySound(SoundHandle sound, bool loop = false, float volume = 1.0f, float pitch = 1.0f);
 
         /*!
          * \brief Plays a sound by name.
@@ -346,7 +427,7 @@ namespace IS {
          * \param sound A pointer to the FMOD::Sound to save.
          */
         void SaveSound(const std::string& name, FMOD::Sound* sound) {
-            mSoundList[name] = sound;
+            mSoundList.Add(name, sound);
         }
 
         /*!
@@ -366,11 +447,18 @@ namespace IS {
          * \return A pointer to the FMOD::Sound with the specified name.
          */
         FMOD::Sound* GetSound(const std::string& name) {
-            auto iter = mSoundList.find(name);
-            if (iter != mSoundList.end()) {
-                return iter->second;
-            }
-            return nullptr;
+            return GetSound(mSoundList.Find(name));
+        }
+
+        /*!
+         * \brief Retrieves a sound by handle.
+         *
+         * \param sound The handle of the sound to retrieve.
+         * \return A pointer to the FMOD::Sound, nullptr if the handle is stale.
+         */
+        FMOD::Sound* GetSound(SoundHandle sound) {
+            FMOD::Sound** entry = mSoundList.Get(sound);
+            return entry ? *entry : nullptr;
         }
 
         /*!
@@ -393,10 +481,10 @@ namespace IS {
          * \param name The name of the sound to remove.
          */
         void RemoveSound(const std::string& name) {
-            auto iter = mSoundList.find(name);
-            if (iter != mSoundList.end()) {
-                iter->second->release();  // Important: Release the FMOD::Sound object
-                mSoundList.erase(iter);
+            SoundHandle sound = mSoundList.Find(name);
+            if (FMOD::Sound* entry = GetSound(sound)) {
+                entry->release();  // Important: Release the FMOD::Sound object
+                mSoundList.Remove(sound);
             }
         }
 
@@ -434,18 +522,12 @@ namespace IS {
         /*!
          * \brief Loads a particle from a file.
          *
+         * Reads the cooked preset if it is up to date, otherwise parses the text and cooks it.
+         *
          * \param filename The name of the file to load from.
          * \return The loaded Particle.
          */
-        Particle LoadParticleFromFile(const std::string& filename) {
-            std::ifstream file(filename);
-            std::stringstream data;
-            if (file.is_open()) {
-                data << file.rdbuf();
-                file.close();
-            }
-            return Particle::Deserialize(data.str());
-        }
+        Particle LoadParticleFromFile(const std::string& filename);
 
         /*!
          * \brief Saves a particle to a file in the particle directory.
@@ -467,19 +549,29 @@ namespace IS {
         void LoadParticle(std::string filename) {
            
             IS_CORE_DEBUG("{}", filename);
-            mParticleList[filename]=LoadParticleFromFile(filename);
+            Particle particle = LoadParticleFromFile(filename);
+            std::lock_guard<std::mutex> lock(mListMutex);
+            if (Particle const* old = mParticleList.Get(mParticleList.Find(filename))) {
+                mImageList.Release(old->mImage);
+            }
+            particle.mImage = mImageList.Acquire(particle.mImageName);
 
+            // reloading keeps the handle, so spawned particles pick up the new curves
+            ParticleHandle handle = mParticleList.Add(filename, particle);
+            mParticleList.Get(handle)->mPreset = handle;
+            IS_CORE_INFO("Loaded Particle: {} ", filename);
         }
 
         /*!
          * \brief Retrieves a particle by filename from the particle directory.
          *
          * \param filename The name of the file to retrieve.
-         * \return The retrieved Particle.
+         * \return The retrieved Particle, a default Particle if none is loaded with the name.
          */
-        Particle GetParticle(std::string filename) {
-            filename = PARTICLE_DIRECTORY + filename;
-            return mParticleList[filename];
+        Particle const& GetParticle(std::string const& filename) {
+            static Particle const default_particle;
+            Particle const* particle = mParticleList.Get(mParticleList.Find(PARTICLE_DIRECTORY + filename));
+            return particle ? *particle : default_particle;
         }
 
         /*!
@@ -504,7 +596,7 @@ namespace IS {
         static GLFWcursor* LoadWindowCursor(const char* filepath);
 
         // for save sounds and fonts
-        std::unordered_map<std::string, FMOD::Sound*> mSoundList;
+        AssetRegistry<FMOD::Sound*> mSoundList;
         std::unordered_map<std::string, FMOD::Channel*> mChannelList;
 
         using AudioChannel = std::pair<std::string, FMOD::Channel*>;
@@ -517,19 +609,25 @@ namespace IS {
         std::vector<AudioData> mBGMChannel;
         std::vector<AudioData> mSFXChannel;
 
-        std::unordered_map<std::string, Image> mImageList;
+        AssetRegistry<Image> mImageList;
         std::unordered_map <std::string, Image> mIconList;
         std::vector<std::string> mShaderList;
         std::vector<std::string> mImageNames;
         std::vector<std::string> mIconNames;
-        std::unordered_map<std::string, Prefab> mPrefabList;
+        AssetRegistry<Prefab> mPrefabList;
         std::vector<std::string> mSceneList;
         std::vector<std::string> mScriptList;
-        std::unordered_map<std::string,Particle> mParticleList;
-        std::vector<std::thread> mThreads;
-        std::vector<std::pair<std::string, ImageData>> mImageData;
-        std::mutex mImageDataMutex;
+        AssetRegistry<Particle> mParticleList;
+        std::mutex mListMutex;                          // Guards the lists filled by worker jobs
+        std::deque<std::function<void()>> mUploads;     // Work handed back to the main thread
+        std::mutex mUploadMutex;
+        int mPendingImages{};                           // Registered images not uploaded yet
+        bool mTrimAtlas{};                              // Initialize is still streaming, trim the atlas once it is done
         int mCurrentTexId{};
+        ThreadPool mWorkers;                            // Declared last so its jobs stop first
+
+        static constexpr double UPLOAD_BUDGET = .004;   // Seconds of uploads per frame
+        static constexpr GLsizei ENCODE_STRIP_TEXELS = 64 * 1024; // Texels encoded per upload, keeps one image from using up the budget
 
         static constexpr const char* TEXTURE_DIRECTORY  = "Assets/Textures/";
         static constexpr const char* ICON_DIRECTORY     = "Assets/Icons/";
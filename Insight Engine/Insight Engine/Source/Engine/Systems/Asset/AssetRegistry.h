@@ -0,0 +1,345 @@
+/* Start Header **************************************************************/
+/*!
+ * \file AssetRegistry.h
+ * \author Tan Zheng Xun, t.zhengxun@digipen.edu
+ * \par Course: CSD2451
+ * \date 19-10-2026
+ * \brief
+ * Declaration and definition of the AssetHandle and AssetRegistry class templates,
+ * which store loaded assets in slots addressed by typed 32-bit handles.
+ *
+ * All content (C) 2024 DigiPen Institute of Technology Singapore.
+ * All rights reserved.
+ * Reproduction or disclosure of this file or its contents without the prior written
+ * consent of DigiPen Institute of Technology is prohibited.
+ */
+ /* End Header ****************************************************************/
+
+/*include guards*/
+#ifndef GAM200_INSIGHT_ENGINE_SOURCE_ASSET_REGISTRY_H
+#define GAM200_INSIGHT_ENGINE_SOURCE_ASSET_REGISTRY_H
+
+/*includes */
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace FMOD {
+    class Sound;
+}
+
+namespace IS {
+
+    /*!
+     * \brief Typed reference to an asset in an AssetRegistry.
+     *
+     * The low 24 bits are the slot index and the high 8 bits the generation of the
+     * slot, so a handle kept after its asset was removed no longer resolves.
+     */
+    template <typename T>
+    class AssetHandle {
+    public:
+        static constexpr uint32_t INDEX_BITS = 24;
+        static constexpr uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+        static constexpr uint32_t GENERATION_MASK = 0xFFu;
+        static constexpr uint32_t INVALID = 0xFFFFFFFFu;
+
+        /*!
+         * \brief Constructs a handle that refers to nothing.
+         */
+        AssetHandle() = default;
+
+        /*!
+         * \brief Constructs a handle to a slot.
+         * \param index The slot index.
+         * \param generation The generation of the slot.
+         */
+        AssetHandle(uint32_t index, uint32_t generation)
+            : mID(((generation & GENERATION_MASK) << INDEX_BITS) | (index & INDEX_MASK)) {}
+
+        uint32_t GetIndex() const { return mID & INDEX_MASK; }
+        uint32_t GetGeneration() const { return mID >> INDEX_BITS; }
+        uint32_t GetID() const { return mID; }
+        bool IsValid() const { return mID != INVALID; }
+
+        bool operator==(AssetHandle const& other) const = default;
+
+    private:
+        uint32_t mID{ INVALID };
+    };
+
+    struct Image;
+    class Prefab;
+    struct Particle;
+
+    using ImageHandle = AssetHandle<Image>;
+    using SoundHandle = AssetHandle<FMOD::Sound*>;
+    using PrefabHandle = AssetHandle<Prefab>;
+    using ParticleHandle = AssetHandle<Particle>;
+
+    /*!
+     * \brief Slot storage for one type of asset.
+     *
+     * Resolving a handle is an array access. Names are only an index into the slots,
+     * meant for the edges (loading, deserializing, the editor and scripts), where
+     * handles are looked up once and kept. Slots live in a deque, so pointers to assets
+     * stay valid while other assets are added. Removed slots are reused with the next
+     * generation. Reference counts are kept for the edges that hold on to a handle.
+     * Not thread safe, callers that fill a registry from workers lock around it.
+     *
+     * \tparam T The type of asset.
+     */
+    template <typename T>
+    class AssetRegistry {
+        struct Slot {
+            std::string name;
+            T asset{};
+            uint32_t generation{};
+            uint32_t ref_count{};
+            bool alive{};
+        };
+
+        // lets find() take a string_view or char const* without building a std::string
+        struct NameHash {
+            using is_transparent = void;
+            size_t operator()(std::string_view name) const { return std::hash<std::string_view>{}(name); }
+        };
+
+        /*!
+         * \brief Bidirectional iterator over the live slots, dereferences to a (name, asset) pair.
+         */
+        template <bool IS_CONST>
+        class Iterator {
+            using Registry = std::conditional_t<IS_CONST, AssetRegistry const, AssetRegistry>;
+            using Asset = std::conditional_t<IS_CONST, T const, T>;
+
+        public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using difference_type = std::ptrdiff_t;
+            using value_type = std::pair<std::string const&, Asset&>;
+            using reference = value_type;
+            using pointer = void;
+
+            Iterator() = default;
+            Iterator(Registry* registry, size_t index) : mRegistry(registry), mIndex(index) { SkipForward(); }
+
+            reference operator*() const {
+                auto& slot = mRegistry->mSlots[mIndex];
+                return { slot.name, slot.asset };
+            }
+
+            Iterator& operator++() { ++mIndex; SkipForward(); return *this; }
+            Iterator operator++(int) { Iterator old = *this; ++*this; return old; }
+            Iterator& operator--() {
+                do { --mIndex; } while (mIndex > 0 && !mRegistry->mSlots[mIndex].alive);
+                return *this;
+            }
+            Iterator operator--(int) { Iterator old = *this; --*this; return old; }
+
+            bool operator==(Iterator const& other) const { return mIndex == other.mIndex; }
+
+            size_t GetIndex() const { return mIndex; }
+
+        private:
+            void SkipForward() {
+                while (mIndex < mRegistry->mSlots.size() && !mRegistry->mSlots[mIndex].alive) {
+                    ++mIndex;
+                }
+            }
+
+            Registry* mRegistry{};
+            size_t mIndex{};
+        };
+
+    public:
+        using Handle = AssetHandle<T>;
+        using iterator = Iterator<false>;
+        using const_iterator = Iterator<true>;
+
+        /*!
+         * \brief Adds an asset, or replaces the asset already using the name.
+         * \param name The name of the asset.
+         * \param asset The asset.
+         * \return The handle of the asset, the same handle if it was replaced.
+         */
+        Handle Add(std::string const& name, T asset) {
+            if (auto it = mNames.find(name); it != mNames.end()) {
+                Slot& slot = mSlots[it->second];
+                slot.asset = std::move(asset);
+                return { it->second, slot.generation };
+            }
+
+            uint32_t index{};
+            if (!mFree.empty()) {
+                index = mFree.back();
+                mFree.pop_back();
+            }
+            else {
+                index = static_cast<uint32_t>(mSlots.size());
+                mSlots.emplace_back();
+            }
+            Slot& slot = mSlots[index];
+            slot.name = name;
+            slot.asset = std::move(asset);
+            slot.ref_count = 0;
+            slot.alive = true;
+            mNames.emplace(name, index);
+            ++mCount;
+            return { index, slot.generation };
+        }
+
+        /*!
+         * \brief Looks up an asset by name.
+         * \param name The name of the asset.
+         * \return The handle, invalid if no asset uses the name.
+         */
+        Handle Find(std::string_view name) const {
+            auto it = mNames.find(name);
+            if (it == mNames.end()) {
+                return {};
+            }
+            return { it->second, mSlots[it->second].generation };
+        }
+
+        /*!
+         * \brief Resolves a handle.
+         * \param handle The handle.
+         * \return The asset, nullptr if the handle is invalid or stale.
+         */
+        T* Get(Handle handle) { return IsLive(handle) ? &mSlots[handle.GetIndex()].asset : nullptr; }
+        T const* Get(Handle handle) const { return IsLive(handle) ? &mSlots[handle.GetIndex()].asset : nullptr; }
+
+        /*!
+         * \brief Resolves a handle that caches a name which may have changed, such as a
+         * name edited in the inspector. Looks the name up again only if they disagree.
+         * \param handle The cached handle, updated if it was looked up again.
+         * \param name The name the handle should refer to.
+         * \return The asset, nullptr if no asset uses the name.
+         */
+        T* Resolve(Handle& handle, std::string_view name) {
+            if (!IsLive(handle) || mSlots[handle.GetIndex()].name != name) {
+                handle = Find(name);
+            }
+            return Get(handle);
+        }
+
+        /*!
+         * \brief Looks up an asset by name and holds a reference to it.
+         * \param name The name of the asset.
+         * \return The handle, invalid if no asset uses the name.
+         */
+        Handle Acquire(std::string_view name) {
+            Handle handle = Find(name);
+            if (handle.IsValid()) {
+                ++mSlots[handle.GetIndex()].ref_count;
+            }
+            return handle;
+        }
+
+        /*!
+         * \brief Drops a reference taken with Acquire().
+         * \param handle The handle.
+         */
+        void Release(Handle handle) {
+            if (IsLive(handle) && mSlots[handle.GetIndex()].ref_count > 0) {
+                --mSlots[handle.GetIndex()].ref_count;
+            }
+        }
+
+        /*!
+         * \brief Gets the number of references held on an asset.
+         * \param handle The handle.
+         * \return The reference count, 0 if the handle is stale.
+         */
+        uint32_t GetRefCount(Handle handle) const { return IsLive(handle) ? mSlots[handle.GetIndex()].ref_count : 0; }
+
+        /*!
+         * \brief Gets the name of an asset.
+         * \param handle The handle.
+         * \return The name, empty if the handle is stale.
+         */
+        std::string const& GetName(Handle handle) const {
+            static std::string const no_name;
+            return IsLive(handle) ? mSlots[handle.GetIndex()].name : no_name;
+        }
+
+        bool Contains(std::string_view name) const { return mNames.find(name) != mNames.end(); }
+
+        /*!
+         * \brief Removes an asset, its handles stop resolving.
+         * \param handle The handle.
+         * \return True if the asset was removed.
+         */
+        bool Remove(Handle handle) {
+            if (!IsLive(handle)) {
+                return false;
+            }
+            uint32_t index = handle.GetIndex();
+            Slot& slot = mSlots[index];
+            mNames.erase(mNames.find(slot.name));
+            slot.name.clear();
+            slot.asset = T{};
+            slot.ref_count = 0;
+            slot.alive = false;
+            slot.generation = (slot.generation + 1) & Handle::GENERATION_MASK;
+            mFree.push_back(index);
+            --mCount;
+            return true;
+        }
+
+        bool Remove(std::string_view name) { return Remove(Find(name)); }
+
+        /*!
+         * \brief Removes the asset at an iterator.
+         * \param it The iterator.
+         * \return An iterator to the next asset.
+         */
+        iterator erase(iterator it) {
+            size_t index = it.GetIndex();
+            Remove(Handle(static_cast<uint32_t>(index), mSlots[index].generation));
+            return { this, index + 1 };
+        }
+
+        /*!
+         * \brief Removes every asset, slots are kept so old handles stay stale.
+         */
+        void clear() {
+            for (uint32_t index = 0; index < static_cast<uint32_t>(mSlots.size()); ++index) {
+                if (mSlots[index].alive) {
+                    Remove(Handle(index, mSlots[index].generation));
+                }
+            }
+        }
+
+        size_t size() const { return mCount; }
+        bool empty() const { return mCount == 0; }
+
+        iterator begin() { return { this, 0 }; }
+        iterator end() { return { this, mSlots.size() }; }
+        const_iterator begin() const { return { this, 0 }; }
+        const_iterator end() const { return { this, mSlots.size() }; }
+
+    private:
+        bool IsLive(Handle handle) const {
+            if (!handle.IsValid() || handle.GetIndex() >= mSlots.size()) {
+                return false;
+            }
+            Slot const& slot = mSlots[handle.GetIndex()];
+            return slot.alive && slot.generation == handle.GetGeneration();
+        }
+
+        std::deque<Slot> mSlots;
+        std::vector<uint32_t> mFree;    // Dead slots to reuse
+        std::unordered_map<std::string, uint32_t, NameHash, std::equal_to<>> mNames;
+        size_t mCount{};                // Live slots
+    };
+
+} // end namespace IS
+
+#endif // !GAM200_INSIGHT_ENGINE_SOURCE_ASSET_REGISTRY_H
@@ -0,0 +1,113 @@
+/* Start Header **************************************************************/
+/*!
+\file	CacheFile.cpp
+\author Tan Zheng Xun, t.zhengxun@digipen.edu
+\par Course: CSD2451
+\date 19-10-2026
+\brief
+Definition of the CacheFile class, the file handling shared by the asset caches.
+
+All content (C) 2024 DigiPen Institute of Technology Singapore.
+All rights reserved.
+Reproduction or disclosure of this file or its contents without the prior written
+consent of DigiPen Institute of Technology is prohibited.
+*/
+/* End Header ****************************************************************/
+
+/* includes*/
+#include "Pch.h"
+#include "CacheFile.h"
+
+#include <array>
+#include <format>
+#include <fstream>
+
+namespace IS {
+
+    namespace {
+        constexpr uint64_t FNV_OFFSET = 14695981039346656037ull;
+        constexpr uint64_t FNV_PRIME = 1099511628211ull;
+    }
+
+    std::filesystem::path CacheFile::GetPath(char const* directory, std::string const& source_path, char const* extension) {
+        uint64_t hash = FNV_OFFSET;
+        for (char c : std::filesystem::path(source_path).generic_string()) {
+            hash = (hash ^ static_cast<uint8_t>(c)) * FNV_PRIME;
+        }
+        std::string stem = std::filesystem::path(source_path).stem().string();
+        return std::filesystem::path(directory) / std::format("{}_{:016x}{}", stem, hash, extension);
+    }
+
+    bool CacheFile::Stamp(std::string const& source_path, SourceStamp& stamp) {
+        return GetFileTime(source_path, stamp) && HashContents(source_path, stamp.hash);
+    }
+
+    bool CacheFile::IsCurrent(std::string const& source_path, SourceStamp const& stamp) {
+        SourceStamp current;
+        if (!GetFileTime(source_path, current) || current.size != stamp.size) {
+            return false;
+        }
+        // the source was touched, it is only stale if its contents changed
+        if (current.time != stamp.time) {
+            return HashContents(source_path, current.hash) && current.hash == stamp.hash;
+        }
+        return true;
+    }
+
+    bool CacheFile::Write(std::filesystem::path const& path, std::initializer_list<std::span<char const>> chunks) {
+        std::error_code error;
+        std::filesystem::create_directories(path.parent_path(), error);
+
+        std::filesystem::path temp_path = path;
+        temp_path += ".tmp";
+        {
+            std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+            for (std::span<char const> chunk : chunks) {
+                file.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+            }
+            if (!file) {
+                IS_CORE_WARN("Failed to write cache file: {}", temp_path.string());
+                return false;
+            }
+        }
+        std::filesystem::rename(temp_path, path, error);
+        if (error) {
+            IS_CORE_WARN("Failed to write cache file: {}", path.string());
+            std::filesystem::remove(temp_path, error);
+            return false;
+        }
+        return true;
+    }
+
+    bool CacheFile::GetFileTime(std::string const& source_path, SourceStamp& stamp) {
+        std::error_code error;
+        uintmax_t size = std::filesystem::file_size(source_path, error);
+        if (error) {
+            return false;
+        }
+        auto time = std::filesystem::last_write_time(source_path, error);
+        if (error) {
+            return false;
+        }
+        stamp.size = static_cast<uint64_t>(size);
+        stamp.time = static_cast<int64_t>(time.time_since_epoch().count());
+        return true;
+    }
+
+    bool CacheFile::HashContents(std::string const& source_path, uint64_t& hash) {
+        std::ifstream file(source_path, std::ios::binary);
+        if (!file) {
+            return false;
+        }
+
+        hash = FNV_OFFSET;
+        std::array<char, 64 * 1024> buffer;
+        while (file.read(buffer.data(), buffer.size()) || file.gcount() > 0) {
+            for (std::streamsize i = 0; i < file.gcount(); ++i) {
+                hash = (hash ^ static_cast<uint8_t>(buffer[i])) * FNV_PRIME;
+            }
+        }
+        return file.eof();
+    }
+
+} // end namespace IS
@@ -0,0 +1,103 @@
+/* Start Header **************************************************************/
+/*!
+ * \file CacheFile.h
+ * \author Tan Zheng Xun, t.zhengxun@digipen.edu
+ * \par Course: CSD2451
+ * \date 19-10-2026
+ * \brief
+ * Declaration of the CacheFile class, the file handling shared by the asset caches
+ * that store cooked versions of source assets on disk.
+ *
+ * All content (C) 2024 DigiPen Institute of Technology Singapore.
+ * All rights reserved.
+ * Reproduction or disclosure of this file or its contents without the prior written
+ * consent of DigiPen Institute of Technology is prohibited.
+ */
+ /* End Header ****************************************************************/
+
+/*include guards*/
+#ifndef GAM200_INSIGHT_ENGINE_SOURCE_CACHE_FILE_H
+#define GAM200_INSIGHT_ENGINE_SOURCE_CACHE_FILE_H
+
+/*includes */
+#include <cstdint>
+#include <filesystem>
+#include <initializer_list>
+#include <span>
+#include <string>
+
+namespace IS {
+
+    /*!
+     * \brief Naming, staleness checks and writing of cache files.
+     *
+     * Each source has one cache file named after a hash of its path, the stem keeps
+     * the folder readable. A cache file records the size, modification time and
+     * content hash of the source it was cooked from. A matching size and time is
+     * trusted without reading the source, otherwise the source is hashed, so a file
+     * only touched by a checkout or copy is still current.
+     */
+    class CacheFile {
+    public:
+        /*!
+         * \brief Source a cache file was cooked from, stored in its header.
+         */
+        struct SourceStamp {
+            uint64_t size{};
+            int64_t time{};
+            uint64_t hash{};    // FNV-1a of the contents
+        };
+
+        /*!
+         * \brief Gets the cache file of a source.
+         * \param directory The cache directory.
+         * \param source_path The path to the source.
+         * \param extension The extension of the cache file, with the dot.
+         */
+        static std::filesystem::path GetPath(char const* directory, std::string const& source_path, char const* extension);
+
+        /*!
+         * \brief Stamps a source, hashing its contents.
+         * \return False if the source file cannot be read.
+         */
+        static bool Stamp(std::string const& source_path, SourceStamp& stamp);
+
+        /*!
+         * \brief Checks if a source is still the one a cache file was cooked from.
+         * \param source_path The path to the source.
+         * \param stamp The stamp read from the cache file.
+         * \return False if the source changed or cannot be read.
+         */
+        static bool IsCurrent(std::string const& source_path, SourceStamp const& stamp);
+
+        /*!
+         * \brief Writes a cache file next to its final path and swaps it in, a half written file is never read.
+         * \param path The cache file.
+         * \param chunks The bytes to write, in order.
+         * \return True if the cache file was written.
+         */
+        static bool Write(std::filesystem::path const& path, std::initializer_list<std::span<char const>> chunks);
+
+        /*!
+         * \brief Gets the bytes of a trivially copyable value, for Write().
+         */
+        template <typename T>
+        static std::span<char const> Bytes(T const& value) { return { reinterpret_cast<char const*>(&value), sizeof(T) }; }
+
+    private:
+        /*!
+         * \brief Gets the size and modification time of a source.
+         * \return False if the source file cannot be read.
+         */
+        static bool GetFileTime(std::string const& source_path, SourceStamp& stamp);
+
+        /*!
+         * \brief Gets the FNV-1a hash of the contents of a source.
+         * \return False if the source file cannot be read.
+         */
+        static bool HashContents(std::string const& source_path, uint64_t& hash);
+    };
+
+} // end namespace IS
+
+#endif // !GAM200_INSIGHT_ENGINE_SOURCE_CACHE_FILE_H
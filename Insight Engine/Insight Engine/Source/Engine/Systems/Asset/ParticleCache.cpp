@@ -0,0 +1,139 @@
+/* Start Header **************************************************************/
+/*!
+\file	ParticleCache.cpp
+\author Tan Zheng Xun, t.zhengxun@digipen.edu
+\par Course: CSD2451
+\date 19-10-2026
+\brief
+Definition of the ParticleCache class, which stores particle presets on disk.
+
+All content (C) 2024 DigiPen Institute of Technology Singapore.
+All rights reserved.
+Reproduction or disclosure of this file or its contents without the prior written
+consent of DigiPen Institute of Technology is prohibited.
+*/
+/* End Header ****************************************************************/
+
+/* includes*/
+#include "Pch.h"
+#include "ParticleCache.h"
+
+#include <cstring>
+#include <fstream>
+
+namespace IS {
+
+    namespace {
+        template <typename CurveRecord>
+        void WriteCurve(ParticleCurve const& curve, CurveRecord& record) {
+            record.key_count = curve.mKeyCount;
+            for (int i = 0; i < curve.mKeyCount; ++i) {
+                record.keys[i][0] = curve.mKeys[i].mTime;
+                for (int c = 0; c < 4; ++c) {
+                    record.keys[i][c + 1] = curve.mKeys[i].mValue[c];
+                }
+            }
+        }
+
+        template <typename CurveRecord>
+        void ReadCurve(CurveRecord const& record, ParticleCurve& curve) {
+            int key_count = std::clamp(record.key_count, 0, ParticleCurve::MAX_KEYS);
+            for (int i = 0; i < key_count; ++i) {
+                curve.AddKey(record.keys[i][0], { record.keys[i][1], record.keys[i][2], record.keys[i][3], record.keys[i][4] });
+            }
+            curve.Bake();
+        }
+    }
+
+    bool ParticleCache::Load(std::string const& source_path, Particle& particle) {
+        std::ifstream file(CacheFile::GetPath(CACHE_DIRECTORY, source_path, ".ispt"), std::ios::binary);
+        if (!file) {
+            return false;
+        }
+
+        Header expected;
+        Header header;
+        Record record;
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+            return false;
+        }
+        if (std::memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0 || header.version != VERSION ||
+            !CacheFile::IsCurrent(source_path, header.source)) {
+            return false;
+        }
+        if (!file.read(reinterpret_cast<char*>(&record), sizeof(record))) {
+            return false;
+        }
+        std::string image_name(record.image_name_size, '\0');
+        if (!file.read(image_name.data(), static_cast<std::streamsize>(image_name.size()))) {
+            return false;
+        }
+
+        particle = Particle{};
+        particle.mVelocity = { record.velocity[0], record.velocity[1] };
+        particle.mSizeGrowth = record.size_growth;
+        particle.mScale = { record.scale[0], record.scale[1] };
+        particle.mLifespan = record.lifespan;
+        particle.mColor = Color(record.color[0], record.color[1], record.color[2], record.color[3]);
+        particle.mAlpha = record.alpha;
+        particle.mAlphaGrowth = record.alpha_growth;
+        particle.mRotation = record.rotation;
+        particle.mDirection = record.direction;
+        particle.mParticlePos = { record.position[0], record.position[1] };
+        particle.mParticleType = record.particle_type;
+        particle.mTotalCols = record.total_cols;
+        particle.mTotalRows = record.total_rows;
+        particle.mLayer = record.layer;
+        particle.mGravity = record.gravity != 0;
+        particle.mImageName = std::move(image_name);
+
+        ParticleCurves curves;
+        ReadCurve(record.size_curve, curves.mSize);
+        ReadCurve(record.alpha_curve, curves.mAlpha);
+        ReadCurve(record.color_curve, curves.mColor);
+        if (curves.IsActive()) {
+            particle.mCurves = std::make_shared<ParticleCurves const>(curves);
+        }
+        return true;
+    }
+
+    bool ParticleCache::Save(std::string const& source_path, Particle const& particle) {
+        Header header;
+        if (!CacheFile::Stamp(source_path, header.source)) {
+            return false;
+        }
+
+        Record record;
+        record.velocity[0] = particle.mVelocity.x;
+        record.velocity[1] = particle.mVelocity.y;
+        record.size_growth = particle.mSizeGrowth;
+        record.scale[0] = particle.mScale.x;
+        record.scale[1] = particle.mScale.y;
+        record.lifespan = particle.mLifespan;
+        record.color[0] = particle.mColor.R;
+        record.color[1] = particle.mColor.G;
+        record.color[2] = particle.mColor.B;
+        record.color[3] = particle.mColor.A;
+        record.alpha = particle.mAlpha;
+        record.alpha_growth = particle.mAlphaGrowth;
+        record.rotation = particle.mRotation;
+        record.direction = particle.mDirection;
+        record.position[0] = particle.mParticlePos.x;
+        record.position[1] = particle.mParticlePos.y;
+        record.particle_type = particle.mParticleType;
+        record.total_cols = particle.mTotalCols;
+        record.total_rows = particle.mTotalRows;
+        record.layer = particle.mLayer;
+        record.gravity = particle.mGravity ? 1 : 0;
+        if (particle.mCurves) {
+            WriteCurve(particle.mCurves->mSize, record.size_curve);
+            WriteCurve(particle.mCurves->mAlpha, record.alpha_curve);
+            WriteCurve(particle.mCurves->mColor, record.color_curve);
+        }
+        record.image_name_size = static_cast<uint32_t>(particle.mImageName.size());
+
+        return CacheFile::Write(CacheFile::GetPath(CACHE_DIRECTORY, source_path, ".ispt"),
+                                { CacheFile::Bytes(header), CacheFile::Bytes(record), std::span<char const>(particle.mImageName) });
+    }
+
+} // end namespace IS
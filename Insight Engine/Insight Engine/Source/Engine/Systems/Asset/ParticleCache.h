@@ -0,0 +1,107 @@
+/* Start Header **************************************************************/
+/*!
+ * \file ParticleCache.h
+ * \author Tan Zheng Xun, t.zhengxun@digipen.edu
+ * \par Course: CSD2451
+ * \date 19-10-2026
+ * \brief
+ * Declaration of the ParticleCache class, which stores particle presets on disk in
+ * a flat binary form so loading them skips parsing the text presets.
+ *
+ * All content (C) 2024 DigiPen Institute of Technology Singapore.
+ * All rights reserved.
+ * Reproduction or disclosure of this file or its contents without the prior written
+ * consent of DigiPen Institute of Technology is prohibited.
+ */
+ /* End Header ****************************************************************/
+
+/*include guards*/
+#ifndef GAM200_INSIGHT_ENGINE_SOURCE_PARTICLE_CACHE_H
+#define GAM200_INSIGHT_ENGINE_SOURCE_PARTICLE_CACHE_H
+
+/*includes */
+#include "Engine/Systems/Particle/Particle.h"
+#include "CacheFile.h"
+
+#include <cstdint>
+#include <string>
+
+namespace IS {
+
+    /*!
+     * \brief Disk cache of particle presets.
+     *
+     * The text presets in Assets/Particles stay the authored format, they diff and merge
+     * like any other text. Each one is cooked into a versioned CacheFile holding a
+     * fixed size record and the image name, stamped with the text it came from.
+     */
+    class ParticleCache {
+    public:
+        static constexpr const char* CACHE_DIRECTORY = "Assets/Cache/Particles/";
+        static constexpr uint32_t VERSION = 2; // bump when the record layout changes
+
+        /*!
+         * \brief Loads the cooked version of a preset, safe to call from worker threads.
+         *
+         * \param source_path The path to the text preset.
+         * \param particle The particle to fill, its curves are baked.
+         * \return True if an up to date cache file was read.
+         */
+        static bool Load(std::string const& source_path, Particle& particle);
+
+        /*!
+         * \brief Saves the cooked version of a preset.
+         *
+         * \param source_path The path to the text preset.
+         * \param particle The particle read from the preset.
+         * \return True if the cache file was written.
+         */
+        static bool Save(std::string const& source_path, Particle const& particle);
+
+    private:
+        /*!
+         * \brief Header of a cache file.
+         */
+        struct Header {
+            char magic[4]{ 'I', 'S', 'P', 'T' };
+            uint32_t version{ VERSION };
+            CacheFile::SourceStamp source;
+        };
+
+        /*!
+         * \brief Keys of a curve.
+         */
+        struct CurveRecord {
+            int32_t key_count{};
+            float keys[ParticleCurve::MAX_KEYS][5]{};   // time and value of each key
+        };
+
+        /*!
+         * \brief The preset, followed in the file by image_name_size bytes of the image name.
+         */
+        struct Record {
+            float velocity[2]{};
+            float size_growth{};
+            float scale[2]{};
+            float lifespan{};
+            float color[4]{};
+            float alpha{};
+            float alpha_growth{};
+            float rotation{};
+            float direction{};
+            float position[2]{};
+            int32_t particle_type{};
+            int32_t total_cols{};
+            int32_t total_rows{};
+            int32_t layer{};
+            int32_t gravity{};
+            CurveRecord size_curve;
+            CurveRecord alpha_curve;
+            CurveRecord color_curve;
+            uint32_t image_name_size{};
+        };
+    };
+
+} // end namespace IS
+
+#endif // !GAM200_INSIGHT_ENGINE_SOURCE_PARTICLE_CACHE_H
@@ -0,0 +1,73 @@
+/* Start Header **************************************************************/
+/*!
+\file	TextureCache.cpp
+\author Tan Zheng Xun, t.zhengxun@digipen.edu
+\par Course: CSD2451
+\date 19-10-2026
+\brief
+Definition of the TextureCache class, which stores cooked textures on disk.
+
+All content (C) 2024 DigiPen Institute of Technology Singapore.
+All rights reserved.
+Reproduction or disclosure of this file or its contents without the prior written
+consent of DigiPen Institute of Technology is prohibited.
+*/
+/* End Header ****************************************************************/
+
+/* includes*/
+#include "Pch.h"
+#include "TextureCache.h"
+
+#include <cstring>
+#include <fstream>
+
+namespace IS {
+
+    bool TextureCache::Load(std::string const& source_path, TextureAtlas::CookedImage& image) {
+        std::ifstream file(CacheFile::GetPath(CACHE_DIRECTORY, source_path, ".istex"), std::ios::binary);
+        if (!file) {
+            return false;
+        }
+
+        Header expected;
+        Header header;
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+            return false;
+        }
+        if (std::memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0 || header.version != VERSION ||
+            !CacheFile::IsCurrent(source_path, header.source)) {
+            return false;
+        }
+
+        image.width = header.width;
+        image.height = header.height;
+        image.channels = header.channels;
+        image.padded_width = header.padded_width;
+        image.padded_height = header.padded_height;
+        image.format = header.format;
+        image.data.resize(header.data_size);
+        if (!file.read(reinterpret_cast<char*>(image.data.data()), static_cast<std::streamsize>(header.data_size))) {
+            image.data.clear();
+            return false;
+        }
+        return true;
+    }
+
+    bool TextureCache::Save(std::string const& source_path, TextureAtlas::CookedImage const& image) {
+        Header header;
+        if (!CacheFile::Stamp(source_path, header.source)) {
+            return false;
+        }
+        header.width = image.width;
+        header.height = image.height;
+        header.channels = image.channels;
+        header.padded_width = image.padded_width;
+        header.padded_height = image.padded_height;
+        header.format = image.format;
+        header.data_size = image.data.size();
+
+        std::span<char const> data(reinterpret_cast<char const*>(image.data.data()), image.data.size());
+        return CacheFile::Write(CacheFile::GetPath(CACHE_DIRECTORY, source_path, ".istex"), { CacheFile::Bytes(header), data });
+    }
+
+} // end namespace IS
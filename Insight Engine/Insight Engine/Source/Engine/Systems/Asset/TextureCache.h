@@ -0,0 +1,81 @@
+/* Start Header **************************************************************/
+/*!
+ * \file TextureCache.h
+ * \author Tan Zheng Xun, t.zhengxun@digipen.edu
+ * \par Course: CSD2451
+ * \date 19-10-2026
+ * \brief
+ * Declaration of the TextureCache class, which stores cooked textures on disk so
+ * startup can skip decoding and encoding the source images.
+ *
+ * All content (C) 2024 DigiPen Institute of Technology Singapore.
+ * All rights reserved.
+ * Reproduction or disclosure of this file or its contents without the prior written
+ * consent of DigiPen Institute of Technology is prohibited.
+ */
+ /* End Header ****************************************************************/
+
+/*include guards*/
+#ifndef GAM200_INSIGHT_ENGINE_SOURCE_TEXTURE_CACHE_H
+#define GAM200_INSIGHT_ENGINE_SOURCE_TEXTURE_CACHE_H
+
+/*includes */
+#include "Graphics/System/TextureAtlas.h"
+#include "CacheFile.h"
+
+#include <cstdint>
+#include <string>
+
+namespace IS {
+
+    /*!
+     * \brief Disk cache of cooked textures.
+     *
+     * Each source image has one CacheFile, stamped with the source it was cooked
+     * from. The payload is the cooked image exactly as it is uploaded, so a cache hit
+     * is a single read with no decoding.
+     */
+    class TextureCache {
+    public:
+        static constexpr const char* CACHE_DIRECTORY = "Assets/Cache/Textures/";
+        static constexpr uint32_t VERSION = 2; // bump when the cooked layout changes
+
+        /*!
+         * \brief Loads the cooked version of an image, safe to call from worker threads.
+         *
+         * \param source_path The path to the source image.
+         * \param image The cooked image to fill.
+         * \return True if an up to date cache file was read.
+         */
+        static bool Load(std::string const& source_path, TextureAtlas::CookedImage& image);
+
+        /*!
+         * \brief Saves the cooked version of an image.
+         *
+         * \param source_path The path to the source image.
+         * \param image The cooked image.
+         * \return True if the cache file was written.
+         */
+        static bool Save(std::string const& source_path, TextureAtlas::CookedImage const& image);
+
+    private:
+        /*!
+         * \brief Header of a cache file.
+         */
+        struct Header {
+            char magic[4]{ 'I', 'S', 'T', 'X' };
+            uint32_t version{ VERSION };
+            CacheFile::SourceStamp source;
+            int32_t width{};
+            int32_t height{};
+            int32_t channels{};
+            int32_t padded_width{};
+            int32_t padded_height{};
+            uint32_t format{};
+            uint64_t data_size{};
+        };
+    };
+
+} // end namespace IS
+
+#endif // !GAM200_INSIGHT_ENGINE_SOURCE_TEXTURE_CACHE_H
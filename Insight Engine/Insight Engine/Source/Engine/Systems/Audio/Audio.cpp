@@ -146,7 +146,8 @@ namespace IS {
                     emitter.Channel->setVolume(emitter.volumeLevel * listener.volume * volume *mAudioConfig.mMasterControl.mVolume *2.f * mAudioConfig.mBGMControl.mVolume);
                 }
                 else {
-                    emitter.Channel=PlaySoundCheck(assetsys->GetSound(emitter.soundName),emitter.Channel, emitter.isLoop, emitter.volumeLevel * listener.volume * volume * mAudioConfig.mMasterControl.mVolume *2.f * mAudioConfig.mBGMControl.mVolume, emitter.pitch);
+                    FMOD::Sound** sound = assetsys->mSoundList.Resolve(emitter.sound, emitter.soundName);
+                    emitter.Channel=PlaySoundCheck(sound ? *sound : nullptr,emitter.Channel, emitter.isLoop, emitter.volumeLevel * listener.volume * volume * mAudioConfig.mMasterControl.mVolume *2.f * mAudioConfig.mBGMControl.mVolume, emitter.pitch);
                     mChannelList.emplace_back(emitter.Channel);
                 }
 
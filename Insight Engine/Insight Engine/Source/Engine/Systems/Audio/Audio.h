@@ -23,6 +23,7 @@
 /*includes */
 #include "Engine/ECS/System.h"
 #include "Engine/ECS/Component.h"
+#include "Engine/Systems/Asset/AssetRegistry.h"
 #include <fmod.hpp>
 
 namespace IS {
@@ -53,6 +54,7 @@ namespace IS {
         float volumeLevel=1;
         float pitch = 1;
         std::string soundName="";
+        SoundHandle sound{}; // cached lookup of soundName, resolved again if the name changes
         //we are going to use the formula
         //gain=1/distance+fall-off factor higher the falloff factor faster the sound disappears
 
@@ -0,0 +1,361 @@
+/*!
+ * \file Benchmark.cpp
+ * \author Tan Zheng Xun, t.zhengxun@digipen.edu
+ * \par Course: CSD2451
+ * \date 19-10-2026
+ * \brief
+ * This source file defines the BenchmarkManager class, which runs a scene, a
+ * replay or a synthetic stress workload for a fixed number of steps and writes
+ * the frame, system, allocation and entity statistics to a JSON report.
+ *
+ * \copyright
+ * All content (C) 2024 DigiPen Institute of Technology Singapore.
+ * All rights reserved.
+ * Reproduction or disclosure of this file or its contents without the prior written
+ * consent of DigiPen Institute of Technology is prohibited.
+ *____________________________________________________________________________*/
+
+ /*                                                                   includes
+ ----------------------------------------------------------------------------- */
+#include "Pch.h"
+#include "Benchmark.h"
+#include "Engine/Core/CoreEngine.h"
+#include "Engine/JSON/JsonSaveLoad.h"
+#include "Engine/Systems/Asset/Asset.h"
+#include "Engine/Systems/Replay/Replay.h"
+#include "Engine/Systems/Window/WindowSystem.h"
+#include "Engine/Systems/Particle/ParticleEmitter.h"
+#include "Scene/SceneManager.h"
+#include "Physics/System/Physics.h"
+#include "Physics/Dynamics/Body.h"
+#include "Physics/Collision/Collider.h"
+#include "Graphics/Core/Graphics.h"
+#include "Graphics/System/Camera3D.h"
+#include "Graphics/System/Light.h"
+#include "Math/Random.h"
+
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+#include <filesystem>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+
+namespace IS {
+
+    namespace {
+        // Whether the path ends with the extension
+        bool HasExtension(std::string const& path, std::string const& extension)
+        {
+            return std::filesystem::path(path).extension().string() == extension;
+        }
+    }
+
+    BenchmarkManager& BenchmarkManager::Instance()
+    {
+        static BenchmarkManager instance;
+        return instance;
+    }
+
+    void BenchmarkManager::QueueBenchmark(std::string const& workload, unsigned frames, std::string const& output)
+    {
+        mQueuedWorkload = workload;
+        mFrames = frames > 0 ? frames : DEFAULT_FRAMES;
+        mOutput = output;
+    }
+
+    void BenchmarkManager::BeginFrame()
+    {
+        auto& engine = InsightEngine::Instance();
+
+        if (!mQueuedWorkload.empty())
+        {
+            mWorkload = std::move(mQueuedWorkload);
+            mQueuedWorkload.clear();
+
+            // the benchmark only measures, nothing needs to be shown
+            engine.mRenderGUI = false;
+            if (GLFWwindow* window = engine.GetSystem<WindowSystem>("Window")->GetNativeWindow())
+                glfwHideWindow(window);
+            if (!Start())
+            {
+                engine.Exit();
+                return;
+            }
+        }
+
+        if (!mRunning)
+            return;
+
+        // the recording ran out before enough frames were measured
+        if (mReplay && !ReplayManager::Instance().IsReplaying())
+        {
+            Finish();
+            engine.currentNumberOfSteps = 0;
+            return;
+        }
+
+        // one fixed step per frame, whatever the previous frame cost
+        if (!mReplay)
+        {
+            engine.currentNumberOfSteps = 1;
+            engine.mDeltaTime = engine.mFixedDeltaTime;
+        }
+
+        if (mFrameIndex == WARMUP_FRAMES)
+        {
+            mEntitiesAtStart = mPeakEntities = engine.EntitiesAlive();
+            RenderDevice::Stats const& stats = ISGraphics::Device().stats();
+            mDrawsAtStart = stats.draws;
+            mInstancesAtStart = stats.instances;
+            mUploadedAtStart = stats.bytes_uploaded;
+            MemoryTracker::ResetPeaks();
+        }
+
+#ifdef IS_MEMORY_TRACKING
+        for (size_t i = 0; i <= MemoryTracker::TAG_COUNT; ++i)
+            mMemoryAtStart[i] = MemoryTracker::GetStats(static_cast<MemoryTag>(i));
+#endif
+        mFrameStart = glfwGetTime();
+    }
+
+    void BenchmarkManager::EndFrame()
+    {
+        if (!mRunning)
+            return;
+
+        auto& engine = InsightEngine::Instance();
+        double frame_end = glfwGetTime();
+
+        if (mFrameIndex++ < WARMUP_FRAMES)
+            return;
+
+        mFrameTimes.push_back(static_cast<float>((frame_end - mFrameStart) * 1000.0));
+        for (auto const& [name, delta] : engine.GetSystemDeltas())
+        {
+            if (name != "Engine")
+                mSystemTimes[name].push_back(delta * 1000.f);
+        }
+
+#ifdef IS_MEMORY_TRACKING
+        for (size_t i = 0; i <= MemoryTracker::TAG_COUNT; ++i)
+        {
+            MemoryTracker::Stats stats = MemoryTracker::GetStats(static_cast<MemoryTag>(i));
+            mAllocations[i].push_back(static_cast<float>(stats.mAllocations - mMemoryAtStart[i].mAllocations));
+            mAllocatedBytes[i].push_back(static_cast<float>(stats.mAllocatedBytes - mMemoryAtStart[i].mAllocatedBytes));
+        }
+#endif
+        mPeakEntities = std::max(mPeakEntities, engine.EntitiesAlive());
+
+        if (mFrameTimes.size() >= mFrames)
+            Finish();
+    }
+
+    bool BenchmarkManager::Start()
+    {
+        auto& engine = InsightEngine::Instance();
+        mReplay = HasExtension(mWorkload, ".isreplay");
+
+        if (mReplay)
+        {
+            // the replay loads its scene, seeds the PRNG and enters deterministic mode
+            if (!ReplayManager::Instance().StartReplay(mWorkload, false))
+                return false;
+        }
+        else
+        {
+            Physics::mDeterministic = true;
+            PRNG::Instance().seed(SEED);
+            engine.mRuntime = true;
+            Camera3D::mActiveCamera = CAMERA_TYPE_GAME;
+
+            if (size_t colon = mWorkload.find(':'); colon != std::string::npos)
+            {
+                int count = std::atoi(mWorkload.c_str() + colon + 1);
+                if (count <= 0 || !GenerateStress(mWorkload.substr(0, colon), count))
+                {
+                    IS_CORE_ERROR("Invalid benchmark workload {}, expected bodies:N, sprites:N, particles:N or lights:N", mWorkload);
+                    return false;
+                }
+            }
+            else
+            {
+                std::filesystem::path scene(mWorkload);
+                if (!std::filesystem::exists(scene))
+                    scene = std::filesystem::path(AssetManager::SCENE_DIRECTORY) / mWorkload;
+                if (!std::filesystem::exists(scene))
+                {
+                    IS_CORE_ERROR("Benchmark scene {} not found", mWorkload);
+                    return false;
+                }
+                SceneManager::Instance().LoadScene(scene.string());
+            }
+        }
+
+        mFrameIndex = 0;
+        mFrameTimes.clear();
+        mSystemTimes.clear();
+        mFrameTimes.reserve(mFrames);
+        for (size_t i = 0; i <= MemoryTracker::TAG_COUNT; ++i)
+        {
+            mAllocations[i].clear();
+            mAllocatedBytes[i].clear();
+            mAllocations[i].reserve(mFrames);
+            mAllocatedBytes[i].reserve(mFrames);
+        }
+        mRunning = true;
+
+        IS_CORE_INFO("Benchmarking {} for {} frames after {} warmup frames", mWorkload, mFrames, WARMUP_FRAMES);
+        return true;
+    }
+
+    bool BenchmarkManager::GenerateStress(std::string const& kind, int count)
+    {
+        if (kind != "bodies" && kind != "sprites" && kind != "particles" && kind != "lights")
+            return false;
+
+        auto& engine = InsightEngine::Instance();
+        PRNG& prng = PRNG::Instance();
+        SceneManager::Instance().NewScene("Benchmark");
+
+        if (kind == "particles")
+        {
+            // a particle lives mLifespan seconds, spawn enough per step to keep count alive
+            Entity entity = engine.GenerateRandomEntity();
+            ParticleEmitter emitter;
+            emitter.mParticle.mLifespan = 1.f;
+            emitter.mParticle.mVelocity = { 50.f, 50.f };
+            emitter.mParticlesAmount = std::max(1, static_cast<int>(std::lround(count * engine.mFixedDeltaTime / emitter.mParticle.mLifespan)));
+            engine.AddComponent<ParticleEmitter>(entity, emitter);
+            return true;
+        }
+
+        for (int i = 0; i < count; ++i)
+        {
+            Entity entity = engine.GenerateRandomEntity();
+            if (kind == "bodies")
+            {
+                engine.AddComponent<RigidBody>(entity, RigidBody());
+                engine.AddComponent<Collider>(entity, Collider());
+            }
+            else if (kind == "lights")
+            {
+                Vector3D hue{ prng.generate(), prng.generate(), prng.generate() };
+                engine.AddComponent<Light>(entity, Light({}, hue, 1.f, 100.f + prng.generate() * 300.f, true));
+            }
+        }
+        return true;
+    }
+
+    void BenchmarkManager::Finish()
+    {
+        auto& engine = InsightEngine::Instance();
+        mRunning = false;
+        if (mReplay)
+            ReplayManager::Instance().StopReplay();
+
+        size_t frames = mFrameTimes.size();
+        Json::Value report;
+        report["workload"] = mWorkload;
+        report["frames"] = static_cast<Json::UInt64>(frames);
+        report["fixed_dt"] = engine.mFixedDeltaTime;
+        report["seed"] = mReplay ? Json::Value() : Json::Value(SEED);
+        report["headless"] = engine.mHeadless;
+        report["frame_ms"] = Summarize(mFrameTimes);
+
+        Json::Value& systems = report["systems"];
+        systems = Json::Value(Json::objectValue);
+        for (auto& [name, samples] : mSystemTimes)
+            systems[name] = Summarize(samples);
+
+#ifdef IS_MEMORY_TRACKING
+        // the totals, then the tags that allocated while measuring, to find which system churns the heap
+        auto summarize_tag = [this](size_t tag) {
+            MemoryTracker::Stats stats = MemoryTracker::GetStats(static_cast<MemoryTag>(tag));
+            Json::Value summary;
+            summary["count"] = Summarize(mAllocations[tag]);
+            summary["bytes"] = Summarize(mAllocatedBytes[tag]);
+            summary["live_bytes"] = static_cast<Json::UInt64>(stats.mLiveBytes);
+            summary["peak_bytes"] = static_cast<Json::UInt64>(stats.mPeakBytes);
+            return summary;
+        };
+        Json::Value& allocations = report["allocations"];
+        allocations = summarize_tag(MemoryTracker::TAG_COUNT);
+        allocations["tags"] = Json::Value(Json::objectValue);
+        for (size_t i = 0; i < MemoryTracker::TAG_COUNT; ++i)
+        {
+            Samples const& counts = mAllocations[i];
+            if (std::any_of(counts.begin(), counts.end(), [](float count) { return count > 0.f; }))
+                allocations["tags"][MemoryTracker::GetTagName(static_cast<MemoryTag>(i))] = summarize_tag(i);
+        }
+#else
+        report["allocations"] = Json::Value();
+#endif
+
+        report["entities"]["start"] = mEntitiesAtStart;
+        report["entities"]["end"] = engine.EntitiesAlive();
+        report["entities"]["peak"] = mPeakEntities;
+
+        // only the null device counts its work, the OpenGL device only counts frames
+        if (frames > 0 && !ISGraphics::HasContext())
+        {
+            RenderDevice::Stats const& stats = ISGraphics::Device().stats();
+            report["render"]["draws"] = static_cast<double>(stats.draws - mDrawsAtStart) / frames;
+            report["render"]["instances"] = static_cast<double>(stats.instances - mInstancesAtStart) / frames;
+            report["render"]["bytes_uploaded"] = static_cast<double>(stats.bytes_uploaded - mUploadedAtStart) / frames;
+        }
+        else
+        {
+            report["render"] = Json::Value();
+        }
+
+        std::string output = mOutput;
+        if (output.empty())
+        {
+            std::time_t now = std::time(nullptr);
+            std::tm local{};
+#ifdef _WIN32
+            localtime_s(&local, &now);
+#else
+            localtime_r(&now, &local);
+#endif
+            std::string name = mWorkload;
+            std::replace(name.begin(), name.end(), ':', '_');
+            std::ostringstream filepath;
+            filepath << BENCHMARK_DIRECTORY << std::filesystem::path(name).stem().string()
+                     << std::put_time(&local, "_%Y%m%d_%H%M%S") << ".json";
+            output = filepath.str();
+        }
+        if (std::filesystem::path parent = std::filesystem::path(output).parent_path(); !parent.empty())
+            std::filesystem::create_directories(parent);
+
+        if (SaveJsonToFile(report, output))
+            IS_CORE_INFO("Benchmark of {} written to {} ({} frames, p50 {:.3f} ms)", mWorkload, output, frames, report["frame_ms"]["p50"].asFloat());
+        else
+            IS_CORE_ERROR("Failed to write benchmark report {}", output);
+
+        engine.Exit();
+    }
+
+    Json::Value BenchmarkManager::Summarize(Samples& samples)
+    {
+        Json::Value summary(Json::objectValue);
+        if (samples.empty())
+            return summary;
+
+        // nearest rank percentiles
+        std::sort(samples.begin(), samples.end());
+        auto percentile = [&samples](double p) {
+            size_t rank = static_cast<size_t>(std::ceil(p * samples.size()));
+            return samples[std::clamp<size_t>(rank, 1, samples.size()) - 1];
+        };
+        summary["p50"] = percentile(.50);
+        summary["p95"] = percentile(.95);
+        summary["p99"] = percentile(.99);
+        summary["mean"] = std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+        summary["max"] = samples.back();
+        return summary;
+    }
+
+} // end namespace IS
@@ -0,0 +1,161 @@
+/*!
+ * \file Benchmark.h
+ * \author Tan Zheng Xun, t.zhengxun@digipen.edu
+ * \par Course: CSD2451
+ * \date 19-10-2026
+ * \brief
+ * This header file declares the BenchmarkManager class, which runs a scene, a
+ * replay or a synthetic stress workload for a fixed number of steps and writes
+ * the frame, system, allocation and entity statistics to a JSON report.
+ *
+ * \copyright
+ * All content (C) 2024 DigiPen Institute of Technology Singapore.
+ * All rights reserved.
+ * Reproduction or disclosure of this file or its contents without the prior written
+ * consent of DigiPen Institute of Technology is prohibited.
+ *____________________________________________________________________________*/
+
+ /*                                                                   guard
+ ----------------------------------------------------------------------------- */
+#ifndef GAM200_INSIGHT_ENGINE_ENGINE_SYSTEMS_BENCHMARK_H
+#define GAM200_INSIGHT_ENGINE_ENGINE_SYSTEMS_BENCHMARK_H
+
+ /*                                                                   includes
+ ----------------------------------------------------------------------------- */
+#include "Debug/Utils/MemoryTracker.h"
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Json { class Value; }
+
+namespace IS {
+
+    /*!
+     * \brief Runs reproducible workloads and reports their cost.
+     *
+     * Launching with "-benchmark <workload>" runs one of:
+     *   - a scene, "CaveLevel.insight" or a path to a scene file,
+     *   - a replay, "<file>.isreplay", which supplies the scene and scripted input,
+     *   - a stress workload, "bodies:N", "sprites:N", "particles:N" or "lights:N",
+     *     built on an empty scene from GenerateRandomEntity.
+     * Physics runs in deterministic mode with a fixed seed and one fixed step per
+     * frame (a replay keeps its recorded steps), frames are not capped, and the first
+     * WARMUP_FRAMES frames are not measured. Once "-frames N" frames were measured
+     * (or the replay ended) the report is written and the engine quits. Combine with
+     * "-headless" to measure the simulation without a window.
+     *
+     * Report layout:
+     *   { workload, frames, fixed_dt, seed, headless,
+     *     frame_ms: { p50, p95, p99, mean, max },
+     *     systems: { <name>: { p50, p95, p99, mean, max } },
+     *     allocations: { count: {...}, bytes: {...}, live_bytes, peak_bytes,
+     *                    tags: { <tag>: { count, bytes, live_bytes, peak_bytes } } } per frame,
+     *                  or null in builds without IS_MEMORY_TRACKING, peaks are since the warmup,
+     *     entities: { start, end, peak },
+     *     render: { draws, instances, bytes_uploaded } per frame }
+     */
+    class BenchmarkManager {
+    public:
+        static constexpr const char* BENCHMARK_DIRECTORY = "Assets/Benchmarks/"; ///< Default directory of the reports.
+        static constexpr unsigned DEFAULT_FRAMES = 600;                         ///< Frames measured unless "-frames" is given.
+        static constexpr unsigned WARMUP_FRAMES = 30;                           ///< Frames run before measuring.
+        static constexpr uint32_t SEED = 0x15B3u;                               ///< Seed of the PRNG for every workload.
+
+        /*!
+         * \brief Gets the singleton instance of the benchmark manager.
+         *
+         * \return Reference to the benchmark manager.
+         */
+        static BenchmarkManager& Instance();
+
+        /*!
+         * \brief Queues a workload to start on the first frame, used when launching with "-benchmark".
+         *
+         * \param workload Scene, replay or stress workload to run.
+         * \param frames Number of frames to measure.
+         * \param output Path of the report, empty to write it to the benchmark directory.
+         */
+        void QueueBenchmark(std::string const& workload, unsigned frames, std::string const& output);
+
+        /*!
+         * \brief Called at the start of InsightEngine::Update, after the replay manager.
+         *
+         * Starts a queued workload and forces the fixed step of the frame.
+         */
+        void BeginFrame();
+
+        /*!
+         * \brief Called at the end of InsightEngine::Update, once the systems ran.
+         *
+         * Records the frame and finishes the benchmark once enough frames were measured.
+         */
+        void EndFrame();
+
+        bool IsRunning() const { return mRunning; }
+
+    private:
+        /*!
+         * \brief Times of a measured quantity, one per frame.
+         */
+        using Samples = std::vector<float>;
+
+        BenchmarkManager() = default;
+
+        /*!
+         * \brief Loads the workload and enters deterministic mode.
+         *
+         * \return True if the workload could be loaded, false otherwise.
+         */
+        bool Start();
+
+        /*!
+         * \brief Creates the entities of a stress workload in a new scene.
+         *
+         * \param kind "bodies", "sprites", "particles" or "lights".
+         * \param count Number of bodies, sprites, live particles or lights.
+         * \return True if the kind is known, false otherwise.
+         */
+        bool GenerateStress(std::string const& kind, int count);
+
+        /*!
+         * \brief Writes the report and quits the engine.
+         */
+        void Finish();
+
+        /*!
+         * \brief Summarizes samples into percentiles, mean and max.
+         *
+         * \param samples The samples, reordered by the call.
+         * \return JSON object of the summary.
+         */
+        static Json::Value Summarize(Samples& samples);
+
+        bool mRunning{};
+        std::string mWorkload;
+        std::string mQueuedWorkload;
+        std::string mOutput;
+        unsigned mFrames{};                 ///< Frames to measure.
+        unsigned mFrameIndex{};             ///< Frames run so far, warmup included.
+        bool mReplay{};                     ///< Whether the workload is a replay.
+        double mFrameStart{};
+
+        Samples mFrameTimes;                ///< Frame time in milliseconds.
+        std::unordered_map<std::string, Samples> mSystemTimes; ///< Update and draw time of each system in milliseconds.
+        using TagSamples = std::array<Samples, MemoryTracker::TAG_COUNT + 1>;
+        TagSamples mAllocations;            ///< Allocations made during each frame per memory tag, totals last.
+        TagSamples mAllocatedBytes;         ///< Bytes allocated during each frame per memory tag, totals last.
+        std::array<MemoryTracker::Stats, MemoryTracker::TAG_COUNT + 1> mMemoryAtStart{}; ///< Counters at the start of the frame.
+        uint32_t mEntitiesAtStart{};
+        uint32_t mPeakEntities{};
+        uint64_t mDrawsAtStart{};
+        uint64_t mInstancesAtStart{};
+        uint64_t mUploadedAtStart{};
+    };
+
+} // end namespace IS
+
+#endif // !GAM200_INSIGHT_ENGINE_ENGINE_SYSTEMS_BENCHMARK_H
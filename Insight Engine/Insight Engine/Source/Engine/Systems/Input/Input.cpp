@@ -25,6 +25,7 @@
 #include "Graphics/Core/Graphics.h"
 #include "Scene/SceneManager.h"
 #include "Editor/Utils/FileUtils.h"
+#include "Engine/Systems/Replay/Replay.h"
 
 
 namespace IS {
@@ -34,6 +35,10 @@ namespace IS {
 
     static void controllerCallBack(int jid, int event1)
     {
+        // the replay decides whether a controller is connected
+        if (ReplayManager::Instance().IsReplaying()) {
+            return;
+        }
         if (jid != GLFW_JOYSTICK_1) {
             INPUT_MANAGER->mControllerConnected = false;
             return;
@@ -46,17 +51,22 @@ namespace IS {
         Subscribe(MessageType::DebugInfo);
 
         GLFWwindow* native_window = mWindow->GetNativeWindow();
+        glfwSetJoystickCallback(controllerCallBack);
+
+        // headless runs have no window to take events from
+        if (!native_window)
+            return;
+
         glfwSetWindowUserPointer(native_window, this); // Set InputManager as user pointer
         glfwSetKeyCallback(native_window, KeyCallback);
-        glfwSetJoystickCallback(controllerCallBack);
         glfwSetMouseButtonCallback(native_window, MouseButtonCallback);
 
         // Mouse scroll callback
         glfwSetScrollCallback(native_window, [](GLFWwindow* window, double xoffset, double yoffset)
         {
             InputManager& input = *(static_cast<InputManager*>(glfwGetWindowUserPointer(window)));
-            input.mMouseScrollXOffset = xoffset;
-            input.mMouseScrollYOffset = yoffset;
+            if (ReplayManager::Instance().OnScroll(xoffset, yoffset))
+                input.InjectScroll(xoffset, yoffset);
         });
 
         // Window size callback
@@ -131,12 +141,14 @@ namespace IS {
         // Important comments. Do not delete.
         if (mControllerConnected) {
 
-            if (glfwJoystickPresent(GLFW_JOYSTICK_1)) {
-                if (glfwJoystickIsGamepad(GLFW_JOYSTICK_1)) { //>+O
+            // replays carry their own gamepad state
+            const bool replaying = ReplayManager::Instance().IsReplaying();
+            if (replaying || glfwJoystickPresent(GLFW_JOYSTICK_1)) {
+                if (replaying || glfwJoystickIsGamepad(GLFW_JOYSTICK_1)) { //>+O
                     //record key inputs                         -|
                     GLFWgamepadstate a;
                     
-                    if (glfwGetGamepadState(GLFW_JOYSTICK_1, &a)) {
+                    if (ReplayManager::Instance().PollGamepad(a)) {
                         for (int i = 0; i < GLFW_JOYSTICK_LAST; i++)
                         {
                             if (a.buttons[i] == GLFW_PRESS) {                        // --------  |
@@ -296,7 +308,7 @@ namespace IS {
             FileUtils::FileMakeCopy(relative_filepath, directory);
             oss << directory << "/" << filepath.filename().string();
             std::string new_filepath = oss.str();
-            asset->WorkerLoadImageData(new_filepath);
+            asset->StreamImage(new_filepath);
         }
         else if (extension == ".MP3" || extension == ".WAV" || extension == ".wav" || extension == ".mp3") // Audio
         {
@@ -339,34 +351,48 @@ namespace IS {
 #endif
     }
 
-    void InputManager::KeyCallback(GLFWwindow* window, int key, [[maybe_unused]] int scancode, int action, [[maybe_unused]] int mods) {
-        InputManager* inputManager = static_cast<InputManager*>(glfwGetWindowUserPointer(window));
+    void InputManager::InjectKey(int key, int action) {
         if (action == GLFW_PRESS) {
-            inputManager->mPressedKeys.insert(key);
-            inputManager->mReleasedKeys.erase(key);
-            inputManager->mKeyPressTime[key] = glfwGetTime();
+            mPressedKeys.insert(key);
+            mReleasedKeys.erase(key);
+            mKeyPressTime[key] = glfwGetTime();
         }
         if (action == GLFW_RELEASE) {
-            inputManager->mPressedKeys.erase(key);
-            inputManager->mReleasedKeys.insert(key);
-            inputManager->mHeldKeys.erase(key); // Remove from held_keys when released
+            mPressedKeys.erase(key);
+            mReleasedKeys.insert(key);
+            mHeldKeys.erase(key); // Remove from held_keys when released
         }
-        
     }
 
-    void InputManager::MouseButtonCallback(GLFWwindow* window, int button, int action, [[maybe_unused]] int mods) {
-        InputManager* inputManager = static_cast<InputManager*>(glfwGetWindowUserPointer(window));
+    void InputManager::InjectMouseButton(int button, int action) {
         if (action == GLFW_PRESS) {
-            inputManager->mPressedMouseButtons.insert(button);
-            inputManager->mReleasedMouseButtons.erase(button);
+            mPressedMouseButtons.insert(button);
+            mReleasedMouseButtons.erase(button);
         }
         if (action == GLFW_RELEASE) {
-            inputManager->mPressedMouseButtons.erase(button);
-            inputManager->mReleasedMouseButtons.insert(button);
-            inputManager->mHeldMouseButtons.erase(button); // Remove from held_mouse_buttons when released
+            mPressedMouseButtons.erase(button);
+            mReleasedMouseButtons.insert(button);
+            mHeldMouseButtons.erase(button); // Remove from held_mouse_buttons when released
         }
     }
 
+    void InputManager::InjectScroll(double xoffset, double yoffset) {
+        mMouseScrollXOffset = xoffset;
+        mMouseScrollYOffset = yoffset;
+    }
+
+    void InputManager::KeyCallback(GLFWwindow* window, int key, [[maybe_unused]] int scancode, int action, [[maybe_unused]] int mods) {
+        InputManager* inputManager = static_cast<InputManager*>(glfwGetWindowUserPointer(window));
+        if (ReplayManager::Instance().OnInputEvent(ReplayEvent::KEY, key, action))
+            inputManager->InjectKey(key, action);
+    }
+
+    void InputManager::MouseButtonCallback(GLFWwindow* window, int button, int action, [[maybe_unused]] int mods) {
+        InputManager* inputManager = static_cast<InputManager*>(glfwGetWindowUserPointer(window));
+        if (ReplayManager::Instance().OnInputEvent(ReplayEvent::MOUSE_BUTTON, button, action))
+            inputManager->InjectMouseButton(button, action);
+    }
+
     void InputManager::FileDropCallback(GLFWwindow* window, int count, const char** paths)
     {
         InputManager* input = static_cast<InputManager*>(glfwGetWindowUserPointer(window));
@@ -153,6 +153,21 @@ namespace IS {
          */
         bool IsMouseButtonHeld(int button) const;
 
+        /**
+         * \brief Applies a key event, from the GLFW callback or from a replay.
+         */
+        void InjectKey(int key, int action);
+
+        /**
+         * \brief Applies a mouse button event, from the GLFW callback or from a replay.
+         */
+        void InjectMouseButton(int button, int action);
+
+        /**
+         * \brief Applies a mouse scroll event, from the GLFW callback or from a replay.
+         */
+        void InjectScroll(double xoffset, double yoffset);
+
         /**
          * \brief Sets the center world position for the mouse relative to the GLFW window
          */
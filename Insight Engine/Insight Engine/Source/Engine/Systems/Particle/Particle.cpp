@@ -20,13 +20,177 @@
 #include "Engine/Systems/Asset/Asset.h"
 #include "Graphics/System/Animation.h"
 #include "Graphics/System/Sprite.h"
+#include "Graphics/System/ParticleBatch.h"
 #include "../Graphics/System/Transform.h"
 #include "../Graphics/System/Light.h"
 #include "Graphics/Core/Graphics.h"
 
+#include <xmmintrin.h>
+
 namespace IS {
     Animation run_anim;
 
+    namespace {
+        /*!
+         * \brief Writes the keys of a curve as "time value, time value", with 1 or 3 values a key.
+         */
+        void SerializeCurve(std::ostringstream& out, char const* label, ParticleCurve const& curve, int components) {
+            if (!curve.IsActive()) {
+                return;
+            }
+            out << label << ": ";
+            for (int i = 0; i < curve.mKeyCount; ++i) {
+                ParticleCurve::Key const& key = curve.mKeys[i];
+                out << (i ? ", " : "") << key.mTime;
+                for (int c = 0; c < components; ++c) {
+                    out << " " << key.mValue[c];
+                }
+            }
+            out << "\n";
+        }
+
+        /*!
+         * \brief Reads the keys written by SerializeCurve().
+         */
+        void DeserializeCurve(std::string const& text, ParticleCurve& curve, int components) {
+            std::istringstream keys(text);
+            std::string key_text;
+            while (std::getline(keys, key_text, ',')) {
+                std::istringstream key(key_text);
+                float time{};
+                glm::vec4 value{ 1.f };
+                if (!(key >> time)) {
+                    continue;
+                }
+                for (int c = 0; c < components; ++c) {
+                    key >> value[c];
+                }
+                if (components == 1) {
+                    value = glm::vec4(value.x);
+                }
+                curve.AddKey(time, value);
+            }
+            curve.Bake();
+        }
+    }
+
+    void ParticleCurve::AddKey(float time, glm::vec4 const& value) {
+        if (mKeyCount >= MAX_KEYS) {
+            return;
+        }
+        time = std::clamp(time, 0.f, 1.f);
+        int index = mKeyCount++;
+        for (; index > 0 && mKeys[index - 1].mTime > time; --index) {
+            mKeys[index] = mKeys[index - 1];
+        }
+        mKeys[index] = { time, value };
+    }
+
+    void ParticleCurve::Bake() {
+        if (!IsActive()) {
+            mLUT.fill(glm::vec4(1.f));
+            return;
+        }
+
+        int key = 0;
+        for (int i = 0; i < LUT_SIZE; ++i) {
+            float age = static_cast<float>(i) / (LUT_SIZE - 1);
+            while (key + 1 < mKeyCount && mKeys[key + 1].mTime <= age) {
+                ++key;
+            }
+
+            // hold the first and last keys outside their range
+            Key const& from = mKeys[key];
+            if (key + 1 == mKeyCount || age <= from.mTime) {
+                mLUT[i] = from.mValue;
+                continue;
+            }
+            Key const& to = mKeys[key + 1];
+            float t = (age - from.mTime) / (to.mTime - from.mTime);
+            mLUT[i] = glm::mix(from.mValue, to.mValue, t);
+        }
+    }
+
+    std::string Particle::Serialize() const {
+        std::ostringstream out;
+        out << "Velocity: " << mVelocity.x << ", " << mVelocity.y << "\n"
+            << "Size Growth: " << mSizeGrowth << "\n"
+            << "Scale: " << mScale.x << ", " << mScale.y << "\n"
+            << "Lifespan: " << mLifespan << "\n"
+            << "Color:\n" << mColor.Serialize()
+            << "Alpha: " << mAlpha << "\n"
+            << "Alpha Growth: " << mAlphaGrowth << "\n"
+            << "Rotation: " << mRotation << "\n"
+            << "Direction: " << mDirection << "\n"
+            << "Particle Type: " << mParticleType << "\n"
+            << "Image Name: " << mImageName << "\n"
+            << "Particle Position: " << mParticlePos.x << ", " << mParticlePos.y << "\n"
+            << "Total Cols: " << mTotalCols << "\n"
+            << "Total Rows: " << mTotalRows << "\n"
+            << "Layer: " << mLayer << "\n"
+            << "Gravity: " << mGravity << "\n";
+        if (mCurves) {
+            SerializeCurve(out, "Size Curve", mCurves->mSize, 1);
+            SerializeCurve(out, "Alpha Curve", mCurves->mAlpha, 1);
+            SerializeCurve(out, "Color Curve", mCurves->mColor, 3);
+        }
+        return out.str();
+    }
+
+    Particle Particle::Deserialize(const std::string& data) {
+        std::istringstream in(data);
+        std::string line;
+        Particle particle;
+        ParticleCurves curves;
+        int color_lines = 0; // the lines after "Color:" are its components
+
+        while (std::getline(in, line)) {
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            size_t colon = line.find(':');
+            if (colon == std::string::npos) {
+                continue;
+            }
+            std::string label = line.substr(0, colon);
+            std::istringstream value(line.substr(colon + 1));
+            char comma{};
+
+            if (color_lines > 0) {
+                --color_lines;
+                if (label == "Red") { value >> particle.mColor.R; continue; }
+                if (label == "Green") { value >> particle.mColor.G; continue; }
+                if (label == "Blue") { value >> particle.mColor.B; continue; }
+                if (label == "Alpha") { value >> particle.mColor.A; continue; }
+            }
+
+            if (label == "Velocity") { value >> particle.mVelocity.x >> comma >> particle.mVelocity.y; }
+            else if (label == "Size Growth") { value >> particle.mSizeGrowth; }
+            else if (label == "Scale") { value >> particle.mScale.x >> comma >> particle.mScale.y; }
+            else if (label == "Lifespan") { value >> particle.mLifespan; }
+            else if (label == "Color") { color_lines = 4; }
+            else if (label == "Alpha") { value >> particle.mAlpha; }
+            else if (label == "Alpha Growth") { value >> particle.mAlphaGrowth; }
+            else if (label == "Rotation") { value >> particle.mRotation; }
+            else if (label == "Direction") { value >> particle.mDirection; }
+            else if (label == "Particle Type") { value >> particle.mParticleType; }
+            else if (label == "Image Name") { std::getline(value >> std::ws, particle.mImageName); }
+            else if (label == "Particle Position") { value >> particle.mParticlePos.x >> comma >> particle.mParticlePos.y; }
+            else if (label == "Total Cols") { value >> particle.mTotalCols; }
+            else if (label == "Total Rows") { value >> particle.mTotalRows; }
+            else if (label == "Layer") { value >> particle.mLayer; }
+            else if (label == "Gravity") { int gravity{}; value >> gravity; particle.mGravity = gravity != 0; }
+            else if (label == "Size Curve") { DeserializeCurve(value.str(), curves.mSize, 1); }
+            else if (label == "Alpha Curve") { DeserializeCurve(value.str(), curves.mAlpha, 1); }
+            else if (label == "Color Curve") { DeserializeCurve(value.str(), curves.mColor, 3); }
+        }
+
+        if (curves.IsActive()) {
+            particle.mCurves = std::make_shared<ParticleCurves const>(curves);
+        }
+        return particle;
+    }
+
     std::string ParticleSystem::GetName() {
         return "Particle";
     }
@@ -40,128 +204,299 @@ namespace IS {
 
     void ParticleSystem::Update(float deltaTime) {
         auto& engine = InsightEngine::Instance();
-        auto asset = engine.GetSystem<AssetManager>("Asset");
 
+        // every affector is a constant rate, so all the steps of a frame integrate at once
+        Integrate(deltaTime * static_cast<float>(engine.GetCurrentNumberOfSteps()));
+        Compact();
+        ApplyCurves();
+        ApplyEffects(deltaTime);
+        Draw(deltaTime);
 
-            for (int id = 0; id < mParticleAmount; id++) {
-                //particles death
-                if (mParticleList[id].mLifespan <= 0) {
-                    DeleteParticle(id);
-                    continue;
-                }
+        for (auto const& emitters : mEntities) {
+            auto& emitter = engine.GetComponent<ParticleEmitter>(emitters);
+            for (int i = 0; i < emitter.mParticlesAmount; i++) {
+                SpawnParticles(emitter.mParticle);
+            }
+        }
+    }
 
-                if (mParticleList[id].mAlpha <= 0) {
-                    DeleteParticle(id);
-                    continue;
-                }
+    void ParticleSystem::SpawnParticles(Particle const& particles) {
+        if (mParticleAmount >= MAX_PARTICLES) {
+            return;
+        }
 
+        int id = mParticleAmount++;
+        mPosX[id] = particles.mParticlePos.x;
+        mPosY[id] = particles.mParticlePos.y;
+        mScaleX[id] = particles.mScale.x;
+        mScaleY[id] = particles.mScale.y;
+        mSizeGrowth[id] = particles.mSizeGrowth;
+        mAlpha[id] = particles.mAlpha;
+        mAlphaGrowth[id] = particles.mAlphaGrowth;
+        mLifespan[id] = particles.mLifespan;
+        mRotation[id] = particles.mRotation;
 
-                // particle types
-                switch (mParticleList[id].mParticleType)
-                {
-                case pt_square:
-                    Sprite::draw_colored_quad(mParticleList[id].mParticlePos, mParticleList[id].mRotation, mParticleList[id].mScale, { mParticleList[id].mColor.R, mParticleList[id].mColor.G ,mParticleList[id].mColor.B ,mParticleList[id].mColor.A },mParticleList[id].mLayer);
-                    break;
+        ParticleAttributes& attributes = mAttributes[id];
+        attributes.mColor = particles.mColor;
+        attributes.mSpeed = particles.mVelocity;
+        attributes.mDirection = particles.mDirection;
+        attributes.mRotationSpeed = particles.mRotationSpeed;
+        attributes.mEffectTimer = particles.mParticleEffectTimer;
+        attributes.mEffectTimerSet = particles.mParticleEffectTimerSet;
+        attributes.mImage = particles.mImage;
+        attributes.mParticleType = particles.mParticleType;
+        attributes.mLayer = particles.mLayer;
+        attributes.mColIndex = particles.mColIndex;
+        attributes.mRowIndex = particles.mRowIndex;
+        attributes.mTotalCols = particles.mTotalCols;
+        attributes.mTotalRows = particles.mTotalRows;
+        attributes.mEffect = particles.mEffect;
+        attributes.mGravity = particles.mGravity;
+        UpdateVelocity(id);
 
-                case pt_circle:
-                    for (int i = 0; i < 8; i++) {
-                        Sprite::draw_colored_quad(mParticleList[id].mParticlePos, mParticleList[id].mRotation + (i * 45), mParticleList[id].mScale, { mParticleList[id].mColor.R, mParticleList[id].mColor.G ,mParticleList[id].mColor.B ,mParticleList[id].mColor.A }, mParticleList[id].mLayer);
-                    }
+        // curves replace the growth rates of what they drive
+        attributes.mPreset = {};
+        if (ParticleCurves const* curves = particles.mCurves.get(); curves && particles.mPreset.IsValid()) {
+            attributes.mPreset = particles.mPreset;
+            attributes.mBaseColor = particles.mColor;
+            attributes.mBaseScale = particles.mScale;
+            attributes.mBaseAlpha = particles.mAlpha;
+            attributes.mInverseLifespan = particles.mLifespan > 0.f ? 1.f / particles.mLifespan : 0.f;
+            if (curves->mSize.IsActive()) {
+                mSizeGrowth[id] = 0.f;
+            }
+            if (curves->mAlpha.IsActive()) {
+                mAlphaGrowth[id] = 0.f;
+            }
+        }
+    }
 
-                    break;
+    void ParticleSystem::UpdateVelocity(int id) {
+        ParticleAttributes const& attributes = mAttributes[id];
+        Vector2D velocity = attributes.mSpeed * DirectionToVector2D(attributes.mDirection);
+        mVelX[id] = velocity.x;
+        mVelY[id] = velocity.y - 98.f * static_cast<float>(attributes.mGravity);
+    }
 
-                case pt_texture:
-                    Sprite::draw_textured_quad_colour(mParticleList[id].mParticlePos, mParticleList[id].mRotation, mParticleList[id].mScale, *asset->GetImage(mParticleList[id].mImageName), mParticleList[id].mAlpha, mParticleList[id].mLayer, std::tuple<float,float,float>(mParticleList[id].mColor.R, mParticleList[id].mColor.G, mParticleList[id].mColor.B));
-                    break;
+    void ParticleSystem::Integrate(float dt) {
+        if (dt == 0.f) {
+            return;
+        }
 
-                case pt_texture_frames:
-                    //Sprite::draw_textured_quad(mParticleList[id].mParticlePos, mParticleList[id].mRotation, mParticleList[id].mScale,*asset->GetImage(mParticleList[id].mImageName), mParticleList[id].mAlpha);
-                    Sprite::drawSpritesheetFrame(mParticleList[id].mRowIndex, mParticleList[id].mColIndex, mParticleList[id].mTotalRows, mParticleList[id].mTotalCols, mParticleList[id].mParticlePos, mParticleList[id].mRotation, mParticleList[id].mScale, *asset->GetImage(mParticleList[id].mImageName), mParticleList[id].mAlpha, mParticleList[id].mLayer);
-                    break;
+        // slots past mParticleAmount are scratch, so round up instead of handling a tail
+        int count = (mParticleAmount + 3) & ~3;
+        __m128 step = _mm_set1_ps(dt);
+        auto advance = [step](float* value, float const* rate) {
+            _mm_storeu_ps(value, _mm_add_ps(_mm_loadu_ps(value), _mm_mul_ps(_mm_loadu_ps(rate), step)));
+        };
+
+        for (int id = 0; id < count; id += 4) {
+            _mm_storeu_ps(&mLifespan[id], _mm_sub_ps(_mm_loadu_ps(&mLifespan[id]), step));
+            advance(&mPosX[id], &mVelX[id]);
+            advance(&mPosY[id], &mVelY[id]);
+            advance(&mScaleX[id], &mSizeGrowth[id]);
+            advance(&mScaleY[id], &mSizeGrowth[id]);
+            advance(&mAlpha[id], &mAlphaGrowth[id]);
+        }
+    }
+
+    void ParticleSystem::Compact() {
+        int alive = 0;
+        for (int id = 0; id < mParticleAmount; id++) {
+            //particles death
+            if (mLifespan[id] <= 0.f || mAlpha[id] <= 0.f) {
+                continue;
+            }
+            if (alive != id) {
+                MoveParticle(id, alive);
+            }
+            alive++;
+        }
+        mParticleAmount = alive;
+    }
+
+    void ParticleSystem::MoveParticle(int from, int to) {
+        mPosX[to] = mPosX[from];
+        mPosY[to] = mPosY[from];
+        mVelX[to] = mVelX[from];
+        mVelY[to] = mVelY[from];
+        mScaleX[to] = mScaleX[from];
+        mScaleY[to] = mScaleY[from];
+        mSizeGrowth[to] = mSizeGrowth[from];
+        mAlpha[to] = mAlpha[from];
+        mAlphaGrowth[to] = mAlphaGrowth[from];
+        mLifespan[to] = mLifespan[from];
+        mRotation[to] = mRotation[from];
+        mAttributes[to] = mAttributes[from];
+    }
+
+    void ParticleSystem::ApplyCurves() {
+        auto asset = InsightEngine::Instance().GetSystem<AssetManager>("Asset");
+
+        // particles of a preset are usually spawned together, so remember the last lookup
+        ParticleHandle last_preset{};
+        ParticleCurves const* curves = nullptr;
+
+        for (int id = 0; id < mParticleAmount; id++) {
+            ParticleAttributes& attributes = mAttributes[id];
+            if (!attributes.mPreset.IsValid()) {
+                continue;
+            }
+            if (!(attributes.mPreset == last_preset)) {
+                last_preset = attributes.mPreset;
+                Particle const* preset = asset->mParticleList.Get(last_preset);
+                curves = preset ? preset->mCurves.get() : nullptr;
+            }
+            if (!curves) {
+                continue;
+            }
+
+            float age = 1.f - mLifespan[id] * attributes.mInverseLifespan;
+            if (curves->mSize.IsActive()) {
+                float size = curves->mSize.Sample(age).x;
+                mScaleX[id] = attributes.mBaseScale.x * size;
+                mScaleY[id] = attributes.mBaseScale.y * size;
+            }
+            if (curves->mAlpha.IsActive()) {
+                // squares draw with the color alpha, so both follow the curve
+                float alpha = curves->mAlpha.Sample(age).x;
+                mAlpha[id] = attributes.mBaseAlpha * alpha;
+                attributes.mColor.A = attributes.mBaseColor.A * alpha;
+            }
+            if (curves->mColor.IsActive()) {
+                glm::vec4 const& color = curves->mColor.Sample(age);
+                attributes.mColor.R = attributes.mBaseColor.R * color.x;
+                attributes.mColor.G = attributes.mBaseColor.G * color.y;
+                attributes.mColor.B = attributes.mBaseColor.B * color.z;
+            }
+        }
+    }
 
-                case pt_anim:
-                    auto system = InsightEngine::Instance().GetSystem<AssetManager>("Asset");
-                    Image* img = system->GetImage(mParticleList[id].mImageName);
-                    run_anim.drawNonEntityAnimation(deltaTime, mParticleList[id].mParticlePos, mParticleList[id].mRotation, mParticleList[id].mScale, *img, 1.f, mParticleList[id].mLayer);
+    void ParticleSystem::ApplyEffects(float dt) {
+        for (int id = 0; id < mParticleAmount; id++) {
+            ParticleAttributes& attributes = mAttributes[id];
+
+            //particle effect
+            switch (attributes.mEffect) {
+                case effect_normal:
                     break;
+
+                case effect_swing:
+                attributes.mEffectTimer -= dt;
+                if (attributes.mEffectTimer <= 0.f) {
+                    if (attributes.mDirection > 180 && attributes.mDirection < 270) {
+                        attributes.mDirection += 70;
+                    }
+                    else if (attributes.mDirection > 270 && attributes.mDirection < 360) {
+                        attributes.mDirection -= 70;
+                    }
+                    UpdateVelocity(id);
+                    mRotation[id] += 180;
+                    attributes.mEffectTimer = attributes.mEffectTimerSet;
                 }
-                for (int step = 0; step < InsightEngine::Instance().GetCurrentNumberOfSteps(); ++step)
-                {
-                    //affectors
-                    mParticleList[id].mLifespan -= deltaTime;
-                    mParticleList[id].mParticlePos += mParticleList[id].mVelocity * deltaTime * DirectionToVector2D(mParticleList[id].mDirection);
-                    mParticleList[id].mScale.x += mParticleList[id].mSizeGrowth * deltaTime;
-                    mParticleList[id].mScale.y += mParticleList[id].mSizeGrowth * deltaTime;
-                    mParticleList[id].mAlpha += mParticleList[id].mAlphaGrowth * deltaTime;
-                    mParticleList[id].mParticlePos.y -= 98.f * deltaTime * static_cast<int>(mParticleList[id].mGravity);
-                }
+                    break;
 
-                //particle effect
-                switch (mParticleList[id].mEffect) {
-                    case effect_normal:
-                        break;
+                case effect_spin:
+                    mRotation[id] += attributes.mRotationSpeed;
+                    break;
 
-                    case effect_swing:
-                    mParticleList[id].mParticleEffectTimer -= deltaTime;
-                    if (mParticleList[id].mParticleEffectTimer <= 0.f) {
-                        if (mParticleList[id].mDirection > 180 && mParticleList[id].mDirection < 270) {
-                            mParticleList[id].mDirection += 70;
+                case effect_animate:
+                    attributes.mEffectTimer -= dt;
+                    if (attributes.mEffectTimer <= 0.f) {
+                        if (attributes.mColIndex < attributes.mTotalCols-1) {
+                            attributes.mColIndex++;
                         }
-                        else if (mParticleList[id].mDirection > 270 && mParticleList[id].mDirection < 360) {
-                            mParticleList[id].mDirection -= 70;
+                        else {
+                            attributes.mColIndex = 0;
                         }
-                        mParticleList[id].mRotation += 180;
-                        mParticleList[id].mParticleEffectTimer= mParticleList[id].mParticleEffectTimerSet;
+
+                        attributes.mEffectTimer = attributes.mEffectTimerSet;
                     }
-                        break;
-
-                    case effect_spin:
-                        mParticleList[id].mRotation += mParticleList[id].mRotationSpeed;
-                        break;
-
-                    case effect_animate:
-                        mParticleList[id].mParticleEffectTimer -= deltaTime;
-                        if (mParticleList[id].mParticleEffectTimer <= 0.f) {
-                            if (mParticleList[id].mColIndex < mParticleList[id].mTotalCols-1) {
-                                mParticleList[id].mColIndex++;
-                            }
-                            else {
-                                mParticleList[id].mColIndex = 0;
-                            }
-
-                            mParticleList[id].mParticleEffectTimer = mParticleList[id].mParticleEffectTimerSet;
-                        }
-                        break;
+                    break;
+
+                case effect_light: 
+                    Sprite::instanceData lightData;
+                    Vector2D position(mPosX[id], mPosY[id]);
+
+                    lightData.color = { attributes.mColor.R, attributes.mColor.G, attributes.mColor.B, attributes.mColor.A };
+
+                    Transform lightXform(position, 0.f, { mScaleX[id], mScaleY[id] });
+                    lightData.setTransform(lightXform);
+                    lightData.entID = 2; // no idea what its supposed to do
 
-                    case effect_light: 
-                        Sprite::instanceData lightData;
+                    Light::lightPos.emplace_back(position.x, position.y);
+                    Light::lightClr.emplace_back(lightData.color);
+                    ISGraphics::lightInstances.emplace_back(lightData);
+                    ISGraphics::lightRadius.emplace_back(mScaleX[id]);
+                    break;
+            }
+        }
+    }
+
+    void ParticleSystem::Draw(float dt) {
+        auto asset = InsightEngine::Instance().GetSystem<AssetManager>("Asset");
+        ParticleBatch& batch = ISGraphics::particleInstances;
+
+        // the animated particles share one animation, advanced once per step
+        for (int step = 0; step < InsightEngine::Instance().GetCurrentNumberOfSteps(); ++step) {
+            run_anim.updateAnimation(dt);
+        }
 
-                        lightData.color = { mParticleList[id].mColor.R, mParticleList[id].mColor.G, mParticleList[id].mColor.B, mParticleList[id].mColor.A };
+        for (int id = 0; id < mParticleAmount; id++) {
+            ParticleAttributes const& attributes = mAttributes[id];
+            Color const& color = attributes.mColor;
 
-                        Transform lightXform(mParticleList[id].mParticlePos, 0.f, mParticleList[id].mScale);
-                        lightData.model_to_ndc_xform = lightXform.Return3DXformMatrix();
-                        lightData.entID = 2; // no idea what its supposed to do
+            ParticleInstance instance;
+            instance.position = { mPosX[id], mPosY[id] };
+            instance.size = { mScaleX[id], mScaleY[id] };
+            instance.rotation = mRotation[id];
 
-                        Light::lightPos.emplace_back(mParticleList[id].mParticlePos.x, mParticleList[id].mParticlePos.y);
-                        Light::lightClr.emplace_back(lightData.color);
-                        ISGraphics::lightInstances.emplace_back(lightData);
-                        ISGraphics::lightRadius.emplace_back(mParticleList[id].mScale.x);
-                        break;
-                    
+            // particle types
+            switch (attributes.mParticleType)
+            {
+            case pt_square:
+                instance.color = { color.R, color.G, color.B, color.A };
+                batch.push_back(instance, attributes.mLayer);
+                break;
 
+            case pt_circle:
+                instance.color = { color.R, color.G, color.B, color.A };
+                for (int i = 0; i < 8; i++) {
+                    instance.rotation = mRotation[id] + (i * 45);
+                    batch.push_back(instance, attributes.mLayer);
                 }
+                break;
 
+            case pt_texture:
+                if (Image* img = asset->GetImage(attributes.mImage)) {
+                    instance.color = { color.R, color.G, color.B, mAlpha[id] };
+                    instance.setTexture(img->texture_index);
+                    batch.push_back(instance, attributes.mLayer);
+                }
+                break;
 
-                
-            }
+            case pt_texture_frames:
+                if (attributes.mRowIndex < 0 || attributes.mRowIndex >= attributes.mTotalRows ||
+                    attributes.mColIndex < 0 || attributes.mColIndex >= attributes.mTotalCols) {
+                    break;
+                }
+                if (Image* img = asset->GetImage(attributes.mImage)) {
+                    instance.color = { 1.f, 1.f, 1.f, mAlpha[id] };
+                    instance.setTexture(img->texture_index, { 1.f / attributes.mTotalCols, 1.f / attributes.mTotalRows },
+                                        { attributes.mColIndex, attributes.mRowIndex });
+                    batch.push_back(instance, attributes.mLayer);
+                }
+                break;
 
-            for (auto const& emitters : mEntities) {
-                auto& emitter = engine.GetComponent<ParticleEmitter>(emitters);
-                for (int i = 0; i < emitter.mParticlesAmount; i++) {
-                    SpawnParticles(emitter.mParticle);
+            case pt_anim:
+                if (Image* img = asset->GetImage(attributes.mImage)) {
+                    instance.setTexture(img->texture_index, run_anim.frame_dimension, run_anim.frame_index);
+                    batch.push_back(instance, attributes.mLayer);
                 }
+                break;
             }
         }
+    }
 
     void ParticleSystem::HandleMessage(const Message& message) {
         if (message.GetType() == MessageType::DebugInfo) {
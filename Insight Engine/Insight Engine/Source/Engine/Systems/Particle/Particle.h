@@ -21,8 +21,11 @@
 /*                                                                   includes
 ----------------------------------------------------------------------------- */
 #include "Engine/ECS/System.h"
+#include "Engine/Systems/Asset/AssetRegistry.h"
 #include <array>
 #include <fstream>
+#include <memory>
+#include <glm/glm.hpp>
 #include <sstream>
 #define MAX_PARTICLES 50000
 
@@ -123,6 +126,63 @@ namespace IS {
 		}
 	};
 
+	/*!
+	 * \struct ParticleCurve
+	 * \brief Keyframed multiplier over the life of a particle.
+	 *
+	 * The keys are linearly interpolated once into a lookup table when the preset is
+	 * loaded, particles then sample the table by their age.
+	 */
+	struct ParticleCurve {
+		static constexpr int MAX_KEYS = 8;
+		static constexpr int LUT_SIZE = 64;
+
+		struct Key {
+			float mTime = 0.f;					// 0 at spawn, 1 at death
+			glm::vec4 mValue{ 1.f };
+		};
+
+		int mKeyCount = 0;
+		std::array<Key, MAX_KEYS> mKeys{};		// sorted by time
+		std::array<glm::vec4, LUT_SIZE> mLUT{};
+
+		bool IsActive() const { return mKeyCount > 0; }
+
+		/*!
+		 * \brief Adds a key, keeping the keys sorted. Keys past MAX_KEYS are ignored.
+		 * \param time The age of the key, clamped to [0, 1].
+		 * \param value The multiplier at that age.
+		 */
+		void AddKey(float time, glm::vec4 const& value);
+
+		/*!
+		 * \brief Fills the lookup table from the keys.
+		 */
+		void Bake();
+
+		/*!
+		 * \brief Samples the lookup table.
+		 * \param age The age of the particle, 0 at spawn and 1 at death.
+		 * \return The multiplier.
+		 */
+		glm::vec4 const& Sample(float age) const {
+			int index = static_cast<int>(age * (LUT_SIZE - 1) + .5f);
+			return mLUT[std::clamp(index, 0, LUT_SIZE - 1)];
+		}
+	};
+
+	/*!
+	 * \struct ParticleCurves
+	 * \brief Curves of a preset, each scales the value the particle spawned with.
+	 */
+	struct ParticleCurves {
+		ParticleCurve mSize;	// x scales the size
+		ParticleCurve mAlpha;	// x scales the alpha
+		ParticleCurve mColor;	// xyz scale the color
+
+		bool IsActive() const { return mSize.IsActive() || mAlpha.IsActive() || mColor.IsActive(); }
+	};
+
 	/*!
 	 * \struct Particle
 	 * \brief Represents a particle with various attributes.
@@ -140,6 +200,9 @@ namespace IS {
 		float mDirection = 0.f;
 		int mParticleType = pt_square;
 		std::string mImageName = "";
+		ImageHandle mImage{}; // resolved from mImageName when the particle is loaded
+		ParticleHandle mPreset{}; // the preset this particle was made from, if any
+		std::shared_ptr<ParticleCurves const> mCurves; // shared by the copies of a preset
 		int mLayer = 1;
 		bool mGravity=false;
 		int mColIndex = 0;
@@ -202,112 +265,55 @@ namespace IS {
 			return part;
 		}
 
-		// Serialize Particle object to a string with labels
-		std::string Serialize() const {
-			std::ostringstream out;
-			out << "Velocity: " << mVelocity.x << ", " << mVelocity.y << "\n"
-				<< "Size Growth: " << mSizeGrowth << "\n"
-				<< "Scale: " << mScale.x << ", " << mScale.y << "\n"
-				<< "Lifespan: " << mLifespan << "\n"
-				<< "Color:\n" << mColor.Serialize()
-				<< "Alpha: " << mAlpha << "\n"
-				<< "Alpha Growth: " << mAlphaGrowth << "\n"
-				<< "Rotation: " << mRotation << "\n"
-				<< "Direction: " << mDirection << "\n"
-				<< "Particle Type: " << mParticleType << "\n"
-				<< "Image Name: " << mImageName << "\n"
-				<< "Particle Position: " << mParticlePos.x << ", " << mParticlePos.y << "\n"
-				<< "Total Cols: " << mTotalCols << "\n"
-				<< "Total Rows: " << mTotalRows << "\n"
-				<< "Layer: " << mLayer << "\n"
-				<< "Gravity: " << mLayer << "\n";
-				return out.str();
-		}
-
-
-		// Deserialize a string to a Particle object
-		static Particle Deserialize(const std::string& data) {
-			std::istringstream in(data);
-			std::string label;
-			Particle particle;
-
-			// Deserialize velocity
-			std::getline(in, label, ':'); in >> particle.mVelocity.x;
-			in.ignore(2); // Ignore the comma and space
-			in >> particle.mVelocity.y;
-			std::getline(in, label); // Finish the line
-
-			// Deserialize size growth
-			std::getline(in, label, ':'); in >> particle.mSizeGrowth;
-			std::getline(in, label);
-
-			// Deserialize scale
-			std::getline(in, label, ':'); in >> particle.mScale.x;
-			in.ignore(2); // Ignore the comma and space
-			in >> particle.mScale.y;
-			std::getline(in, label);
-
-			// Deserialize lifespan
-			std::getline(in, label, ':'); in >> particle.mLifespan;
-			std::getline(in, label);
-
-			// Deserialize color
-			std::getline(in, label); // Skip "Color" line
-			std::string colorData;
-			for (int i = 0; i < 4; ++i) { // Assuming 4 lines for R, G, B, A
-				std::getline(in, label);
-				colorData += label + "\n";
-			}
-			particle.mColor = Color::Deserialize(colorData);
-
-			// Deserialize alpha
-			std::getline(in, label, ':'); in >> particle.mAlpha;
-			std::getline(in, label);
-
-			// Deserialize alpha growth
-			std::getline(in, label, ':'); in >> particle.mAlphaGrowth;
-			std::getline(in, label);
-
-			// Deserialize rotation
-			std::getline(in, label, ':'); in >> particle.mRotation;
-			std::getline(in, label);
-
-			// Deserialize direction
-			std::getline(in, label, ':'); in >> particle.mDirection;
-			std::getline(in, label);
-
-			// Deserialize particle type
-			std::getline(in, label, ':'); in >> particle.mParticleType;
-			std::getline(in, label);
+		/*!
+		 * \brief Writes the particle as labelled text, the format presets are kept in.
+		 * \return The text.
+		 */
+		std::string Serialize() const;
 
-			// Deserialize image name
-			std::getline(in, label, ':');
-			std::getline(in, particle.mImageName);
-			if (particle.mImageName.size() > 1) { // Check if the image name is not empty
-				particle.mImageName = particle.mImageName.substr(1); // Remove leading space
-			}
+		/*!
+		 * \brief Reads a particle from labelled text. Lines are matched by label, so
+		 * missing or reordered lines keep their defaults.
+		 * \param data The text.
+		 * \return The particle.
+		 */
+		static Particle Deserialize(const std::string& data);
+	};
 
-			// Deserialize particle position
-			std::getline(in, label, ':'); in >> particle.mParticlePos.x;
-			in.ignore(2); // Ignore the comma and space
-			in >> particle.mParticlePos.y;
-
-			// Deserialize the rows and cols for animation
-			std::getline(in, label, ':'); in >> particle.mTotalCols;
-			std::getline(in, label);
-			std::getline(in, label, ':'); in >> particle.mTotalRows;			
-			std::getline(in, label);
-			std::getline(in, label, ':'); in >> particle.mLayer;			
-			std::getline(in, label);
-			std::getline(in, label, ':'); in >> particle.mGravity;
-
-			return particle;
-		}
+	/*!
+	 * \struct ParticleAttributes
+	 * \brief Per particle state that is only read by effects and drawing.
+	 */
+	struct ParticleAttributes {
+		Color mColor = color_white;
+		Vec2D mSpeed = { 0.f,0.f };   // speed along the direction, kept to rebuild the velocity
+		float mDirection = 0.f;
+		float mRotationSpeed = 0.f;
+		float mEffectTimer = 0.f;
+		float mEffectTimerSet = 2.f;
+		ImageHandle mImage{};
+		ParticleHandle mPreset{};     // curves are looked up through the preset, so reloads apply
+		Color mBaseColor = color_white; // values at spawn, scaled by the curves
+		Vec2D mBaseScale = { 1.f,1.f };
+		float mBaseAlpha = 1.f;
+		float mInverseLifespan = 1.f;
+		int mParticleType = pt_square;
+		int mLayer = 1;
+		int mColIndex = 0;
+		int mRowIndex = 0;
+		int mTotalCols = 0;
+		int mTotalRows = 0;
+		Particle_Effect mEffect = effect_normal;
+		bool mGravity = false;
 	};
 
 	/*!
 	 * \class ParticleSystem
 	 * \brief Manages particle effects and behaviors.
+	 *
+	 * Live particles are packed at the front of a structure of arrays. The values
+	 * integrated every step each have their own array so they can be updated four
+	 * at a time, everything else sits in ParticleAttributes.
 	 */
     class ParticleSystem : public ParentSystem {
     public:
@@ -323,14 +329,7 @@ namespace IS {
 		 * \brief Spawns particles in the system.
 		 * \param particles Particle object to be spawned.
 		 */
-		void SpawnParticles(Particle particles) {
-			if (mParticleAmount >= MAX_PARTICLES) {
-				return;
-			}
-			
-			mParticleList[mParticleAmount] = particles;
-			mParticleAmount++;
-		}
+		void SpawnParticles(Particle const& particles);
 		
 		/*!
 		 * \brief Generates a random floating-point number between min and max.
@@ -358,13 +357,13 @@ namespace IS {
 		}
 
 		/*!
-		 * \brief Deletes a particle from the system by its ID.
+		 * \brief Deletes a particle from the system by its ID, the last live particle
+		 * takes its ID.
 		 * \param id ID of the particle to be deleted.
 		 */
 		void DeleteParticle(int id) {
-			mParticleList[id] = mParticleList[mParticleAmount];
+			MoveParticle(mParticleAmount - 1, id);
 			mParticleAmount--;
-
 		}
 
 		/*!
@@ -372,10 +371,67 @@ namespace IS {
 		 */
 		void ClearParticles() { mParticleAmount = 0; };
 
+		int GetParticleAmount() const { return mParticleAmount; }
 
     private:
+		/*!
+		 * \brief Advances every particle by a time step, four particles at a time.
+		 * \param dt The time step.
+		 */
+		void Integrate(float dt);
+
+		/*!
+		 * \brief Removes dead particles in one pass, keeping the live ones in order.
+		 */
+		void Compact();
+
+		/*!
+		 * \brief Sets the size, alpha and color of particles from preset curves.
+		 */
+		void ApplyCurves();
+
+		/*!
+		 * \brief Applies the particle effects.
+		 * \param dt The frame time.
+		 */
+		void ApplyEffects(float dt);
+
+		/*!
+		 * \brief Draws the particles.
+		 * \param dt The frame time.
+		 */
+		void Draw(float dt);
+
+		/*!
+		 * \brief Recomputes the velocity of a particle from its speed and direction.
+		 * \param id ID of the particle.
+		 */
+		void UpdateVelocity(int id);
+
+		/*!
+		 * \brief Copies a particle into another slot.
+		 * \param from ID of the particle to copy.
+		 * \param to ID of the slot to copy into.
+		 */
+		void MoveParticle(int from, int to);
+
+		static_assert(MAX_PARTICLES % 4 == 0, "Particle arrays are integrated four at a time");
+
+		using ParticleArray = std::array<float, MAX_PARTICLES>;
+
 		int mParticleAmount=0;
-		std::array<Particle,MAX_PARTICLES> mParticleList; //fixed array of particles
+		ParticleArray mPosX{};
+		ParticleArray mPosY{};
+		ParticleArray mVelX{};      // world units per second, gravity included
+		ParticleArray mVelY{};
+		ParticleArray mScaleX{};
+		ParticleArray mScaleY{};
+		ParticleArray mSizeGrowth{};
+		ParticleArray mAlpha{};
+		ParticleArray mAlphaGrowth{};
+		ParticleArray mLifespan{};
+		ParticleArray mRotation{};
+		std::array<ParticleAttributes, MAX_PARTICLES> mAttributes;
 
     };
 
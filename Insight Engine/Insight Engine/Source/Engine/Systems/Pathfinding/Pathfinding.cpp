@@ -19,6 +19,7 @@
 #include "Pathfinding.h"
 #include "Engine/Core/CoreEngine.h"
 #include "Graphics/System/Transform.h"
+#include "Physics/Collision/StaticGeometry.h"
 
 namespace IS {
     static int i = 0;
@@ -83,7 +84,7 @@ namespace IS {
 
                     if (!path.empty()) {
                         Vector2D nextGoal = path.front()->mPosition - trans.getWorldPosition();
-                        trans.world_position += nextGoal * deltaTime *2;
+                        trans.Move(nextGoal * deltaTime * 2);
                     }
                 }
             }
@@ -201,6 +202,10 @@ namespace IS {
 
     void Pathfinding::AddWaypoint(const Waypoint& waypoint) {
         mWaypoints.emplace_back(waypoint);
+        // waypoints inside baked level geometry cannot be reached
+        if (StaticGeometry::Instance().IsPointBlocked(waypoint.mPosition)) {
+            mWaypoints.back().mIsObstacle = true;
+        }
     }
 
     void Pathfinding::ConnectWaypoints(Waypoint& waypoint1, Waypoint& waypoint2) {
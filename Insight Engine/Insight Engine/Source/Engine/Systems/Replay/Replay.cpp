@@ -0,0 +1,512 @@
+/*!
+ * \file Replay.cpp
+ * \author Tan Zheng Xun, t.zhengxun@digipen.edu
+ * \par Course: CSD2451
+ * \date 19-10-2026
+ * \brief
+ * This source file defines the ReplayManager class, which records the inputs,
+ * step counts and random seed of a play session into a compact binary log and
+ * re-simulates the session deterministically from that log.
+ *
+ * \copyright
+ * All content (C) 2024 DigiPen Institute of Technology Singapore.
+ * All rights reserved.
+ * Reproduction or disclosure of this file or its contents without the prior written
+ * consent of DigiPen Institute of Technology is prohibited.
+ *____________________________________________________________________________*/
+
+ /*                                                                   includes
+ ----------------------------------------------------------------------------- */
+#include "Pch.h"
+#include "Replay.h"
+#include "Engine/Core/CoreEngine.h"
+#include "Engine/Systems/Asset/Asset.h"
+#include "Engine/Systems/Input/Input.h"
+#include "Engine/Systems/Window/WindowSystem.h"
+#include "Scene/SceneManager.h"
+#include "Physics/System/Physics.h"
+#include "Physics/Dynamics/Body.h"
+#include "Graphics/System/Transform.h"
+#include "Graphics/System/Camera3D.h"
+#include "Math/Random.h"
+
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace IS {
+
+    namespace {
+        // Flags of a frame record
+        enum FrameFlags : uint8_t {
+            FRAME_MOUSE    = 1 << 0,
+            FRAME_SCROLL   = 1 << 1,
+            FRAME_GAMEPAD  = 1 << 2,
+            FRAME_CHECKSUM = 1 << 3
+        };
+
+        constexpr char REPLAY_MAGIC[4] = { 'I', 'S', 'R', 'P' };
+
+        template <typename T>
+        void Write(std::vector<uint8_t>& buffer, T const& value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            size_t offset = buffer.size();
+            buffer.resize(offset + sizeof(T));
+            std::memcpy(buffer.data() + offset, &value, sizeof(T));
+        }
+
+        template <typename T>
+        bool Read(std::vector<uint8_t> const& buffer, size_t& cursor, T& value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            if (cursor + sizeof(T) > buffer.size())
+                return false;
+            std::memcpy(&value, buffer.data() + cursor, sizeof(T));
+            cursor += sizeof(T);
+            return true;
+        }
+
+        // FNV-1a over raw bytes
+        void HashBytes(uint64_t& hash, void const* data, size_t size)
+        {
+            auto bytes = static_cast<uint8_t const*>(data);
+            for (size_t i = 0; i < size; ++i)
+            {
+                hash ^= bytes[i];
+                hash *= 1099511628211ull;
+            }
+        }
+    }
+
+    ReplayManager& ReplayManager::Instance()
+    {
+        static ReplayManager instance;
+        return instance;
+    }
+
+    void ReplayManager::StartRecording()
+    {
+        if (mState != ReplayState::None)
+            return;
+
+        auto& scene_manager = SceneManager::Instance();
+        if (scene_manager.GetSceneCount() == 0)
+        {
+            IS_CORE_WARN("Cannot record without a scene loaded!");
+            return;
+        }
+
+        // the session always starts from the saved scene
+        mScenePath = std::string(AssetManager::SCENE_DIRECTORY) + scene_manager.GetActiveSceneName() + ".insight";
+        scene_manager.LoadScene(mScenePath);
+        mSeed = std::random_device{}();
+
+        mBuffer.clear();
+        mBuffer.reserve(64 * 1024);
+        mBuffer.insert(mBuffer.end(), std::begin(REPLAY_MAGIC), std::end(REPLAY_MAGIC));
+        Write(mBuffer, REPLAY_VERSION);
+        Write(mBuffer, mSeed);
+        Write(mBuffer, InsightEngine::Instance().mFixedDeltaTime);
+        Write(mBuffer, static_cast<uint16_t>(mScenePath.size()));
+        mBuffer.insert(mBuffer.end(), mScenePath.begin(), mScenePath.end());
+        mFrameCountOffset = mBuffer.size();
+        Write(mBuffer, uint32_t{});
+
+        mPendingEvents.clear();
+        mPendingScroll = false;
+        mFrameOpen = false;
+        mFrameIndex = mFrameCount = 0;
+        mLastMouseX = mLastMouseY = std::numeric_limits<float>::quiet_NaN();
+
+        EnterDeterministicMode();
+        mState = ReplayState::Recording;
+        IS_CORE_INFO("Recording session of {} (seed {})", mScenePath, mSeed);
+    }
+
+    std::string ReplayManager::StopRecording()
+    {
+        if (mState != ReplayState::Recording)
+            return {};
+
+        if (mFrameOpen)
+            WriteFrame(mFrame);
+        mFrameOpen = false;
+        mState = ReplayState::None;
+        LeaveDeterministicMode();
+
+        uint32_t frame_count = mFrameCount;
+        std::memcpy(mBuffer.data() + mFrameCountOffset, &frame_count, sizeof(frame_count));
+
+        // name the log after the scene and the time it was saved
+        std::time_t now = std::time(nullptr);
+        std::tm local_time{};
+#ifdef _WIN32
+        localtime_s(&local_time, &now);
+#else
+        localtime_r(&now, &local_time);
+#endif
+        std::ostringstream filepath;
+        filepath << REPLAY_DIRECTORY << std::filesystem::path(mScenePath).stem().string()
+                 << std::put_time(&local_time, "_%Y%m%d_%H%M%S") << REPLAY_EXTENSION;
+
+        std::filesystem::create_directories(REPLAY_DIRECTORY);
+        std::ofstream file(filepath.str(), std::ios::binary);
+        if (!file)
+        {
+            IS_CORE_ERROR("Failed to save replay {}", filepath.str());
+            return {};
+        }
+        file.write(reinterpret_cast<char const*>(mBuffer.data()), static_cast<std::streamsize>(mBuffer.size()));
+
+        IS_CORE_INFO("Saved replay {} ({} frames, {} bytes)", filepath.str(), mFrameCount, mBuffer.size());
+        mBuffer.clear();
+        return filepath.str();
+    }
+
+    bool ReplayManager::StartReplay(std::string const& filepath, bool exit_on_finish)
+    {
+        if (mState != ReplayState::None)
+            return false;
+
+        std::ifstream file(filepath, std::ios::binary);
+        if (!file)
+        {
+            IS_CORE_ERROR("Failed to open replay {}", filepath);
+            return false;
+        }
+        mBuffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+        // validate the header
+        mCursor = 0;
+        char magic[4]{};
+        uint16_t version{}, path_length{};
+        double fixed_dt{};
+        uint32_t frame_count{};
+        bool valid = mBuffer.size() >= sizeof(magic);
+        if (valid)
+        {
+            std::memcpy(magic, mBuffer.data(), sizeof(magic));
+            mCursor = sizeof(magic);
+            valid = std::equal(std::begin(magic), std::end(magic), std::begin(REPLAY_MAGIC))
+                 && Read(mBuffer, mCursor, version) && version == REPLAY_VERSION
+                 && Read(mBuffer, mCursor, mSeed) && Read(mBuffer, mCursor, fixed_dt)
+                 && Read(mBuffer, mCursor, path_length) && mCursor + path_length <= mBuffer.size();
+        }
+        if (valid)
+        {
+            mScenePath.assign(reinterpret_cast<char const*>(mBuffer.data() + mCursor), path_length);
+            mCursor += path_length;
+            valid = Read(mBuffer, mCursor, frame_count);
+        }
+        if (!valid)
+        {
+            IS_CORE_ERROR("Invalid replay file {}", filepath);
+            mBuffer.clear();
+            return false;
+        }
+
+        auto& engine = InsightEngine::Instance();
+        if (fixed_dt != engine.mFixedDeltaTime)
+            IS_CORE_WARN("Replay was recorded with a fixed delta time of {}, using it instead of {}", fixed_dt, engine.mFixedDeltaTime);
+        engine.mFixedDeltaTime = fixed_dt;
+
+        SceneManager::Instance().LoadScene(mScenePath);
+
+        mFrameCount = frame_count;
+        mFrameIndex = 0;
+        mMismatchFrame = -1;
+        mFrameOpen = false;
+        mExitOnFinish = exit_on_finish;
+        mReplayStartTime = glfwGetTime();
+
+        EnterDeterministicMode();
+        mState = ReplayState::Replaying;
+        IS_CORE_INFO("Replaying {} ({} frames, seed {})", filepath, mFrameCount, mSeed);
+        return true;
+    }
+
+    void ReplayManager::QueueReplay(std::string const& filepath)
+    {
+        mQueuedReplay = filepath;
+    }
+
+    void ReplayManager::StopReplay()
+    {
+        if (mState != ReplayState::Replaying)
+            return;
+
+        mState = ReplayState::None;
+        mFrameOpen = false;
+        LeaveDeterministicMode();
+        mBuffer.clear();
+
+        double elapsed = glfwGetTime() - mReplayStartTime;
+        IS_CORE_INFO("Replay finished: {} of {} frames in {:.3f}s ({:.1f} frames/s)",
+                     mFrameIndex, mFrameCount, elapsed, elapsed > 0.0 ? mFrameIndex / elapsed : 0.0);
+        if (mMismatchFrame >= 0)
+            IS_CORE_ERROR("Replay diverged from the recording at frame {}", mMismatchFrame);
+        else
+            IS_CORE_INFO("Replay matched the recording");
+
+        if (mExitOnFinish)
+            InsightEngine::Instance().Exit();
+    }
+
+    void ReplayManager::BeginFrame()
+    {
+        if (!mQueuedReplay.empty())
+        {
+            std::string filepath = std::move(mQueuedReplay);
+            mQueuedReplay.clear();
+
+            // the replay runner only simulates, nothing needs to be shown
+            auto& engine = InsightEngine::Instance();
+            engine.mRenderGUI = false;
+            if (GLFWwindow* window = engine.GetSystem<WindowSystem>("Window")->GetNativeWindow())
+                glfwHideWindow(window);
+            if (!StartReplay(filepath, true))
+                engine.Exit();
+        }
+
+        auto& engine = InsightEngine::Instance();
+
+        if (mState == ReplayState::Recording)
+        {
+            if (mFrameOpen)
+                WriteFrame(mFrame);
+
+            mFrame = ReplayFrame{};
+            mFrame.mSteps = static_cast<uint8_t>(engine.GetCurrentNumberOfSteps());
+            mFrame.mDeltaTime = static_cast<float>(engine.mDeltaTime);
+            mFrame.mEvents.swap(mPendingEvents);
+            mPendingEvents.clear();
+
+            std::pair<float, float> ndc = Transform::GetMouseNDC();
+            if (ndc.first != mLastMouseX || ndc.second != mLastMouseY)
+            {
+                mFrame.mHasMouse = true;
+                mFrame.mMouseX = mLastMouseX = ndc.first;
+                mFrame.mMouseY = mLastMouseY = ndc.second;
+            }
+            if (mPendingScroll)
+            {
+                mFrame.mHasScroll = true;
+                mFrame.mScrollX = mPendingScrollX;
+                mFrame.mScrollY = mPendingScrollY;
+                mPendingScroll = false;
+            }
+            if (mFrameIndex % CHECKSUM_INTERVAL == 0)
+            {
+                mFrame.mHasChecksum = true;
+                mFrame.mChecksum = ComputeChecksum();
+            }
+
+            mFrameOpen = true;
+            ++mFrameIndex;
+            ++mFrameCount;
+        }
+        else if (mState == ReplayState::Replaying)
+        {
+            // keep the mouse position of the previous frame unless the log moves it
+            float mouse_x = mFrame.mMouseX, mouse_y = mFrame.mMouseY;
+            mFrame = ReplayFrame{};
+            mFrame.mMouseX = mouse_x;
+            mFrame.mMouseY = mouse_y;
+
+            if (mFrameIndex >= mFrameCount || !ReadFrame(mFrame))
+            {
+                StopReplay();
+                return;
+            }
+
+            if (mFrame.mHasChecksum && mMismatchFrame < 0 && mFrame.mChecksum != ComputeChecksum())
+            {
+                mMismatchFrame = static_cast<int>(mFrameIndex);
+                IS_CORE_WARN("Replay state checksum mismatch at frame {}", mFrameIndex);
+            }
+
+            engine.currentNumberOfSteps = mFrame.mSteps;
+            engine.mDeltaTime = mFrame.mDeltaTime;
+
+            auto input = engine.GetSystem<InputManager>("Input");
+            for (ReplayEvent const& event : mFrame.mEvents)
+            {
+                if (event.mType == ReplayEvent::KEY)
+                    input->InjectKey(event.mCode, event.mAction);
+                else
+                    input->InjectMouseButton(event.mCode, event.mAction);
+            }
+            if (mFrame.mHasScroll)
+                input->InjectScroll(mFrame.mScrollX, mFrame.mScrollY);
+            input->mControllerConnected = mFrame.mHasGamepad;
+
+            ++mFrameIndex;
+        }
+    }
+
+    bool ReplayManager::OnInputEvent(ReplayEvent::Type type, int code, int action)
+    {
+        if (mState == ReplayState::Replaying)
+            return false;
+
+        // key repeats do not change the input state
+        if (mState == ReplayState::Recording && (action == GLFW_PRESS || action == GLFW_RELEASE))
+            mPendingEvents.push_back({ static_cast<uint8_t>(type), static_cast<uint8_t>(action), static_cast<int16_t>(code) });
+        return true;
+    }
+
+    bool ReplayManager::OnScroll(double xoffset, double yoffset)
+    {
+        if (mState == ReplayState::Replaying)
+            return false;
+
+        if (mState == ReplayState::Recording)
+        {
+            mPendingScroll = true;
+            mPendingScrollX = static_cast<float>(xoffset);
+            mPendingScrollY = static_cast<float>(yoffset);
+        }
+        return true;
+    }
+
+    bool ReplayManager::PollGamepad(GLFWgamepadstate& state)
+    {
+        if (mState == ReplayState::Replaying)
+        {
+            if (mFrame.mHasGamepad)
+            {
+                for (int i = 0; i <= GLFW_GAMEPAD_BUTTON_LAST; ++i)
+                    state.buttons[i] = (mFrame.mGamepadButtons & (1 << i)) ? GLFW_PRESS : GLFW_RELEASE;
+                for (int i = 0; i <= GLFW_GAMEPAD_AXIS_LAST; ++i)
+                    state.axes[i] = mFrame.mGamepadAxes[i];
+            }
+            return mFrame.mHasGamepad;
+        }
+
+        bool polled = glfwGetGamepadState(GLFW_JOYSTICK_1, &state) == GLFW_TRUE;
+
+        if (mState == ReplayState::Recording && polled && mFrameOpen)
+        {
+            // pack the buttons into a bitmask, the axes are stored as they are
+            mFrame.mHasGamepad = true;
+            mFrame.mGamepadButtons = 0;
+            for (int i = 0; i <= GLFW_GAMEPAD_BUTTON_LAST; ++i)
+                if (state.buttons[i] == GLFW_PRESS)
+                    mFrame.mGamepadButtons |= static_cast<uint16_t>(1 << i);
+            for (int i = 0; i <= GLFW_GAMEPAD_AXIS_LAST; ++i)
+                mFrame.mGamepadAxes[i] = state.axes[i];
+        }
+        return polled;
+    }
+
+    bool ReplayManager::GetReplayMouseNDC(float& x, float& y) const
+    {
+        if (mState != ReplayState::Replaying)
+            return false;
+
+        x = mFrame.mMouseX;
+        y = mFrame.mMouseY;
+        return true;
+    }
+
+    uint64_t ReplayManager::ComputeChecksum() const
+    {
+        auto& engine = InsightEngine::Instance();
+        uint64_t hash = 14695981039346656037ull;
+
+        // the physics entity set is ordered, so the hash does not depend on hash map order
+        for (Entity entity : engine.GetSystem<Physics>("Physics")->mEntities)
+        {
+            auto const& trans = engine.GetComponent<Transform>(entity);
+            auto const& body = engine.GetComponent<RigidBody>(entity);
+            float values[] = { trans.world_position.x, trans.world_position.y, trans.rotation,
+                               body.mVelocity.x, body.mVelocity.y, body.mAngularVelocity };
+            HashBytes(hash, &entity, sizeof(entity));
+            HashBytes(hash, values, sizeof(values));
+        }
+        return hash;
+    }
+
+    void ReplayManager::WriteFrame(ReplayFrame const& frame)
+    {
+        uint8_t flags = static_cast<uint8_t>((frame.mHasMouse ? FRAME_MOUSE : 0) | (frame.mHasScroll ? FRAME_SCROLL : 0)
+                      | (frame.mHasGamepad ? FRAME_GAMEPAD : 0) | (frame.mHasChecksum ? FRAME_CHECKSUM : 0));
+        Write(mBuffer, flags);
+        Write(mBuffer, frame.mSteps);
+        Write(mBuffer, frame.mDeltaTime);
+        Write(mBuffer, static_cast<uint16_t>(frame.mEvents.size()));
+        for (ReplayEvent const& event : frame.mEvents)
+            Write(mBuffer, event);
+        if (frame.mHasMouse)
+        {
+            Write(mBuffer, frame.mMouseX);
+            Write(mBuffer, frame.mMouseY);
+        }
+        if (frame.mHasScroll)
+        {
+            Write(mBuffer, frame.mScrollX);
+            Write(mBuffer, frame.mScrollY);
+        }
+        if (frame.mHasGamepad)
+        {
+            Write(mBuffer, frame.mGamepadButtons);
+            Write(mBuffer, frame.mGamepadAxes);
+        }
+        if (frame.mHasChecksum)
+            Write(mBuffer, frame.mChecksum);
+    }
+
+    bool ReplayManager::ReadFrame(ReplayFrame& frame)
+    {
+        uint8_t flags{};
+        uint16_t event_count{};
+        if (!Read(mBuffer, mCursor, flags) || !Read(mBuffer, mCursor, frame.mSteps) ||
+            !Read(mBuffer, mCursor, frame.mDeltaTime) || !Read(mBuffer, mCursor, event_count))
+            return false;
+
+        frame.mEvents.resize(event_count);
+        for (ReplayEvent& event : frame.mEvents)
+            if (!Read(mBuffer, mCursor, event))
+                return false;
+
+        frame.mHasMouse = (flags & FRAME_MOUSE) != 0;
+        if (frame.mHasMouse && !(Read(mBuffer, mCursor, frame.mMouseX) && Read(mBuffer, mCursor, frame.mMouseY)))
+            return false;
+
+        frame.mHasScroll = (flags & FRAME_SCROLL) != 0;
+        if (frame.mHasScroll && !(Read(mBuffer, mCursor, frame.mScrollX) && Read(mBuffer, mCursor, frame.mScrollY)))
+            return false;
+
+        frame.mHasGamepad = (flags & FRAME_GAMEPAD) != 0;
+        if (frame.mHasGamepad && !(Read(mBuffer, mCursor, frame.mGamepadButtons) && Read(mBuffer, mCursor, frame.mGamepadAxes)))
+            return false;
+
+        frame.mHasChecksum = (flags & FRAME_CHECKSUM) != 0;
+        if (frame.mHasChecksum && !Read(mBuffer, mCursor, frame.mChecksum))
+            return false;
+
+        return true;
+    }
+
+    void ReplayManager::EnterDeterministicMode()
+    {
+        auto& engine = InsightEngine::Instance();
+        mPreviousDeterministic = Physics::mDeterministic;
+        mPreviousRuntime = engine.mRuntime;
+
+        Physics::mDeterministic = true;
+        PRNG::Instance().seed(mSeed);
+        engine.mRuntime = true;
+        Camera3D::mActiveCamera = CAMERA_TYPE_GAME;
+    }
+
+    void ReplayManager::LeaveDeterministicMode()
+    {
+        Physics::mDeterministic = mPreviousDeterministic;
+        InsightEngine::Instance().mRuntime = mPreviousRuntime;
+    }
+
+} // end namespace IS
@@ -0,0 +1,242 @@
+/*!
+ * \file Replay.h
+ * \author Tan Zheng Xun, t.zhengxun@digipen.edu
+ * \par Course: CSD2451
+ * \date 19-10-2026
+ * \brief
+ * This header file declares the ReplayManager class, which records the inputs,
+ * step counts and random seed of a play session into a compact binary log and
+ * re-simulates the session deterministically from that log.
+ *
+ * \copyright
+ * All content (C) 2024 DigiPen Institute of Technology Singapore.
+ * All rights reserved.
+ * Reproduction or disclosure of this file or its contents without the prior written
+ * consent of DigiPen Institute of Technology is prohibited.
+ *____________________________________________________________________________*/
+
+ /*                                                                   guard
+ ----------------------------------------------------------------------------- */
+#ifndef GAM200_INSIGHT_ENGINE_ENGINE_SYSTEMS_REPLAY_H
+#define GAM200_INSIGHT_ENGINE_ENGINE_SYSTEMS_REPLAY_H
+
+ /*                                                                   includes
+ ----------------------------------------------------------------------------- */
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct GLFWgamepadstate;
+
+namespace IS {
+
+    /*!
+     * \brief State of the replay manager.
+     */
+    enum class ReplayState : uint8_t {
+        None,       ///< Normal play, inputs come from GLFW.
+        Recording,  ///< Inputs come from GLFW and are written to the log.
+        Replaying   ///< Inputs come from the log, live inputs are ignored.
+    };
+
+    /*!
+     * \brief A single input event as received from the GLFW callbacks.
+     */
+    struct ReplayEvent {
+        enum Type : uint8_t { KEY = 0, MOUSE_BUTTON };
+
+        uint8_t mType;      ///< Key or mouse button.
+        uint8_t mAction;    ///< GLFW_PRESS or GLFW_RELEASE.
+        int16_t mCode;      ///< GLFW key code or mouse button.
+    };
+
+    /*!
+     * \brief Everything the simulation consumed from the outside world in one frame.
+     */
+    struct ReplayFrame {
+        uint8_t mSteps{};                       ///< Number of fixed steps simulated this frame.
+        float mDeltaTime{};                     ///< Frame delta time seen by scripts.
+        std::vector<ReplayEvent> mEvents;       ///< Input events received before the frame.
+        bool mHasMouse{};                       ///< Whether the mouse moved since the last frame.
+        float mMouseX{}, mMouseY{};             ///< Mouse position in normalized device coordinates.
+        bool mHasScroll{};                      ///< Whether the mouse wheel was scrolled.
+        float mScrollX{}, mScrollY{};           ///< Mouse scroll offsets.
+        bool mHasGamepad{};                     ///< Whether a gamepad state was polled.
+        uint16_t mGamepadButtons{};             ///< Pressed gamepad buttons, one bit per button.
+        float mGamepadAxes[6]{};                ///< Gamepad axes.
+        bool mHasChecksum{};                    ///< Whether a state checksum is stored.
+        uint64_t mChecksum{};                   ///< Checksum of the physics state at the start of the frame.
+    };
+
+    /*!
+     * \brief Records and replays play sessions.
+     *
+     * While recording or replaying, physics runs in deterministic mode (fixed iteration
+     * order and sorted contact pairs), the PRNG is seeded from the log and the frame
+     * step counts come from the log instead of the wall clock. Every CHECKSUM_INTERVAL
+     * frames a checksum of the physics state is logged, so a replay reports the first
+     * frame where it diverged from the recorded session.
+     *
+     * Log layout (little endian):
+     *   header: "ISRP", u16 version, u32 seed, f64 fixed dt, u16 length + scene path, u32 frame count
+     *   frame:  u8 flags, u8 steps, f32 dt, u16 event count, events (4 bytes each),
+     *           [f32 mouse x, y], [f32 scroll x, y], [u16 buttons, f32 axes[6]], [u64 checksum]
+     */
+    class ReplayManager {
+    public:
+        static constexpr const char* REPLAY_DIRECTORY = "Assets/Replays/"; ///< Directory where recordings are saved.
+        static constexpr const char* REPLAY_EXTENSION = ".isreplay";      ///< Extension of the recordings.
+        static constexpr uint16_t REPLAY_VERSION = 1;                     ///< Version of the log layout.
+        static constexpr unsigned CHECKSUM_INTERVAL = 60;                 ///< Frames between state checksums.
+
+        /*!
+         * \brief Gets the singleton instance of the replay manager.
+         *
+         * \return Reference to the replay manager.
+         */
+        static ReplayManager& Instance();
+
+        /*!
+         * \brief Reloads the active scene, seeds the PRNG and starts recording.
+         */
+        void StartRecording();
+
+        /*!
+         * \brief Stops recording and writes the log to the replay directory.
+         *
+         * \return The path of the saved log, empty if nothing was recorded.
+         */
+        std::string StopRecording();
+
+        /*!
+         * \brief Loads a log and starts replaying it from the next frame.
+         *
+         * \param filepath Path to the log.
+         * \param exit_on_finish Quit the engine once the replay is done, used by the replay runner.
+         * \return True if the log was loaded, false otherwise.
+         */
+        bool StartReplay(std::string const& filepath, bool exit_on_finish = false);
+
+        /*!
+         * \brief Queues a replay to start on the first frame, used when launching with "-replay <file>".
+         *
+         * \param filepath Path to the log.
+         */
+        void QueueReplay(std::string const& filepath);
+
+        /*!
+         * \brief Stops the current replay and reports the result.
+         */
+        void StopReplay();
+
+        /*!
+         * \brief Called at the start of InsightEngine::Update.
+         *
+         * While recording, finalizes the previous frame and captures the step count, delta
+         * time and inputs of this frame. While replaying, applies the next frame of the log.
+         */
+        void BeginFrame();
+
+        /*!
+         * \brief Called by the input callbacks for every key or mouse button event.
+         *
+         * \param type Key or mouse button.
+         * \param code GLFW key code or mouse button.
+         * \param action GLFW action.
+         * \return False if the live event should be ignored (while replaying), true otherwise.
+         */
+        bool OnInputEvent(ReplayEvent::Type type, int code, int action);
+
+        /*!
+         * \brief Called by the scroll callback.
+         *
+         * \param xoffset Horizontal scroll offset.
+         * \param yoffset Vertical scroll offset.
+         * \return False if the live event should be ignored (while replaying), true otherwise.
+         */
+        bool OnScroll(double xoffset, double yoffset);
+
+        /*!
+         * \brief Polls the gamepad state, from GLFW or from the log while replaying.
+         *
+         * \param state Output gamepad state.
+         * \return True if a gamepad state is available.
+         */
+        bool PollGamepad(GLFWgamepadstate& state);
+
+        /*!
+         * \brief Gets the mouse position recorded for the current frame.
+         *
+         * \param x Output x position in normalized device coordinates.
+         * \param y Output y position in normalized device coordinates.
+         * \return True if replaying, false otherwise.
+         */
+        bool GetReplayMouseNDC(float& x, float& y) const;
+
+        bool IsRecording() const { return mState == ReplayState::Recording; }
+        bool IsReplaying() const { return mState == ReplayState::Replaying; }
+        ReplayState GetState() const { return mState; }
+        unsigned GetFrameIndex() const { return mFrameIndex; }
+        unsigned GetFrameCount() const { return mFrameCount; }
+        size_t GetLogSize() const { return mBuffer.size(); }
+
+    private:
+        ReplayManager() = default;
+
+        /*!
+         * \brief Hashes the transform and rigidbody state of every physics entity in entity order.
+         *
+         * \return The checksum.
+         */
+        uint64_t ComputeChecksum() const;
+
+        /*!
+         * \brief Appends a frame to the log buffer.
+         *
+         * \param frame The frame to write.
+         */
+        void WriteFrame(ReplayFrame const& frame);
+
+        /*!
+         * \brief Reads the next frame from the log buffer.
+         *
+         * \param frame The frame read.
+         * \return True if a frame was read, false at the end of the log.
+         */
+        bool ReadFrame(ReplayFrame& frame);
+
+        /*!
+         * \brief Enters deterministic mode for recording or replaying.
+         */
+        void EnterDeterministicMode();
+
+        /*!
+         * \brief Restores the settings changed by EnterDeterministicMode.
+         */
+        void LeaveDeterministicMode();
+
+        ReplayState mState = ReplayState::None;
+        std::vector<uint8_t> mBuffer;       ///< Log being recorded or replayed.
+        size_t mCursor{};                   ///< Read position while replaying.
+        size_t mFrameCountOffset{};         ///< Offset of the frame count in the header.
+        ReplayFrame mFrame;                 ///< Frame being recorded or replayed.
+        bool mFrameOpen{};                  ///< Whether mFrame still needs to be written.
+        std::vector<ReplayEvent> mPendingEvents; ///< Events received since the last frame.
+        bool mPendingScroll{};
+        float mPendingScrollX{}, mPendingScrollY{};
+        float mLastMouseX{}, mLastMouseY{};
+        uint32_t mSeed{};
+        std::string mScenePath;
+        unsigned mFrameIndex{};
+        unsigned mFrameCount{};
+        int mMismatchFrame = -1;            ///< First frame whose checksum did not match, -1 if none.
+        bool mExitOnFinish{};
+        std::string mQueuedReplay;
+        double mReplayStartTime{};
+        bool mPreviousDeterministic{};
+        bool mPreviousRuntime{};
+    };
+
+} // end namespace IS
+
+#endif // !GAM200_INSIGHT_ENGINE_ENGINE_SYSTEMS_REPLAY_H
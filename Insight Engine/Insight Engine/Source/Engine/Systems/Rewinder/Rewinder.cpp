@@ -0,0 +1,370 @@
+/*!
+ * \file Rewinder.cpp
+ * \author Tan Zheng Xun, t.zhengxun@digipen.edu
+ * \par Course: CSD2451
+ * \date 19-10-2026
+ * \brief
+ * This source file defines the RewinderComponent and the Rewinder system, which
+ * keeps a bounded ring of delta compressed entity states for rewinding.
+ *
+ * \copyright
+ * All content (C) 2024 DigiPen Institute of Technology Singapore.
+ * All rights reserved.
+ * Reproduction or disclosure of this file or its contents without the prior written
+ * consent of DigiPen Institute of Technology is prohibited.
+ *____________________________________________________________________________*/
+
+ /*                                                                   includes
+ ----------------------------------------------------------------------------- */
+#include "Pch.h"
+#include "Rewinder.h"
+#include "Engine/Core/CoreEngine.h"
+#include "Graphics/System/Transform.h"
+#include "Graphics/System/Sprite.h"
+#include "Physics/Dynamics/Body.h"
+
+#include <cmath>
+
+namespace IS {
+
+    namespace {
+        // Fixed point scale of the quantized float fields (1/1024 of a unit, degree or second)
+        constexpr float QUANTIZE_SCALE = 1024.f;
+
+        // Field layout of an entity state
+        enum Field : size_t {
+            POSITION_X = 0, POSITION_Y, ROTATION, SCALE_X, SCALE_Y,         // Transform
+            VELOCITY_X, VELOCITY_Y, ANGULAR_VELOCITY,                       // RigidBody
+            ANIMATION_INDEX, FRAME_INDEX_X, FRAME_INDEX_Y, FRAME_TIMER      // Sprite animation
+        };
+
+        int32_t Quantize(float value) { return static_cast<int32_t>(std::lround(value * QUANTIZE_SCALE)); }
+        float Dequantize(int32_t value) { return static_cast<float>(value) / QUANTIZE_SCALE; }
+
+        void WriteVarint(std::vector<uint8_t>& out, uint32_t value)
+        {
+            while (value >= 0x80) {
+                out.push_back(static_cast<uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+            out.push_back(static_cast<uint8_t>(value));
+        }
+
+        uint32_t ReadVarint(uint8_t const*& in)
+        {
+            uint32_t value = 0;
+            for (int shift = 0; ; shift += 7) {
+                uint8_t byte = *in++;
+                value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+                if (!(byte & 0x80))
+                    return value;
+            }
+        }
+
+        // Zigzag encoding maps small negative differences to small unsigned values
+        uint32_t ZigZag(int32_t value) { return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31); }
+        int32_t UnZigZag(uint32_t value) { return static_cast<int32_t>(value >> 1) ^ -static_cast<int32_t>(value & 1); }
+
+        void WriteU16(std::vector<uint8_t>& out, uint16_t value)
+        {
+            out.push_back(static_cast<uint8_t>(value & 0xFF));
+            out.push_back(static_cast<uint8_t>(value >> 8));
+        }
+
+        uint16_t ReadU16(uint8_t const*& in)
+        {
+            uint16_t value = static_cast<uint16_t>(in[0] | (in[1] << 8));
+            in += 2;
+            return value;
+        }
+    }
+
+    Json::Value RewinderComponent::Serialize()
+    {
+        Json::Value data;
+        data["RewinderRecording"] = mIsRecording;
+        data["RewinderRecordPhysics"] = mRecordPhysics;
+        data["RewinderRecordAnimations"] = mRecordAnimations;
+        data["RewinderTimeToSave"] = time_to_save;
+        return data;
+    }
+
+    void RewinderComponent::Deserialize(Json::Value data)
+    {
+        mIsRecording = data["RewinderRecording"].asBool();
+        mRecordPhysics = data["RewinderRecordPhysics"].asBool();
+        mRecordAnimations = data["RewinderRecordAnimations"].asBool();
+        time_to_save = data["RewinderTimeToSave"].asFloat();
+    }
+
+    void Rewinder::Initialize()
+    {
+        Clear();
+    }
+
+    void Rewinder::Update([[maybe_unused]] float delta_time)
+    {
+        InsightEngine& engine = InsightEngine::Instance();
+
+        // Only record frames where the simulation actually stepped
+        if (!engine.mRuntime || mPaused || engine.GetCurrentNumberOfSteps() <= 0) {
+            return;
+        }
+
+        UpdateCapacity();
+        if (mRing.empty())
+            return;
+
+        Capture(mCurrent);
+
+        // Keyframe when the interval is reached or the recorded entities changed
+        bool keyframe = mCount == 0 || mFramesSinceKeyframe + 1 >= KEYFRAME_INTERVAL || mCurrent.size() != mPrevious.size();
+        for (size_t i = 0; !keyframe && i < mCurrent.size(); ++i) {
+            keyframe = mCurrent[i].mEntity != mPrevious[i].mEntity;
+        }
+
+        // A full ring overwrites its oldest frame, which is always a keyframe, so the frame
+        // after it becomes the oldest and must decode on its own
+        if (mCount == mRing.size()) {
+            if (mRing.size() == 1) {
+                keyframe = true;
+            }
+            else if (Slot& next = mRing[(mHead + 1) % mRing.size()]; !next.mKeyframe) {
+                Decode(mRing[mHead], mScratch);
+                Decode(next, mScratch);
+                Encode(next, mScratch, true);
+            }
+        }
+
+        Encode(mRing[mHead], mCurrent, keyframe);
+        mHead = (mHead + 1) % mRing.size();
+        mCount = std::min(mCount + 1, mRing.size());
+        mFramesSinceKeyframe = keyframe ? 0 : mFramesSinceKeyframe + 1;
+        std::swap(mPrevious, mCurrent);
+    }
+
+    bool Rewinder::Rewind(size_t frames)
+    {
+        if (frames >= GetRewindableFrames())
+            return false;
+
+        // Walk back to the keyframe the target frame was encoded against
+        size_t keyframe_back = frames;
+        while (!mRing[SlotIndex(keyframe_back)].mKeyframe) {
+            ++keyframe_back;
+        }
+
+        // Replay at most KEYFRAME_INTERVAL slots forward to the target
+        std::vector<EntityState> states;
+        for (size_t back = keyframe_back + 1; back-- > frames; ) {
+            Decode(mRing[SlotIndex(back)], states);
+        }
+        Apply(states);
+
+        // Drop the newer frames and continue recording from the restored one
+        mHead = (mHead + mRing.size() - frames) % mRing.size();
+        mCount -= frames;
+        mFramesSinceKeyframe = static_cast<unsigned>(keyframe_back - frames);
+        mPrevious = std::move(states);
+
+        IS_CORE_DEBUG("Rewound {} frames, decoded {} slots", frames, keyframe_back - frames + 1);
+        return true;
+    }
+
+    void Rewinder::Clear()
+    {
+        for (Slot& slot : mRing) {
+            slot.mData.clear();
+            slot.mKeyframe = false;
+        }
+        mHead = 0;
+        mCount = 0;
+        mFramesSinceKeyframe = 0;
+        mPrevious.clear();
+    }
+
+    size_t Rewinder::GetRewindableFrames() const
+    {
+        // The oldest frame is kept a keyframe, this only guards against a broken ring
+        for (size_t back = mCount; back-- > 0; ) {
+            if (mRing[SlotIndex(back)].mKeyframe)
+                return back + 1;
+        }
+        return 0;
+    }
+
+    size_t Rewinder::GetEncodedSize() const
+    {
+        size_t size = 0;
+        for (Slot const& slot : mRing) {
+            size += slot.mData.size();
+        }
+        return size;
+    }
+
+    void Rewinder::Capture(std::vector<EntityState>& states) const
+    {
+        InsightEngine& engine = InsightEngine::Instance();
+        states.clear();
+
+        for (Entity const& entity : mEntities) {
+            auto const& rewinder = engine.GetComponent<RewinderComponent>(entity);
+            if (!rewinder.mIsRecording)
+                continue;
+
+            EntityState state;
+            state.mEntity = entity;
+            Fields& fields = state.mFields;
+
+            auto const& trans = engine.GetComponent<Transform>(entity);
+            fields[POSITION_X] = Quantize(trans.world_position.x);
+            fields[POSITION_Y] = Quantize(trans.world_position.y);
+            fields[ROTATION] = Quantize(trans.rotation);
+            fields[SCALE_X] = Quantize(trans.scaling.x);
+            fields[SCALE_Y] = Quantize(trans.scaling.y);
+
+            if (rewinder.mRecordPhysics && engine.HasComponent<RigidBody>(entity)) {
+                auto const& body = engine.GetComponent<RigidBody>(entity);
+                fields[VELOCITY_X] = Quantize(body.mVelocity.x);
+                fields[VELOCITY_Y] = Quantize(body.mVelocity.y);
+                fields[ANGULAR_VELOCITY] = Quantize(body.mAngularVelocity);
+            }
+
+            if (rewinder.mRecordAnimations && engine.HasComponent<Sprite>(entity)) {
+                auto const& sprite = engine.GetComponent<Sprite>(entity);
+                fields[ANIMATION_INDEX] = sprite.animation_index;
+                if (sprite.animation_index >= 0 && static_cast<size_t>(sprite.animation_index) < sprite.anims.size()) {
+                    auto const& anim = sprite.anims[sprite.animation_index];
+                    fields[FRAME_INDEX_X] = static_cast<int32_t>(anim.frame_index.x);
+                    fields[FRAME_INDEX_Y] = static_cast<int32_t>(anim.frame_index.y);
+                    fields[FRAME_TIMER] = Quantize(anim.frame_timer);
+                }
+            }
+
+            states.push_back(state);
+        }
+    }
+
+    void Rewinder::Apply(std::vector<EntityState> const& states) const
+    {
+        InsightEngine& engine = InsightEngine::Instance();
+
+        for (EntityState const& state : states) {
+            Entity entity = state.mEntity;
+            if (!engine.HasComponent<RewinderComponent>(entity) || !engine.HasComponent<Transform>(entity))
+                continue;
+
+            auto const& rewinder = engine.GetComponent<RewinderComponent>(entity);
+            Fields const& fields = state.mFields;
+
+            auto& trans = engine.GetComponent<Transform>(entity);
+            trans.world_position = Vec2D(Dequantize(fields[POSITION_X]), Dequantize(fields[POSITION_Y]));
+            trans.rotation = Dequantize(fields[ROTATION]);
+            trans.scaling = Vec2D(Dequantize(fields[SCALE_X]), Dequantize(fields[SCALE_Y]));
+            trans.MarkDirty();
+
+            if (engine.HasComponent<RigidBody>(entity)) {
+                auto& body = engine.GetComponent<RigidBody>(entity);
+                body.mPosition = trans.world_position;
+                body.mRotation = trans.rotation;
+                if (rewinder.mRecordPhysics) {
+                    body.mVelocity = Vector2D(Dequantize(fields[VELOCITY_X]), Dequantize(fields[VELOCITY_Y]));
+                    body.mAngularVelocity = Dequantize(fields[ANGULAR_VELOCITY]);
+                    trans.angle_speed = body.mAngularVelocity;
+                }
+            }
+
+            if (engine.HasComponent<Sprite>(entity)) {
+                auto& sprite = engine.GetComponent<Sprite>(entity);
+                if (rewinder.mRecordAnimations) {
+                    sprite.animation_index = fields[ANIMATION_INDEX];
+                    if (sprite.animation_index >= 0 && static_cast<size_t>(sprite.animation_index) < sprite.anims.size()) {
+                        auto& anim = sprite.anims[sprite.animation_index];
+                        anim.frame_index = glm::vec2(static_cast<float>(fields[FRAME_INDEX_X]), static_cast<float>(fields[FRAME_INDEX_Y]));
+                        anim.frame_timer = Dequantize(fields[FRAME_TIMER]);
+                    }
+                }
+                sprite.followTransform(trans);
+            }
+        }
+    }
+
+    void Rewinder::Encode(Slot& slot, std::vector<EntityState> const& states, bool keyframe) const
+    {
+        slot.mKeyframe = keyframe;
+        slot.mData.clear();
+
+        // Keyframe: entity count, then every entity id and field
+        if (keyframe) {
+            WriteVarint(slot.mData, static_cast<uint32_t>(states.size()));
+            for (EntityState const& state : states) {
+                WriteVarint(slot.mData, state.mEntity);
+                for (int32_t field : state.mFields) {
+                    WriteVarint(slot.mData, ZigZag(field));
+                }
+            }
+            return;
+        }
+
+        // Delta: per entity in keyframe order, a mask of the changed fields and their differences
+        for (size_t i = 0; i < states.size(); ++i) {
+            Fields const& current = states[i].mFields;
+            Fields const& previous = mPrevious[i].mFields;
+
+            uint16_t mask = 0;
+            for (size_t f = 0; f < FIELD_COUNT; ++f) {
+                if (current[f] != previous[f])
+                    mask |= static_cast<uint16_t>(1u << f);
+            }
+            WriteU16(slot.mData, mask);
+            for (size_t f = 0; f < FIELD_COUNT; ++f) {
+                if (mask & (1u << f))
+                    WriteVarint(slot.mData, ZigZag(current[f] - previous[f]));
+            }
+        }
+    }
+
+    void Rewinder::Decode(Slot const& slot, std::vector<EntityState>& states) const
+    {
+        uint8_t const* in = slot.mData.data();
+
+        if (slot.mKeyframe) {
+            states.resize(ReadVarint(in));
+            for (EntityState& state : states) {
+                state.mEntity = static_cast<Entity>(ReadVarint(in));
+                for (int32_t& field : state.mFields) {
+                    field = UnZigZag(ReadVarint(in));
+                }
+            }
+            return;
+        }
+
+        for (EntityState& state : states) {
+            uint16_t mask = ReadU16(in);
+            for (size_t f = 0; f < FIELD_COUNT; ++f) {
+                if (mask & (1u << f))
+                    state.mFields[f] += UnZigZag(ReadVarint(in));
+            }
+        }
+    }
+
+    void Rewinder::UpdateCapacity()
+    {
+        InsightEngine& engine = InsightEngine::Instance();
+
+        float time_to_save = 0.f;
+        for (Entity const& entity : mEntities) {
+            time_to_save = std::max(time_to_save, engine.GetComponent<RewinderComponent>(entity).time_to_save);
+        }
+
+        size_t capacity = engine.mFixedDeltaTime > 0.0 ? static_cast<size_t>(std::ceil(time_to_save / engine.mFixedDeltaTime)) : 0;
+        if (capacity == mRing.size())
+            return;
+
+        // The ring indices change with the size, so start over
+        Clear();
+        mRing.resize(capacity);
+        mRing.shrink_to_fit();
+    }
+
+} // end namespace IS
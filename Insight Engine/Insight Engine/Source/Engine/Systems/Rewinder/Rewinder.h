@@ -1,41 +1,194 @@
+/*!
+ * \file Rewinder.h
+ * \author Tan Zheng Xun, t.zhengxun@digipen.edu
+ * \par Course: CSD2451
+ * \date 19-10-2026
+ * \brief
+ * This header file declares the RewinderComponent and the Rewinder system. The
+ * Rewinder records the transform, rigidbody and animation state of every entity
+ * with a RewinderComponent into a fixed-size ring of delta compressed steps and
+ * can restore any buffered step.
+ *
+ * \copyright
+ * All content (C) 2024 DigiPen Institute of Technology Singapore.
+ * All rights reserved.
+ * Reproduction or disclosure of this file or its contents without the prior written
+ * consent of DigiPen Institute of Technology is prohibited.
+ *____________________________________________________________________________*/
+
+ /*                                                                   guard
+ ----------------------------------------------------------------------------- */
+#ifndef GAM200_INSIGHT_ENGINE_ENGINE_SYSTEMS_REWINDER_H
+#define GAM200_INSIGHT_ENGINE_ENGINE_SYSTEMS_REWINDER_H
+
+ /*                                                                   includes
+ ----------------------------------------------------------------------------- */
 #include "../../ECS/Component.h"
 #include "../../ECS/System.h"
-#include "../../../Physics/System/Physics.h"
-
-namespace IS {
-
-	class RewinderComponent : IComponent {
-	public:
-		bool mIsRecording = false;
-		bool mRecordPhysics = false;
-		bool mRecordAnimations = false;
-		float time_to_save = 1.f;
-
-
-
-	};
-
-	class Rewinder : public ParentSystem {
-	public:
-        std::string GetName() {
-            return "Rewinder";
-        }
-
-
-
-        void Initialize(){}
-
-
-        void Update([[maybe_unused]] float delta_time);
-
-
-		//save a copy of the component
-		std::unordered_map<Entity, RigidBody> mRigidBodies;
-		std::unordered_map<Entity, Transform> mTransforms;
-
-	};
-
 
+#include <array>
+#include <cstdint>
+#include <vector>
 
+namespace IS {
 
-}
\ No newline at end of file
+    /*!
+     * \brief Marks an entity to be recorded by the Rewinder.
+     */
+    class RewinderComponent : public IComponent {
+    public:
+        bool mIsRecording = true;       ///< Whether the entity is recorded.
+        bool mRecordPhysics = false;    ///< Also record the rigidbody velocities.
+        bool mRecordAnimations = false; ///< Also record the sprite animation frame.
+        float time_to_save = 5.f;       ///< Seconds of history to keep.
+
+        /*!
+         * \brief Gets the type of the component.
+         */
+        static std::string GetType() { return "RewinderComponent"; }
+
+        /*!
+         * \brief Serializes the component to a JSON value.
+         */
+        Json::Value Serialize() override;
+
+        /*!
+         * \brief Deserializes the component from a JSON value.
+         */
+        void Deserialize(Json::Value data) override;
+    };
+
+    /*!
+     * \brief Records entity state every simulated frame and rewinds to it on request.
+     *
+     * Each recorded frame is stored in one slot of a fixed-size ring, so memory is bounded
+     * by the longest time_to_save of the recorded entities. A slot is either a keyframe,
+     * holding every entity in full, or a delta against the previous slot, holding for each
+     * entity a 16-bit mask of the changed fields followed by the zigzag varint difference of
+     * each changed field. Fields are quantized to fixed point before diffing, so bodies at
+     * rest cost 2 bytes per frame and moving bodies a handful of bytes.
+     *
+     * A keyframe is written every KEYFRAME_INTERVAL frames and whenever the set of recorded
+     * entities changes, so restoring any buffered frame decodes at most KEYFRAME_INTERVAL
+     * slots regardless of the buffer length. When the ring wraps, the frame after the one
+     * overwritten is re-encoded as a keyframe, so every buffered frame stays decodable
+     * even when the ring is shorter than KEYFRAME_INTERVAL.
+     */
+    class Rewinder : public ParentSystem {
+    public:
+        static constexpr unsigned KEYFRAME_INTERVAL = 30;   ///< Maximum frames between keyframes.
+        static constexpr size_t FIELD_COUNT = 12;           ///< Quantized fields per entity.
+
+        /*!
+         * \brief Gets the name of the system.
+         */
+        std::string GetName() override { return "Rewinder"; }
+
+        /*!
+         * \brief Initializes the system.
+         */
+        void Initialize() override;
+
+        /*!
+         * \brief Records the state of the recorded entities if the simulation stepped.
+         * \param delta_time The fixed delta time.
+         */
+        void Update(float delta_time) override;
+
+        /*!
+         * \brief Restores the state recorded a number of frames ago and drops the newer frames.
+         * \param frames Number of frames to go back, 0 restores the newest frame.
+         * \return True if the frame was restored, false if it is not buffered.
+         */
+        bool Rewind(size_t frames);
+
+        /*!
+         * \brief Clears the buffer.
+         */
+        void Clear();
+
+        /*!
+         * \brief Gets the number of frames that can be restored.
+         */
+        size_t GetRewindableFrames() const;
+
+        /*!
+         * \brief Gets the capacity of the ring in frames.
+         */
+        size_t GetCapacity() const { return mRing.size(); }
+
+        /*!
+         * \brief Gets the bytes used by the encoded frames.
+         */
+        size_t GetEncodedSize() const;
+
+        /*!
+         * \brief Pauses or resumes recording, used while scrubbing through the buffer.
+         */
+        void SetPaused(bool paused) { mPaused = paused; }
+        bool IsPaused() const { return mPaused; }
+
+    private:
+        using Fields = std::array<int32_t, FIELD_COUNT>;
+
+        /*!
+         * \brief Quantized state of one entity.
+         */
+        struct EntityState {
+            Entity mEntity{};
+            Fields mFields{};
+        };
+
+        /*!
+         * \brief One encoded frame of the ring.
+         */
+        struct Slot {
+            bool mKeyframe{};
+            std::vector<uint8_t> mData; ///< Reused between frames so recording does not allocate.
+        };
+
+        /*!
+         * \brief Captures the quantized state of the recorded entities.
+         * \param states Output states, in entity order.
+         */
+        void Capture(std::vector<EntityState>& states) const;
+
+        /*!
+         * \brief Writes the quantized state back to the live components.
+         * \param states The states to restore.
+         */
+        void Apply(std::vector<EntityState> const& states) const;
+
+        /*!
+         * \brief Encodes a frame into a slot.
+         */
+        void Encode(Slot& slot, std::vector<EntityState> const& states, bool keyframe) const;
+
+        /*!
+         * \brief Decodes a slot on top of the previous state.
+         */
+        void Decode(Slot const& slot, std::vector<EntityState>& states) const;
+
+        /*!
+         * \brief Resizes the ring to fit the longest time_to_save, clearing it if the size changed.
+         */
+        void UpdateCapacity();
+
+        /*!
+         * \brief Gets the ring index of a frame counted back from the newest.
+         */
+        size_t SlotIndex(size_t frames_back) const { return (mHead + mRing.size() - 1 - frames_back) % mRing.size(); }
+
+        std::vector<Slot> mRing;                ///< Encoded frames.
+        size_t mHead{};                         ///< Ring index of the next frame to write.
+        size_t mCount{};                        ///< Number of frames in the ring.
+        unsigned mFramesSinceKeyframe{};        ///< Frames written since the last keyframe.
+        std::vector<EntityState> mPrevious;     ///< State of the newest frame, used to diff the next one.
+        std::vector<EntityState> mCurrent;      ///< Scratch state of the frame being recorded.
+        std::vector<EntityState> mScratch;      ///< Scratch state of the oldest frame, re-encoded when the ring wraps.
+        bool mPaused{};
+    };
+
+} // end namespace IS
+
+#endif // !GAM200_INSIGHT_ENGINE_ENGINE_SYSTEMS_REWINDER_H
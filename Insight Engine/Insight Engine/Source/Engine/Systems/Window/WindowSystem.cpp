@@ -46,6 +46,14 @@ namespace IS {
 
         LoadProperties();
         PrintProperties();
+
+        // headless runs only simulate, there is no window, context or OpenGL to load
+        if (InsightEngine::Instance().mHeadless)
+        {
+            IS_CORE_INFO("Running headless, no window or OpenGL context created");
+            return;
+        }
+
         SetWindowHints();
 
         // Create a window and its OpenGL context
@@ -115,6 +123,9 @@ namespace IS {
 
     void WindowSystem::Update(float)
     {
+        if (!mWindow)
+            return;
+
         //register window closing 
         if (glfwWindowShouldClose(mWindow)) {
             Message quit = Message(MessageType::Quit);
@@ -128,13 +139,23 @@ namespace IS {
 
     std::string WindowSystem::GetName() { return "Window"; }
 
-    void WindowSystem::SwapBuffers() { glfwSwapBuffers(mWindow); }
+    void WindowSystem::SwapBuffers() { if (mWindow) glfwSwapBuffers(mWindow); }
 
     /*                                                                    Getters
     ----------------------------------------------------------------------------- */
     GLFWwindow* WindowSystem::GetNativeWindow() const               { return mWindow; }
     std::string WindowSystem::GetWindowTitle() const                { return mProps.title; }
-    void WindowSystem::GetWindowSize(int& width, int& height) const { glfwGetWindowSize(mWindow, &width, &height); }
+    void WindowSystem::GetWindowSize(int& width, int& height) const
+    {
+        // without a window the size of the properties is the size of the screen
+        if (!mWindow)
+        {
+            width = mProps.width;
+            height = mProps.height;
+            return;
+        }
+        glfwGetWindowSize(mWindow, &width, &height);
+    }
     int WindowSystem::GetWindowWidth() const
     {
         int width, height;
@@ -151,6 +172,8 @@ namespace IS {
     {
         GLFWmonitor* active_monitor = GetActiveMonitor();
         GLFWmonitor* monitor = active_monitor ? active_monitor : glfwGetPrimaryMonitor();
+        if (!monitor)
+            return mProps.width;
         const GLFWvidmode* mode = glfwGetVideoMode(monitor);
         return mode->width;
     }
@@ -158,6 +181,8 @@ namespace IS {
     {
         GLFWmonitor* active_monitor = GetActiveMonitor();
         GLFWmonitor* monitor = active_monitor ? active_monitor : glfwGetPrimaryMonitor();
+        if (!monitor)
+            return mProps.height;
         const GLFWvidmode* mode = glfwGetVideoMode(monitor);
         return mode->height;
     }
@@ -171,7 +196,8 @@ namespace IS {
     void WindowSystem::SetWindowTitle(std::string const& title)
     {
         mProps.title = title;
-        glfwSetWindowTitle(mWindow, title.c_str());
+        if (mWindow)
+            glfwSetWindowTitle(mWindow, title.c_str());
     }
 
     void WindowSystem::SetWindowSize(int width, int height)
@@ -179,18 +205,22 @@ namespace IS {
         mProps.width = width;
         mProps.height = height;
 
-        glfwSetWindowSize(mWindow, width, height);
+        if (mWindow)
+            glfwSetWindowSize(mWindow, width, height);
     }
 
     void WindowSystem::EnableVsync(bool enabled)
     {
         mProps.vsync = enabled;
-        glfwSwapInterval(enabled ? 1 : 0);
+        if (mWindow)
+            glfwSwapInterval(enabled ? 1 : 0);
     }
 
     void WindowSystem::ToggleFullScreen()
     {
         mProps.fullscreen = !mProps.fullscreen;
+        if (!mWindow)
+            return;
 
         GLFWmonitor* monitor = GetActiveMonitor();
         const GLFWvidmode* mode = glfwGetVideoMode(monitor);
@@ -221,6 +251,13 @@ namespace IS {
 
     int WindowSystem::ShowMessageBox(std::string const& message, std::string const& title)
     {
+        // nobody is there to close a message box in a headless run
+        if (!mWindow)
+        {
+            IS_CORE_WARN("{}: {}", title, message);
+            return IDOK;
+        }
+
         HWND hwnd = glfwGetWin32Window(mWindow);
         return MessageBox(hwnd, message.c_str(), title.c_str(), MB_OK | MB_ICONINFORMATION);
     }
@@ -232,22 +269,30 @@ namespace IS {
 
     void WindowSystem::UseCustomCursor()
     {
+        if (!mWindow)
+            return;
         glfwSetInputMode(mWindow, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
         glfwSetCursor(mWindow, mCursor);
     }
 
     void WindowSystem::UseDefaultCursor()
     {
+        if (!mWindow)
+            return;
         glfwSetInputMode(mWindow, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
     }
 
     void WindowSystem::HideCursor()
     {
+        if (!mWindow)
+            return;
         glfwSetInputMode(mWindow, GLFW_CURSOR, GLFW_CURSOR_HIDDEN);
     }
 
     void WindowSystem::ShowCursor()
     {
+        if (!mWindow)
+            return;
         glfwSetInputMode(mWindow, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
     }
 
@@ -274,8 +319,8 @@ namespace IS {
             // Validate window size
             GLFWmonitor* monitor = glfwGetPrimaryMonitor();
             const GLFWvidmode* mode = glfwGetVideoMode(monitor);
-            if (mProps.width < DEFAULT_PROPERTIES.width || mProps.width > mode->width ||
-                mProps.height < DEFAULT_PROPERTIES.height || mProps.height > mode->height)
+            if (mode && (mProps.width < DEFAULT_PROPERTIES.width || mProps.width > mode->width ||
+                         mProps.height < DEFAULT_PROPERTIES.height || mProps.height > mode->height))
             {
                 mProps = DEFAULT_PROPERTIES;
                 IS_CORE_INFO("Loaded window properties from \"{}\"", filename);
@@ -377,6 +422,9 @@ namespace IS {
 
     GLFWmonitor* WindowSystem::GetActiveMonitor()
     {
+        if (!mWindow)
+            return nullptr;
+
         int window_x, window_y;
         glfwGetWindowPos(mWindow, &window_x, &window_y);
 
@@ -39,6 +39,64 @@ namespace IS {
         return pixel_data;
     }
 
+    uint64_t Framebuffer::RequestPixel(GLint x, GLint y)
+    {
+        if (x < 0 || y < 0 || x >= static_cast<GLint>(mProps.mWidth) || y >= static_cast<GLint>(mProps.mHeight))
+            return 0;
+
+        // reuse the oldest slot, dropping its read if it is still in flight
+        PixelRequest& request = mPixelRequests[mPixelRequestCount % PIXEL_REQUEST_COUNT];
+        if (request.mFence)
+            glDeleteSync(request.mFence);
+        if (!request.mBuffer)
+        {
+            glCreateBuffers(1, &request.mBuffer);
+            glNamedBufferData(request.mBuffer, sizeof(int), nullptr, GL_STREAM_READ);
+        }
+
+        // read into the pixel buffer, glReadPixels returns without waiting for the GPU
+        GLint previous_read_framebuffer{};
+        glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previous_read_framebuffer);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, mFramebufferID);
+        glNamedFramebufferReadBuffer(mFramebufferID, GL_COLOR_ATTACHMENT1);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, request.mBuffer);
+        glReadPixels(x, y, 1, 1, GL_RED_INTEGER, GL_INT, nullptr);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(previous_read_framebuffer));
+
+        request.mFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        request.mID = ++mPixelRequestCount;
+        return request.mID;
+    }
+
+    bool Framebuffer::PollPixel(uint64_t& request, int& pixel)
+    {
+        bool finished = false;
+        for (PixelRequest& pending : mPixelRequests)
+        {
+            if (!pending.mFence)
+                continue;
+
+            GLenum status = glClientWaitSync(pending.mFence, 0, 0);
+            if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+                continue;
+
+            glDeleteSync(pending.mFence);
+            pending.mFence = nullptr;
+
+            // keep the newest result
+            if (!finished || pending.mID > request)
+            {
+                int pixel_data{};
+                glGetNamedBufferSubData(pending.mBuffer, 0, sizeof(int), &pixel_data);
+                request = pending.mID;
+                pixel = pixel_data - 1;
+                finished = true;
+            }
+        }
+        return finished;
+    }
+
     Framebuffer::Framebuffer(FramebufferProps const& properties) : mFramebufferID(0), mProps(properties) { Create(); }
 
 
@@ -54,6 +112,14 @@ namespace IS {
         glDeleteFramebuffers(1, &mFramebufferID);
         glDeleteTextures(1, &mProps.mColorAttachment);
         glDeleteTextures(1, &mProps.mEntIDAttachment);
+
+        for (PixelRequest& request : mPixelRequests)
+        {
+            if (request.mFence)
+                glDeleteSync(request.mFence);
+            glDeleteBuffers(1, &request.mBuffer);
+            request = PixelRequest{};
+        }
     }
 
     void Framebuffer::Create()
@@ -24,6 +24,9 @@
 ----------------------------------------------------------------------------- */
 #include <glad/glad.h> // for access to OpenGL API
 
+#include <array>
+#include <cstdint>
+
 namespace IS {
 
     /*!
@@ -71,7 +74,8 @@ namespace IS {
         void Unbind();
 
         /*!
-         * \brief Reads the pixel at given location.
+         * \brief Reads the pixel at given location. Waits for the GPU to finish
+         * rendering, prefer RequestPixel() every frame.
          * 
          * \param x The x coordinate of the pixel.
          * \param y The y coordinate of the pixel.
@@ -79,6 +83,26 @@ namespace IS {
          */
         int ReadPixel(GLint x, GLint y);
 
+        /*!
+         * \brief Queues a read of the entity ID at given location into a pixel buffer.
+         * The result is fetched with PollPixel() once the GPU got to it, usually a
+         * frame later. The oldest unfinished request is dropped if all are in flight.
+         *
+         * \param x The x coordinate of the pixel.
+         * \param y The y coordinate of the pixel.
+         * \return The ID of the request, 0 if the location is outside the framebuffer.
+         */
+        uint64_t RequestPixel(GLint x, GLint y);
+
+        /*!
+         * \brief Fetches the finished pixel requests without waiting.
+         *
+         * \param request Set to the ID of the newest finished request.
+         * \param pixel Set to the integer value read by that request.
+         * \return True if any request finished since the last poll.
+         */
+        bool PollPixel(uint64_t& request, int& pixel);
+
         /*!
          * \brief Gets the width and height of the framebuffer.
          * 
@@ -109,8 +133,21 @@ namespace IS {
         void SetColorAttachment(GLuint color_attachment);        
 
     private:
+        /*!
+         * \brief A pixel read in flight.
+         */
+        struct PixelRequest {
+            GLuint mBuffer{};       ///< Pixel buffer the value is read into.
+            GLsync mFence{};        ///< Signaled once the value is in the buffer.
+            uint64_t mID{};         ///< ID returned by RequestPixel().
+        };
+
+        static constexpr size_t PIXEL_REQUEST_COUNT = 3; ///< Reads in flight at once.
+
         GLuint mFramebufferID{};  ///< ID of the framebuffer
         FramebufferProps mProps{}; ///< Properties of the framebuffer.
+        std::array<PixelRequest, PIXEL_REQUEST_COUNT> mPixelRequests{}; ///< Ring of pixel reads.
+        uint64_t mPixelRequestCount{}; ///< Pixel reads requested so far.
     };
 
 } // end namespace IS
@@ -0,0 +1,121 @@
+/*!
+ * \file InstanceBuffer.cpp
+ * \author Koh Yan Khang, yankhang.k@digipen.edu
+ * \par Course: CSD2451
+ * \date 19-10-2026
+ * \brief
+ * This source file defines the implementation for class InstanceBuffer
+ * which encapsulates a persistently mapped, fenced ring of instance data
+ * regions.
+ *
+ * \copyright
+ * All content (C) 2024 DigiPen Institute of Technology Singapore.
+ * All rights reserved.
+ * Reproduction or disclosure of this file or its contents without the prior written
+ * consent of DigiPen Institute of Technology is prohibited.
+ *____________________________________________________________________________*/
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include "Pch.h"
+#include "InstanceBuffer.h"
+
+namespace IS {
+
+    void InstanceBuffer::Create(GLsizeiptr element_size, GLsizei capacity)
+    {
+        mCapacity = capacity;
+        mRegionSize = element_size * capacity;
+        mRegion = 0;
+        // The persistent path uses the DSA entry points, which buffer storage alone does not load
+        mPersistent = GLAD_GL_VERSION_4_5 || (GLAD_GL_ARB_buffer_storage && GLAD_GL_ARB_direct_state_access);
+
+        if (mPersistent)
+        {
+            GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+            glCreateBuffers(1, &mBufferID);
+            glNamedBufferStorage(mBufferID, mRegionSize * REGION_COUNT, nullptr, flags);
+            mMapped = static_cast<char*>(glMapNamedBufferRange(mBufferID, 0, mRegionSize * REGION_COUNT, flags));
+            if (mMapped)
+                return;
+
+            // Storage is immutable, start over with a mutable buffer
+            IS_CORE_WARN("Persistent mapping failed, instance buffer {} falls back to orphaning", mBufferID);
+            glDeleteBuffers(1, &mBufferID);
+            mPersistent = false;
+        }
+
+        glGenBuffers(1, &mBufferID);
+        glBindBuffer(GL_ARRAY_BUFFER, mBufferID);
+        glBufferData(GL_ARRAY_BUFFER, mRegionSize, nullptr, GL_STREAM_DRAW);
+    }
+
+    void InstanceBuffer::Destroy()
+    {
+        for (GLsync& fence : mFences)
+        {
+            if (fence)
+                glDeleteSync(fence);
+            fence = nullptr;
+        }
+        if (mMapped)
+            glUnmapNamedBuffer(mBufferID);
+        mMapped = nullptr;
+        glDeleteBuffers(1, &mBufferID);
+        mBufferID = 0;
+    }
+
+    void* InstanceBuffer::Map()
+    {
+        if (!mPersistent)
+        {
+            // Orphan the old storage so the driver does not wait for the previous draw
+            glBindBuffer(GL_ARRAY_BUFFER, mBufferID);
+            glBufferData(GL_ARRAY_BUFFER, mRegionSize, nullptr, GL_STREAM_DRAW);
+            return glMapBufferRange(GL_ARRAY_BUFFER, 0, mRegionSize, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+        }
+
+        mRegion = (mRegion + 1) % REGION_COUNT;
+
+        // Only blocks if the GPU is more than REGION_COUNT draws behind
+        if (GLsync& fence = mFences[mRegion]; fence)
+        {
+            GLenum result = glClientWaitSync(fence, 0, 0);
+            while (result == GL_TIMEOUT_EXPIRED)
+            {
+                result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1'000'000);
+            }
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+
+        return mMapped + mRegionSize * mRegion;
+    }
+
+    GLuint InstanceBuffer::Unmap()
+    {
+        if (!mPersistent)
+        {
+            glBindBuffer(GL_ARRAY_BUFFER, mBufferID);
+            if (glUnmapBuffer(GL_ARRAY_BUFFER) == GL_FALSE)
+            {
+                IS_CORE_ERROR("Failed to unmap instance buffer {}", mBufferID);
+            }
+            return 0;
+        }
+
+        // Coherent mapping, writes are visible without flushing
+        return static_cast<GLuint>(mRegion * mCapacity);
+    }
+
+    void InstanceBuffer::Fence()
+    {
+        if (!mPersistent)
+            return;
+
+        if (mFences[mRegion])
+            glDeleteSync(mFences[mRegion]);
+        mFences[mRegion] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+
+} // end namespace IS
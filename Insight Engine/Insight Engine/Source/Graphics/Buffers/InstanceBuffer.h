@@ -0,0 +1,117 @@
+/*!
+ * \file InstanceBuffer.h
+ * \author Koh Yan Khang, yankhang.k@digipen.edu
+ * \par Course: CSD2451
+ * \date 19-10-2026
+ * \brief
+ * This header file declares the interface for class InstanceBuffer which
+ * encapsulates a persistently mapped, fenced ring of instance data regions.
+ *
+ * \copyright
+ * All content (C) 2024 DigiPen Institute of Technology Singapore.
+ * All rights reserved.
+ * Reproduction or disclosure of this file or its contents without the prior written
+ * consent of DigiPen Institute of Technology is prohibited.
+ *____________________________________________________________________________*/
+
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+#ifndef GAM200_INSIGHT_ENGINE_GRAPHICS_BUFFERS_INSTANCEBUFFER_H
+#define GAM200_INSIGHT_ENGINE_GRAPHICS_BUFFERS_INSTANCEBUFFER_H
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include <glad/glad.h> // for access to OpenGL API
+
+#include <array>
+
+namespace IS {
+
+    /*!
+     * \brief The InstanceBuffer class represents an instance vertex buffer written every draw.
+     *
+     * With buffer storage and direct state access available, the buffer holds REGION_COUNT
+     * regions and is mapped once, persistently and coherently. Each draw writes the next
+     * region and fences it, and a region is only waited on when the GPU has not finished
+     * the draw that used it REGION_COUNT draws ago, so writes normally never synchronize
+     * with the driver. The region is selected with the base instance of the draw call, so
+     * the VAO attribute setup stays the same for every region.
+     *
+     * Otherwise the buffer holds a single region which is orphaned before every map.
+     */
+    class InstanceBuffer {
+    public:
+        static constexpr int REGION_COUNT = 3; ///< Number of regions in flight.
+
+        /*!
+         * \brief Creates the buffer.
+         *
+         * \param element_size Size of one instance in bytes.
+         * \param capacity Maximum number of instances per draw.
+         */
+        void Create(GLsizeiptr element_size, GLsizei capacity);
+
+        /*!
+         * \brief Releases the fences, mapping and buffer.
+         */
+        void Destroy();
+
+        /*!
+         * \brief Gets a pointer to the next region to write, waiting if the GPU still reads it.
+         *
+         * \return Pointer to the region, nullptr if mapping failed.
+         */
+        void* Map();
+
+        /*!
+         * \brief Typed version of Map().
+         */
+        template <typename T>
+        T* Map() { return reinterpret_cast<T*>(Map()); }
+
+        /*!
+         * \brief Finishes writing the current region.
+         *
+         * \return Base instance to draw the current region with.
+         */
+        GLuint Unmap();
+
+        /*!
+         * \brief Fences the current region, called after the draw that reads it.
+         */
+        void Fence();
+
+        /*!
+         * \brief Gets the ID of the buffer object.
+         *
+         * \return The buffer ID.
+         */
+        GLuint GetID() const { return mBufferID; }
+
+        /*!
+         * \brief Gets the maximum number of instances per draw.
+         *
+         * \return The capacity.
+         */
+        GLsizei GetCapacity() const { return mCapacity; }
+
+        /*!
+         * \brief Checks if the buffer is persistently mapped.
+         *
+         * \return True if persistently mapped, false if orphaned every map.
+         */
+        bool IsPersistent() const { return mPersistent; }
+
+    private:
+        GLuint mBufferID{};                          ///< ID of the buffer object.
+        GLsizeiptr mRegionSize{};                    ///< Size of a region in bytes.
+        GLsizei mCapacity{};                         ///< Instances per region.
+        bool mPersistent{};                          ///< Whether the buffer is persistently mapped.
+        char* mMapped{};                             ///< Persistent mapping of all the regions.
+        int mRegion{};                               ///< Region currently written.
+        std::array<GLsync, REGION_COUNT> mFences{};  ///< Fence of the last draw reading each region.
+    };
+
+} // end namespace IS
+
+#endif // !GAM200_INSIGHT_ENGINE_GRAPHICS_BUFFERS_INSTANCEBUFFER_H
@@ -23,6 +23,7 @@
 #include "Physics/Dynamics/Body.h"
 #include "Physics/Collision/Collider.h"
 #include "Physics/System/Physics.h"
+#include "Physics/Collision/StaticGeometry.h"
 
 #include <stb_image.h>
 
@@ -48,19 +49,27 @@ namespace IS {
     Shader ISGraphics::quad_shader_pgm;
     Shader ISGraphics::non_quad_shader_pgm;
     Shader ISGraphics::glitched_quad_shader_pgm;
+    Shader ISGraphics::particle_shader_pgm;
+    Shader ISGraphics::glitched_particle_shader_pgm;
     Shader ISGraphics::quad_border_shader_pgm;
     Shader ISGraphics::light_shader_pgm;
+    Shader ISGraphics::light_mask_shader_pgm;
     Shader ISGraphics::videoShader;
 
     // Texture vector
     std::vector<Image> ISGraphics::textures;
+    TextureAtlas ISGraphics::textureAtlas;
 
     // instance data containers
-    std::multiset<Sprite::instanceData, Layering::GfxLayerComparator> ISGraphics::layeredQuadInstances;
+    InstanceQueue ISGraphics::layeredQuadInstances;
+    ParticleBatch ISGraphics::particleInstances;
     std::vector<Sprite::nonQuadInstanceData> ISGraphics::lineInstances;
     std::vector<Sprite::nonQuadInstanceData> ISGraphics::circleInstances;
     std::vector<Sprite::instanceData> ISGraphics::lightInstances;
     std::vector<float> ISGraphics::lightRadius;
+    LightMask ISGraphics::lightMask;
+    RenderQueue ISGraphics::mRenderQueue;
+    std::unique_ptr<RenderDevice> ISGraphics::mDevice;
 
     // Editor and entity camera
     // Camera ISGraphics::cameras[2];
@@ -72,6 +81,10 @@ namespace IS {
     bool ISGraphics::mGlitched = false;
     bool ISGraphics::mLightsOn = true;
     bool ISGraphics::mDisplayFPS = false;
+    bool ISGraphics::mCullingEnabled = true;
+    size_t ISGraphics::mVisibleSprites = 0;
+    size_t ISGraphics::mTotalSprites = 0;
+    std::vector<Entity> ISGraphics::mVisibleEntities;
 
     VideoPlayer ISGraphics::videoplayer;
     std::vector<VideoPlayer> ISGraphics::videos;
@@ -86,27 +99,35 @@ namespace IS {
         ISGraphics::Instance().Subscribe(MessageType::SpriteRemoved);
         ISGraphics::ClearLayers();
 
-        glClearColor(0.f, 0.f, 0.f, 0.f); // set background to black
-
         int width, height;
         InsightEngine::Instance().GetWindowSize(width, height);
-        glViewport(0, 0, width, height); // set viewport to window size
 
-        // init graphics systems
-        Mesh::initMeshes(meshes); // init 3 meshes
-        
-        // init quad shader
-        Shader::compileAllShaders();
-        Shader::setMainQuadShader(quad_shader_pgm);
-        
+        // a headless run keeps the CPU side only, the null device counts its frames
+        if (HasContext()) {
+            glClearColor(0.f, 0.f, 0.f, 0.f); // set background to black
+            glViewport(0, 0, width, height); // set viewport to window size
+
+            // init graphics systems
+            Mesh::initMeshes(meshes); // init 3 meshes
+
+            // init quad shader
+            Shader::compileAllShaders();
+            Shader::setMainQuadShader(quad_shader_pgm);
+        }
+        else {
+            IS_CORE_INFO("Graphics running on the null render device");
+        }
+
         // init all fonts
         InitFonts();
 
         // create framebuffer
-        Framebuffer::FramebufferProps props{ 0, 0, static_cast<GLuint>(width), static_cast<GLuint>(height) }; 
-        mFramebuffer = std::make_shared<Framebuffer>(props);
+        if (HasContext()) {
+            Framebuffer::FramebufferProps props{ 0, 0, static_cast<GLuint>(width), static_cast<GLuint>(height) };
+            mFramebuffer = std::make_shared<Framebuffer>(props);
 
-        mShaderFrameBuffer = Framebuffer(props);
+            mShaderFrameBuffer = Framebuffer(props);
+        }
 
         // initialize cameras
         for (int i{}; i < 2; ++i) {
@@ -152,7 +173,7 @@ namespace IS {
     void ISGraphics::Update(float delta_time) {
         // macro to catch graphics error
         GLenum error;
-        while ((error = glGetError()) != GL_NO_ERROR) {
+        while (HasContext() && (error = glGetError()) != GL_NO_ERROR) {
             IS_CORE_ERROR("OpenGL Error: {}", error);
         }
 
@@ -185,28 +206,61 @@ namespace IS {
     #endif // USING_IMGUI
 
 
-            // for each entity
+        // world region seen by the active camera, sprites outside it are culled
+        SpatialGrid::Bounds view_bounds;
+        bool culling = mCullingEnabled && GetViewBounds(view_bounds);
+        mVisibleSprites = mTotalSprites = 0;
+
+        // for each entity
         for (int i = 0; i < static_cast<int>(mLayers.size()); i++)
         {
             Layering& layers = mLayers[i];
             if (layers.mLayerActive == false) { 
                 continue; 
             }
+
+            // refresh the layer's grid and advance animations of every sprite, on screen or not
             for (auto& entity : layers.mLayerEntities) {
                 // get sprite and transform components
                 auto& sprite = engine.GetComponent<Sprite>(entity);
                 auto& trans = engine.GetComponent<Transform>(entity);
                 if (&trans == nullptr) { continue; }
 
-                // update sprite's transform [will be changed]
+                // update sprite's transform, the model transform and grid are only updated if it changed
                 sprite.followTransform(trans);
-                sprite.transform();
+                if (sprite.transform() || !layers.mGrid.IsCurrent(entity)) {
+                    layers.mGrid.Update(entity, GetSpriteBounds(sprite.model_TRS));
+                }
 
                 // if a sprite has animations, update their values with dt
                 if (!sprite.anims.empty()) {
                     sprite.anims[sprite.animation_index].updateAnimation(delta_time);
                 }
 
+                // lights can reach the screen from off screen sprites
+                if (sprite.primitive_type == GL_TRIANGLE_STRIP && engine.HasComponent<Light>(entity) && mLightsOn)
+                {
+                    auto& light = engine.GetComponent<Light>(entity);
+                    light.FollowTransform(trans.world_position);
+                    light.draw(static_cast<float>(entity));
+                }
+            }
+
+            // only visible sprites get an instance, in entity order like the layer set
+            mVisibleEntities.clear();
+            if (culling) {
+                layers.mGrid.Query(view_bounds, mVisibleEntities);
+                std::sort(mVisibleEntities.begin(), mVisibleEntities.end());
+            }
+            else {
+                mVisibleEntities.assign(layers.mLayerEntities.begin(), layers.mLayerEntities.end());
+            }
+            mTotalSprites += layers.mLayerEntities.size();
+            mVisibleSprites += mVisibleEntities.size();
+
+            for (auto& entity : mVisibleEntities) {
+                auto& sprite = engine.GetComponent<Sprite>(entity);
+
                 // quad entities
                 if (sprite.primitive_type == GL_TRIANGLE_STRIP) {
                     // if sprite and it's layer is to be rendered
@@ -215,39 +269,27 @@ namespace IS {
                     Sprite::instanceData instData;
 
                     // all quads will have xform, entityID, layer
-                    instData.model_to_ndc_xform = sprite.model_TRS.mdl_to_3dcam_to_ndc_xform;
+                    instData.rot_scale = sprite.model_TRS.mdl_rot_scale;
+                    instData.translation = sprite.model_TRS.mdl_translation;
                     instData.entID = static_cast<float>(entity);
                     instData.layer = sprite.layer;
 
-                    // quads with no texture
-                    if (sprite.img.texture_id == 0) {
-                        // copy sprite's color to instance data
-                        instData.color = sprite.color;
-                        // set to -1 to represent no texture
-                        instData.tex_index = -1.f;
-                    }
-                    // quad has a texture (animation too)
-                    else {
-                        // copy texture index
-                        instData.color = sprite.color;
-                        instData.tex_index = static_cast<float>(sprite.img.texture_index);
-                    }
+                    // copy sprite's color to instance data, quads with no texture keep atlas layer -1
+                    instData.color = sprite.color;
 
-                    // if sprite is an animation
-                    if (!sprite.anims.empty()) {
-                        // copy animation data
-                        instData.anim_frame_dimension = sprite.anims[sprite.animation_index].frame_dimension;
-                        instData.anim_frame_index = sprite.anims[sprite.animation_index].frame_index;
-                    }
-                    // insert to multiset with comparator function
-                    layeredQuadInstances.insert(instData);
-
-                    if (engine.HasComponent<Light>(entity) && mLightsOn)
-                    {
-                        auto& light = engine.GetComponent<Light>(entity);
-                        light.FollowTransform(trans.world_position);
-                        light.draw(static_cast<float>(entity));
+                    // quad has a texture (animation too)
+                    if (sprite.img.texture_id != 0) {
+                        // if sprite is an animation, select the current frame
+                        if (!sprite.anims.empty()) {
+                            Animation const& anim = sprite.anims[sprite.animation_index];
+                            instData.setTexture(sprite.img.texture_index, anim.frame_dimension, anim.frame_index);
+                        }
+                        else {
+                            instData.setTexture(sprite.img.texture_index);
+                        }
                     }
+                    // queue instance, sorted by layer when drawn
+                    layeredQuadInstances.push_back(instData);
                 }
 
                 // Debug draw
@@ -268,15 +310,74 @@ namespace IS {
             }
         }
 
+        // draw baked static geometry outline if activated
+        StaticGeometry::Instance().DrawChains();
+
         // update active camera
         cameras3D[Camera3D::mActiveCamera].Update();
 
+        // the frame is queued, sort and build its lights for Draw()
+        mRenderQueue.handoff();
+
         // ShaderEffect::shader_effect_update(delta_time); // not working yet
 
         videoplayer.update(delta_time);
     }
 
-    void ISGraphics::Draw([[maybe_unused]] float delta_time) {
+    bool ISGraphics::GetViewBounds(SpatialGrid::Bounds& bounds) {
+        glm::mat4 ndc_to_world = cameras3D[Camera3D::mActiveCamera].getInverseCameraToNDCXform();
+        glm::vec2 ndc_corners[4] = { { -1.f, -1.f }, { 1.f, -1.f }, { 1.f, 1.f }, { -1.f, 1.f } };
+
+        bounds.min = glm::vec2(std::numeric_limits<float>::max());
+        bounds.max = glm::vec2(std::numeric_limits<float>::lowest());
+        for (glm::vec2 const& corner : ndc_corners) {
+            // unproject the corner on the near and far planes and intersect the ray with the sprite plane
+            glm::vec4 near_point = ndc_to_world * glm::vec4(corner, -1.f, 1.f);
+            glm::vec4 far_point = ndc_to_world * glm::vec4(corner, 1.f, 1.f);
+            glm::vec3 origin = glm::vec3(near_point) / near_point.w;
+            glm::vec3 direction = glm::vec3(far_point) / far_point.w - origin;
+            if (std::abs(direction.z) < 1e-6f) {
+                return false;
+            }
+            float t = (1.f - origin.z) / direction.z;
+            if (t < 0.f) {
+                return false;
+            }
+            glm::vec2 hit = glm::vec2(origin + direction * t);
+            bounds.min = glm::min(bounds.min, hit);
+            bounds.max = glm::max(bounds.max, hit);
+        }
+
+        // small margin so sprites do not pop at the edges
+        glm::vec2 margin = (bounds.max - bounds.min) * .05f;
+        bounds.min -= margin;
+        bounds.max += margin;
+        return true;
+    }
+
+    SpatialGrid::Bounds ISGraphics::GetSpriteBounds(Transform const& trans) {
+        // the quad spans [-1, 1], so each extent is the sum of the absolute axis components
+        glm::vec4 const& m = trans.mdl_rot_scale;
+        glm::vec2 extents{ std::abs(m.x) + std::abs(m.z), std::abs(m.y) + std::abs(m.w) };
+        return { trans.mdl_translation - extents, trans.mdl_translation + extents };
+    }
+
+    void ISGraphics::Draw(float delta_time) {
+        // draw the frame handed off at the end of the update
+        mRenderQueue.begin_submit();
+        Device().draw_frame(delta_time);
+        mRenderQueue.end_submit();
+    }
+
+    RenderDevice& ISGraphics::Device() {
+        // assets are uploaded before graphics initializes, so the device cannot wait for it
+        if (!mDevice) {
+            mDevice = RenderDevice::create(InsightEngine::Instance().mHeadless);
+        }
+        return *mDevice;
+    }
+
+    void ISGraphics::DrawFrame([[maybe_unused]] float delta_time) {
         // get engine instance
         InsightEngine& engine = InsightEngine::Instance();
         
@@ -432,6 +533,9 @@ namespace IS {
     void ISGraphics::cleanup()
     {
         Mesh::cleanupMeshes(meshes); // delete array and buffers
+        textureAtlas.Clear();
+        lightMask.destroy();
+        Text::cleanupText(mTexts);
     }
 
     ImageData ISGraphics::loadImageData(const std::string& filepath) {
@@ -460,6 +564,16 @@ namespace IS {
             return;
         }
 
+        // no texture without a context, the image keeps its size
+        if (!HasContext()) {
+            stbi_image_free(data);
+            image.width = width;
+            image.height = height;
+            image.channels = channels;
+            image.mFileName = std::filesystem::path(filepath).filename().string();
+            return;
+        }
+
         // Enable blending for transparency
         glEnable(GL_BLEND);
         glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
@@ -513,6 +627,62 @@ namespace IS {
         image.texture_id = textureID;
     }
 
+    void ISGraphics::initCookedTexture(const std::string& filepath, Image& image, TextureAtlas::CookedImage const& cooked)
+    {
+        if (cooked.data.empty()) {
+            IS_CORE_ERROR("Failed to load image: {}", filepath.empty() ? "No filepath provided!" : filepath);
+            return;
+        }
+
+        // no texture without a context, the image keeps its size
+        if (!HasContext()) {
+            image.width = cooked.width;
+            image.height = cooked.height;
+            image.channels = cooked.channels;
+            image.mFileName = std::filesystem::path(filepath).filename().string();
+            return;
+        }
+
+        // Enable blending for transparency
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+        // create texture in the cooked format, cut out of the edge padding the atlas needs
+        // streamed images already own a texture object, it only lacks storage
+        GLuint textureID = image.texture_id;
+        if (!textureID) {
+            glCreateTextures(GL_TEXTURE_2D, 1, &textureID);
+        }
+        std::vector<uint8_t> data = TextureAtlas::Unpad(cooked);
+        glTextureStorage2D(textureID, 1, cooked.format, cooked.width, cooked.height);
+        if (cooked.format == GL_RGBA8) {
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+            glTextureSubImage2D(textureID, 0, 0, 0, cooked.width, cooked.height, GL_RGBA, GL_UNSIGNED_BYTE, data.data());
+        }
+        else {
+            // sizes that are not whole blocks are fine, the upload reaches the edge of the texture
+            glCompressedTextureSubImage2D(textureID, 0, 0, 0, cooked.width, cooked.height, cooked.format,
+                                          static_cast<GLsizei>(data.size()), data.data());
+        }
+        GLenum err = glGetError();
+        if (err != GL_NO_ERROR) {
+            IS_CORE_DEBUG("OpenGL error: {}", err);
+        }
+
+        // Set texture wrapping parameters to GL_CLAMP_TO_EDGE
+        glTextureParameteri(textureID, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTextureParameteri(textureID, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTextureParameteri(textureID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTextureParameteri(textureID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+        // update asset members
+        image.width = cooked.width;
+        image.height = cooked.height;
+        image.channels = cooked.channels;
+        image.mFileName = std::filesystem::path(filepath).filename().string();
+        image.texture_id = textureID;
+    }
+
     void ISGraphics::initFastTextures(const std::string& filepath, Image& image)
     {
         // get asset manager
@@ -528,6 +698,16 @@ namespace IS {
             return;
         }
 
+        // no texture without a context, the image keeps its size
+        if (!HasContext()) {
+            stbi_image_free(data);
+            image.width = width;
+            image.height = height;
+            image.channels = channels;
+            image.mFileName = std::filesystem::path(filepath).filename().string();
+            return;
+        }
+
         // Enable blending for transparency
         glEnable(GL_BLEND);
         glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
@@ -617,6 +797,12 @@ namespace IS {
     void ISGraphics::Shutdown()
     {
         VideoPlayer::unloadVideos();
+        if (!HasContext()) {
+            RenderDevice::Stats const& stats = Device().stats();
+            IS_CORE_INFO("Null render device: {} frames, {} draws, {} instances, {} bytes uploaded",
+                         stats.frames, stats.draws, stats.instances, stats.bytes_uploaded);
+            return;
+        }
         mFramebuffer->Destroy();
         mShaderFrameBuffer.Destroy();
     }
@@ -33,10 +33,16 @@
 #include "Graphics/System/Camera.h"
 #include "Graphics/System/Camera3D.h"
 #include "Graphics/System/Layering.h"
+#include "Graphics/System/InstanceQueue.h"
+#include "Graphics/System/ParticleBatch.h"
+#include "Graphics/System/LightMask.h"
+#include "Graphics/System/RenderQueue.h"
+#include "Graphics/System/TextureAtlas.h"
 #include "Graphics/System/ShaderEffects.h"
 #include "Graphics/System/Videoplayer.h"
 
 #include "Graphics/Buffers/Framebuffer.h"
+#include "Graphics/Core/RenderDevice.h"
 
 namespace IS {
 	/*!
@@ -88,6 +94,24 @@ namespace IS {
 		* \param delta_time The time difference since the last draw call.
 		*/
 		void Draw(float delta) override;
+
+		/*!
+		* \brief Draws the queued frame with OpenGL, called by the OpenGL render device.
+		* \param delta_time The time difference since the last draw call.
+		*/
+		static void DrawFrame(float delta_time);
+
+		/*!
+		 * \brief Gets the render device, picked on first use from the engine's run mode.
+		 * \return The render device.
+		 */
+		static RenderDevice& Device();
+
+		/*!
+		 * \brief Checks if the render device has an OpenGL context to create resources in.
+		 * \return True if OpenGL can be used, false in a headless run.
+		 */
+		static bool HasContext() { return Device().has_context(); }
 		
 		/*!
 		 * \brief Cleans up resources used by the ISGraphics system.
@@ -102,6 +126,14 @@ namespace IS {
 		static void initTextures(const std::string& filepath, Image& image, ImageData stbi_data);
 		static void initFastTextures(const std::string& filepath, Image& image);// needed for icons etc
 
+		/*!
+		* \brief Initializes a texture from a cooked image, padding included.
+		* \param filepath The file path to the source image.
+		* \param image An Image struct to store texture information.
+		* \param cooked The cooked image to upload.
+		*/
+		static void initCookedTexture(const std::string& filepath, Image& image, TextureAtlas::CookedImage const& cooked);
+
 		static ImageData loadImageData(const std::string& filepath);
 
 
@@ -125,11 +157,25 @@ namespace IS {
 		 *
 		 * @param lWidth - The desired line width to set in OpenGL.
 		 */
-		static void setLineWidth(float lWidth) { glLineWidth(lWidth); }
+		static void setLineWidth(float lWidth) { if (HasContext()) glLineWidth(lWidth); }
 		
 		static void deleteTexture(Image& image);
 		static void Shutdown();
 
+		/*!
+		 * \brief Gets the world region seen by the active camera on the sprite plane (z = 1).
+		 * \param bounds Output axis aligned bounds of the region.
+		 * \return False if the view does not hit the plane everywhere (tilted camera), true otherwise.
+		 */
+		static bool GetViewBounds(SpatialGrid::Bounds& bounds);
+
+		/*!
+		 * \brief Gets the world bounds of a sprite from its cached model transform.
+		 * \param trans The transform of the sprite, its cached model transform must be up to date.
+		 * \return Axis aligned bounds of the rotated quad.
+		 */
+		static SpatialGrid::Bounds GetSpriteBounds(Transform const& trans);
+
 		/// Static objects ///
 
 		// Frame Buffer
@@ -144,20 +190,28 @@ namespace IS {
 		static Shader main_quad_shader;
 		static Shader quad_shader_pgm;
 		static Shader glitched_quad_shader_pgm;
+		static Shader particle_shader_pgm;
+		static Shader glitched_particle_shader_pgm;
 		static Shader non_quad_shader_pgm;
 		static Shader quad_border_shader_pgm;
 		static Shader light_shader_pgm;
+		static Shader light_mask_shader_pgm;
 		static Shader videoShader;
 
 		// Texture vector
 		static std::vector<Image> textures;
+		static TextureAtlas textureAtlas;		// Every texture packed in one array texture, drawn by the quads
 
 		// instance data containers
-		static std::multiset<Sprite::instanceData, Layering::GfxLayerComparator> layeredQuadInstances;
+		static InstanceQueue layeredQuadInstances;
+		static ParticleBatch particleInstances;
 		static std::vector<Sprite::nonQuadInstanceData> lineInstances;
 		static std::vector<Sprite::nonQuadInstanceData> circleInstances;
 		static std::vector<Sprite::instanceData> lightInstances;
 		static std::vector<float> lightRadius;
+		static LightMask lightMask;				// Lit areas of the lights with shadows, read by the lighting pass
+		static RenderQueue mRenderQueue;		// Hands the containers above over to the frame's draw
+		static std::unique_ptr<RenderDevice> mDevice;	// Draws or counts the frames, see Device()
 
 		// Editor and entity camera
 		static Camera3D cameras3D[2];
@@ -174,6 +228,12 @@ namespace IS {
 		static bool mLightsOn;
 		static bool mDisplayFPS;
 
+		// Culling
+		static bool mCullingEnabled;			// Skip sprites outside the active camera's view
+		static size_t mVisibleSprites;			// Sprites that passed culling last update
+		static size_t mTotalSprites;			// Sprites in active layers last update
+		static std::vector<Entity> mVisibleEntities;	// Scratch list of the visible sprites of a layer
+
 		// Layers
 		static std::vector<Layering>mLayers;
 		
@@ -0,0 +1,93 @@
+/*!
+ * \file RenderDevice.cpp
+ * \author Koh Yan Khang, yankhang.k@digipen.edu
+ * \par Course: CSD2451
+ * \date 19-10-2026
+ * \brief
+ * This source file defines the RenderDevice backends, the OpenGL device and the null
+ * device that counts frames without a graphics context.
+ *
+ * \copyright
+ * All content (C) 2024 DigiPen Institute of Technology Singapore.
+ * All rights reserved.
+ * Reproduction or disclosure of this file or its contents without the prior written
+ * consent of DigiPen Institute of Technology is prohibited.
+ *____________________________________________________________________________*/
+
+ /*                                                                   includes
+ ----------------------------------------------------------------------------- */
+#include "Pch.h"
+#include "RenderDevice.h"
+#include "Graphics/Core/Graphics.h"
+#include "Graphics/System/Light.h"
+
+#include <algorithm>
+
+namespace IS {
+    std::unique_ptr<RenderDevice> RenderDevice::create(bool headless) {
+        if (headless) {
+            return std::make_unique<NullRenderDevice>();
+        }
+        return std::make_unique<GLRenderDevice>();
+    }
+
+    void GLRenderDevice::draw_frame(float delta_time) {
+        ISGraphics::DrawFrame(delta_time);
+        ++mStats.frames;
+    }
+
+    void NullRenderDevice::draw_frame([[maybe_unused]] float delta_time) {
+        ++mStats.frames;
+
+        count_layered_quads();
+
+        // the lighting pass draws the light mask and one screen quad
+        if (ISGraphics::mLightsOn) {
+            mStats.draws += 2;
+            mStats.instances += Light::lightPos.size();
+        }
+        ISGraphics::lightRadius.clear();
+        ISGraphics::lightInstances.clear();
+        Light::lightPos.clear();
+        Light::lightClr.clear();
+        Light::shadowLineSegments.clear();
+
+        // debug lines and circles are copied as is, one draw each
+        for (auto* instances : { &ISGraphics::lineInstances, &ISGraphics::circleInstances }) {
+            if (!instances->empty()) {
+                ++mStats.draws;
+                mStats.instances += instances->size();
+                mStats.bytes_uploaded += instances->size() * sizeof(Sprite::nonQuadInstanceData);
+            }
+            instances->clear();
+        }
+
+        // glyphs are laid out and gathered into batches, only the draw is left out
+        size_t glyphs{}, batches{};
+        mStats.bytes_uploaded += Text::gatherAllText(ISGraphics::mTexts, glyphs, batches);
+        mStats.instances += glyphs;
+        mStats.draws += batches;
+    }
+
+    void NullRenderDevice::count_layered_quads() {
+        InstanceQueue& quads = ISGraphics::layeredQuadInstances;
+        ParticleBatch& particles = ISGraphics::particleInstances;
+
+        // same sorted writes as into the mapped instance buffers
+        mQuads.resize(std::min(quads.size(), InstanceQueue::MAX_INSTANCES));
+        size_t quad_count = quads.write_sorted(mQuads.data(), mQuads.size());
+        size_t particle_count{};
+        if (!particles.empty()) {
+            mParticles.resize(std::min(particles.size(), ParticleBatch::MAX_INSTANCES));
+            particle_count = particles.write_sorted(mParticles.data(), mParticles.size());
+        }
+        mStats.instances += quad_count + particle_count;
+        mStats.bytes_uploaded += quad_count * sizeof(Sprite::instanceData) + particle_count * sizeof(ParticleInstance);
+
+        // the same walk as the GL draw, one draw per run of layers that only one of the streams has
+        walk_layer_runs(quads.layer_runs(), particles.layer_runs(), [this](bool, size_t, size_t) { ++mStats.draws; });
+
+        quads.clear();
+        particles.clear();
+    }
+} // end namespace IS
@@ -0,0 +1,109 @@
+/*!
+ * \file RenderDevice.h
+ * \author Koh Yan Khang, yankhang.k@digipen.edu
+ * \par Course: CSD2451
+ * \date 19-10-2026
+ * \brief
+ * This header file declares the RenderDevice interface and its two backends, the
+ * OpenGL device and the null device that counts frames without a graphics context.
+ *
+ * \copyright
+ * All content (C) 2024 DigiPen Institute of Technology Singapore.
+ * All rights reserved.
+ * Reproduction or disclosure of this file or its contents without the prior written
+ * consent of DigiPen Institute of Technology is prohibited.
+ *____________________________________________________________________________*/
+
+ /*                                                                      guard
+ ----------------------------------------------------------------------------- */
+#ifndef GAM200_INSIGHT_ENGINE_GRAPHICS_CORE_RENDER_DEVICE_H
+#define GAM200_INSIGHT_ENGINE_GRAPHICS_CORE_RENDER_DEVICE_H
+
+ /*                                                                   includes
+ ----------------------------------------------------------------------------- */
+#include "Graphics/System/Sprite.h"
+#include "Graphics/System/ParticleBatch.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace IS {
+    /*!
+     * \brief Backend a frame is drawn with.
+     *
+     * Systems queue a frame into the graphics statics the same way whichever device is
+     * in use, and the device consumes it in draw_frame(). The OpenGL device draws it.
+     * The null device runs the same sorting and batching on the CPU and only counts the
+     * draws, instances and bytes it would have sent, so scenes can be run and measured
+     * without a window or an OpenGL context.
+     */
+    class RenderDevice {
+    public:
+        /*!
+         * \brief Totals of the frames drawn since the last reset.
+         */
+        struct Stats {
+            uint64_t frames{};
+            uint64_t draws{};               // Draw calls
+            uint64_t instances{};           // Quads, particles, lines, circles, lights and glyphs
+            uint64_t bytes_uploaded{};      // Instance data streamed to buffers
+        };
+
+        virtual ~RenderDevice() = default;
+
+        /*!
+         * \brief Creates the device of a run mode.
+         * \param headless True for the null device, false for the OpenGL device.
+         * \return The device.
+         */
+        static std::unique_ptr<RenderDevice> create(bool headless);
+
+        /*!
+         * \brief Whether the device has an OpenGL context. Textures, buffers, shaders and
+         * framebuffers are only created if it does.
+         */
+        virtual bool has_context() const = 0;
+
+        /*!
+         * \brief Consumes the frame queued in the graphics statics, which are empty afterwards.
+         * \param delta_time The time difference since the last draw.
+         */
+        virtual void draw_frame(float delta_time) = 0;
+
+        Stats const& stats() const { return mStats; }
+        void reset_stats() { mStats = {}; }
+
+    protected:
+        Stats mStats;
+    };
+
+    /*!
+     * \brief Draws the frames with OpenGL, only the frame count is kept.
+     */
+    class GLRenderDevice final : public RenderDevice {
+    public:
+        bool has_context() const override { return true; }
+        void draw_frame(float delta_time) override;
+    };
+
+    /*!
+     * \brief Counts what the frames would have drawn, without touching OpenGL.
+     */
+    class NullRenderDevice final : public RenderDevice {
+    public:
+        bool has_context() const override { return false; }
+        void draw_frame(float delta_time) override;
+
+    private:
+        /*!
+         * \brief Counts the quads and particles, walking their layer runs like the quad pass does.
+         */
+        void count_layered_quads();
+
+        std::vector<Sprite::instanceData> mQuads;   // Scratch the sorted quads are written to
+        std::vector<ParticleInstance> mParticles;   // Scratch the sorted particles are written to
+    };
+} // end namespace IS
+
+#endif // !GAM200_INSIGHT_ENGINE_GRAPHICS_CORE_RENDER_DEVICE_H
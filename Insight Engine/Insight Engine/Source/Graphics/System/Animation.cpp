@@ -72,17 +72,14 @@ namespace IS {
             if (Sprite::layersToIgnore.find(layer) == Sprite::layersToIgnore.end()) {
 
                 Transform quadTRS(pos, rotation, scale);
-                glm::mat4 world_to_NDC_xform = quadTRS.Return3DXformMatrix();
 
                 Sprite::instanceData instData;
                 instData.color = { 1.f, 1.f, 1.f, alpha };
-                instData.tex_index = static_cast<float>(texture.texture_index);
-                instData.model_to_ndc_xform = world_to_NDC_xform;
+                instData.setTexture(texture.texture_index, this->frame_dimension, this->frame_index);
+                instData.setTransform(quadTRS);
                 instData.layer = layer;
-                instData.anim_frame_dimension = this->frame_dimension;
-                instData.anim_frame_index = this->frame_index;
 
-                ISGraphics::layeredQuadInstances.insert(instData);
+                ISGraphics::layeredQuadInstances.push_back(instData);
 
             }
         }   
@@ -187,7 +187,7 @@ namespace IS {
 		static const float CAMERA_FOV_MIN; ///< minimum fov
 		static const float CAMERA_FOV_MAX; ///< maximum fov
 
-		const glm::vec3 mUp = glm::vec3(0.f, 1.f, 0.f);
+		glm::vec3 mUp = glm::vec3(0.f, 1.f, 0.f);
 		glm::vec3 mFront = glm::vec3(0.f, 0.f, -1.f);	
 
 		float mAspectRatio{};
@@ -0,0 +1,102 @@
+/*!
+ * \file InstanceQueue.cpp
+ * \author Koh Yan Khang, yankhang.k@digipen.edu
+ * \par Course: CSD2451
+ * \date 19-10-2026
+ * \brief
+ * This source file defines the InstanceQueue class, which radix sorts the quad
+ * instances of a frame by layer.
+ *
+ * \copyright
+ * All content (C) 2024 DigiPen Institute of Technology Singapore.
+ * All rights reserved.
+ * Reproduction or disclosure of this file or its contents without the prior written
+ * consent of DigiPen Institute of Technology is prohibited.
+ *____________________________________________________________________________*/
+
+ /*                                                                   includes
+ ----------------------------------------------------------------------------- */
+#include "Pch.h"
+#include "InstanceQueue.h"
+
+#include <array>
+
+namespace IS {
+    void InstanceQueue::push_back(Sprite::instanceData const& instance) {
+        // flip the sign bit so negative layers sort before positive ones
+        uint64_t layer = static_cast<uint32_t>(instance.layer) ^ 0x8000'0000u;
+        mKeys.emplace_back((layer << 32) | static_cast<uint32_t>(mInstances.size()));
+        mInstances.emplace_back(instance);
+        mSorted = false;
+    }
+
+    void InstanceQueue::sort() {
+        if (!mSorted) {
+            sort_keys();
+            mSorted = true;
+        }
+    }
+
+    size_t InstanceQueue::write_sorted(Sprite::instanceData* dest, size_t capacity) {
+        if (mInstances.size() > capacity) {
+            IS_CORE_WARN("{} quad instances exceed the instance buffer size of {}, extra quads are dropped", mInstances.size(), capacity);
+        }
+
+        sort();
+
+        // gather the instances in sorted order straight into the destination
+        size_t count = std::min(mKeys.size(), capacity);
+        mRuns.clear();
+        for (size_t i = 0; i < count; ++i) {
+            Sprite::instanceData const& instance = mInstances[static_cast<uint32_t>(mKeys[i])];
+            dest[i] = instance;
+            if (mRuns.empty() || mRuns.back().layer != instance.layer) {
+                mRuns.push_back({ instance.layer, i, 0 });
+            }
+            ++mRuns.back().count;
+        }
+        return count;
+    }
+
+    void InstanceQueue::clear() {
+        mInstances.clear();
+        mKeys.clear();
+        mRuns.clear();
+        mSorted = false;
+    }
+
+    void InstanceQueue::sort_keys() {
+        // the submission index is already ascending, so only the layer bytes need sorting
+        constexpr int FIRST_BYTE = 4, LAST_BYTE = 8;
+        if (mKeys.empty()) {
+            return;
+        }
+
+        mScratch.resize(mKeys.size());
+        for (int byte = FIRST_BYTE; byte < LAST_BYTE; ++byte) {
+            int shift = byte * 8;
+
+            std::array<size_t, 256> offsets{};
+            for (uint64_t key : mKeys) {
+                ++offsets[(key >> shift) & 0xFF];
+            }
+
+            // every key has the same byte, the pass would not move anything
+            if (offsets[(mKeys.front() >> shift) & 0xFF] == mKeys.size()) {
+                continue;
+            }
+
+            size_t total = 0;
+            for (size_t& offset : offsets) {
+                size_t count = offset;
+                offset = total;
+                total += count;
+            }
+
+            for (uint64_t key : mKeys) {
+                mScratch[offsets[(key >> shift) & 0xFF]++] = key;
+            }
+            mKeys.swap(mScratch);
+        }
+    }
+} // end namespace IS
@@ -0,0 +1,137 @@
+/*!
+ * \file InstanceQueue.h
+ * \author Koh Yan Khang, yankhang.k@digipen.edu
+ * \par Course: CSD2451
+ * \date 19-10-2026
+ * \brief
+ * This header file declares the InstanceQueue class, a flat per-frame list of quad
+ * instances that is radix sorted by layer before being written to the instance VBO.
+ *
+ * \copyright
+ * All content (C) 2024 DigiPen Institute of Technology Singapore.
+ * All rights reserved.
+ * Reproduction or disclosure of this file or its contents without the prior written
+ * consent of DigiPen Institute of Technology is prohibited.
+ *____________________________________________________________________________*/
+
+ /*                                                                      guard
+ ----------------------------------------------------------------------------- */
+#ifndef GAM200_INSIGHT_ENGINE_GRAPHICS_SYSTEM_INSTANCE_QUEUE_H
+#define GAM200_INSIGHT_ENGINE_GRAPHICS_SYSTEM_INSTANCE_QUEUE_H
+
+ /*                                                                   includes
+ ----------------------------------------------------------------------------- */
+#include "Sprite.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace IS {
+    /*!
+     * \brief A range of sorted instances that share a layer.
+     */
+    struct LayerRun {
+        int layer{};
+        size_t first{};
+        size_t count{};
+    };
+
+    /*!
+     * \brief Walks the layer runs of the quad and particle streams in drawing order.
+     *
+     * Particles of a layer go under its sprites. Consecutive runs of one stream are
+     * contiguous in its instance buffer, so they are merged into one draw.
+     *
+     * \param quad_runs The layer runs of the quads.
+     * \param particle_runs The layer runs of the particles.
+     * \param draw Called as draw(particles, first, count) for each draw, particles is true for the particle stream.
+     */
+    template <typename DrawFn>
+    void walk_layer_runs(std::vector<LayerRun> const& quad_runs, std::vector<LayerRun> const& particle_runs, DrawFn&& draw) {
+        size_t quad_run{}, particle_run{};
+        while (quad_run < quad_runs.size() || particle_run < particle_runs.size()) {
+            bool draw_quads = particle_run == particle_runs.size() ||
+                (quad_run < quad_runs.size() && quad_runs[quad_run].layer < particle_runs[particle_run].layer);
+
+            if (draw_quads) {
+                size_t first = quad_runs[quad_run].first, count{};
+                while (quad_run < quad_runs.size() &&
+                       (particle_run == particle_runs.size() || quad_runs[quad_run].layer < particle_runs[particle_run].layer)) {
+                    count += quad_runs[quad_run++].count;
+                }
+                draw(false, first, count);
+            }
+            else {
+                size_t first = particle_runs[particle_run].first, count{};
+                while (particle_run < particle_runs.size() &&
+                       (quad_run == quad_runs.size() || particle_runs[particle_run].layer <= quad_runs[quad_run].layer)) {
+                    count += particle_runs[particle_run++].count;
+                }
+                draw(true, first, count);
+            }
+        }
+    }
+
+    /*!
+     * \brief Collects the quad instances of a frame and sorts them by layer.
+     *
+     * Instances are appended to a flat vector together with a 64-bit sort key holding the
+     * layer in the upper 32 bits and the submission index in the lower 32 bits, so quads
+     * within a layer keep the order they were submitted in (same result as the multiset
+     * this replaces). The keys are sorted with an LSD radix sort over the layer bytes,
+     * skipping bytes that are the same for every key, and the sorted instances are copied
+     * straight into the destination buffer. All storage is reused between frames.
+     */
+    class InstanceQueue {
+    public:
+        static constexpr size_t MAX_INSTANCES = 100'000;   // Size of the quad instance VBO
+
+        /*!
+         * \brief Appends an instance to the queue.
+         * \param instance The instance data to draw.
+         */
+        void push_back(Sprite::instanceData const& instance);
+
+        /*!
+         * \brief Sorts the queued instances by layer, nothing to do if already sorted.
+         * Can run on another thread than the one that writes the instances out.
+         */
+        void sort();
+
+        /*!
+         * \brief Sorts the queued instances by layer and writes them to a buffer.
+         * \param dest The buffer to write to, usually the mapped instance VBO.
+         * \param capacity Maximum number of instances the buffer can hold.
+         * \return The number of instances written.
+         */
+        size_t write_sorted(Sprite::instanceData* dest, size_t capacity);
+
+        /*!
+         * \brief Gets the layer runs of the last write_sorted(), in drawing order.
+         * \return The runs.
+         */
+        std::vector<LayerRun> const& layer_runs() const { return mRuns; }
+
+        /*!
+         * \brief Removes all the queued instances, keeping the allocated storage.
+         */
+        void clear();
+
+        size_t size() const { return mInstances.size(); }
+        bool empty() const { return mInstances.empty(); }
+
+    private:
+        /*!
+         * \brief Stable radix sort of mKeys by the layer bits.
+         */
+        void sort_keys();
+
+        std::vector<Sprite::instanceData> mInstances;   // Instances in submission order
+        std::vector<uint64_t> mKeys;                    // Layer and submission index of each instance
+        std::vector<uint64_t> mScratch;                 // Scratch buffer for the radix passes
+        std::vector<LayerRun> mRuns;                    // Layer runs of the last write
+        bool mSorted{};                                 // mKeys is sorted
+    };
+} // end namespace IS
+
+#endif // !GAM200_INSIGHT_ENGINE_GRAPHICS_SYSTEM_INSTANCE_QUEUE_H
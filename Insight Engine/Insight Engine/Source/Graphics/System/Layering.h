@@ -4,10 +4,10 @@
  * \par Course: CSD2451
  * \date 25-11-2023
  * \brief
- * This source file defines the Layering class, and its comparator.
+ * This source file defines the Layering class.
  *
- * The Layering class is used to group entities into layers, and sort them by their layer value.
- * The comparator is used to sort the entities in the layer by their layer value.
+ * The Layering class is used to group entities into layers. Quad instances are sorted
+ * by their layer value in InstanceQueue.
  * 
  * \copyright
  * All content (C) 2024 DigiPen Institute of Technology Singapore.
@@ -20,30 +20,12 @@
 #define GAM200_INSIGHT_ENGINE_GRAPHICS_SYSTEM_LAYERING_H
 
 #include "Sprite.h"
+#include "SpatialGrid.h"
 
 namespace IS {
     // Layering class
     class Layering {
     public:
-        struct GfxLayerComparator {
-            /*!
-             * \brief Compares two Entity objects.
-             *
-             * Determines the ordering of two Entity objects based on a specific
-             * comparison criterion, such as their IDs, names, or any other relevant
-             * attributes. The specific comparison logic should be defined within
-             * this method, ensuring that it provides a strict weak ordering.
-             *
-             * \param lhs The left-hand side Entity object in the comparison.
-             * \param rhs The right-hand side Entity object in the comparison.
-             * \return True if lhs should come before rhs according to the defined
-             *         criterion; otherwise, false.
-             */
-            bool operator()(Sprite::instanceData const& a, Sprite::instanceData const& b) const {
-                return a.layer < b.layer;
-            }
-        };
-
         /*!
          * \brief Adds an entity to the layer's entity set.
          *
@@ -71,11 +53,13 @@ namespace IS {
                 return;
             }
             mLayerEntities.erase(val);
+            mGrid.Remove(entity);
         }
 
         bool mLayerActive=true;
         std::string mName = "";
         std::set<Entity> mLayerEntities;
+        SpatialGrid mGrid;              // World bounds of the layer's sprites, used for culling
 
         /*!
          * \brief Serializes the layer's state to JSON format.
@@ -36,7 +36,7 @@ namespace IS {
 			lightData.color = { mHue.x, mHue.y, mHue.z, mIntensity };
 
 			Transform lightXform(mPosition, 0.f, { mSize, mSize });
-			lightData.model_to_ndc_xform = lightXform.Return3DXformMatrix();
+			lightData.setTransform(lightXform);
 			lightData.entID = attachedEntID; // to allow mousepicking past light
 
 			lightPos.emplace_back(mPosition.x, mPosition.y);
@@ -58,7 +58,7 @@ namespace IS {
 		lightData.color = { r, g, b, a };
 
 		Transform lightXform(position, 0.f, { size, size });
-		lightData.model_to_ndc_xform = lightXform.Return3DXformMatrix();
+		lightData.setTransform(lightXform);
 		lightData.entID = 20000; // to allow mousepicking past light
 
 		lightPos.emplace_back(position.x, position.y);
@@ -0,0 +1,309 @@
+/*!
+ * \file LightMask.cpp
+ * \author Koh Yan Khang, yankhang.k@digipen.edu
+ * \par Course: CSD2451
+ * \date 19-10-2026
+ * \brief
+ * This source file defines the LightMask class, which builds the visibility polygons
+ * of the lights and renders them into the light mask.
+ *
+ * \copyright
+ * All content (C) 2024 DigiPen Institute of Technology Singapore.
+ * All rights reserved.
+ * Reproduction or disclosure of this file or its contents without the prior written
+ * consent of DigiPen Institute of Technology is prohibited.
+ *____________________________________________________________________________*/
+
+ /*                                                                   includes
+ ----------------------------------------------------------------------------- */
+#include "Pch.h"
+#include "LightMask.h"
+#include "Graphics/Core/Graphics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace IS {
+    namespace {
+        constexpr float RAY_OFFSET = 1e-4f;         // Angle either side of an endpoint, to see past it
+        constexpr int MAX_SEGMENT_CELLS = 64;       // Segments spanning more cells are not gridded
+
+        float cross(glm::vec2 a, glm::vec2 b) { return a.x * b.y - a.y * b.x; }
+
+        bool overlaps(glm::vec4 const& segment, glm::vec2 min, glm::vec2 max) {
+            return std::max(segment.x, segment.z) >= min.x && std::min(segment.x, segment.z) <= max.x &&
+                   std::max(segment.y, segment.w) >= min.y && std::min(segment.y, segment.w) <= max.y;
+        }
+    }
+
+    void LightMask::build(std::vector<glm::vec2> const& positions, std::vector<glm::vec4> const& colors,
+                          std::vector<float> const& radii, std::vector<glm::vec4> const& segments) {
+        size_t light_count = std::min({ positions.size(), colors.size(), radii.size() });
+
+        index_segments(segments);
+        mPolygons.resize(light_count);
+        mVertices.clear();
+        mRebuilt = 0;
+
+        for (size_t i = 0; i < light_count; ++i) {
+            glm::vec2 const position = positions[i];
+            float const radius = radii[i];
+
+            // FNV-1a of the segments around the light, any change nearby rebuilds the polygon
+            query_segments(segments, position, radius);
+            uint64_t hash = 14695981039346656037ull;
+            for (uint32_t index : mNearby) {
+                uint32_t bits[4];
+                std::memcpy(bits, &segments[index], sizeof(bits));
+                for (uint32_t word : bits) {
+                    hash = (hash ^ word) * 1099511628211ull;
+                }
+            }
+
+            CachedPolygon& polygon = mPolygons[i];
+            if (polygon.position != position || polygon.radius != radius || polygon.segment_hash != hash) {
+                build_polygon(segments, position, radius, polygon.points);
+                polygon.position = position;
+                polygon.radius = radius;
+                polygon.segment_hash = hash;
+                ++mRebuilt;
+            }
+
+            // triangle fan around the light, as a list so every light goes in one draw
+            LightVertex const center{ position, position, colors[i], radius };
+            size_t point_count = polygon.points.size();
+            for (size_t k = 0; k < point_count; ++k) {
+                LightVertex edge_start = center, edge_end = center;
+                edge_start.position = polygon.points[k];
+                edge_end.position = polygon.points[(k + 1) % point_count];
+                mVertices.push_back(center);
+                mVertices.push_back(edge_start);
+                mVertices.push_back(edge_end);
+            }
+        }
+        mFanVertexCount = mVertices.size();
+
+        // unshadowed squares for the distance to the nearest light
+        for (size_t i = 0; i < light_count; ++i) {
+            glm::vec2 const position = positions[i];
+            float const radius = radii[i];
+            LightVertex vertex{ position, position, colors[i], radius };
+            for (glm::vec2 corner : { glm::vec2(-1.f, -1.f), glm::vec2(1.f, -1.f), glm::vec2(1.f, 1.f),
+                                      glm::vec2(-1.f, -1.f), glm::vec2(1.f, 1.f), glm::vec2(-1.f, 1.f) }) {
+                vertex.position = position + corner * radius;
+                mVertices.push_back(vertex);
+            }
+        }
+    }
+
+    void LightMask::render(glm::mat4 const& view_projection, glm::ivec2 resolution) {
+        create(resolution);
+
+        GLint previous_framebuffer{};
+        GLint previous_viewport[4]{};
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previous_framebuffer);
+        glGetIntegerv(GL_VIEWPORT, previous_viewport);
+
+        // no light is 1 in alpha, as far from a light as it gets
+        GLfloat const clear_color[4]{ 0.f, 0.f, 0.f, 1.f };
+        GL_CALL(glClearNamedFramebufferfv(mFramebuffer, GL_COLOR, 0, clear_color));
+
+        if (!mVertices.empty()) {
+            GL_CALL(glNamedBufferData(mVBO, static_cast<GLsizeiptr>(sizeof(LightVertex) * mVertices.size()), mVertices.data(), GL_STREAM_DRAW));
+
+            GL_CALL(glBindFramebuffer(GL_FRAMEBUFFER, mFramebuffer));
+            GL_CALL(glViewport(0, 0, mSize.x, mSize.y));
+
+            ISGraphics::light_mask_shader_pgm.use();
+            ISGraphics::light_mask_shader_pgm.setUniform("uViewProj", view_projection);
+            GL_CALL(glBindVertexArray(mVAO));
+
+            // lights add up in rgb, alpha keeps the nearest
+            GL_CALL(glBlendEquationSeparate(GL_FUNC_ADD, GL_MIN));
+            GL_CALL(glBlendFunc(GL_ONE, GL_ONE));
+
+            GL_CALL(glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_FALSE));
+            GL_CALL(glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(mFanVertexCount)));
+            GL_CALL(glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_TRUE));
+            GL_CALL(glDrawArrays(GL_TRIANGLES, static_cast<GLint>(mFanVertexCount), static_cast<GLsizei>(mVertices.size() - mFanVertexCount)));
+
+            GL_CALL(glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE));
+            GL_CALL(glBlendEquation(GL_FUNC_ADD));
+            GL_CALL(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+
+            GL_CALL(glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(previous_framebuffer)));
+            GL_CALL(glViewport(previous_viewport[0], previous_viewport[1], previous_viewport[2], previous_viewport[3]));
+        }
+    }
+
+    void LightMask::destroy() {
+        if (mTexture) glDeleteTextures(1, &mTexture);
+        if (mFramebuffer) glDeleteFramebuffers(1, &mFramebuffer);
+        if (mVBO) glDeleteBuffers(1, &mVBO);
+        if (mVAO) glDeleteVertexArrays(1, &mVAO);
+        mTexture = mFramebuffer = mVBO = mVAO = 0;
+        mSize = {};
+        mPolygons.clear();
+    }
+
+    void LightMask::index_segments(std::vector<glm::vec4> const& segments) {
+        // keep the cell vectors between frames, drop them if old cells pile up
+        if (mCells.size() > 4 * segments.size() + 64) {
+            mCells.clear();
+        }
+        for (auto& cell : mCells) {
+            cell.second.clear();
+        }
+        mOversized.clear();
+        mSegmentStamps.assign(segments.size(), 0);
+        mStamp = 0;
+
+        for (uint32_t index = 0; index < static_cast<uint32_t>(segments.size()); ++index) {
+            glm::vec4 const& segment = segments[index];
+            int min_x = static_cast<int>(std::floor(std::min(segment.x, segment.z) / CELL_SIZE));
+            int min_y = static_cast<int>(std::floor(std::min(segment.y, segment.w) / CELL_SIZE));
+            int max_x = static_cast<int>(std::floor(std::max(segment.x, segment.z) / CELL_SIZE));
+            int max_y = static_cast<int>(std::floor(std::max(segment.y, segment.w) / CELL_SIZE));
+            if (static_cast<int64_t>(max_x - min_x + 1) * (max_y - min_y + 1) > MAX_SEGMENT_CELLS) {
+                mOversized.push_back(index);
+                continue;
+            }
+            for (int y = min_y; y <= max_y; ++y) {
+                for (int x = min_x; x <= max_x; ++x) {
+                    mCells[cell_key(x, y)].push_back(index);
+                }
+            }
+        }
+    }
+
+    void LightMask::query_segments(std::vector<glm::vec4> const& segments, glm::vec2 position, float radius) {
+        glm::vec2 const min = position - radius;
+        glm::vec2 const max = position + radius;
+        ++mStamp;
+        mNearby.clear();
+
+        int min_x = static_cast<int>(std::floor(min.x / CELL_SIZE));
+        int min_y = static_cast<int>(std::floor(min.y / CELL_SIZE));
+        int max_x = static_cast<int>(std::floor(max.x / CELL_SIZE));
+        int max_y = static_cast<int>(std::floor(max.y / CELL_SIZE));
+        for (int y = min_y; y <= max_y; ++y) {
+            for (int x = min_x; x <= max_x; ++x) {
+                auto it = mCells.find(cell_key(x, y));
+                if (it == mCells.end()) {
+                    continue;
+                }
+                for (uint32_t index : it->second) {
+                    if (mSegmentStamps[index] != mStamp) {
+                        mSegmentStamps[index] = mStamp;
+                        if (overlaps(segments[index], min, max)) {
+                            mNearby.push_back(index);
+                        }
+                    }
+                }
+            }
+        }
+        for (uint32_t index : mOversized) {
+            if (overlaps(segments[index], min, max)) {
+                mNearby.push_back(index);
+            }
+        }
+
+        // index order makes the hash independent of the cell walk
+        std::sort(mNearby.begin(), mNearby.end());
+    }
+
+    void LightMask::build_polygon(std::vector<glm::vec4> const& segments, glm::vec2 position, float radius, std::vector<glm::vec2>& points) {
+        points.clear();
+        mAngles.clear();
+
+        auto add_angles = [this, position](glm::vec2 point) {
+            float angle = std::atan2(point.y - position.y, point.x - position.x);
+            mAngles.push_back(angle - RAY_OFFSET);
+            mAngles.push_back(angle);
+            mAngles.push_back(angle + RAY_OFFSET);
+        };
+
+        // the light's square bounds the polygon, so every ray hits something
+        for (glm::vec2 corner : { glm::vec2(-1.f, -1.f), glm::vec2(1.f, -1.f), glm::vec2(1.f, 1.f), glm::vec2(-1.f, 1.f) }) {
+            add_angles(position + corner * radius);
+        }
+        for (uint32_t index : mNearby) {
+            add_angles({ segments[index].x, segments[index].y });
+            add_angles({ segments[index].z, segments[index].w });
+        }
+        std::sort(mAngles.begin(), mAngles.end());
+        mAngles.erase(std::unique(mAngles.begin(), mAngles.end()), mAngles.end());
+
+        for (float angle : mAngles) {
+            glm::vec2 const direction{ std::cos(angle), std::sin(angle) };
+
+            // distance to the square
+            float nearest = std::min(std::abs(direction.x) > 0.f ? radius / std::abs(direction.x) : FLT_MAX,
+                                     std::abs(direction.y) > 0.f ? radius / std::abs(direction.y) : FLT_MAX);
+
+            for (uint32_t index : mNearby) {
+                glm::vec2 const start{ segments[index].x, segments[index].y };
+                glm::vec2 const edge = glm::vec2(segments[index].z, segments[index].w) - start;
+                float denominator = cross(direction, edge);
+                if (std::abs(denominator) < 1e-8f) {
+                    continue; // parallel to the ray
+                }
+                glm::vec2 const offset = start - position;
+                float t = cross(offset, edge) / denominator;   // along the ray
+                float u = cross(offset, direction) / denominator; // along the segment
+                if (t >= 0.f && t < nearest && u >= 0.f && u <= 1.f) {
+                    nearest = t;
+                }
+            }
+            points.push_back(position + direction * nearest);
+        }
+    }
+
+    void LightMask::create(glm::ivec2 resolution) {
+        if (!mVAO) {
+            GL_CALL(glCreateVertexArrays(1, &mVAO));
+            GL_CALL(glCreateBuffers(1, &mVBO));
+            GL_CALL(glVertexArrayVertexBuffer(mVAO, 0, mVBO, 0, sizeof(LightVertex)));
+
+            GL_CALL(glEnableVertexArrayAttrib(mVAO, 0));
+            GL_CALL(glVertexArrayAttribFormat(mVAO, 0, 2, GL_FLOAT, GL_FALSE, offsetof(LightVertex, position)));
+            GL_CALL(glVertexArrayAttribBinding(mVAO, 0, 0));
+
+            GL_CALL(glEnableVertexArrayAttrib(mVAO, 1));
+            GL_CALL(glVertexArrayAttribFormat(mVAO, 1, 2, GL_FLOAT, GL_FALSE, offsetof(LightVertex, center)));
+            GL_CALL(glVertexArrayAttribBinding(mVAO, 1, 0));
+
+            GL_CALL(glEnableVertexArrayAttrib(mVAO, 2));
+            GL_CALL(glVertexArrayAttribFormat(mVAO, 2, 4, GL_FLOAT, GL_FALSE, offsetof(LightVertex, color)));
+            GL_CALL(glVertexArrayAttribBinding(mVAO, 2, 0));
+
+            GL_CALL(glEnableVertexArrayAttrib(mVAO, 3));
+            GL_CALL(glVertexArrayAttribFormat(mVAO, 3, 1, GL_FLOAT, GL_FALSE, offsetof(LightVertex, radius)));
+            GL_CALL(glVertexArrayAttribBinding(mVAO, 3, 0));
+        }
+
+        resolution = glm::max(resolution, glm::ivec2(1));
+        if (resolution == mSize) {
+            return;
+        }
+
+        // half float so many dim lights add up without banding
+        if (mTexture) {
+            glDeleteTextures(1, &mTexture);
+        }
+        mSize = resolution;
+        GL_CALL(glCreateTextures(GL_TEXTURE_2D, 1, &mTexture));
+        GL_CALL(glTextureStorage2D(mTexture, 1, GL_RGBA16F, mSize.x, mSize.y));
+        GL_CALL(glTextureParameteri(mTexture, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
+        GL_CALL(glTextureParameteri(mTexture, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+        GL_CALL(glTextureParameteri(mTexture, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+        GL_CALL(glTextureParameteri(mTexture, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+
+        if (!mFramebuffer) {
+            GL_CALL(glCreateFramebuffers(1, &mFramebuffer));
+        }
+        GL_CALL(glNamedFramebufferTexture(mFramebuffer, GL_COLOR_ATTACHMENT0, mTexture, 0));
+        IS_CORE_ASSERT_MESG(glCheckNamedFramebufferStatus(mFramebuffer, GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE, "Error: Light mask framebuffer is incomplete!");
+    }
+} // end namespace IS
@@ -0,0 +1,149 @@
+/*!
+ * \file LightMask.h
+ * \author Koh Yan Khang, yankhang.k@digipen.edu
+ * \par Course: CSD2451
+ * \date 19-10-2026
+ * \brief
+ * This header file declares the LightMask class, which builds the visibility polygon
+ * of every light on the CPU and renders the lit areas into a texture that the
+ * lighting pass adds onto the scene.
+ *
+ * \copyright
+ * All content (C) 2024 DigiPen Institute of Technology Singapore.
+ * All rights reserved.
+ * Reproduction or disclosure of this file or its contents without the prior written
+ * consent of DigiPen Institute of Technology is prohibited.
+ *____________________________________________________________________________*/
+
+ /*                                                                      guard
+ ----------------------------------------------------------------------------- */
+#ifndef GAM200_INSIGHT_ENGINE_GRAPHICS_SYSTEM_LIGHT_MASK_H
+#define GAM200_INSIGHT_ENGINE_GRAPHICS_SYSTEM_LIGHT_MASK_H
+
+ /*                                                                   includes
+ ----------------------------------------------------------------------------- */
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace IS {
+    /*!
+     * \brief Accumulated light of a frame, shadows included.
+     *
+     * The shadow casting segments are put in a uniform hash grid, and each light
+     * fetches the segments inside its radius from it. The visibility polygon of a
+     * light is found by casting rays at every segment endpoint (and just either side
+     * of it) and keeping the nearest hit, in angle order. Polygons are cached per
+     * light and rebuilt only when the light moves, resizes or the segments inside its
+     * radius change. Each polygon is drawn as a fan that shades the light's falloff,
+     * and the fans are added into the mask. The alpha channel keeps the smallest
+     * distance to any light as a fraction of its radius, ignoring shadows, for the
+     * shader effects that darken around lights.
+     */
+    class LightMask {
+    public:
+        static constexpr float CELL_SIZE = 256.f;   // World size of a segment grid cell
+
+        /*!
+         * \brief Builds or reuses the visibility polygon of every light.
+         *
+         * \param positions World position of each light.
+         * \param colors Color and intensity of each light.
+         * \param radii Radius of each light.
+         * \param segments Shadow casting line segments, (x, y) to (z, w) in world space.
+         */
+        void build(std::vector<glm::vec2> const& positions, std::vector<glm::vec4> const& colors,
+                   std::vector<float> const& radii, std::vector<glm::vec4> const& segments);
+
+        /*!
+         * \brief Renders the polygons of the last build() into the mask texture. Keeps the
+         * bound framebuffer and viewport.
+         *
+         * \param view_projection View-projection matrix of the camera.
+         * \param resolution Size of the render target the mask is read in, in pixels.
+         */
+        void render(glm::mat4 const& view_projection, glm::ivec2 resolution);
+
+        /*!
+         * \brief Deletes the mask, buffers and cached polygons.
+         */
+        void destroy();
+
+        /*!
+         * \brief Gets the mask texture, lit color in rgb and nearest light distance in alpha.
+         * \return The texture ID.
+         */
+        GLuint texture() const { return mTexture; }
+
+        /*!
+         * \brief Gets the number of polygons rebuilt by the last build(), the rest were cached.
+         */
+        size_t rebuilt_count() const { return mRebuilt; }
+
+    private:
+        /*!
+         * \brief Vertex of a light fan or light square.
+         */
+        struct LightVertex {
+            glm::vec2 position{};           // world position
+            glm::vec2 center{};             // world position of the light
+            glm::vec4 color{};              // color and intensity of the light
+            float radius{};                 // radius of the light
+        };
+
+        /*!
+         * \brief Visibility polygon of a light and what it was built from.
+         */
+        struct CachedPolygon {
+            glm::vec2 position{};
+            float radius{ -1.f };
+            uint64_t segment_hash{};        // hash of the segments inside the radius
+            std::vector<glm::vec2> points;  // polygon in angle order around the light
+        };
+
+        /*!
+         * \brief Puts the segments in the hash grid.
+         */
+        void index_segments(std::vector<glm::vec4> const& segments);
+
+        /*!
+         * \brief Fetches the segments overlapping a light's square into mNearby, in index order.
+         */
+        void query_segments(std::vector<glm::vec4> const& segments, glm::vec2 position, float radius);
+
+        /*!
+         * \brief Computes the visibility polygon of a light from mNearby.
+         */
+        void build_polygon(std::vector<glm::vec4> const& segments, glm::vec2 position, float radius, std::vector<glm::vec2>& points);
+
+        /*!
+         * \brief Creates the mask texture, framebuffer and vertex array as needed.
+         */
+        void create(glm::ivec2 resolution);
+
+        static int64_t cell_key(int x, int y) { return (static_cast<int64_t>(x) << 32) | static_cast<uint32_t>(y); }
+
+        std::unordered_map<int64_t, std::vector<uint32_t>> mCells;  // Segments overlapping each cell
+        std::vector<uint32_t> mOversized;                           // Segments too long to grid
+        std::vector<uint32_t> mSegmentStamps;                       // Last query that returned each segment
+        uint32_t mStamp{};                                          // Current query, used to skip duplicates
+        std::vector<uint32_t> mNearby;                              // Segments of the current query
+        std::vector<float> mAngles;                                 // Ray angles of the current polygon
+
+        std::vector<CachedPolygon> mPolygons;                       // Polygon of each light, by submission order
+        std::vector<LightVertex> mVertices;                         // Fans, then squares
+        size_t mFanVertexCount{};                                   // Vertices of the fans in mVertices
+        size_t mRebuilt{};                                          // Polygons rebuilt by the last build
+
+        glm::ivec2 mSize{};                                         // Size of the mask texture
+        GLuint mTexture{};
+        GLuint mFramebuffer{};
+        GLuint mVAO{};
+        GLuint mVBO{};
+    };
+} // end namespace IS
+
+#endif // !GAM200_INSIGHT_ENGINE_GRAPHICS_SYSTEM_LIGHT_MASK_H
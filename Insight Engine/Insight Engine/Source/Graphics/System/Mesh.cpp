@@ -16,13 +16,15 @@
 #include "Pch.h"
 #include "Mesh.h"
 #include "Sprite.h"
+#include "InstanceQueue.h"
+#include "ParticleBatch.h"
 
 
 namespace IS {
 
     void Mesh::initMeshes(std::vector<Mesh>& meshes) {
         // Create, init and emplace into mesh vector
-        Mesh inst_quad_mesh, inst_line_mesh, inst_circle_mesh, inst_3d_quad_mesh, outline_mesh, fb_mesh, video_player_mesh;
+        Mesh inst_quad_mesh, inst_line_mesh, inst_circle_mesh, inst_3d_quad_mesh, outline_mesh, fb_mesh, video_player_mesh, inst_particle_mesh;
 
         // inst_quad_mesh.setupInstancedQuadVAO();
         inst_line_mesh.setupInstancedLineVAO();
@@ -31,6 +33,7 @@ namespace IS {
         outline_mesh.setupOutlineVAO();
         fb_mesh.setupFBVAO();
         video_player_mesh.setupVideoPlayerVAO();
+        inst_particle_mesh.setupInstancedParticleVAO();
 
         meshes.emplace_back(inst_quad_mesh);
         meshes.emplace_back(inst_line_mesh);
@@ -39,6 +42,7 @@ namespace IS {
         meshes.emplace_back(outline_mesh);
         meshes.emplace_back(fb_mesh);
         meshes.emplace_back(video_player_mesh);
+        meshes.emplace_back(inst_particle_mesh);
     }
 
     void Mesh::setupInstanced3DQuadVAO() {
@@ -68,41 +72,32 @@ namespace IS {
         glVertexAttribPointer(tex_coord_attrib, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<GLvoid*>(offsetof(Vertex, texCoord)));
 
         // Create Instance Buffer Object
-        glCreateBuffers(1, &instance_vbo_ID);
-        glNamedBufferStorage(instance_vbo_ID, sizeof(Sprite::instanceData) * 100'000, NULL, GL_DYNAMIC_STORAGE_BIT | GL_MAP_WRITE_BIT);
-        glBindBuffer(GL_ARRAY_BUFFER, instance_vbo_ID);
+        instance_buffer.Create(sizeof(Sprite::instanceData), static_cast<GLsizei>(InstanceQueue::MAX_INSTANCES));
+        glBindBuffer(GL_ARRAY_BUFFER, instance_buffer.GetID());
 
         // Enable attributes
         glEnableVertexArrayAttrib(vao_ID, color_attrib);
-        glEnableVertexArrayAttrib(vao_ID, tex_index_attrib);
-        glEnableVertexArrayAttrib(vao_ID, x_form_row1_attrib);
-        glEnableVertexArrayAttrib(vao_ID, x_form_row2_attrib);
-        glEnableVertexArrayAttrib(vao_ID, x_form_row3_attrib);
-        glEnableVertexArrayAttrib(vao_ID, x_form_row4_attrib);
-        glEnableVertexArrayAttrib(vao_ID, anim_dim_attrib);
-        glEnableVertexArrayAttrib(vao_ID, anim_index_attrib);
+        glEnableVertexArrayAttrib(vao_ID, tex_layer_attrib);
+        glEnableVertexArrayAttrib(vao_ID, tex_rect_attrib);
+        glEnableVertexArrayAttrib(vao_ID, rot_scale_attrib);
+        glEnableVertexArrayAttrib(vao_ID, translation_attrib);
         glEnableVertexArrayAttrib(vao_ID, ent_ID_attrib);
 
         // Specify instance data layout
-        glVertexAttribPointer(color_attrib, 4, GL_FLOAT, GL_FALSE, sizeof(Sprite::instanceData), 0);
-        glVertexAttribPointer(tex_index_attrib, 1, GL_FLOAT, GL_FALSE, sizeof(Sprite::instanceData), reinterpret_cast<GLvoid*>(sizeof(float) * 4));
-        glVertexAttribPointer(x_form_row1_attrib, 4, GL_FLOAT, GL_FALSE, sizeof(Sprite::instanceData), reinterpret_cast<GLvoid*>(sizeof(float) * 5));
-        glVertexAttribPointer(x_form_row2_attrib, 4, GL_FLOAT, GL_FALSE, sizeof(Sprite::instanceData), reinterpret_cast<GLvoid*>(sizeof(float) * 9));
-        glVertexAttribPointer(x_form_row3_attrib, 4, GL_FLOAT, GL_FALSE, sizeof(Sprite::instanceData), reinterpret_cast<GLvoid*>(sizeof(float) * 13));
-        glVertexAttribPointer(x_form_row4_attrib, 4, GL_FLOAT, GL_FALSE, sizeof(Sprite::instanceData), reinterpret_cast<GLvoid*>(sizeof(float) * 17));
-        glVertexAttribPointer(anim_dim_attrib, 2, GL_FLOAT, GL_FALSE, sizeof(Sprite::instanceData), reinterpret_cast<GLvoid*>(sizeof(float) * 21));
-        glVertexAttribPointer(anim_index_attrib, 2, GL_FLOAT, GL_FALSE, sizeof(Sprite::instanceData), reinterpret_cast<GLvoid*>(sizeof(float) * 23));
-        glVertexAttribPointer(ent_ID_attrib, 1, GL_FLOAT, GL_FALSE, sizeof(Sprite::instanceData), reinterpret_cast<GLvoid*>(sizeof(float) * 25));
+        GLsizei const stride = sizeof(Sprite::instanceData);
+        glVertexAttribPointer(color_attrib, 4, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<GLvoid*>(offsetof(Sprite::instanceData, color)));
+        glVertexAttribPointer(tex_layer_attrib, 1, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<GLvoid*>(offsetof(Sprite::instanceData, tex_layer)));
+        glVertexAttribPointer(tex_rect_attrib, 4, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<GLvoid*>(offsetof(Sprite::instanceData, tex_rect)));
+        glVertexAttribPointer(rot_scale_attrib, 4, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<GLvoid*>(offsetof(Sprite::instanceData, rot_scale)));
+        glVertexAttribPointer(translation_attrib, 2, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<GLvoid*>(offsetof(Sprite::instanceData, translation)));
+        glVertexAttribPointer(ent_ID_attrib, 1, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<GLvoid*>(offsetof(Sprite::instanceData, entID)));
 
         // Specify instance data divisor for attribute instancing
         glVertexAttribDivisor(color_attrib, 1);
-        glVertexAttribDivisor(tex_index_attrib, 1);
-        glVertexAttribDivisor(x_form_row1_attrib, 1);
-        glVertexAttribDivisor(x_form_row2_attrib, 1);
-        glVertexAttribDivisor(x_form_row3_attrib, 1);
-        glVertexAttribDivisor(x_form_row4_attrib, 1);
-        glVertexAttribDivisor(anim_dim_attrib, 1);
-        glVertexAttribDivisor(anim_index_attrib, 1);
+        glVertexAttribDivisor(tex_layer_attrib, 1);
+        glVertexAttribDivisor(tex_rect_attrib, 1);
+        glVertexAttribDivisor(rot_scale_attrib, 1);
+        glVertexAttribDivisor(translation_attrib, 1);
         glVertexAttribDivisor(ent_ID_attrib, 1);
 
         glBindBuffer(GL_ARRAY_BUFFER, 0);
@@ -110,6 +105,66 @@ namespace IS {
         draw_count = static_cast<GLuint>(vertices.size());
     }
 
+    void Mesh::setupInstancedParticleVAO() {
+        // Same quad as the instanced 3D quad
+        std::array<Vertex, 4> vertices{
+            Vertex{glm::vec2(-1.0f, -1.0f), glm::vec2(0.0f, 1.f)},
+            Vertex{ glm::vec2(1.0f, -1.0f),  glm::vec2(1.f, 1.f) },
+            Vertex{ glm::vec2(-1.0f, 1.0f),  glm::vec2(0.0f, 0.0f) },
+            Vertex{ glm::vec2(1.0f, 1.0f),   glm::vec2(1.f, 0.0f) }
+        };
+
+        // Generate a VAO handle to encapsulate the VBO
+        glCreateVertexArrays(1, &vao_ID);
+        glBindVertexArray(vao_ID);
+
+        // Create and bind a VBO to store the vertex data
+        glCreateBuffers(1, &vbo_ID);
+        glNamedBufferStorage(vbo_ID, sizeof(Vertex) * vertices.size(), vertices.data(), GL_DYNAMIC_STORAGE_BIT);
+        glBindBuffer(GL_ARRAY_BUFFER, vbo_ID);
+
+        // Enable attributes
+        glEnableVertexArrayAttrib(vao_ID, pos_attrib);
+        glEnableVertexArrayAttrib(vao_ID, tex_coord_attrib);
+
+        // Bind attributes
+        glVertexAttribPointer(pos_attrib, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), 0);
+        glVertexAttribPointer(tex_coord_attrib, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<GLvoid*>(offsetof(Vertex, texCoord)));
+
+        // Create Instance Buffer Object
+        instance_buffer.Create(sizeof(ParticleInstance), static_cast<GLsizei>(ParticleBatch::MAX_INSTANCES));
+        glBindBuffer(GL_ARRAY_BUFFER, instance_buffer.GetID());
+
+        // Enable attributes
+        glEnableVertexArrayAttrib(vao_ID, color_attrib);
+        glEnableVertexArrayAttrib(vao_ID, tex_layer_attrib);
+        glEnableVertexArrayAttrib(vao_ID, tex_rect_attrib);
+        glEnableVertexArrayAttrib(vao_ID, particle_position_attrib);
+        glEnableVertexArrayAttrib(vao_ID, particle_size_attrib);
+        glEnableVertexArrayAttrib(vao_ID, particle_rotation_attrib);
+
+        // Specify instance data layout
+        GLsizei const stride = sizeof(ParticleInstance);
+        glVertexAttribPointer(color_attrib, 4, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<GLvoid*>(offsetof(ParticleInstance, color)));
+        glVertexAttribPointer(tex_layer_attrib, 1, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<GLvoid*>(offsetof(ParticleInstance, tex_layer)));
+        glVertexAttribPointer(tex_rect_attrib, 4, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<GLvoid*>(offsetof(ParticleInstance, tex_rect)));
+        glVertexAttribPointer(particle_position_attrib, 2, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<GLvoid*>(offsetof(ParticleInstance, position)));
+        glVertexAttribPointer(particle_size_attrib, 2, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<GLvoid*>(offsetof(ParticleInstance, size)));
+        glVertexAttribPointer(particle_rotation_attrib, 1, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<GLvoid*>(offsetof(ParticleInstance, rotation)));
+
+        // Specify instance data divisor for attribute instancing
+        glVertexAttribDivisor(color_attrib, 1);
+        glVertexAttribDivisor(tex_layer_attrib, 1);
+        glVertexAttribDivisor(tex_rect_attrib, 1);
+        glVertexAttribDivisor(particle_position_attrib, 1);
+        glVertexAttribDivisor(particle_size_attrib, 1);
+        glVertexAttribDivisor(particle_rotation_attrib, 1);
+
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glBindVertexArray(0);
+        draw_count = static_cast<GLuint>(vertices.size());
+    }
+
     void Mesh::setupInstancedLineVAO() {
         // Define the vertices of the quad as a triangle strip
         std::vector<glm::vec2> vertices = { // start horizontal
@@ -133,9 +188,8 @@ namespace IS {
         glVertexAttribPointer(pos_attrib, 2, GL_FLOAT, GL_FALSE, sizeof(glm::vec2), 0);
 
         // Create Instance Buffer Object
-        glCreateBuffers(1, &instance_vbo_ID);
-        glNamedBufferStorage(instance_vbo_ID, sizeof(Sprite::nonQuadInstanceData) * MAX_ENTITIES, NULL, GL_DYNAMIC_STORAGE_BIT | GL_MAP_WRITE_BIT);
-        glBindBuffer(GL_ARRAY_BUFFER, instance_vbo_ID);
+        instance_buffer.Create(sizeof(Sprite::nonQuadInstanceData), static_cast<GLsizei>(MAX_ENTITIES));
+        glBindBuffer(GL_ARRAY_BUFFER, instance_buffer.GetID());
 
         // Enable attributes
         glEnableVertexArrayAttrib(vao_ID, color_attrib);
@@ -193,9 +247,8 @@ namespace IS {
         glVertexAttribPointer(pos_attrib, 2, GL_FLOAT, GL_FALSE, sizeof(glm::vec2), 0);
 
         // Create Instance Buffer Object
-        glCreateBuffers(1, &instance_vbo_ID);
-        glNamedBufferStorage(instance_vbo_ID, sizeof(Sprite::nonQuadInstanceData) * MAX_ENTITIES, NULL, GL_DYNAMIC_STORAGE_BIT | GL_MAP_WRITE_BIT);
-        glBindBuffer(GL_ARRAY_BUFFER, instance_vbo_ID);
+        instance_buffer.Create(sizeof(Sprite::nonQuadInstanceData), static_cast<GLsizei>(MAX_ENTITIES));
+        glBindBuffer(GL_ARRAY_BUFFER, instance_buffer.GetID());
 
         // Enable attributes
         glEnableVertexArrayAttrib(vao_ID, color_attrib);
@@ -350,6 +403,8 @@ namespace IS {
         for (auto& mesh : meshes) {
             glDeleteVertexArrays(1, &mesh.vao_ID);
             glDeleteBuffers(1, &mesh.vbo_ID);
+            if (mesh.instance_buffer.GetID())
+                mesh.instance_buffer.Destroy();
         }
     }
 
@@ -19,6 +19,8 @@
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 
+#include "Graphics/Buffers/InstanceBuffer.h"
+
 namespace IS {
     /*!
      * \brief The Mesh class represents OpenGL vertex array objects and buffers for rendering.
@@ -43,12 +45,25 @@ namespace IS {
             x_form_row4_attrib,
             anim_dim_attrib,
             anim_index_attrib,
-            ent_ID_attrib
+            ent_ID_attrib,
+
+            // instanced quads only carry a 2D affine transform, in place of the matrix rows
+            rot_scale_attrib = x_form_row1_attrib,
+            translation_attrib = x_form_row2_attrib,
+
+            // and an atlas layer and sub-rect, in place of the texture and frame indices
+            tex_layer_attrib = tex_index_attrib,
+            tex_rect_attrib = anim_dim_attrib,
+
+            // particles carry their position, size and rotation, expanded in the shader
+            particle_position_attrib = x_form_row1_attrib,
+            particle_size_attrib = x_form_row2_attrib,
+            particle_rotation_attrib = x_form_row3_attrib
         };
 
         GLuint vao_ID{};            // The OpenGL vertex array object ID.
         GLuint vbo_ID{};            // The OpenGL vertex buffer object ID.
-        GLuint instance_vbo_ID{};   // The OpenGL instance vertex buffer object ID.
+        InstanceBuffer instance_buffer{}; // The ring of instance data regions, drawn with a base instance.
         GLuint draw_count{};        // The number of vertices to be drawn.
 
         /*!
@@ -73,6 +88,11 @@ namespace IS {
          */
         void setupInstanced3DQuadVAO();
 
+        /**
+         * @brief Set up an instanced particle quad mesh.
+         */
+        void setupInstancedParticleVAO();
+
         /*!
          * \brief Set up an instanced line mesh.
          *
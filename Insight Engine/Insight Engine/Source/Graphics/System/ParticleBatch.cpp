@@ -0,0 +1,105 @@
+/*!
+ * \file ParticleBatch.cpp
+ * \author Koh Yan Khang, yankhang.k@digipen.edu
+ * \par Course: CSD2451
+ * \date 19-10-2026
+ * \brief
+ * This source file defines the ParticleBatch class, which groups the particle
+ * instances of a frame by layer.
+ *
+ * \copyright
+ * All content (C) 2024 DigiPen Institute of Technology Singapore.
+ * All rights reserved.
+ * Reproduction or disclosure of this file or its contents without the prior written
+ * consent of DigiPen Institute of Technology is prohibited.
+ *____________________________________________________________________________*/
+
+ /*                                                                   includes
+ ----------------------------------------------------------------------------- */
+#include "Pch.h"
+#include "ParticleBatch.h"
+#include "Graphics/Core/Graphics.h"
+
+#include <algorithm>
+
+namespace IS {
+    void ParticleInstance::setTexture(int texture_index, glm::vec2 frame_dimension, glm::vec2 frame_index) {
+        TextureAtlas::SubTexture const& sub_texture = ISGraphics::textureAtlas.Get(texture_index);
+        glm::vec2 frame_size = glm::vec2(sub_texture.rect.z, sub_texture.rect.w) * frame_dimension;
+        tex_layer = sub_texture.layer;
+        tex_rect = { glm::vec2(sub_texture.rect.x, sub_texture.rect.y) + frame_size * frame_index, frame_size };
+    }
+
+    void ParticleBatch::push_back(ParticleInstance const& instance, int layer) {
+        uint32_t slot = layer_slot(layer);
+        ++mLayers[slot].count;
+        mSlots.emplace_back(slot);
+        mInstances.emplace_back(instance);
+    }
+
+    size_t ParticleBatch::write_sorted(ParticleInstance* dest, size_t capacity) {
+        if (mInstances.size() > capacity) {
+            IS_CORE_WARN("{} particle instances exceed the instance buffer size of {}, extra particles are dropped", mInstances.size(), capacity);
+        }
+
+        // lay the layers out in drawing order, ignored layers get an empty range
+        mRuns.clear();
+        for (LayerRun const& layer : mLayers) {
+            if (Sprite::layersToIgnore.find(layer.layer) == Sprite::layersToIgnore.end()) {
+                mRuns.push_back(layer);
+            }
+        }
+        std::sort(mRuns.begin(), mRuns.end(), [](LayerRun const& lhs, LayerRun const& rhs) { return lhs.layer < rhs.layer; });
+
+        mCursors.assign(mLayers.size(), 0);
+        mEnds.assign(mLayers.size(), 0);
+        size_t total = 0;
+        for (LayerRun& run : mRuns) {
+            run.first = total;
+            run.count = std::min(run.count, capacity - total);
+            total += run.count;
+
+            // slots are few, finding the slot of each run is cheaper than keeping a map
+            for (size_t slot = 0; slot < mLayers.size(); ++slot) {
+                if (mLayers[slot].layer == run.layer) {
+                    mCursors[slot] = run.first;
+                    mEnds[slot] = run.first + run.count;
+                    break;
+                }
+            }
+        }
+        std::erase_if(mRuns, [](LayerRun const& run) { return run.count == 0; });
+
+        // scatter in submission order, which keeps the order within a layer
+        for (size_t i = 0; i < mInstances.size(); ++i) {
+            uint32_t slot = mSlots[i];
+            if (mCursors[slot] < mEnds[slot]) {
+                dest[mCursors[slot]++] = mInstances[i];
+            }
+        }
+        return total;
+    }
+
+    void ParticleBatch::clear() {
+        mInstances.clear();
+        mSlots.clear();
+        mLayers.clear();
+        mRuns.clear();
+        mLastSlot = UINT32_MAX;
+    }
+
+    uint32_t ParticleBatch::layer_slot(int layer) {
+        if (mLastSlot != UINT32_MAX && mLastLayer == layer) {
+            return mLastSlot;
+        }
+
+        auto it = std::find_if(mLayers.begin(), mLayers.end(), [layer](LayerRun const& run) { return run.layer == layer; });
+        if (it == mLayers.end()) {
+            mLayers.push_back({ layer, 0, 0 });
+            it = std::prev(mLayers.end());
+        }
+        mLastLayer = layer;
+        mLastSlot = static_cast<uint32_t>(it - mLayers.begin());
+        return mLastSlot;
+    }
+} // end namespace IS
@@ -0,0 +1,112 @@
+/*!
+ * \file ParticleBatch.h
+ * \author Koh Yan Khang, yankhang.k@digipen.edu
+ * \par Course: CSD2451
+ * \date 19-10-2026
+ * \brief
+ * This header file declares the ParticleBatch class, the per-frame instance stream
+ * of particles that the particle vertex shader expands into quads.
+ *
+ * \copyright
+ * All content (C) 2024 DigiPen Institute of Technology Singapore.
+ * All rights reserved.
+ * Reproduction or disclosure of this file or its contents without the prior written
+ * consent of DigiPen Institute of Technology is prohibited.
+ *____________________________________________________________________________*/
+
+ /*                                                                      guard
+ ----------------------------------------------------------------------------- */
+#ifndef GAM200_INSIGHT_ENGINE_GRAPHICS_SYSTEM_PARTICLE_BATCH_H
+#define GAM200_INSIGHT_ENGINE_GRAPHICS_SYSTEM_PARTICLE_BATCH_H
+
+ /*                                                                   includes
+ ----------------------------------------------------------------------------- */
+#include "InstanceQueue.h"
+
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace IS {
+    /*!
+     * \brief Instance data of a particle quad.
+     *
+     * Only the values a particle changes are stored, the vertex shader builds the
+     * rotation and scale, so no matrix is computed on the CPU.
+     */
+    struct ParticleInstance {
+        glm::vec4 color{ 1.f, 1.f, 1.f, 1.f };
+        glm::vec4 tex_rect{ 0.f, 0.f, 1.f, 1.f };  // UV offset (xy) and size (zw) in the atlas layer
+        glm::vec2 position{};
+        glm::vec2 size{ 1.f, 1.f };                 // full width and height in world units
+        float rotation{};                           // degrees
+        float tex_layer{ -1.f };                    // texture atlas layer, -1 if untextured
+
+        /*!
+         * \brief Looks up a texture in the atlas and selects a frame of it.
+         *
+         * \param texture_index The texture index of the image.
+         * \param frame_dimension The UV size of a frame, (1, 1) for the whole image.
+         * \param frame_index The column and row of the frame.
+         */
+        void setTexture(int texture_index, glm::vec2 frame_dimension = { 1.f, 1.f }, glm::vec2 frame_index = { 0.f, 0.f });
+    };
+
+    /*!
+     * \brief Collects the particle instances of a frame and groups them by layer.
+     *
+     * Particles are mostly submitted a layer at a time, so instead of the radix sort of
+     * InstanceQueue the few distinct layers are counted and the instances are scattered
+     * into their layer's range, keeping submission order within a layer. Layers in
+     * Sprite::layersToIgnore are dropped when written. All storage is reused between frames.
+     */
+    class ParticleBatch {
+    public:
+        static constexpr size_t MAX_INSTANCES = 100'000;   // Size of the particle instance VBO
+
+        /*!
+         * \brief Appends an instance to the batch.
+         * \param instance The particle to draw.
+         * \param layer The layer to draw it in.
+         */
+        void push_back(ParticleInstance const& instance, int layer);
+
+        /*!
+         * \brief Groups the instances by layer and writes them to a buffer.
+         * \param dest The buffer to write to, usually the mapped instance VBO.
+         * \param capacity Maximum number of instances the buffer can hold.
+         * \return The number of instances written.
+         */
+        size_t write_sorted(ParticleInstance* dest, size_t capacity);
+
+        /*!
+         * \brief Gets the layer runs of the last write_sorted(), in drawing order.
+         * \return The runs.
+         */
+        std::vector<LayerRun> const& layer_runs() const { return mRuns; }
+
+        /*!
+         * \brief Removes all the instances, keeping the allocated storage.
+         */
+        void clear();
+
+        size_t size() const { return mInstances.size(); }
+        bool empty() const { return mInstances.empty(); }
+
+    private:
+        /*!
+         * \brief Gets the slot of a layer in mLayers, adding it if new.
+         */
+        uint32_t layer_slot(int layer);
+
+        std::vector<ParticleInstance> mInstances;   // Instances in submission order
+        std::vector<uint32_t> mSlots;               // Layer slot of each instance
+        std::vector<LayerRun> mLayers;              // Layer and instance count of each slot, in first seen order
+        std::vector<size_t> mCursors;               // Next write position of each slot
+        std::vector<size_t> mEnds;                  // End of the written range of each slot
+        std::vector<LayerRun> mRuns;                // Layer runs of the last write
+        int mLastLayer{};                           // Layer of the last push_back
+        uint32_t mLastSlot{ UINT32_MAX };           // Slot of mLastLayer
+    };
+} // end namespace IS
+
+#endif // !GAM200_INSIGHT_ENGINE_GRAPHICS_SYSTEM_PARTICLE_BATCH_H
@@ -0,0 +1,69 @@
+/*!
+ * \file RenderQueue.cpp
+ * \author Koh Yan Khang, yankhang.k@digipen.edu
+ * \par Course: CSD2451
+ * \date 19-10-2026
+ * \brief
+ * This source file defines the RenderQueue class, which hands the render state queued
+ * during a frame over to its draw.
+ *
+ * \copyright
+ * All content (C) 2024 DigiPen Institute of Technology Singapore.
+ * All rights reserved.
+ * Reproduction or disclosure of this file or its contents without the prior written
+ * consent of DigiPen Institute of Technology is prohibited.
+ *____________________________________________________________________________*/
+
+ /*                                                                   includes
+ ----------------------------------------------------------------------------- */
+#include "Pch.h"
+#include "RenderQueue.h"
+#include "Graphics/Core/Graphics.h"
+#include "Graphics/System/Light.h"
+
+#include <algorithm>
+
+namespace IS {
+    void RenderQueue::handoff() {
+        // until the draw, the statics collect into the containers drawn last frame
+        swap_frame_state();
+        prepare();
+    }
+
+    void RenderQueue::begin_submit() {
+        swap_frame_state();
+    }
+
+    void RenderQueue::end_submit() {
+        swap_frame_state();
+    }
+
+    void RenderQueue::swap_frame_state() {
+        std::swap(mPacket.quads, ISGraphics::layeredQuadInstances);
+        std::swap(mPacket.particles, ISGraphics::particleInstances);
+        std::swap(mPacket.lines, ISGraphics::lineInstances);
+        std::swap(mPacket.circles, ISGraphics::circleInstances);
+        std::swap(mPacket.lights, ISGraphics::lightInstances);
+        std::swap(mPacket.light_radii, ISGraphics::lightRadius);
+        std::swap(mPacket.light_positions, Light::lightPos);
+        std::swap(mPacket.light_colors, Light::lightClr);
+        std::swap(mPacket.shadow_segments, Light::shadowLineSegments);
+
+        // fonts live in a node based map, their addresses are stable
+        for (auto& [name, font] : ISGraphics::mTexts) {
+            auto calls = std::find_if(mPacket.texts.begin(), mPacket.texts.end(),
+                                      [&font](FontCalls const& entry) { return entry.font == &font; });
+            if (calls == mPacket.texts.end()) {
+                calls = mPacket.texts.insert(mPacket.texts.end(), FontCalls{ &font });
+            }
+            std::swap(calls->centered, font.renderCalls);
+            std::swap(calls->left_align, font.leftAlignRenderCalls);
+        }
+    }
+
+    void RenderQueue::prepare() {
+        IS_PROFILE_FUNCTION();
+        mPacket.quads.sort();
+        ISGraphics::lightMask.build(mPacket.light_positions, mPacket.light_colors, mPacket.light_radii, mPacket.shadow_segments);
+    }
+} // end namespace IS
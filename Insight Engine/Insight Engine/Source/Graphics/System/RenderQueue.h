@@ -0,0 +1,106 @@
+/*!
+ * \file RenderQueue.h
+ * \author Koh Yan Khang, yankhang.k@digipen.edu
+ * \par Course: CSD2451
+ * \date 19-10-2026
+ * \brief
+ * This header file declares the RenderQueue class, which hands the render state queued
+ * during a frame over to its draw.
+ *
+ * \copyright
+ * All content (C) 2024 DigiPen Institute of Technology Singapore.
+ * All rights reserved.
+ * Reproduction or disclosure of this file or its contents without the prior written
+ * consent of DigiPen Institute of Technology is prohibited.
+ *____________________________________________________________________________*/
+
+ /*                                                                      guard
+ ----------------------------------------------------------------------------- */
+#ifndef GAM200_INSIGHT_ENGINE_GRAPHICS_SYSTEM_RENDER_QUEUE_H
+#define GAM200_INSIGHT_ENGINE_GRAPHICS_SYSTEM_RENDER_QUEUE_H
+
+ /*                                                                   includes
+ ----------------------------------------------------------------------------- */
+#include "InstanceQueue.h"
+#include "ParticleBatch.h"
+#include "Sprite.h"
+#include "Text.h"
+
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace IS {
+    /*!
+     * \brief Double buffered render state of a frame.
+     *
+     * Systems keep queueing sprites, particles, lights, shadow segments, debug lines and
+     * text into the graphics statics during a frame. Once the graphics system has queued
+     * its sprites, handoff() swaps all of those containers with the ones of the packet and
+     * prepares the packet: the quads are sorted by layer and the light polygons are built.
+     * The draw of the same frame swaps the packet back into the statics for the duration
+     * of the draw, so the draw code reads the statics as before and only issues GL.
+     * Anything queued after the handoff is drawn with the next frame.
+     *
+     * The packet is prepared inline. Graphics is one of the last systems, so between the
+     * handoff and the draw there is no work a render thread could overlap, and handing
+     * the packet to the next frame's draw instead would show every frame a frame late.
+     */
+    class RenderQueue {
+    public:
+        /*!
+         * \brief Captures the render state queued this frame into the packet and prepares it.
+         * Called once a frame, before the draw.
+         */
+        void handoff();
+
+        /*!
+         * \brief Swaps the prepared packet into the statics for drawing.
+         */
+        void begin_submit();
+
+        /*!
+         * \brief Swaps the drawn packet back out, the statics hold the frame being collected again.
+         */
+        void end_submit();
+
+    private:
+        /*!
+         * \brief Text queued for a font.
+         */
+        struct FontCalls {
+            Text* font{};
+            std::vector<Text::TextRenderCall> centered;
+            std::vector<Text::TextRenderCall> left_align;
+        };
+
+        /*!
+         * \brief Everything a frame queued for drawing.
+         */
+        struct FramePacket {
+            InstanceQueue quads;
+            ParticleBatch particles;
+            std::vector<Sprite::nonQuadInstanceData> lines;
+            std::vector<Sprite::nonQuadInstanceData> circles;
+            std::vector<Sprite::instanceData> lights;
+            std::vector<float> light_radii;
+            std::vector<glm::vec2> light_positions;
+            std::vector<glm::vec4> light_colors;
+            std::vector<glm::vec4> shadow_segments;
+            std::vector<FontCalls> texts;
+        };
+
+        /*!
+         * \brief Swaps the queued containers of the packet with the statics.
+         */
+        void swap_frame_state();
+
+        /*!
+         * \brief Sorts the quads and builds the light polygons of the packet.
+         */
+        void prepare();
+
+        FramePacket mPacket;
+    };
+} // end namespace IS
+
+#endif // !GAM200_INSIGHT_ENGINE_GRAPHICS_SYSTEM_RENDER_QUEUE_H
@@ -33,6 +33,16 @@ namespace IS {
 		ISGraphics::glitched_quad_shader_pgm.link();
 		ISGraphics::glitched_quad_shader_pgm.validate();
 
+		ISGraphics::particle_shader_pgm.compileShaderFromFile(GL_VERTEX_SHADER, directory + "InstParticle.vert");
+		ISGraphics::particle_shader_pgm.compileShaderFromFile(GL_FRAGMENT_SHADER, directory + "InstQuad.frag");
+		ISGraphics::particle_shader_pgm.link();
+		ISGraphics::particle_shader_pgm.validate();
+
+		ISGraphics::glitched_particle_shader_pgm.compileShaderFromFile(GL_VERTEX_SHADER, directory + "InstParticle.vert");
+		ISGraphics::glitched_particle_shader_pgm.compileShaderFromFile(GL_FRAGMENT_SHADER, directory + "GlitchEffect.frag");
+		ISGraphics::glitched_particle_shader_pgm.link();
+		ISGraphics::glitched_particle_shader_pgm.validate();
+
 		ISGraphics::non_quad_shader_pgm.compileShaderFromFile(GL_VERTEX_SHADER, directory + "InstNonQuad.vert");
 		ISGraphics::non_quad_shader_pgm.compileShaderFromFile(GL_FRAGMENT_SHADER, directory + "InstNonQuad.frag");
 		ISGraphics::non_quad_shader_pgm.link();
@@ -48,6 +58,11 @@ namespace IS {
 		ISGraphics::light_shader_pgm.link();
 		ISGraphics::light_shader_pgm.validate();
 
+		ISGraphics::light_mask_shader_pgm.compileShaderFromFile(GL_VERTEX_SHADER, directory + "LightMask.vert");
+		ISGraphics::light_mask_shader_pgm.compileShaderFromFile(GL_FRAGMENT_SHADER, directory + "LightMask.frag");
+		ISGraphics::light_mask_shader_pgm.link();
+		ISGraphics::light_mask_shader_pgm.validate();
+
 		Text::textShader.compileShaderFromFile(GL_VERTEX_SHADER, directory + "Text.vert");
 		Text::textShader.compileShaderFromFile(GL_FRAGMENT_SHADER, directory + "Text.frag");
 		Text::textShader.link();
@@ -73,6 +88,12 @@ namespace IS {
 		if (glIsProgram(ISGraphics::glitched_quad_shader_pgm.getHandle()))
 			glDeleteProgram(ISGraphics::glitched_quad_shader_pgm.getHandle());
 
+		if (glIsProgram(ISGraphics::particle_shader_pgm.getHandle()))
+			glDeleteProgram(ISGraphics::particle_shader_pgm.getHandle());
+
+		if (glIsProgram(ISGraphics::glitched_particle_shader_pgm.getHandle()))
+			glDeleteProgram(ISGraphics::glitched_particle_shader_pgm.getHandle());
+
 		if (glIsProgram(ISGraphics::non_quad_shader_pgm.getHandle()))
 			glDeleteProgram(ISGraphics::non_quad_shader_pgm.getHandle());
 
@@ -82,6 +103,9 @@ namespace IS {
 		if (glIsProgram(ISGraphics::light_shader_pgm.getHandle()))
 			glDeleteProgram(ISGraphics::light_shader_pgm.getHandle());
 
+		if (glIsProgram(ISGraphics::light_mask_shader_pgm.getHandle()))
+			glDeleteProgram(ISGraphics::light_mask_shader_pgm.getHandle());
+
 		if (glIsProgram(Text::textShader.getHandle()))
 			glDeleteProgram(Text::textShader.getHandle());
 
@@ -93,9 +117,12 @@ namespace IS {
 
 		ISGraphics::quad_shader_pgm.Unlink();
 		ISGraphics::glitched_quad_shader_pgm.Unlink();
+		ISGraphics::particle_shader_pgm.Unlink();
+		ISGraphics::glitched_particle_shader_pgm.Unlink();
 		ISGraphics::non_quad_shader_pgm.Unlink();
 		ISGraphics::quad_border_shader_pgm.Unlink();
 		ISGraphics::light_shader_pgm.Unlink();
+		ISGraphics::light_mask_shader_pgm.Unlink();
 		Text::textShader.Unlink();
 		ISGraphics::fb_shader_pgm.Unlink();
 		ISGraphics::videoShader.Unlink();
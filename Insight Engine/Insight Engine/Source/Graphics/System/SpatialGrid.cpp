@@ -0,0 +1,168 @@
+/*!
+ * \file SpatialGrid.cpp
+ * \author Koh Yan Khang, yankhang.k@digipen.edu
+ * \par Course: CSD2451
+ * \date 19-10-2026
+ * \brief
+ * This source file defines the SpatialGrid class, a uniform hash grid over the
+ * world bounds of the sprites in a layer.
+ *
+ * \copyright
+ * All content (C) 2024 DigiPen Institute of Technology Singapore.
+ * All rights reserved.
+ * Reproduction or disclosure of this file or its contents without the prior written
+ * consent of DigiPen Institute of Technology is prohibited.
+ *____________________________________________________________________________*/
+
+ /*                                                                   includes
+ ----------------------------------------------------------------------------- */
+#include "Pch.h"
+#include "SpatialGrid.h"
+
+#include <cmath>
+
+namespace IS {
+    float SpatialGrid::mCellSize = 256.f;
+
+    void SpatialGrid::Update(Entity entity, Bounds const& bounds) {
+        // the cell size was changed in the editor, regrid everything
+        if (mGridCellSize != mCellSize) {
+            std::unordered_map<Entity, Record> records;
+            records.swap(mRecords);
+            Clear();
+            mGridCellSize = mCellSize;
+            for (auto const& [other, record] : records) {
+                Update(other, record.bounds);
+            }
+        }
+
+        CellRange cells = ToCells(bounds);
+        bool oversized = cells.Count() > MAX_ENTITY_CELLS;
+
+        auto it = mRecords.find(entity);
+        if (it != mRecords.end()) {
+            Record& record = it->second;
+            if (record.bounds == bounds) {
+                return;
+            }
+
+            // still in the same cells, only the bounds changed
+            if (record.oversized == oversized && (oversized || record.cells == cells)) {
+                record.bounds = bounds;
+                return;
+            }
+
+            Unlink(entity, record);
+            record.bounds = bounds;
+            record.cells = cells;
+            record.oversized = oversized;
+            Link(entity, record);
+            return;
+        }
+
+        Record record{ bounds, cells, oversized };
+        Link(entity, record);
+        mRecords.emplace(entity, record);
+    }
+
+    void SpatialGrid::Remove(Entity entity) {
+        auto it = mRecords.find(entity);
+        if (it == mRecords.end()) {
+            return;
+        }
+        Unlink(entity, it->second);
+        mRecords.erase(it);
+    }
+
+    void SpatialGrid::Clear() {
+        mCells.clear();
+        mRecords.clear();
+        mOversized.clear();
+    }
+
+    void SpatialGrid::Query(Bounds const& region, std::vector<Entity>& result) {
+        ++mStamp;
+        auto add = [&](Entity entity) {
+            Record& record = mRecords[entity];
+            if (record.stamp != mStamp && record.bounds.Overlaps(region)) {
+                record.stamp = mStamp;
+                result.emplace_back(entity);
+            }
+        };
+
+        for (Entity entity : mOversized) {
+            add(entity);
+        }
+
+        // zoomed far out, visiting the cells would cost more than testing every entity
+        CellRange cells = ToCells(region);
+        if (cells.Count() > static_cast<int64_t>(mRecords.size())) {
+            for (auto const& [entity, record] : mRecords) {
+                if (!record.oversized) {
+                    add(entity);
+                }
+            }
+            return;
+        }
+
+        for (int y = cells.min_y; y <= cells.max_y; ++y) {
+            for (int x = cells.min_x; x <= cells.max_x; ++x) {
+                auto cell = mCells.find(CellKey(x, y));
+                if (cell == mCells.end()) {
+                    continue;
+                }
+                for (Entity entity : cell->second) {
+                    add(entity);
+                }
+            }
+        }
+    }
+
+    SpatialGrid::CellRange SpatialGrid::ToCells(Bounds const& bounds) const {
+        float size = mGridCellSize > 0.f ? mGridCellSize : 1.f;
+        auto to_cell = [size](float value) {
+            // clamp so huge or invalid bounds cannot overflow the cell coordinates
+            return static_cast<int>(std::clamp(std::floor(value / size), -1e6f, 1e6f));
+        };
+        return { to_cell(bounds.min.x), to_cell(bounds.min.y), to_cell(bounds.max.x), to_cell(bounds.max.y) };
+    }
+
+    void SpatialGrid::Link(Entity entity, Record const& record) {
+        if (record.oversized) {
+            mOversized.emplace_back(entity);
+            return;
+        }
+        for (int y = record.cells.min_y; y <= record.cells.max_y; ++y) {
+            for (int x = record.cells.min_x; x <= record.cells.max_x; ++x) {
+                mCells[CellKey(x, y)].emplace_back(entity);
+            }
+        }
+    }
+
+    void SpatialGrid::Unlink(Entity entity, Record const& record) {
+        auto erase_from = [entity](std::vector<Entity>& entities) {
+            auto it = std::find(entities.begin(), entities.end(), entity);
+            if (it != entities.end()) {
+                *it = entities.back();
+                entities.pop_back();
+            }
+        };
+
+        if (record.oversized) {
+            erase_from(mOversized);
+            return;
+        }
+        for (int y = record.cells.min_y; y <= record.cells.max_y; ++y) {
+            for (int x = record.cells.min_x; x <= record.cells.max_x; ++x) {
+                auto cell = mCells.find(CellKey(x, y));
+                if (cell == mCells.end()) {
+                    continue;
+                }
+                erase_from(cell->second);
+                if (cell->second.empty()) {
+                    mCells.erase(cell);
+                }
+            }
+        }
+    }
+} // end namespace IS
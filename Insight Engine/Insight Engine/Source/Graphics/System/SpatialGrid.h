@@ -0,0 +1,131 @@
+/*!
+ * \file SpatialGrid.h
+ * \author Koh Yan Khang, yankhang.k@digipen.edu
+ * \par Course: CSD2451
+ * \date 19-10-2026
+ * \brief
+ * This header file declares the SpatialGrid class, a uniform hash grid over the
+ * world bounds of the sprites in a layer, used to cull sprites outside the view.
+ *
+ * \copyright
+ * All content (C) 2024 DigiPen Institute of Technology Singapore.
+ * All rights reserved.
+ * Reproduction or disclosure of this file or its contents without the prior written
+ * consent of DigiPen Institute of Technology is prohibited.
+ *____________________________________________________________________________*/
+
+ /*                                                                      guard
+ ----------------------------------------------------------------------------- */
+#ifndef GAM200_INSIGHT_ENGINE_GRAPHICS_SYSTEM_SPATIAL_GRID_H
+#define GAM200_INSIGHT_ENGINE_GRAPHICS_SYSTEM_SPATIAL_GRID_H
+
+ /*                                                                   includes
+ ----------------------------------------------------------------------------- */
+#include "Engine/ECS/Entities.h"
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace IS {
+    /*!
+     * \brief Uniform hash grid of entity bounds.
+     *
+     * Each entity is stored in every cell its bounds overlap. Moving an entity only touches
+     * the grid when it crosses into a different range of cells, so static scenery costs a
+     * compare per frame. Entities covering more than MAX_ENTITY_CELLS cells (backgrounds)
+     * are kept in a separate list that every query tests directly.
+     */
+    class SpatialGrid {
+    public:
+        /*!
+         * \brief Axis aligned bounds in world coordinates.
+         */
+        struct Bounds {
+            glm::vec2 min{};
+            glm::vec2 max{};
+
+            bool Overlaps(Bounds const& other) const {
+                return min.x <= other.max.x && max.x >= other.min.x && min.y <= other.max.y && max.y >= other.min.y;
+            }
+            bool operator==(Bounds const& other) const { return min == other.min && max == other.max; }
+        };
+
+        static float mCellSize;                             // World size of a grid cell
+        static constexpr int MAX_ENTITY_CELLS = 64;         // Entities spanning more cells are not gridded
+
+        /*!
+         * \brief Inserts an entity or updates its bounds.
+         * \param entity The entity.
+         * \param bounds The world bounds of the entity.
+         */
+        void Update(Entity entity, Bounds const& bounds);
+
+        /*!
+         * \brief Removes an entity from the grid.
+         * \param entity The entity.
+         */
+        void Remove(Entity entity);
+
+        /*!
+         * \brief Removes every entity and cell.
+         */
+        void Clear();
+
+        /*!
+         * \brief Appends the entities whose bounds overlap a region, each entity once.
+         * \param region The region to query.
+         * \param result Vector the entities are appended to, in no particular order.
+         */
+        void Query(Bounds const& region, std::vector<Entity>& result);
+
+        /*!
+         * \brief Gets the number of entities in the grid.
+         */
+        size_t Size() const { return mRecords.size(); }
+
+        /*!
+         * \brief Checks if an entity is in the grid and the grid was built with the current cell size.
+         * \param entity The entity.
+         */
+        bool IsCurrent(Entity entity) const { return mGridCellSize == mCellSize && mRecords.contains(entity); }
+
+    private:
+        /*!
+         * \brief Range of cells covered by a set of bounds.
+         */
+        struct CellRange {
+            int min_x{}, min_y{}, max_x{}, max_y{};
+
+            bool operator==(CellRange const& other) const {
+                return min_x == other.min_x && min_y == other.min_y && max_x == other.max_x && max_y == other.max_y;
+            }
+            int64_t Count() const { return static_cast<int64_t>(max_x - min_x + 1) * (max_y - min_y + 1); }
+        };
+
+        /*!
+         * \brief Bookkeeping of an entity in the grid.
+         */
+        struct Record {
+            Bounds bounds{};
+            CellRange cells{};
+            bool oversized{};       // Kept in mOversized instead of the cells
+            uint32_t stamp{};       // Last query that returned the entity
+        };
+
+        CellRange ToCells(Bounds const& bounds) const;
+        static int64_t CellKey(int x, int y) { return (static_cast<int64_t>(x) << 32) | static_cast<uint32_t>(y); }
+
+        void Link(Entity entity, Record const& record);
+        void Unlink(Entity entity, Record const& record);
+
+        std::unordered_map<int64_t, std::vector<Entity>> mCells;    // Entities overlapping each cell
+        std::unordered_map<Entity, Record> mRecords;                // Bounds and cells of each entity
+        std::vector<Entity> mOversized;                             // Entities too large to grid
+        uint32_t mStamp{};                                          // Current query, used to skip duplicates
+        float mGridCellSize{};                                      // Cell size the records were built with
+    };
+} // end namespace IS
+
+#endif // !GAM200_INSIGHT_ENGINE_GRAPHICS_SYSTEM_SPATIAL_GRID_H
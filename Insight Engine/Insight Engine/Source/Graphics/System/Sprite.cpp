@@ -44,151 +44,125 @@ namespace IS {
         img.texture_id = other.img.texture_id;
     }
 
-    void Sprite::transform() {
-        model_TRS.mdl_to_3dcam_to_ndc_xform = model_TRS.Return3DXformMatrix();
+    void Sprite::instanceData::setTexture(int texture_index, glm::vec2 frame_dimension, glm::vec2 frame_index) {
+        TextureAtlas::SubTexture const& sub_texture = ISGraphics::textureAtlas.Get(texture_index);
+        glm::vec2 size = glm::vec2(sub_texture.rect.z, sub_texture.rect.w) * frame_dimension;
+        tex_layer = sub_texture.layer;
+        tex_rect = { glm::vec2(sub_texture.rect.x, sub_texture.rect.y) + size * frame_index, size };
     }
 
-    void Sprite::draw_instanced_quads() {
-        // set shader
-        Shader::setMainQuadShader(ISGraphics::quad_shader_pgm);
-
-        // Bind the instance VBO
-        GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, ISGraphics::meshes[3].instance_vbo_ID));
-
-        glUnmapBuffer(GL_ARRAY_BUFFER);
+    bool Sprite::transform() {
+        return model_TRS.UpdateModelXform();
+    }
 
-        // Upload the quadInstances data to the GPU
-        GL_CALL(Sprite::instanceData* buffer = reinterpret_cast<Sprite::instanceData*>(glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY)));
+    void Sprite::draw_instanced_quads() {
+        draw_layered_quads(ISGraphics::quad_shader_pgm, ISGraphics::particle_shader_pgm, false);
+    }
 
+    void Sprite::draw_instanced_glitched_quads() {
+        // set to glitching effect shader
+        draw_layered_quads(ISGraphics::glitched_quad_shader_pgm, ISGraphics::glitched_particle_shader_pgm, true);
+    }
 
-        // Copy the instance data from the multiset to the vector
-        std::vector<Sprite::instanceData> tempData(ISGraphics::layeredQuadInstances.begin(), ISGraphics::layeredQuadInstances.end());
+    void Sprite::draw_layered_quads(Shader const& quad_shader, Shader const& particle_shader, bool glitched) {
+        // set shader
+        Shader::setMainQuadShader(quad_shader);
 
-        if (buffer) {
+        Mesh& quad_mesh = ISGraphics::meshes[3];
+        Mesh& particle_mesh = ISGraphics::meshes[7];  // will change to enums
+        InstanceBuffer& quad_buffer = quad_mesh.instance_buffer;
+        InstanceBuffer& particle_buffer = particle_mesh.instance_buffer;
 
-            // Copy the instance data to the mapped buffer
-            if (!tempData.empty()) {
-                std::memcpy(buffer, tempData.data(), tempData.size() * sizeof(Sprite::instanceData));
+        // Get the next free region of the instance buffer
+        Sprite::instanceData* buffer = quad_buffer.Map<Sprite::instanceData>();
 
-                // Unmap the buffer
-                if (glUnmapBuffer(GL_ARRAY_BUFFER) == GL_FALSE) { // 
-                    // Handle the case where unmap was not successful
-                    std::cerr << "Failed to unmap the buffer." << std::endl;
-                }
-            }
-        }
-        else {
+        if (!buffer) {
             // Handle the case where mapping the buffer was not successful
             std::cerr << "Failed to map the buffer for writing." << std::endl;
+            ISGraphics::layeredQuadInstances.clear();
+            ISGraphics::particleInstances.clear();
             return;
         }
 
-        // bind shader
-        GL_CALL(glUseProgram(ISGraphics::main_quad_shader.getHandle()));
-        GL_CALL(glBindVertexArray(ISGraphics::meshes[3].vao_ID)); // will change to enums
-
-        // store texture array indices
-        std::vector<int> tex_array_index_vect;
-        for (auto const& texture : ISGraphics::textures) {
-            glBindTextureUnit(texture.texture_index, texture.texture_id);
-            tex_array_index_vect.emplace_back(texture.texture_index);
-        }
-
-        // upload to uniform variable
-        auto tex_arr_uniform = glGetUniformLocation(ISGraphics::main_quad_shader.getHandle(), "uTex2d");
-        if (tex_arr_uniform >= 0)
-            glUniform1iv(tex_arr_uniform, static_cast<int>(tex_array_index_vect.size()), &tex_array_index_vect[0]);
-        else IS_CORE_ERROR({ "uTex2d Uniform not found, shader compilation failed?" });
+        // Sort the instances by layer straight into the mapped region
+        ISGraphics::layeredQuadInstances.write_sorted(buffer, quad_buffer.GetCapacity());
+        GLuint quad_base = quad_buffer.Unmap();
 
-        // draw instanced quads
-        glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, ISGraphics::meshes[3].draw_count, static_cast<GLsizei>(tempData.size()));
-
-        for (auto const& texture : ISGraphics::textures)
-        {
-            glBindTextureUnit(texture.texture_index, 0);
+        // particles have their own stream, grouped by layer the same way
+        GLuint particle_base{};
+        if (!ISGraphics::particleInstances.empty()) {
+            if (ParticleInstance* particles = particle_buffer.Map<ParticleInstance>()) {
+                ISGraphics::particleInstances.write_sorted(particles, particle_buffer.GetCapacity());
+                particle_base = particle_buffer.Unmap();
+            }
+            else {
+                std::cerr << "Failed to map the particle buffer for writing." << std::endl;
+                ISGraphics::particleInstances.clear();
+            }
         }
 
-        ISGraphics::layeredQuadInstances.clear();
-    }
-
-    void Sprite::draw_instanced_glitched_quads() {
-        // set to glitching effect shader
-        Shader::setMainQuadShader(ISGraphics::glitched_quad_shader_pgm);
-
-        // Bind the instance VBO
-        GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, ISGraphics::meshes[3].instance_vbo_ID));
-
-        glUnmapBuffer(GL_ARRAY_BUFFER);
-        // Upload the quadInstances data to the GPU
-        GL_CALL(Sprite::instanceData * buffer = reinterpret_cast<Sprite::instanceData*>(glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY)));
-
-        // Copy the instance data from the multiset to the vector
-        std::vector<Sprite::instanceData> tempData(ISGraphics::layeredQuadInstances.begin(), ISGraphics::layeredQuadInstances.end());
-
-        if (buffer) {
-
-            // Copy the instance data to the mapped buffer
-            if (!tempData.empty()) {
-                std::memcpy(buffer, tempData.data(), tempData.size() * sizeof(Sprite::instanceData));
-
-                // Unmap the buffer
-                if (glUnmapBuffer(GL_ARRAY_BUFFER) == GL_FALSE) { // 
-                    // Handle the case where unmap was not successful
-                    std::cerr << "Failed to unmap the buffer." << std::endl;
+        // every texture is in the atlas, one bind for all the quads
+        ISGraphics::textureAtlas.Bind(0);
+
+        // both programs share the uniforms
+        for (Shader const* shader : { &quad_shader, &particle_shader }) {
+            GL_CALL(glUseProgram(shader->getHandle()));
+
+            auto atlas_uniform = glGetUniformLocation(shader->getHandle(), "uAtlas");
+            if (atlas_uniform >= 0)
+                glUniform1i(atlas_uniform, 0);
+            else IS_CORE_ERROR({ "uAtlas Uniform not found, shader compilation failed?" });
+
+            // the camera is applied once per draw instead of baked into every instance
+            auto view_proj_uniform = glGetUniformLocation(shader->getHandle(), "uViewProj");
+            if (view_proj_uniform >= 0)
+                glUniformMatrix4fv(view_proj_uniform, 1, GL_FALSE, glm::value_ptr(ISGraphics::cameras3D[Camera3D::mActiveCamera].getCameraToNDCXform()));
+            else IS_CORE_ERROR({ "uViewProj Uniform not found, shader compilation failed?" });
+
+            // upload to uniform variable for glitch effect animation
+            if (glitched) {
+                auto globalTimeUniform = glGetUniformLocation(shader->getHandle(), "uGlobalTime");
+                if (globalTimeUniform >= 0) {
+                    glUniform1f(globalTimeUniform, static_cast<float>(InsightEngine::Instance().mElapsedTime));
+                }
+                else {
+                    IS_CORE_ERROR("uGlobalTime Uniform not found, shader compilation failed?");
                 }
             }
         }
-        else {
-            // Handle the case where mapping the buffer was not successful
-            std::cerr << "Failed to map the buffer for writing." << std::endl;
-        }
-
-        // bind shader
-        GL_CALL(glUseProgram(ISGraphics::glitched_quad_shader_pgm.getHandle()));
-        GL_CALL(glBindVertexArray(ISGraphics::meshes[3].vao_ID)); // will change to enums
-
-        // store texture array indices
-        std::vector<int> tex_array_index_vect;
-        for (auto const& texture : ISGraphics::textures) {
-            glBindTextureUnit(texture.texture_index, texture.texture_id);
-            tex_array_index_vect.emplace_back(texture.texture_index);
-        }
-
-        // upload to uniform variable
-        auto tex_arr_uniform = glGetUniformLocation(ISGraphics::main_quad_shader.getHandle(), "uTex2d");
-        if (tex_arr_uniform >= 0)
-            glUniform1iv(tex_arr_uniform, static_cast<int>(tex_array_index_vect.size()), &tex_array_index_vect[0]);
-        else IS_CORE_ERROR({ "uTex2d Uniform not found, shader compilation failed?" });
 
-        // upload to uniform variable for glitch effect animation
-        auto globalTimeUniform = glGetUniformLocation(ISGraphics::main_quad_shader.getHandle(), "uGlobalTime");
-        if (globalTimeUniform >= 0) {
-            glUniform1f(globalTimeUniform, static_cast<float>(InsightEngine::Instance().mElapsedTime));
-        }
-        else {
-            IS_CORE_ERROR("uGlobalTime Uniform not found, shader compilation failed?");
-        }
+        // one draw per run of layers that only one of the streams has
+        std::vector<LayerRun> const& particle_runs = ISGraphics::particleInstances.layer_runs();
+        walk_layer_runs(ISGraphics::layeredQuadInstances.layer_runs(), particle_runs, [&](bool particles, size_t first, size_t count) {
+            Shader const& shader = particles ? particle_shader : quad_shader;
+            Mesh const& mesh = particles ? particle_mesh : quad_mesh;
+            GLuint base = particles ? particle_base : quad_base;
+            GL_CALL(glUseProgram(shader.getHandle()));
+            GL_CALL(glBindVertexArray(mesh.vao_ID));
+            glDrawArraysInstancedBaseInstance(GL_TRIANGLE_STRIP, 0, mesh.draw_count, static_cast<GLsizei>(count), base + static_cast<GLuint>(first));
+        });
+
+        quad_buffer.Fence();
+        if (!particle_runs.empty())
+            particle_buffer.Fence();
+        glBindTextureUnit(0, 0);
 
-        // draw instanced quads
-        glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, ISGraphics::meshes[3].draw_count, static_cast<GLsizei>(tempData.size()));
         ISGraphics::layeredQuadInstances.clear();
+        ISGraphics::particleInstances.clear();
     }
-    
 
     void Sprite::draw_colored_quad(Vector2D const& pos, float rotation, Vector2D const& scale, Vector4D const& color, int layer) {
         // only render if layer not ignored
         if (Sprite::layersToIgnore.find(layer) == Sprite::layersToIgnore.end()) { 
             Transform quadTRS(pos, rotation, scale);
 
-            // get line scaling matrix
-            glm::mat4 world_to_NDC_xform = quadTRS.Return3DXformMatrix();
             Sprite::instanceData instData;
             instData.color = glm::vec4(color.x, color.y, color.z, color.w);
-            instData.model_to_ndc_xform = world_to_NDC_xform;
+            instData.setTransform(quadTRS);
             instData.layer = layer;
 
-            // add to multiset to render everything at the end
-            ISGraphics::layeredQuadInstances.insert(instData);
+            // add to instance queue to render everything at the end
+            ISGraphics::layeredQuadInstances.push_back(instData);
         }
     }
 
@@ -197,16 +171,14 @@ namespace IS {
         if (Sprite::layersToIgnore.find(layer) == Sprite::layersToIgnore.end()) {
             Transform quadTRS(pos, rotation, scale);
 
-            // get line scaling matrix
-            glm::mat4 world_to_NDC_xform = quadTRS.Return3DXformMatrix();
             Sprite::instanceData instData;
             instData.color = { 1.f, 1.f, 1.f, alpha };
-            instData.tex_index = static_cast<float>(texture.texture_index);
-            instData.model_to_ndc_xform = world_to_NDC_xform;
+            instData.setTexture(texture.texture_index);
+            instData.setTransform(quadTRS);
             instData.layer = layer;
 
-            // add to multiset to render everything at the end
-            ISGraphics::layeredQuadInstances.insert(instData);
+            // add to instance queue to render everything at the end
+            ISGraphics::layeredQuadInstances.push_back(instData);
         }
     }
 
@@ -215,16 +187,14 @@ namespace IS {
         if (Sprite::layersToIgnore.find(layer) == Sprite::layersToIgnore.end()) {
             Transform quadTRS(pos, rotation, scale);
 
-            // get line scaling matrix
-            glm::mat4 world_to_NDC_xform = quadTRS.Return3DXformMatrix();
             Sprite::instanceData instData;
             instData.color = { std::get<0>(colour), std::get<1>(colour), std::get<2>(colour), alpha };
-            instData.tex_index = static_cast<float>(texture.texture_index);
-            instData.model_to_ndc_xform = world_to_NDC_xform;
+            instData.setTexture(texture.texture_index);
+            instData.setTransform(quadTRS);
             instData.layer = layer;
 
-            // add to multiset to render everything at the end
-            ISGraphics::layeredQuadInstances.insert(instData);
+            // add to instance queue to render everything at the end
+            ISGraphics::layeredQuadInstances.push_back(instData);
         }
     }
 
@@ -240,76 +210,21 @@ namespace IS {
         if (Sprite::layersToIgnore.find(layer) == Sprite::layersToIgnore.end()) {
             Transform quadTRS(pos, rotation, scale);
 
-            // get line scaling matrix
-            glm::mat4 world_to_NDC_xform = quadTRS.Return3DXformMatrix();
             Sprite::instanceData instData;
             instData.color = { 1.f, 1.f, 1.f, alpha };
-            instData.tex_index = static_cast<float>(texture.texture_index);
-            instData.model_to_ndc_xform = world_to_NDC_xform;
+            instData.setTexture(texture.texture_index, { 1.f / totalCols, 1.f / totalRows }, { columnIndex, rowIndex });
+            instData.setTransform(quadTRS);
             instData.layer = layer;
 
-            // set spritesheet variables
-            instData.anim_frame_index = { columnIndex, rowIndex };
-            instData.anim_frame_dimension = { 1.f / totalCols, 1.f / totalRows };
-
-            // add to multiset to render everything at the end
-            ISGraphics::layeredQuadInstances.insert(instData);
+            // add to instance queue to render everything at the end
+            ISGraphics::layeredQuadInstances.push_back(instData);
         }
     }
 
     void Sprite::draw_lights() {
         GLuint clr_attach_id = ISGraphics::mShaderFrameBuffer.GetColorAttachment(); // texture ID
         GLuint entt_attach_id = ISGraphics::mShaderFrameBuffer.GetEntityIDAttachment();
-      
-        GL_CALL(glUseProgram(ISGraphics::light_shader_pgm.getHandle()));
-        GL_CALL(glBindVertexArray(ISGraphics::meshes[5].vao_ID)); // will change to enums
-
-        GLint tex_arr_uniform{};
-        if (!Light::lightClr.empty()) {
-            tex_arr_uniform = glGetUniformLocation(ISGraphics::light_shader_pgm.getHandle(), "uLightColors");
-            if (tex_arr_uniform >= 0)
-                glUniform4fv(tex_arr_uniform, static_cast<GLsizei>(Light::lightClr.size()), reinterpret_cast<const GLfloat*>(Light::lightClr.data()));
-            else
-                IS_CORE_ERROR("uLightColors Uniform not found, shader compilation failed?");
-        }
 
-        if (!ISGraphics::lightRadius.empty()) {
-            tex_arr_uniform = glGetUniformLocation(ISGraphics::light_shader_pgm.getHandle(), "uLightRadius");
-            if (tex_arr_uniform >= 0)
-                glUniform1fv(tex_arr_uniform, static_cast<GLsizei>(ISGraphics::lightRadius.size()), ISGraphics::lightRadius.data());
-            else
-                IS_CORE_ERROR({ "uLightRadius Uniform not found, shader compilation failed" });
-        }
-
-        if (!Light::lightPos.empty()) {
-            tex_arr_uniform = glGetUniformLocation(ISGraphics::light_shader_pgm.getHandle(), "uLightWorldPos");
-            if (tex_arr_uniform >= 0)
-                glUniform2fv(tex_arr_uniform, static_cast<GLsizei>(Light::lightPos.size()), reinterpret_cast<const GLfloat*>(Light::lightPos.data()));
-            else
-                IS_CORE_ERROR("uLightWorldPos Uniform not found, shader compilation failed?");
-        }
-
-        tex_arr_uniform = glGetUniformLocation(ISGraphics::light_shader_pgm.getHandle(), "uNoOfWorldLights");
-        if (tex_arr_uniform >= 0)
-            glUniform1i(tex_arr_uniform, static_cast<int>(Light::lightPos.size()));
-        else 
-            IS_CORE_ERROR({ "uNoOfWorldLights Uniform not found, shader compilation failed?" });
-
-        if (!Light::shadowLineSegments.empty()) {
-            tex_arr_uniform = glGetUniformLocation(ISGraphics::light_shader_pgm.getHandle(), "uLineSegments");
-            if (tex_arr_uniform >= 0)
-                glUniform4fv(tex_arr_uniform, static_cast<GLsizei>(Light::shadowLineSegments.size()), reinterpret_cast<const GLfloat*>(Light::shadowLineSegments.data()));
-            else
-                IS_CORE_ERROR("uLineSegments Uniform not found, shader compilation failed?");
-        }
-
-        tex_arr_uniform = glGetUniformLocation(ISGraphics::light_shader_pgm.getHandle(), "uNoOfLineSegments");
-        if (tex_arr_uniform >= 0)
-            glUniform1i(tex_arr_uniform, static_cast<int>(Light::shadowLineSegments.size()));
-        else 
-            IS_CORE_ERROR({ "uNoOfLineSegments Uniform not found, shader compilation failed?" });
-
-        
         glm::vec2 resolution{};
 
         InsightEngine& engine = InsightEngine::Instance();
@@ -333,20 +248,20 @@ namespace IS {
         }
 #endif
 
-        tex_arr_uniform = glGetUniformLocation(ISGraphics::light_shader_pgm.getHandle(), "uResolution");
+        // lit areas of every light, the shadows were cut out at the handoff
+        ISGraphics::lightMask.render(ISGraphics::cameras3D[Camera3D::mActiveCamera].getCameraToNDCXform(), glm::ivec2(resolution));
+        GL_CALL(glUseProgram(ISGraphics::light_shader_pgm.getHandle()));
+        GL_CALL(glBindVertexArray(ISGraphics::meshes[5].vao_ID)); // will change to enums
+
+        GLint tex_arr_uniform = glGetUniformLocation(ISGraphics::light_shader_pgm.getHandle(), "uResolution");
         if (tex_arr_uniform >= 0)
             glUniform2fv(tex_arr_uniform, 1, &resolution.x);
         else
             IS_CORE_ERROR("uResolution Uniform not found, shader compilation failed?");
 
-        tex_arr_uniform = glGetUniformLocation(ISGraphics::light_shader_pgm.getHandle(), "uInverseVP");
-        if (tex_arr_uniform >= 0)
-            glUniformMatrix4fv(tex_arr_uniform, 1, GL_FALSE, glm::value_ptr(ISGraphics::cameras3D[Camera3D::mActiveCamera].getInverseCameraToNDCXform()));
-        else
-            IS_CORE_ERROR({ "uInverseVP Uniform not found, shader compilation failed?" });
-        
         GL_CALL(glBindTextureUnit(0, clr_attach_id));
         GL_CALL(glBindTextureUnit(1, entt_attach_id));
+        GL_CALL(glBindTextureUnit(2, ISGraphics::lightMask.texture()));
 
         tex_arr_uniform = glGetUniformLocation(ISGraphics::light_shader_pgm.getHandle(), "bg_tex");
         if (tex_arr_uniform >= 0)
@@ -360,6 +275,12 @@ namespace IS {
         else
             IS_CORE_ERROR({ "id_tex Uniform not found, shader compilation failed?" });
 
+        tex_arr_uniform = glGetUniformLocation(ISGraphics::light_shader_pgm.getHandle(), "light_tex");
+        if (tex_arr_uniform >= 0)
+            glUniform1i(tex_arr_uniform, 2);
+        else
+            IS_CORE_ERROR({ "light_tex Uniform not found, shader compilation failed?" });
+
         tex_arr_uniform = glGetUniformLocation(ISGraphics::light_shader_pgm.getHandle(), "uShaderEffect");
         if (tex_arr_uniform >= 0)
             glUniform1i(tex_arr_uniform, static_cast<GLint>(ShaderEffect::currentShaderEffect));
@@ -412,7 +333,7 @@ namespace IS {
         // bind vao
         glBindVertexArray(ISGraphics::meshes[4].vao_ID);
 
-        shader.setUniform("model_to_ndc_xform", sprite.model_TRS.mdl_to_3dcam_to_ndc_xform);
+        shader.setUniform("model_to_ndc_xform", sprite.model_TRS.Return3DXformMatrix());
         glDrawArrays(GL_LINE_LOOP, 0, ISGraphics::meshes[4].draw_count);
     #endif // USING_IMGUI
     }
@@ -444,32 +365,29 @@ namespace IS {
     }
 
     void Sprite::draw_instanced_lines() {
-        // Bind the instance VBO
-        glBindBuffer(GL_ARRAY_BUFFER, ISGraphics::meshes[1].instance_vbo_ID);
-        // Upload the quadInstances data to the GPU
-        Sprite::nonQuadInstanceData* buffer = reinterpret_cast<Sprite::nonQuadInstanceData*>(glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY));
-
-        if (buffer) {
-            // Copy the instance data to the mapped buffer
-            std::memcpy(buffer, ISGraphics::lineInstances.data(), ISGraphics::lineInstances.size() * sizeof(Sprite::nonQuadInstanceData));
-
-            // Unmap the buffer
-            if (glUnmapBuffer(GL_ARRAY_BUFFER) == GL_FALSE) {
-                // Handle the case where unmap was not successful
-                std::cerr << "Failed to unmap the buffer." << std::endl;
-            }
-        }
-        else {
+        // Get the next free region of the instance buffer
+        InstanceBuffer& instance_buffer = ISGraphics::meshes[1].instance_buffer;
+        Sprite::nonQuadInstanceData* buffer = instance_buffer.Map<Sprite::nonQuadInstanceData>();
+
+        if (!buffer) {
             // Handle the case where mapping the buffer was not successful
             std::cerr << "Failed to map the buffer for writing." << std::endl;
+            ISGraphics::lineInstances.clear();
+            return;
         }
 
+        // Copy the instance data to the mapped region
+        size_t instance_count = std::min(ISGraphics::lineInstances.size(), static_cast<size_t>(instance_buffer.GetCapacity()));
+        std::memcpy(buffer, ISGraphics::lineInstances.data(), instance_count * sizeof(Sprite::nonQuadInstanceData));
+        GLuint base_instance = instance_buffer.Unmap();
+
         // bind shader
         glUseProgram(ISGraphics::non_quad_shader_pgm.getHandle());
         glBindVertexArray(ISGraphics::meshes[1].vao_ID);
 
         // draw instanced lines
-        glDrawArraysInstanced(GL_LINES, 0, ISGraphics::meshes[1].draw_count, static_cast<GLsizei>(ISGraphics::lineInstances.size()));
+        glDrawArraysInstancedBaseInstance(GL_LINES, 0, ISGraphics::meshes[1].draw_count, static_cast<GLsizei>(instance_count), base_instance);
+        instance_buffer.Fence();
         
         // clear vector of instance data
         ISGraphics::lineInstances.clear();
@@ -490,32 +408,29 @@ namespace IS {
     }
 
     void Sprite::draw_instanced_circles() {
-        // Bind the instance VBO
-        glBindBuffer(GL_ARRAY_BUFFER, ISGraphics::meshes[2].instance_vbo_ID);
-        // Upload the quadInstances data to the GPU
-        Sprite::nonQuadInstanceData* buffer = reinterpret_cast<Sprite::nonQuadInstanceData*>(glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY));
-
-        if (buffer) {
-            // Copy the instance data to the mapped buffer
-            std::memcpy(buffer, ISGraphics::circleInstances.data(), ISGraphics::circleInstances.size() * sizeof(Sprite::nonQuadInstanceData));
-
-            // Unmap the buffer
-            if (glUnmapBuffer(GL_ARRAY_BUFFER) == GL_FALSE) {
-                // Handle the case where unmap was not successful
-                std::cerr << "Failed to unmap the buffer." << std::endl;
-            }
-        }
-        else {
+        // Get the next free region of the instance buffer
+        InstanceBuffer& instance_buffer = ISGraphics::meshes[2].instance_buffer;
+        Sprite::nonQuadInstanceData* buffer = instance_buffer.Map<Sprite::nonQuadInstanceData>();
+
+        if (!buffer) {
             // Handle the case where mapping the buffer was not successful
             std::cerr << "Failed to map the buffer for writing." << std::endl;
+            ISGraphics::circleInstances.clear();
+            return;
         }
 
+        // Copy the instance data to the mapped region
+        size_t instance_count = std::min(ISGraphics::circleInstances.size(), static_cast<size_t>(instance_buffer.GetCapacity()));
+        std::memcpy(buffer, ISGraphics::circleInstances.data(), instance_count * sizeof(Sprite::nonQuadInstanceData));
+        GLuint base_instance = instance_buffer.Unmap();
+
         // bind shader
         glUseProgram(ISGraphics::non_quad_shader_pgm.getHandle());
         glBindVertexArray(ISGraphics::meshes[2].vao_ID);
 
         // draw instanced circles
-        glDrawArraysInstanced(GL_LINE_LOOP, 0, ISGraphics::meshes[2].draw_count, static_cast<GLsizei>(ISGraphics::circleInstances.size()));
+        glDrawArraysInstancedBaseInstance(GL_LINE_LOOP, 0, ISGraphics::meshes[2].draw_count, static_cast<GLsizei>(instance_count), base_instance);
+        instance_buffer.Fence();
        
         // clear vector of instance data
         ISGraphics::circleInstances.clear();
@@ -654,6 +569,7 @@ namespace IS {
         model_TRS.rotation = data["SpriteTransformRotation"].asFloat();
         model_TRS.scaling.x = data["SpriteTransformScalingX"].asFloat();
         model_TRS.scaling.y = data["SpriteTransformScalingY"].asFloat();
+        model_TRS.MarkDirty();
 
         // Note: Not deserializing mdl_to_ndc_xform as it's a matrix and the specific deserialization might depend on further needs
 
@@ -52,14 +52,31 @@ namespace IS {
     class Sprite : public IComponent {
     public:
         // Instance data of quad entity (static color, textured, animated)
+        // The camera is applied in the shader, so only the 2D model transform is stored per instance
         struct instanceData {
             glm::vec4 color{};
-            float tex_index{-1};
-            glm::mat4 model_to_ndc_xform{};
-            glm::vec2 anim_frame_dimension{ 1.f, 1.f }; // default UV size
-            glm::vec2 anim_frame_index{ 0.f, 0.f };
+            float tex_layer{ -1.f }; // texture atlas layer, -1 if untextured
+            glm::vec4 tex_rect{ 0.f, 0.f, 1.f, 1.f }; // UV offset (xy) and size (zw) in the atlas layer
+            glm::vec4 rot_scale{ 1.f, 0.f, 0.f, 1.f }; // 2x2 rotation and scale, column major
+            glm::vec2 translation{};
             float entID{}; // initialize with invalid entity id
             int layer{};
+
+            /*!
+             * \brief Looks up a texture in the atlas and selects a frame of it.
+             *
+             * \param texture_index The texture index of the image.
+             * \param frame_dimension The UV size of a frame, (1, 1) for the whole image.
+             * \param frame_index The column and row of the frame.
+             */
+            void setTexture(int texture_index, glm::vec2 frame_dimension = { 1.f, 1.f }, glm::vec2 frame_index = { 0.f, 0.f });
+
+            // Copies the cached model transform of trans, rebuilding it if needed
+            void setTransform(Transform& trans) {
+                trans.UpdateModelXform();
+                rot_scale = trans.mdl_rot_scale;
+                translation = trans.mdl_translation;
+            }
         };
         
         // Instance data of debug non-quad entity (line, circle)
@@ -133,32 +150,37 @@ namespace IS {
         /*!
          * \brief Applies the transformation to the sprite.
          *
-         * This function returns the transformation matrix for the sprite based on its position, rotation, and scaling.
+         * Rebuilds the cached model transform of the sprite if its position, rotation or scaling changed.
+         *
+         * \return True if the cached transform was rebuilt.
          */
-        void transform();
+        bool transform();
 
         /*!
          * \brief Sets the sprite's transformation to follow another transformation.
          *
          * \param trans The transformation to follow.
          */
-        void followTransform(Transform trans) { model_TRS = trans; }
+        void followTransform(Transform const& trans) {
+            // copy the values only when they changed, so the cached model transform stays valid
+            model_TRS.Follow(trans);
+        }
 
         /*!
          * \brief Sets the world position of the sprite.
          *
          * \param trans The world position to set.
          */
-        void setWorldPos(Transform trans) { model_TRS.world_position = trans.world_position; }
-        void setWorldPos(float x, float y) { model_TRS.world_position = Vec2D(x, y); }
+        void setWorldPos(Transform trans) { model_TRS.setWorldPosition(trans.world_position.x, trans.world_position.y); }
+        void setWorldPos(float x, float y) { model_TRS.setWorldPosition(x, y); }
 
         /*!
          * \brief Sets the size of the sprite.
          *
          * \param trans The size to set.
          */
-        void setSpriteSize(Transform trans) { model_TRS.scaling = trans.scaling; }
-        void setSpriteSize(float width, float height) { model_TRS.scaling = Vec2D(width, height); }
+        void setSpriteSize(Transform trans) { model_TRS.setScaling(trans.scaling); }
+        void setSpriteSize(float width, float height) { model_TRS.setScaling(width, height); }
 
         /**
          * @brief Draw instanced quads using the main quad shader.
@@ -175,6 +197,19 @@ namespace IS {
          */
         static void draw_instanced_glitched_quads();
 
+        /**
+         * @brief Draw the instanced quads and particles of the frame, layer by layer.
+         *
+         * Sprite quads and particles are written to their own instance buffers, sorted by layer.
+         * Each layer draws its particles and then its quads, one draw for each run of layers
+         * that only one of the two has.
+         *
+         * @param quad_shader The shader to draw the quads with.
+         * @param particle_shader The shader to draw the particles with.
+         * @param glitched Whether the shaders are the glitch effect and need the time.
+         */
+        static void draw_layered_quads(Shader const& quad_shader, Shader const& particle_shader, bool glitched);
+
         /**
          * @brief Draw a colored quad at the specified position with rotation, scale, color, and layer.
          *
@@ -16,8 +16,10 @@
 #include "Pch.h"
 #include "Text.h"
 #include "Engine/Core/CoreEngine.h"
+#include "Graphics/Core/Graphics.h"
 
-#include <iostream>
+#include <algorithm>
+#include <cstddef>
 #include <glm/gtc/matrix_transform.hpp>
 #pragma warning(push)
 #pragma warning(disable : 4201) // warning C4201: nonstandard extension used: nameless struct/union
@@ -25,13 +27,14 @@
 #pragma warning(pop)
 
 namespace IS {
-    /*std::map<GLchar, Text::Character> Text::Characters;
-    unsigned int Text::text_vao, Text::text_vbo;
-    GLuint Text::textureArray;
-    std::vector<glm::mat4> Text::transforms;
-    std::vector<int> Text::letterMap;*/
-
     Shader Text::textShader;
+    GLuint Text::text_vao{};
+    GLuint Text::text_vbo{};
+    GLuint Text::instance_vbo{};
+    GLsizeiptr Text::instanceCapacity{};
+    std::vector<Text::GlyphInstance> Text::instances;
+    std::vector<Text::TextBatch> Text::batches;
+    uint64_t Text::frame{};
 
     void Text::drawTextAnimation(std::string const& str1, std::string const& str2, float dt, Text& font1, Text& font2) {
         // set static timer and condition
@@ -54,13 +57,6 @@ namespace IS {
 
     void Text::initText(std::string const& filepath) {
 
-        // compile and setup the shader
-        int width, height;
-        InsightEngine::Instance().GetWindowSize(width, height);
-        glm::mat4 projection = glm::ortho(0.0f, static_cast<float>(width), 0.0f, static_cast<float>(height));
-        textShader.use();
-        glUniformMatrix4fv(glGetUniformLocation(textShader.getHandle(), "projection"), 1, GL_FALSE, glm::value_ptr(projection));
-
         // FreeType
         FT_Library ft;
         if (FT_Init_FreeType(&ft))
@@ -73,104 +69,132 @@ namespace IS {
         FT_Face face;
         if (FT_New_Face(ft, filepath.c_str(), 0, &face)) {
             IS_CORE_ERROR("ERROR::FREETYPE: Failed to load font");
+            FT_Done_FreeType(ft);
             return;
         }
-        else {
-            // set size to load glyphs as
-            FT_Set_Pixel_Sizes(face, base_size, base_size);
-
-            // disable byte-alignment restriction
-            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
-            glGenTextures(1, &textureArray);
-            glActiveTexture(GL_TEXTURE0);
-            glBindTexture(GL_TEXTURE_2D_ARRAY, textureArray);
-            glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_R8, base_size, base_size, 128, 0, GL_RED, GL_UNSIGNED_BYTE, 0);
+        // set size to load glyphs as
+        FT_Set_Pixel_Sizes(face, base_size, base_size);
 
-            // Calculate the maximum glyph size
-            unsigned int maxGlyphWidth = 0;
-            unsigned int maxGlyphHeight = 0;
-
-            for (unsigned char c = 0; c < 128; ++c) {
-                if (FT_Load_Char(face, c, FT_LOAD_RENDER)) {
-                    IS_CORE_ERROR("ERROR::FREETYTPE: Failed to load Glyph for character {}", static_cast<int>(c));
-                    continue;
-                }
-
-                maxGlyphWidth = std::max(maxGlyphWidth, face->glyph->bitmap.width);
-                maxGlyphHeight = std::max(maxGlyphHeight, face->glyph->bitmap.rows);
+        // copy out the bitmap of every glyph, they are packed once all sizes are known
+        struct GlyphBitmap {
+            int width{};
+            int rows{};
+            glm::ivec2 offset{};            // position in the atlas
+            std::vector<unsigned char> pixels;
+        };
+        std::array<GlyphBitmap, GLYPH_COUNT> bitmaps;
+        int maxGlyphWidth = 0;
+        int maxGlyphHeight = 0;
+
+        for (int c = 0; c < GLYPH_COUNT; ++c) {
+            // Load character glyph
+            if (FT_Load_Char(face, c, FT_LOAD_RENDER)) {
+                IS_CORE_ERROR("ERROR::FREETYTPE: Failed to load Glyph for character {}", c);
+                continue;
             }
 
-            // Dynamic texture size based on the maximum glyph size
-            unsigned int textureWidth = maxGlyphWidth;
-            unsigned int textureHeight = maxGlyphHeight;
-            int numLayers = 128;
+            FT_Bitmap const& bitmap = face->glyph->bitmap;
+            GlyphBitmap& glyph = bitmaps[c];
+            glyph.width = static_cast<int>(bitmap.width);
+            glyph.rows = static_cast<int>(bitmap.rows);
+            glyph.pixels.resize(static_cast<size_t>(glyph.width) * glyph.rows);
+            for (int row = 0; row < glyph.rows; ++row) {
+                std::copy_n(bitmap.buffer + static_cast<ptrdiff_t>(row) * bitmap.pitch, glyph.width,
+                            glyph.pixels.begin() + static_cast<ptrdiff_t>(row) * glyph.width);
+            }
+            maxGlyphWidth = std::max(maxGlyphWidth, glyph.width);
+            maxGlyphHeight = std::max(maxGlyphHeight, glyph.rows);
 
-            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+            // now store character for later use
+            Characters[c].Size = glm::ivec2(glyph.width, glyph.rows);
+            Characters[c].Bearing = glm::ivec2(face->glyph->bitmap_left, face->glyph->bitmap_top);
+            Characters[c].Advance = static_cast<unsigned int>(face->glyph->advance.x);
+        }
 
-            glGenTextures(1, &textureArray);
-            glActiveTexture(GL_TEXTURE0);
-            glBindTexture(GL_TEXTURE_2D_ARRAY, textureArray);
-            glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_R8, textureWidth, textureHeight, numLayers, 0, GL_RED, GL_UNSIGNED_BYTE, 0);
+        // destroy FreeType once we're finished
+        FT_Done_Face(face);
+        FT_Done_FreeType(ft);
 
-            for (unsigned char c = 0; c < 128; ++c) {
-                // Load character glyph
-                if (FT_Load_Char(face, c, FT_LOAD_RENDER)) {
-                    IS_CORE_ERROR("ERROR::FREETYTPE: Failed to load Glyph for character {}", static_cast<int>(c));
-                    continue;
-                }
+        // glyphs were drawn on a base_size quad spanning a cell as large as the largest glyph,
+        // keep the same on screen size
+        if (maxGlyphWidth > 0 && maxGlyphHeight > 0) {
+            glyphStretch = glm::vec2(static_cast<float>(base_size)) / glm::vec2(maxGlyphWidth, maxGlyphHeight);
+        }
 
-                // Resize texture array if the glyph is larger
-                if (face->glyph->bitmap.width > textureWidth || face->glyph->bitmap.rows > textureHeight) {
-                    textureWidth = std::max(face->glyph->bitmap.width, textureWidth);
-                    textureHeight = std::max(face->glyph->bitmap.rows, textureHeight);
+        // pack the glyphs in shelves, tallest first
+        std::array<int, GLYPH_COUNT> order{};
+        for (int c = 0; c < GLYPH_COUNT; ++c) {
+            order[c] = c;
+        }
+        std::sort(order.begin(), order.end(), [&bitmaps](int lhs, int rhs) { return bitmaps[lhs].rows > bitmaps[rhs].rows; });
+
+        glm::ivec2 pen{ ATLAS_PADDING, ATLAS_PADDING };
+        int shelfHeight = 0;
+        for (int c : order) {
+            GlyphBitmap& glyph = bitmaps[c];
+            if (glyph.width == 0 || glyph.rows == 0) {
+                continue;
+            }
+            if (pen.x + glyph.width + ATLAS_PADDING > ATLAS_WIDTH) {
+                pen = { ATLAS_PADDING, pen.y + shelfHeight + ATLAS_PADDING };
+                shelfHeight = 0;
+            }
+            glyph.offset = pen;
+            pen.x += glyph.width + ATLAS_PADDING;
+            shelfHeight = std::max(shelfHeight, glyph.rows);
+        }
+        int const atlasHeight = pen.y + shelfHeight + ATLAS_PADDING;
+
+        // compose the atlas and upload it at once
+        std::vector<unsigned char> pixels(static_cast<size_t>(ATLAS_WIDTH) * atlasHeight, 0);
+        for (int c = 0; c < GLYPH_COUNT; ++c) {
+            GlyphBitmap const& glyph = bitmaps[c];
+            for (int row = 0; row < glyph.rows; ++row) {
+                std::copy_n(glyph.pixels.begin() + static_cast<ptrdiff_t>(row) * glyph.width, glyph.width,
+                            pixels.begin() + static_cast<ptrdiff_t>(glyph.offset.y + row) * ATLAS_WIDTH + glyph.offset.x);
+            }
+            Characters[c].TexRect = glm::vec4(static_cast<float>(glyph.offset.x) / ATLAS_WIDTH,
+                                              static_cast<float>(glyph.offset.y) / atlasHeight,
+                                              static_cast<float>(glyph.width) / ATLAS_WIDTH,
+                                              static_cast<float>(glyph.rows) / atlasHeight);
+        }
 
-                    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_R8, textureWidth, textureHeight, numLayers, 0, GL_RED, GL_UNSIGNED_BYTE, 0);
-                }
+        centeredLayouts.clear();
+        leftAlignLayouts.clear();
 
-                glTexSubImage3D(
-                    GL_TEXTURE_2D_ARRAY,
-                    0, 0, 0, int(c),
-                    face->glyph->bitmap.width,
-                    face->glyph->bitmap.rows, 1,
-                    GL_RED,
-                    GL_UNSIGNED_BYTE,
-                    face->glyph->bitmap.buffer
-                );
-
-                // now store character for later use
-                Character character = {
-                    int(c),
-                    glm::ivec2(face->glyph->bitmap.width, face->glyph->bitmap.rows),
-                    glm::ivec2(face->glyph->bitmap_left, face->glyph->bitmap_top),
-                    static_cast<unsigned int>(face->glyph->advance.x)
-                };
-
-                GLenum error = glGetError();
-                if (error != GL_NO_ERROR) {
-                    IS_CORE_ERROR("Error loading font character '{}' from {}", static_cast<char>(c), filepath);
-                }
+        // the glyph metrics are all a run without a context lays text out with
+        if (!ISGraphics::HasContext()) {
+            return;
+        }
 
-                Characters.insert(std::pair<char, Character>(c, character));
-            }
-            // set texture options
-            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-            glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
-            
+        if (atlas) {
+            glDeleteTextures(1, &atlas);
+        }
+        glCreateTextures(GL_TEXTURE_2D, 1, &atlas);
+        glTextureStorage2D(atlas, 1, GL_R8, ATLAS_WIDTH, atlasHeight);
+
+        // disable byte-alignment restriction
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTextureSubImage2D(atlas, 0, 0, 0, ATLAS_WIDTH, atlasHeight, GL_RED, GL_UNSIGNED_BYTE, pixels.data());
+
+        // set texture options
+        glTextureParameteri(atlas, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTextureParameteri(atlas, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTextureParameteri(atlas, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTextureParameteri(atlas, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+        GLenum error = glGetError();
+        if (error != GL_NO_ERROR) {
+            IS_CORE_ERROR("Error loading font atlas from {}", filepath);
         }
-        // destroy FreeType once we're finished
-        FT_Done_Face(face);
-        FT_Done_FreeType(ft);
-        textShader.unUse();
 
-        for (int i = 0; i < ARRAY_LIMIT; i++) {
-            letterMap.push_back(0);
-            transforms.push_back(glm::mat4(1.0f));
+        if (!text_vao) {
+            createBuffers();
         }
+    }
 
+    void Text::createBuffers() {
         GLfloat vertex_data[] = { // vertices for VAO
             0.0f, 1.0f,
             0.0f, 0.0f,
@@ -178,278 +202,256 @@ namespace IS {
             1.0f, 0.0f,
         };
 
-        // configure VAO/VBO for text texture quads
-        glGenVertexArrays(1, &text_vao);
-        glGenBuffers(1, &text_vbo);
-        glBindVertexArray(text_vao);
-        glBindBuffer(GL_ARRAY_BUFFER, text_vbo);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(vertex_data), vertex_data, GL_STATIC_DRAW);
-        glEnableVertexAttribArray(0);
-        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, 0);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindVertexArray(0);
-    }
-
-    // render line of text
-    void Text::renderText(std::string text, float widthScalar, float heightScalar, float scale, glm::vec4 color) {
-        // Base window size for reference
-        const float BASE_WINDOW_WIDTH = 1920.0f;
-        const float BASE_WINDOW_HEIGHT = 1080.0f;
+        glCreateBuffers(1, &text_vbo);
+        glNamedBufferStorage(text_vbo, sizeof(vertex_data), vertex_data, 0);
 
-        // Get current window size
-        int width, height;
-        InsightEngine::Instance().GetWindowSize(width, height);
+        instanceCapacity = static_cast<GLsizeiptr>(1024 * sizeof(GlyphInstance));
+        glCreateBuffers(1, &instance_vbo);
+        glNamedBufferData(instance_vbo, instanceCapacity, nullptr, GL_STREAM_DRAW);
 
-        float scaleX = static_cast<float>(width) / BASE_WINDOW_WIDTH;
-        float scaleY = static_cast<float>(height) / BASE_WINDOW_HEIGHT;
-        scale = scale * std::min(scaleX, scaleY); // Use the smaller of the two to maintain aspect ratio
+        // unit quad per vertex, glyph rect, atlas rect and color per instance
+        glCreateVertexArrays(1, &text_vao);
+        glVertexArrayVertexBuffer(text_vao, 0, text_vbo, 0, 2 * sizeof(GLfloat));
+        glVertexArrayVertexBuffer(text_vao, 1, instance_vbo, 0, sizeof(GlyphInstance));
+        glVertexArrayBindingDivisor(text_vao, 1, 1);
 
-        // Adjust scale for text based on the original text size design
-        scale = scale * 48.f / (base_size * 16);
-        glm::mat4 projection = glm::ortho(0.0f, static_cast<float>(width), 0.0f, static_cast<float>(height));
-        textShader.use();
-        glUniformMatrix4fv(glGetUniformLocation(textShader.getHandle(), "projection"), 1, GL_FALSE, glm::value_ptr(projection));
-        textShader.unUse();
+        glEnableVertexArrayAttrib(text_vao, 0);
+        glVertexArrayAttribFormat(text_vao, 0, 2, GL_FLOAT, GL_FALSE, 0);
+        glVertexArrayAttribBinding(text_vao, 0, 0);
 
-        // Calculate the width and height of the text
-        float textWidth = 0.0f;
-        float textHeight = 0.0f;
+        GLuint const offsets[] = {
+            static_cast<GLuint>(offsetof(GlyphInstance, rect)),
+            static_cast<GLuint>(offsetof(GlyphInstance, texRect)),
+            static_cast<GLuint>(offsetof(GlyphInstance, color))
+        };
+        for (GLuint i = 0; i < 3; ++i) {
+            glEnableVertexArrayAttrib(text_vao, i + 1);
+            glVertexArrayAttribFormat(text_vao, i + 1, 4, GL_FLOAT, GL_FALSE, offsets[i]);
+            glVertexArrayAttribBinding(text_vao, i + 1, 1);
+        }
+    }
 
-        const float yPadding = 120; // for newline
+    Text::TextLayout& Text::getLayout(std::string const& text, bool leftAlign) {
+        auto& cache = leftAlign ? leftAlignLayouts : centeredLayouts;
+        auto [it, inserted] = cache.try_emplace(text);
+        TextLayout& layout = it->second;
+        layout.lastFrame = frame;
+        if (!inserted) {
+            return layout;
+        }
 
-        Character longestChar = Characters['l'];
-        float lineHeight = static_cast<float>(longestChar.Size.y) * scale; // Initialize the height for the current line
+        auto glyph = [this](char c) -> Character const& {
+            static Character const missing{};
+            unsigned char code = static_cast<unsigned char>(c);
+            return code < GLYPH_COUNT ? Characters[code] : missing;
+        };
 
-        // Iterate through all characters in the text.
-        std::string::const_iterator c;
-        for (c = text.begin(); c != text.end(); c++) {
-            Character ch = Characters[*c];
+        // laid out at unit scale, the scale of a render call is applied when its glyphs are emitted
+        const float yPadding = 120; // for newline
+        float lineHeight = static_cast<float>(glyph('l').Size.y);
 
-            if (*c == '\n') { // if new line
-                textHeight += lineHeight; // Increase total height for the current line
-                textWidth = std::max(textWidth, 0.0f); // Reset width for new line
-            }
-            else if (*c == ' ') { // if whitespace
-                textWidth += (ch.Advance >> 6) * scale; // Increase total width for whitespace
+        // Calculate the width and height of the text
+        float textWidth = 0.0f;
+        float textHeight = lineHeight;
+        for (char c : text) {
+            if (c == '\n') {
+                textHeight += lineHeight;
             }
             else {
-                textWidth += (ch.Advance >> 6) * scale; // Increase total width for character
+                textWidth += static_cast<float>(glyph(c).Advance >> 6);
             }
         }
-        textHeight += lineHeight; // Add the height of the last line
 
-        // Calculate the adjusted starting position for center alignment
-        float x = widthScalar * width - textWidth / 2.0f;
-        float y = heightScalar * height - textHeight / 2.0f;
+        // starting position relative to the text position, centered or left aligned
+        float startX = leftAlign ? 0.f : -textWidth / 2.0f;
+        float x = startX;
+        float y = leftAlign ? 0.f : -textHeight / 2.0f;
 
-        // Activate the specified shader and set the text color.
-        textShader.use();
-        glUniform4f(glGetUniformLocation(textShader.getHandle(), "textColor"), color.r, color.g, color.b, color.a);
+        layout.quads.reserve(text.size());
+        for (char c : text) {
+            Character const& ch = glyph(c);
 
-        // Bind textures and buffers.
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D_ARRAY, textureArray);
-        glBindVertexArray(text_vao);
-        glBindBuffer(GL_ARRAY_BUFFER, text_vbo);
-
-        int char_index = 0;
-
-        // Iterate through all characters in the text again for rendering.
-        for (c = text.begin(); c != text.end(); c++) {
-            Character ch = Characters[*c];
-
-            if (*c == '\n') { // if new line
-                y -= lineHeight + (yPadding * scale); // Move to the next line by subtracting the line height
-                x = widthScalar * width - textWidth / 2.0f; // Adjust for center alignment
+            if (c == '\n') { // if new line
+                y -= lineHeight + yPadding;
+                x = startX;
+                continue;
             }
-            else if (*c == ' ') { // if whitespace
-                x += (ch.Advance >> 6) * scale; // add empty space in texture
-            }
-            else {
-                // Calculate the position and transformation for the character
-                float xpos = x + ch.Bearing.x * scale;
-                float ypos = y - (base_size - ch.Bearing.y) * scale;
 
-                // Store the transformation matrix and character texture ID
-                transforms[char_index] = glm::translate(glm::mat4(1.0f), glm::vec3(xpos, ypos, 0)) * glm::scale(glm::mat4(1.0f), glm::vec3(base_size * scale, base_size * scale, 0));
-                letterMap[char_index] = ch.TextureID;
-
-                // Render the character as a quad
-                x += (ch.Advance >> 6) * scale; // bitshift by 6 to get value in pixels (2^6 = 64)
-                char_index++;
-            }
-
-            // Perform a render call if the character limit is reached
-            if (char_index == ARRAY_LIMIT - 1) {
-                textRenderCall(char_index);
-                char_index = 0;
+            if (ch.Size.x > 0 && ch.Size.y > 0) {
+                glm::vec2 size = glm::vec2(ch.Size) * glyphStretch;
+                glm::vec2 corner{ x + ch.Bearing.x, y + ch.Bearing.y - size.y };
+                layout.quads.push_back({ glm::vec4(corner, size), ch.TexRect });
             }
+            x += static_cast<float>(ch.Advance >> 6); // bitshift by 6 to get value in pixels (2^6 = 64)
         }
-
-        // Perform the final render call for any remaining characters
-        textRenderCall(char_index);
-
-        // Unbind buffers and textures
-        textShader.unUse();
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindVertexArray(0);
-        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+        return layout;
     }
 
-    // render line of text
-    void Text::renderTextLeftAlign(std::string text, float widthScalar, float heightScalar, float scale, glm::vec4 color) {
+    void Text::emitGlyphs(TextRenderCall const& call, int width, int height) {
         // Base window size for reference
         const float BASE_WINDOW_WIDTH = 1920.0f;
         const float BASE_WINDOW_HEIGHT = 1080.0f;
 
-        // Get current window size
-        int width, height;
-        InsightEngine::Instance().GetWindowSize(width, height);
-
         float scaleX = static_cast<float>(width) / BASE_WINDOW_WIDTH;
         float scaleY = static_cast<float>(height) / BASE_WINDOW_HEIGHT;
-        scale = scale * std::min(scaleX, scaleY); // Use the smaller of the two to maintain aspect ratio
+        float scale = call.scale * std::min(scaleX, scaleY); // Use the smaller of the two to maintain aspect ratio
 
         // Adjust scale for text based on the original text size design
         scale = scale * 48.f / (base_size * 16);
-        glm::mat4 projection = glm::ortho(0.0f, static_cast<float>(width), 0.0f, static_cast<float>(height));
-        textShader.use();
-        glUniformMatrix4fv(glGetUniformLocation(textShader.getHandle(), "projection"), 1, GL_FALSE, glm::value_ptr(projection));
-        textShader.unUse();
 
-        // Calculate the width and height of the text
-        float textWidth = 0.0f;
-        float textHeight = 0.0f;
-
-        const float yPadding = 120; // for newline
-
-        Character longestChar = Characters['l'];
-        float lineHeight = static_cast<float>(longestChar.Size.y) * scale; // Initialize the height for the current line
-
-        // Iterate through all characters in the text.
-        std::string::const_iterator c;
-        for (c = text.begin(); c != text.end(); c++) {
-            Character ch = Characters[*c];
+        glm::vec2 position{ call.widthScalar * width, call.heightScalar * height };
+        for (GlyphQuad const& quad : call.layout->quads) {
+            instances.push_back({ glm::vec4(position.x + quad.rect.x * scale, position.y + quad.rect.y * scale,
+                                            quad.rect.z * scale, quad.rect.w * scale),
+                                  quad.texRect, call.color });
+        }
+    }
 
-            if (*c == '\n') { // if new line
-                textHeight += lineHeight; // Increase total height for the current line
-                textWidth = std::max(textWidth, 0.0f); // Reset width for new line
-            }
-            else if (*c == ' ') { // if whitespace
-                textWidth += (ch.Advance >> 6) * scale; // Increase total width for whitespace
-            }
-            else {
-                textWidth += (ch.Advance >> 6) * scale; // Increase total width for character
+    void Text::evictLayouts() {
+        for (auto* cache : { &centeredLayouts, &leftAlignLayouts }) {
+            if (cache->size() > MAX_CACHED_LAYOUTS) {
+                std::erase_if(*cache, [](auto const& entry) { return entry.second.lastFrame != frame; });
             }
         }
-        textHeight += lineHeight; // Add the height of the last line
+    }
 
-        // Calculate the adjusted starting position for left alignment
-        float x = widthScalar * width;
-        float y = heightScalar * height;
+    void Text::drawBatches(int width, int height) {
+        if (batches.empty() || !text_vao) {
+            return;
+        }
 
-        // Activate the specified shader and set the text color.
-        textShader.use();
-        glUniform4f(glGetUniformLocation(textShader.getHandle(), "textColor"), color.r, color.g, color.b, color.a);
+        // grow or orphan the instance buffer, then stream the glyphs in
+        GLsizeiptr size = static_cast<GLsizeiptr>(instances.size() * sizeof(GlyphInstance));
+        if (size > instanceCapacity) {
+            instanceCapacity = std::max(size, instanceCapacity * 2);
+            glNamedBufferData(instance_vbo, instanceCapacity, nullptr, GL_STREAM_DRAW);
+        }
+        else {
+            glInvalidateBufferData(instance_vbo);
+        }
+        glNamedBufferSubData(instance_vbo, 0, size, instances.data());
 
-        // Bind textures and buffers.
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D_ARRAY, textureArray);
+        glm::mat4 projection = glm::ortho(0.0f, static_cast<float>(width), 0.0f, static_cast<float>(height));
+        textShader.use();
+        textShader.setUniform("projection", projection);
+        textShader.setUniform("atlas", 0);
         glBindVertexArray(text_vao);
-        glBindBuffer(GL_ARRAY_BUFFER, text_vbo);
 
-        int char_index = 0;
+        for (TextBatch const& batch : batches) {
+            // a font without an atlas failed to load
+            if (!batch.atlas) {
+                continue;
+            }
+            glBindTextureUnit(0, batch.atlas);
+            glDrawArraysInstancedBaseInstance(GL_TRIANGLE_STRIP, 0, 4, batch.count, batch.first);
+        }
 
-        // Iterate through all characters in the text again for rendering.
-        for (c = text.begin(); c != text.end(); c++) {
-            Character ch = Characters[*c];
+        // Unbind buffers and textures
+        glBindVertexArray(0);
+        glBindTextureUnit(0, 0);
+        textShader.unUse();
+    }
 
-            if (*c == '\n') { // if new line
-                y -= lineHeight + (yPadding * scale); // Move to the next line by subtracting the line height
-                x = widthScalar * width; // Adjust for left alignment
-            }
-            else if (*c == ' ') { // if whitespace
-                x += (ch.Advance >> 6) * scale; // add empty space in texture
-            }
-            else {
-                // Calculate the position and transformation for the character
-                float xpos = x + ch.Bearing.x * scale;
-                float ypos = y - (base_size - ch.Bearing.y) * scale;
+    // render line of text
+    void Text::renderText(std::string const& text, float widthScalar, float heightScalar, float scale, glm::vec4 color) {
+        if (!atlas) {
+            return;
+        }
 
-                // Store the transformation matrix and character texture ID
-                transforms[char_index] = glm::translate(glm::mat4(1.0f), glm::vec3(xpos, ypos, 0)) * glm::scale(glm::mat4(1.0f), glm::vec3(base_size * scale, base_size * scale, 0));
-                letterMap[char_index] = ch.TextureID;
+        int width, height;
+        InsightEngine::Instance().GetWindowSize(width, height);
 
-                // Render the character as a quad
-                x += (ch.Advance >> 6) * scale; // bitshift by 6 to get value in pixels (2^6 = 64)
-                char_index++;
-            }
+        instances.clear();
+        batches.clear();
+        emitGlyphs({ &getLayout(text, false), widthScalar, heightScalar, scale, color }, width, height);
+        batches.push_back({ atlas, 0, static_cast<GLsizei>(instances.size()) });
+        drawBatches(width, height);
+    }
 
-            // Perform a render call if the character limit is reached
-            if (char_index == ARRAY_LIMIT - 1) {
-                textRenderCall(char_index);
-                char_index = 0;
-            }
+    // render line of text
+    void Text::renderTextLeftAlign(std::string const& text, float widthScalar, float heightScalar, float scale, glm::vec4 color) {
+        if (!atlas) {
+            return;
         }
 
-        // Perform the final render call for any remaining characters
-        textRenderCall(char_index);
+        int width, height;
+        InsightEngine::Instance().GetWindowSize(width, height);
 
-        // Unbind buffers and textures
-        textShader.unUse();
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindVertexArray(0);
-        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+        instances.clear();
+        batches.clear();
+        emitGlyphs({ &getLayout(text, true), widthScalar, heightScalar, scale, color }, width, height);
+        batches.push_back({ atlas, 0, static_cast<GLsizei>(instances.size()) });
+        drawBatches(width, height);
     }
 
+    void Text::addTextRenderCall(std::string const& text, float widthScalar, float heightScalar, float scale, glm::vec4 color) {
+        renderCalls.push_back({ &getLayout(text, false), widthScalar, heightScalar, scale, color });
+    }
 
-    void Text::textRenderCall(int length) {
-        if (length != 0 && !transforms.empty() && !letterMap.empty()) {
-            // Set the transformation matrices and character texture IDs
-            glUniformMatrix4fv(glGetUniformLocation(textShader.getHandle(), "transforms"), length, GL_FALSE, &transforms[0][0][0]);
-            glUniform1iv(glGetUniformLocation(textShader.getHandle(), "letterMap"), length, &letterMap[0]);
-
-            // Render the characters using instanced rendering
-            glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, length);
-        }
+    void Text::addLeftAlignTextRenderCall(std::string const& text, float widthScalar, float heightScalar, float scale, glm::vec4 color) {
+        leftAlignRenderCalls.push_back({ &getLayout(text, true), widthScalar, heightScalar, scale, color });
     }
 
-    void Text::addTextRenderCall(std::string text, float widthScalar, float heightScalar, float scale, glm::vec4 color) {
-        TextRenderCall renderCall;
-        renderCall.text = text;
-        renderCall.widthScalar = widthScalar;
-        renderCall.heightScalar = heightScalar;
-        renderCall.scale = scale;
-        renderCall.color = color;
+    void Text::renderAllText(std::unordered_map<std::string, Text>& textMap) {
+        int width, height;
+        InsightEngine::Instance().GetWindowSize(width, height);
 
-        renderCalls.emplace_back(renderCall);
+        gatherBatches(textMap, width, height);
+        drawBatches(width, height);
+        ++frame;
     }
 
-    void Text::addLeftAlignTextRenderCall(std::string text, float widthScalar, float heightScalar, float scale, glm::vec4 color) {
-        TextRenderCall renderCall;
-        renderCall.text = text;
-        renderCall.widthScalar = widthScalar;
-        renderCall.heightScalar = heightScalar;
-        renderCall.scale = scale;
-        renderCall.color = color;
+    size_t Text::gatherAllText(std::unordered_map<std::string, Text>& textMap, size_t& glyphCount, size_t& batchCount) {
+        int width, height;
+        InsightEngine::Instance().GetWindowSize(width, height);
 
-        leftAlignRenderCalls.emplace_back(renderCall);
+        gatherBatches(textMap, width, height);
+        glyphCount = instances.size();
+        batchCount = batches.size();
+        ++frame;
+        return instances.size() * sizeof(GlyphInstance);
     }
 
-    void Text::renderAllText(std::unordered_map<std::string, Text>& textMap) {
+    void Text::gatherBatches(std::unordered_map<std::string, Text>& textMap, int width, int height) {
+        // gather the glyphs of every font into one stream, one batch per font
+        instances.clear();
+        batches.clear();
         for (auto& [font, text] : textMap) {
-            if (text.renderCalls.empty() && text.leftAlignRenderCalls.empty()) continue;
-
-            for (const auto& renderCall : text.renderCalls) {
-                text.renderText(renderCall.text, renderCall.widthScalar, renderCall.heightScalar, renderCall.scale, renderCall.color);
+            if (!(text.renderCalls.empty() && text.leftAlignRenderCalls.empty())) {
+                size_t first = instances.size();
+                for (const auto& renderCall : text.renderCalls) {
+                    text.emitGlyphs(renderCall, width, height);
+                }
+                for (const auto& LARenderCall : text.leftAlignRenderCalls) {
+                    text.emitGlyphs(LARenderCall, width, height);
+                }
+                if (instances.size() > first) {
+                    batches.push_back({ text.atlas, static_cast<GLuint>(first), static_cast<GLsizei>(instances.size() - first) });
+                }
             }
 
-            for (const auto& LARenderCall : text.leftAlignRenderCalls) {
-                text.renderTextLeftAlign(LARenderCall.text, LARenderCall.widthScalar, LARenderCall.heightScalar, LARenderCall.scale, LARenderCall.color);
-            }
+            text.renderCalls.clear();
+            text.leftAlignRenderCalls.clear();
+            text.evictLayouts();
+        }
+    }
 
+    void Text::cleanupText(std::unordered_map<std::string, Text>& textMap) {
+        for (auto& [font, text] : textMap) {
+            if (text.atlas) {
+                glDeleteTextures(1, &text.atlas);
+                text.atlas = 0;
+            }
             text.renderCalls.clear();
             text.leftAlignRenderCalls.clear();
+            text.centeredLayouts.clear();
+            text.leftAlignLayouts.clear();
         }
+
+        glDeleteVertexArrays(1, &text_vao);
+        glDeleteBuffers(1, &text_vbo);
+        glDeleteBuffers(1, &instance_vbo);
+        text_vao = text_vbo = instance_vbo = 0;
+        instanceCapacity = 0;
     }
 }
\ No newline at end of file
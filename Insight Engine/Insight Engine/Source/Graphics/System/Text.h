@@ -26,6 +26,10 @@
 #include FT_FREETYPE_H
 #include <glad/glad.h>
 #include <glm/glm.hpp>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace IS {
@@ -34,6 +38,11 @@ namespace IS {
      *
      * The Text class encapsulates methods for rendering text using FreeType and OpenGL. It allows you to
      * display text with various fonts, sizes, and colors in an OpenGL application.
+     *
+     * The glyphs of a font are packed into a single atlas texture. The layout of a string is
+     * computed once at unit scale and cached per alignment, so a string drawn every frame only
+     * costs a hash lookup. Render calls are expanded into glyph instances that are streamed into
+     * one instance buffer shared by every font, and drawn with one instanced draw per font.
      */
     class Text {
     public:
@@ -53,105 +62,187 @@ namespace IS {
         /*!
          * \brief Initializes the Text class with a font file and shader.
          *
-         * This function initializes the Text class, loading a font file and configuring the shader for text rendering.
+         * This function initializes the Text class, loading a font file and packing its glyphs into the atlas.
          *
          * \param filepath The filepath to the font file.
-         * \param text_shader The shader for text rendering.
          */
         void initText(std::string const& filepath);
 
         /*!
          * \brief Renders text at a specified position, size, and color.
          *
-         * This function renders text at a specified position, size, and color using the provided shader.
+         * This function renders text immediately, centered on the position.
          *
-         * \param shader The shader to use for rendering.
          * \param text The text to render.
          * \param widthScalar * width for text's position. // 0 to 0.99~ [at 1 the first char will be placed to the right, outside of VP]
          * \param heightScalar * height for text's position. // 0 to 0.99~
          * \param scale The scale of the text.
          * \param color The color of the text.
          */
-        void renderText(std::string text, float widthScalar, float heightScalar, float scale, glm::vec4 color);
+        void renderText(std::string const& text, float widthScalar, float heightScalar, float scale, glm::vec4 color);
 
-        void renderTextLeftAlign(std::string text, float widthScalar, float heightScalar, float scale, glm::vec4 color);
-
-        /*!
-         * \brief Renders text using instanced rendering.
-         *
-         * This function renders text using instanced rendering for improved performance.
-         *
-         * \param length The length of the text to render.
-         * \param shader The shader to use for rendering.
-         */
-        void textRenderCall(int length);
+        void renderTextLeftAlign(std::string const& text, float widthScalar, float heightScalar, float scale, glm::vec4 color);
 
         /**
          * @brief Add a text rendering call to the list of render calls.
          *
          * This function adds a text rendering call to the list of render calls, specifying the text content,
-         * width and height scaling factors, scale, and color.
+         * width and height scaling factors, scale, and color. The layout of the text is looked up (or built)
+         * here, the call itself does not keep a copy of the string.
          *
          * @param text The text content to be rendered.
          * @param widthScalar The width scaling factor for the text rendering.
          * @param heightScalar The height scaling factor for the text rendering.
          * @param scale The overall scale factor for the text rendering.
-         * @param color The color of the rendered text, specified as a glm::vec3 (RGB).
+         * @param color The color of the rendered text, specified as a glm::vec4 (RGBA).
          */
-        void addTextRenderCall(std::string text, float widthScalar, float heightScalar, float scale, glm::vec4 color);
+        void addTextRenderCall(std::string const& text, float widthScalar, float heightScalar, float scale, glm::vec4 color);
+
+        void addLeftAlignTextRenderCall(std::string const& text, float widthScalar, float heightScalar, float scale, glm::vec4 color);
 
-        void addLeftAlignTextRenderCall(std::string text, float widthScalar, float heightScalar, float scale, glm::vec4 color);
 
-        
         /**
          * @brief Render all the queued text rendering calls.
          *
-         * This function iterates through the list of text rendering calls and renders each of them.
-         * After rendering, it clears the list of render calls.
+         * This function gathers the queued calls of every font into the instance buffer and draws
+         * them, one draw per font with queued text. After rendering, it clears the list of render calls.
          */
         static void renderAllText(std::unordered_map<std::string, Text>& textMap);
 
+        /**
+         * @brief Gathers the queued text calls like renderAllText, without drawing them.
+         *
+         * Used when there is no graphics context. The calls are cleared the same way.
+         *
+         * @param glyphCount Set to the number of glyph instances gathered.
+         * @param batchCount Set to the number of draws renderAllText would issue.
+         * @return The size of the gathered glyph instances in bytes.
+         */
+        static size_t gatherAllText(std::unordered_map<std::string, Text>& textMap, size_t& glyphCount, size_t& batchCount);
+
+        /**
+         * @brief Deletes the atlases of the fonts and the buffers shared by all fonts.
+         */
+        static void cleanupText(std::unordered_map<std::string, Text>& textMap);
+
         /// Holds all state information relevant to a character as loaded using FreeType
         struct Character {
-            int TextureID;          // ID handle of the glyph texture
-            glm::ivec2   Size;      // Size of glyph
-            glm::ivec2   Bearing;   // Offset from baseline to left/top of glyph
-            unsigned int Advance;   // Horizontal offset to advance to next glyph
+            glm::vec4    TexRect{};     // Offset and size of the glyph in the atlas, in texture coordinates
+            glm::ivec2   Size{};        // Size of glyph
+            glm::ivec2   Bearing{};     // Offset from baseline to left/top of glyph
+            unsigned int Advance{};     // Horizontal offset to advance to next glyph
         };
 
+        static constexpr int GLYPH_COUNT = 128;             // Characters loaded from a font, indexed by code
+        static constexpr int ATLAS_WIDTH = 2048;            // Width of a glyph atlas, its height fits the glyphs
+        static constexpr int ATLAS_PADDING = 2;             // Empty texels between glyphs, against filtering bleed
+        static constexpr size_t MAX_CACHED_LAYOUTS = 256;   // Layouts kept per alignment before unused ones are dropped
+
         // Member variables
         static Shader textShader;
-        std::map<GLchar, Text::Character> Characters; // A map of character information loaded from FreeType.
-        unsigned int text_vao{};                        // VAO for text rendering.
-        unsigned int text_vbo{};                        // VBO for text rendering.
-        GLuint textureArray{};                          // Texture array for storing glyph textures.
-        std::vector<glm::mat4> transforms{};            // Transforms for text rendering.
-        std::vector<int> letterMap{};                   // Letter map for text rendering.
-        const int ARRAY_LIMIT = 128;         // The maximum limit for text rendering.
-        const int base_size = 256;                    // The base size for text rendering.
+        std::array<Character, GLYPH_COUNT> Characters{};    // Glyph information loaded from FreeType, indexed by character.
+        GLuint atlas{};                                     // Texture all glyphs are packed in.
+        glm::vec2 glyphStretch{ 1.f, 1.f };                 // Size a glyph is drawn at per pixel of its bitmap.
+        static constexpr int base_size = 256;               // The base size for text rendering.
 
     private:
+        /**
+         * @brief A glyph quad of a laid out string at unit scale, relative to the text position.
+         */
+        struct GlyphQuad {
+            glm::vec4 rect{};       // Bottom left corner and size
+            glm::vec4 texRect{};    // Offset and size in the atlas
+        };
+
+        /**
+         * @brief Cached layout of a string.
+         */
+        struct TextLayout {
+            std::vector<GlyphQuad> quads;
+            uint64_t lastFrame{};   // Last frame the layout was used in
+        };
+
+    public:
         /**
          * @brief The TextRenderCall struct represents a single rendering call for text.
          *
-         * The TextRenderCall struct encapsulates information needed for rendering a text string, including the text content,
+         * The TextRenderCall struct encapsulates information needed for rendering a laid out string, including
          * width and height scaling factors, scale, and color.
          */
         struct TextRenderCall {
-            std::string text{};
+            TextLayout const* layout{};
             float widthScalar{};
             float heightScalar{};
             float scale{};
             glm::vec4 color{};
         };
 
+    private:
+        /**
+         * @brief A glyph as streamed to the text shader.
+         */
+        struct GlyphInstance {
+            glm::vec4 rect{};       // Bottom left corner and size, in window pixels
+            glm::vec4 texRect{};    // Offset and size in the atlas
+            glm::vec4 color{};
+        };
+
+        /**
+         * @brief A range of the instance buffer drawn with one atlas.
+         */
+        struct TextBatch {
+            GLuint atlas{};
+            GLuint first{};
+            GLsizei count{};
+        };
+
+        /**
+         * @brief Finds the cached layout of a string, laying it out on a miss.
+         */
+        TextLayout& getLayout(std::string const& text, bool leftAlign);
+
+        /**
+         * @brief Appends the glyph instances of a render call to the instance stream.
+         */
+        void emitGlyphs(TextRenderCall const& call, int width, int height);
+
+        /**
+         * @brief Drops the layouts not used this frame once a cache holds too many.
+         */
+        void evictLayouts();
+
+        /**
+         * @brief Expands the queued calls of every font into the instance stream, one batch per font.
+         */
+        static void gatherBatches(std::unordered_map<std::string, Text>& textMap, int width, int height);
+
+        /**
+         * @brief Uploads the instance stream and draws the batches.
+         */
+        static void drawBatches(int width, int height);
+
+        /**
+         * @brief Creates the vertex array and buffers shared by all fonts.
+         */
+        static void createBuffers();
+
+        std::unordered_map<std::string, TextLayout> centeredLayouts;
+        std::unordered_map<std::string, TextLayout> leftAlignLayouts;
+
+        static GLuint text_vao;                             // VAO for text rendering, shared by all fonts.
+        static GLuint text_vbo;                             // VBO of the unit quad.
+        static GLuint instance_vbo;                         // VBO the glyph instances are streamed to.
+        static GLsizeiptr instanceCapacity;                 // Size of instance_vbo in bytes.
+        static std::vector<GlyphInstance> instances;        // Glyph instances of the current draw.
+        static std::vector<TextBatch> batches;              // Atlas ranges of the current draw.
+        static uint64_t frame;                              // Frames drawn by renderAllText.
+
     public:
         /**
-         * @brief Static vector to store text rendering calls.
+         * @brief Vectors to store text rendering calls.
          *
-         * The static vector `renderCalls` is used to store instances of TextRenderCall, representing text rendering calls.
-         * It holds information such as text content, scaling factors, scale, and color for each rendering call.
-         * The vector is static to ensure that it is shared among all instances of the Text class.
+         * The vector `renderCalls` is used to store instances of TextRenderCall, representing text rendering calls.
+         * It holds information such as the layout, scaling factors, scale, and color for each rendering call.
          */
        std::vector<TextRenderCall> renderCalls;
        std::vector<TextRenderCall> leftAlignRenderCalls;
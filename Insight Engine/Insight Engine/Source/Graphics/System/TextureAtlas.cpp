@@ -0,0 +1,286 @@
+/*!
+ * \file TextureAtlas.cpp
+ * \author Koh Yan Khang, yankhang.k@digipen.edu
+ * \par Course: CSD2451
+ * \date 19-10-2026
+ * \brief
+ * This source file defines the TextureAtlas class, which packs every loaded image
+ * into the layers of a single array texture.
+ *
+ * \copyright
+ * All content (C) 2024 DigiPen Institute of Technology Singapore.
+ * All rights reserved.
+ * Reproduction or disclosure of this file or its contents without the prior written
+ * consent of DigiPen Institute of Technology is prohibited.
+ *____________________________________________________________________________*/
+
+ /*                                                                   includes
+ ----------------------------------------------------------------------------- */
+#include "Pch.h"
+#include "TextureAtlas.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace IS {
+
+    bool TextureAtlas::Pad(uint8_t const* pixels, int width, int height, int channels, CookedImage& image) {
+        if (!pixels || width <= 0 || height <= 0 || channels < 1 || channels > 4) {
+            return false;
+        }
+
+        // pad to whole blocks, the extra texels on the right and bottom repeat the edge too
+        image.width = width;
+        image.height = height;
+        image.channels = channels;
+        image.padded_width = PaddedSize(width);
+        image.padded_height = PaddedSize(height);
+
+        // expand to RGBA the same way the driver expands 1 to 3 channel uploads
+        image.format = GL_RGBA8;
+        image.data.resize(static_cast<size_t>(image.padded_width) * image.padded_height * 4);
+        uint8_t* dst = image.data.data();
+        for (GLsizei row = 0; row < image.padded_height; ++row) {
+            int src_row = std::clamp(row - PADDING, 0, height - 1);
+            for (GLsizei column = 0; column < image.padded_width; ++column) {
+                int src_column = std::clamp(column - PADDING, 0, width - 1);
+                uint8_t const* src = pixels + (static_cast<size_t>(src_row) * width + src_column) * channels;
+                dst[0] = src[0];
+                dst[1] = channels > 1 ? src[1] : 0;
+                dst[2] = channels > 2 ? src[2] : 0;
+                dst[3] = channels > 3 ? src[3] : 255;
+                dst += 4;
+            }
+        }
+        return true;
+    }
+
+    bool TextureAtlas::EncodeRows(CookedImage const& padded, GLsizei first_row, GLsizei row_count, std::vector<uint8_t>& blocks) {
+        if (padded.format != GL_RGBA8 || first_row % BLOCK_SIZE || row_count % BLOCK_SIZE || first_row + row_count > padded.padded_height) {
+            return false;
+        }
+        uint8_t const* rows = padded.data.data() + static_cast<size_t>(first_row) * padded.padded_width * 4;
+        return Compress(rows, padded.padded_width, row_count, blocks);
+    }
+
+    GLenum TextureAtlas::GetCookedFormat() {
+        static GLenum const format = [] {
+            // some drivers only decode BC7, try a block before committing to it
+            std::vector<uint8_t> blocks;
+            uint8_t const texels[BLOCK_SIZE * BLOCK_SIZE * 4]{};
+            if ((GLAD_GL_VERSION_4_2 || GLAD_GL_ARB_texture_compression_bptc) && Compress(texels, BLOCK_SIZE, BLOCK_SIZE, blocks)) {
+                return static_cast<GLenum>(GL_COMPRESSED_RGBA_BPTC_UNORM);
+            }
+            IS_CORE_WARN("BC7 encoding unavailable, textures are cooked uncompressed");
+            return static_cast<GLenum>(GL_RGBA8);
+        }();
+        return format;
+    }
+
+    std::vector<uint8_t> TextureAtlas::Unpad(CookedImage const& image) {
+        // copy rows of texels, or rows of blocks, skipping the padding around the image
+        bool compressed = image.format != GL_RGBA8;
+        GLsizei unit = compressed ? BLOCK_SIZE : 1;
+        size_t unit_bytes = compressed ? BLOCK_BYTES : 4;
+        size_t columns = static_cast<size_t>((image.width + unit - 1) / unit);
+        size_t rows = static_cast<size_t>((image.height + unit - 1) / unit);
+        size_t padded_columns = static_cast<size_t>(image.padded_width / unit);
+        size_t skip = static_cast<size_t>(PADDING / unit);
+
+        std::vector<uint8_t> data(columns * rows * unit_bytes);
+        if (image.data.size() < padded_columns * (rows + skip * 2) * unit_bytes) {
+            data.clear();
+            return data;
+        }
+        for (size_t row = 0; row < rows; ++row) {
+            std::memcpy(data.data() + row * columns * unit_bytes,
+                        image.data.data() + ((row + skip) * padded_columns + skip) * unit_bytes, columns * unit_bytes);
+        }
+        return data;
+    }
+
+    bool TextureAtlas::Add(int texture_index, CookedImage const& image) {
+        if (texture_index < 0 || image.data.empty()) {
+            return false;
+        }
+        if (image.format != GetCookedFormat()) {
+            IS_CORE_ERROR("Texture {} was cooked to format {:#x}, the atlas uses {:#x}", texture_index, image.format, GetCookedFormat());
+            return false;
+        }
+        if (image.padded_width > LAYER_SIZE || image.padded_height > LAYER_SIZE) {
+            IS_CORE_ERROR("Texture {} ({}x{}) does not fit in a {}x{} atlas layer", texture_index, image.width, image.height, LAYER_SIZE, LAYER_SIZE);
+            return false;
+        }
+
+        GLsizei layer{}, x{}, y{};
+        if (!Allocate(image.padded_width, image.padded_height, layer, x, y)) {
+            IS_CORE_ERROR("Texture atlas is out of layers, texture {} not packed", texture_index);
+            return false;
+        }
+
+        if (mFormat == GL_RGBA8) {
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+            glTextureSubImage3D(mTextureID, 0, x, y, layer, image.padded_width, image.padded_height, 1, GL_RGBA, GL_UNSIGNED_BYTE, image.data.data());
+        }
+        else {
+            glCompressedTextureSubImage3D(mTextureID, 0, x, y, layer, image.padded_width, image.padded_height, 1,
+                                          mFormat, static_cast<GLsizei>(image.data.size()), image.data.data());
+        }
+
+        if (static_cast<size_t>(texture_index) >= mSubTextures.size()) {
+            mSubTextures.resize(static_cast<size_t>(texture_index) + 1);
+        }
+        float size = static_cast<float>(LAYER_SIZE);
+        mSubTextures[texture_index] = { static_cast<float>(layer),
+            { (x + PADDING) / size, (y + PADDING) / size, image.width / size, image.height / size } };
+        return true;
+    }
+
+    TextureAtlas::SubTexture const& TextureAtlas::Get(int texture_index) const {
+        static SubTexture const not_packed{};
+        if (texture_index < 0 || static_cast<size_t>(texture_index) >= mSubTextures.size()) {
+            return not_packed;
+        }
+        return mSubTextures[texture_index];
+    }
+
+    void TextureAtlas::Bind(GLuint unit) const {
+        glBindTextureUnit(unit, mTextureID);
+    }
+
+    void TextureAtlas::Clear() {
+        if (mTextureID) {
+            glDeleteTextures(1, &mTextureID);
+        }
+        mTextureID = 0;
+        mCapacity = 0;
+        mLayers.clear();
+        mSubTextures.clear();
+    }
+
+    bool TextureAtlas::Allocate(GLsizei width, GLsizei height, GLsizei& layer, GLsizei& x, GLsizei& y) {
+        // best fitting shelf of any layer
+        Shelf* best = nullptr;
+        GLsizei best_layer{};
+        for (GLsizei i = 0; i < static_cast<GLsizei>(mLayers.size()); ++i) {
+            for (Shelf& shelf : mLayers[i].shelves) {
+                if (shelf.height >= height && LAYER_SIZE - shelf.x >= width && (!best || shelf.height < best->height)) {
+                    best = &shelf;
+                    best_layer = i;
+                }
+            }
+        }
+
+        // a shelf much taller than the image wastes less space as a new shelf
+        if (!best || best->height > height * 2) {
+            for (GLsizei i = 0; i < static_cast<GLsizei>(mLayers.size()); ++i) {
+                Layer& candidate = mLayers[i];
+                if (LAYER_SIZE - candidate.top >= height) {
+                    candidate.shelves.push_back({ 0, candidate.top, height });
+                    candidate.top += height;
+                    best = &candidate.shelves.back();
+                    best_layer = i;
+                    break;
+                }
+            }
+        }
+
+        if (!best) {
+            if (!Reserve(static_cast<GLsizei>(mLayers.size()) + 1)) {
+                return false;
+            }
+            best_layer = static_cast<GLsizei>(mLayers.size());
+            Layer& new_layer = mLayers.emplace_back();
+            new_layer.shelves.push_back({ 0, 0, height });
+            new_layer.top = height;
+            best = &new_layer.shelves.back();
+        }
+
+        layer = best_layer;
+        x = best->x;
+        y = best->y;
+        best->x += width;
+        return true;
+    }
+
+    bool TextureAtlas::Reserve(GLsizei layer_count) {
+        if (layer_count <= mCapacity) {
+            return true;
+        }
+
+        GLint max_layers{};
+        glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &max_layers);
+        if (layer_count > max_layers) {
+            return false;
+        }
+        Resize(std::clamp(mCapacity + mCapacity / 4, layer_count, static_cast<GLsizei>(max_layers)));
+        return true;
+    }
+
+    void TextureAtlas::Trim() {
+        GLsizei layer_count = std::max(static_cast<GLsizei>(mLayers.size()), 1);
+        if (mTextureID && layer_count < mCapacity) {
+            Resize(layer_count);
+        }
+    }
+
+    GLsizei TextureAtlas::EstimateLayers(size_t total_area) {
+        // images arrive unsorted and a shelf up to twice as tall as an image is reused, so best fit
+        // shelves fill about two thirds of a layer, the spare layers are trimmed after the initial load
+        double layer_area = static_cast<double>(LAYER_SIZE) * LAYER_SIZE * 2. / 3.;
+        return static_cast<GLsizei>(std::ceil(static_cast<double>(total_area) / layer_area));
+    }
+
+    void TextureAtlas::Resize(GLsizei capacity) {
+        mFormat = GetCookedFormat();
+        GLuint texture_id{};
+        glCreateTextures(GL_TEXTURE_2D_ARRAY, 1, &texture_id);
+        glTextureStorage3D(texture_id, 1, mFormat, LAYER_SIZE, LAYER_SIZE, capacity);
+        glTextureParameteri(texture_id, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTextureParameteri(texture_id, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTextureParameteri(texture_id, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTextureParameteri(texture_id, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+        // move the packed layers over without a round trip through the CPU
+        if (mTextureID) {
+            if (!mLayers.empty()) {
+                glCopyImageSubData(mTextureID, GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0,
+                                   texture_id, GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0,
+                                   LAYER_SIZE, LAYER_SIZE, static_cast<GLsizei>(mLayers.size()));
+            }
+            glDeleteTextures(1, &mTextureID);
+        }
+
+        IS_CORE_DEBUG("Texture atlas resized to {} layers", capacity);
+        mTextureID = texture_id;
+        mCapacity = capacity;
+    }
+
+    bool TextureAtlas::Compress(uint8_t const* rgba, GLsizei width, GLsizei height, std::vector<uint8_t>& blocks) {
+        while (glGetError() != GL_NO_ERROR) {}
+
+        // uploading texels to BC7 storage makes the driver encode them, read the blocks back
+        GLuint texture_id{};
+        glCreateTextures(GL_TEXTURE_2D, 1, &texture_id);
+        glTextureStorage2D(texture_id, 1, GL_COMPRESSED_RGBA_BPTC_UNORM, width, height);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTextureSubImage2D(texture_id, 0, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, rgba);
+
+        GLint size{};
+        glGetTextureLevelParameteriv(texture_id, 0, GL_TEXTURE_COMPRESSED_IMAGE_SIZE, &size);
+        bool compressed = glGetError() == GL_NO_ERROR && size > 0;
+        if (compressed) {
+            size_t offset = blocks.size();
+            blocks.resize(offset + static_cast<size_t>(size));
+            glGetCompressedTextureImage(texture_id, 0, size, blocks.data() + offset);
+            compressed = glGetError() == GL_NO_ERROR;
+            if (!compressed) {
+                blocks.resize(offset);
+            }
+        }
+        glDeleteTextures(1, &texture_id);
+        return compressed;
+    }
+
+} // end namespace IS
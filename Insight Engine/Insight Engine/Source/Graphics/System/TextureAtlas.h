@@ -0,0 +1,213 @@
+/*!
+ * \file TextureAtlas.h
+ * \author Koh Yan Khang, yankhang.k@digipen.edu
+ * \par Course: CSD2451
+ * \date 19-10-2026
+ * \brief
+ * This header file declares the TextureAtlas class, which packs every loaded image
+ * into the layers of a single array texture so all quads draw with one bind.
+ *
+ * \copyright
+ * All content (C) 2024 DigiPen Institute of Technology Singapore.
+ * All rights reserved.
+ * Reproduction or disclosure of this file or its contents without the prior written
+ * consent of DigiPen Institute of Technology is prohibited.
+ *____________________________________________________________________________*/
+
+ /*                                                                      guard
+ ----------------------------------------------------------------------------- */
+#ifndef GAM200_INSIGHT_ENGINE_GRAPHICS_SYSTEM_TEXTURE_ATLAS_H
+#define GAM200_INSIGHT_ENGINE_GRAPHICS_SYSTEM_TEXTURE_ATLAS_H
+
+ /*                                                                   includes
+ ----------------------------------------------------------------------------- */
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace IS {
+    /*!
+     * \brief Array texture holding every image, with a sub-rect table indexed by texture index.
+     *
+     * Images are cooked first: surrounded by PADDING copies of their edge texels, so
+     * linear filtering behaves like GL_CLAMP_TO_EDGE did on the separate textures, padded
+     * to whole 4x4 blocks and compressed to BC7 when the driver can encode it. Cooked
+     * images are placed on shelves (rows as tall as their tallest image) in layers of
+     * LAYER_SIZE texels, using the best fitting shelf of any layer before opening a new
+     * one. Every size is a multiple of the block size, so shelves stay block aligned. The array
+     * texture grows by a quarter of its layers when full, copying the packed layers on the
+     * GPU, so bulk loads should Reserve() an estimate up front and Trim() afterwards.
+     */
+    class TextureAtlas {
+    public:
+        static constexpr GLsizei LAYER_SIZE = 4096;     // Width and height of a layer in texels
+        static constexpr GLsizei PADDING = 4;           // Edge texels repeated around each image, one block
+        static constexpr GLsizei BLOCK_SIZE = 4;        // Width and height of a BC7 block
+        static constexpr size_t BLOCK_BYTES = 16;       // Size of a BC7 block
+        static_assert(PADDING % BLOCK_SIZE == 0, "the padding must be whole blocks so the image can be cut out of it");
+
+        /*!
+         * \brief Location of an image in the atlas.
+         */
+        struct SubTexture {
+            float layer{ -1.f };                        // Layer of the array texture, -1 if not packed
+            glm::vec4 rect{ 0.f, 0.f, 1.f, 1.f };       // UV offset (xy) and size (zw) within the layer
+        };
+
+        /*!
+         * \brief Image padded and encoded in the format of the atlas, ready to upload.
+         */
+        struct CookedImage {
+            int width{};                    // Size of the source image
+            int height{};
+            int channels{};
+            GLsizei padded_width{};         // Size of the data, including the padding
+            GLsizei padded_height{};
+            GLenum format{};                // GL_COMPRESSED_RGBA_BPTC_UNORM or GL_RGBA8
+            std::vector<uint8_t> data;
+        };
+
+        /*!
+         * \brief Pads an image and expands it to RGBA8, safe to call from worker threads.
+         *
+         * The result is cooked as is when the cooked format is GL_RGBA8, otherwise it
+         * still needs EncodeRows().
+         *
+         * \param pixels The pixel data, rows from the top of the image.
+         * \param width The width of the image.
+         * \param height The height of the image.
+         * \param channels The number of 8-bit channels per pixel (1 to 4).
+         * \param image Output padded image, in GL_RGBA8.
+         * \return True if the image was padded.
+         */
+        static bool Pad(uint8_t const* pixels, int width, int height, int channels, CookedImage& image);
+
+        /*!
+         * \brief Encodes rows of a padded image to the cooked format, needs the OpenGL context.
+         *
+         * Blocks are encoded independently, so an image can be encoded a strip at a
+         * time to spread the cost over several frames.
+         *
+         * \param padded The image from Pad().
+         * \param first_row The first texel row to encode, a multiple of BLOCK_SIZE.
+         * \param row_count The number of texel rows to encode, a multiple of BLOCK_SIZE.
+         * \param blocks Vector the encoded blocks are appended to.
+         * \return False if the driver failed to encode.
+         */
+        static bool EncodeRows(CookedImage const& padded, GLsizei first_row, GLsizei row_count, std::vector<uint8_t>& blocks);
+
+        /*!
+         * \brief Gets the size of an image side once padded and rounded up to whole blocks.
+         * \param size The width or height of the image.
+         * \return The padded size.
+         */
+        static GLsizei PaddedSize(int size) { return (size + PADDING * 2 + BLOCK_SIZE - 1) / BLOCK_SIZE * BLOCK_SIZE; }
+
+        /*!
+         * \brief Gets the format images are cooked to, BC7 unless the driver cannot encode it.
+         * \return The internal format.
+         */
+        static GLenum GetCookedFormat();
+
+        /*!
+         * \brief Cuts the image out of its padding, for textures sampled on their own.
+         * \param image The cooked image.
+         * \return The texels, or the blocks covering them, of the width x height image in the cooked format.
+         */
+        static std::vector<uint8_t> Unpad(CookedImage const& image);
+
+        /*!
+         * \brief Packs a cooked image into the atlas.
+         * \param texture_index The texture index the image is looked up with.
+         * \param image The cooked image, in the cooked format.
+         * \return True if the image was packed, false if it does not fit in a layer.
+         */
+        bool Add(int texture_index, CookedImage const& image);
+
+        /*!
+         * \brief Gets the location of an image.
+         * \param texture_index The texture index of the image.
+         * \return The location, with layer -1 if the image was never packed.
+         */
+        SubTexture const& Get(int texture_index) const;
+
+        /*!
+         * \brief Binds the array texture to a texture unit.
+         * \param unit The texture unit.
+         */
+        void Bind(GLuint unit) const;
+
+        /*!
+         * \brief Grows the array texture to hold at least layer_count layers.
+         * \param layer_count The number of layers.
+         * \return False if the driver limit on layers is reached.
+         */
+        bool Reserve(GLsizei layer_count);
+
+        /*!
+         * \brief Shrinks the array texture to the layers in use.
+         */
+        void Trim();
+
+        /*!
+         * \brief Estimates the layers needed for a set of images.
+         * \param total_area The summed width * height of the images, in texels.
+         * \return The number of layers.
+         */
+        static GLsizei EstimateLayers(size_t total_area);
+
+        /*!
+         * \brief Deletes the array texture and forgets every image.
+         */
+        void Clear();
+
+        GLuint GetID() const { return mTextureID; }
+        GLsizei GetLayerCount() const { return static_cast<GLsizei>(mLayers.size()); }
+        GLsizei GetCapacity() const { return mCapacity; }
+
+    private:
+        /*!
+         * \brief Row of images in a layer.
+         */
+        struct Shelf {
+            GLsizei x{};        // Start of the free space
+            GLsizei y{};
+            GLsizei height{};
+        };
+
+        /*!
+         * \brief Shelves of a layer, stacked from the top.
+         */
+        struct Layer {
+            std::vector<Shelf> shelves;
+            GLsizei top{};      // Start of the unused rows below the last shelf
+        };
+
+        /*!
+         * \brief Finds room for a padded image, opening a shelf or layer if needed.
+         * \return False if no more layers can be added.
+         */
+        bool Allocate(GLsizei width, GLsizei height, GLsizei& layer, GLsizei& x, GLsizei& y);
+
+        /*!
+         * \brief Reallocates the array texture with a number of layers, keeping the packed ones.
+         */
+        void Resize(GLsizei capacity);
+
+        /*!
+         * \brief Lets the driver encode RGBA8 texels to BC7, appending the blocks.
+         * \return False if the driver failed to encode.
+         */
+        static bool Compress(uint8_t const* rgba, GLsizei width, GLsizei height, std::vector<uint8_t>& blocks);
+
+        GLuint mTextureID{};                    // The array texture
+        GLsizei mCapacity{};                    // Layers allocated in the array texture
+        std::vector<Layer> mLayers;             // Layers in use
+        std::vector<SubTexture> mSubTextures;   // Location of each image by texture index
+        GLenum mFormat{};                       // Internal format of the array texture
+    };
+} // end namespace IS
+
+#endif // !GAM200_INSIGHT_ENGINE_GRAPHICS_SYSTEM_TEXTURE_ATLAS_H
@@ -18,6 +18,7 @@
 #include "Transform.h"
 #include "Graphics/Core/Graphics.h"
 #include "Engine/Systems/Window/WindowSystem.h"
+#include "Engine/Systems/Replay/Replay.h"
 
 #ifdef USING_IMGUI
 #include <imgui.h>
@@ -60,26 +61,31 @@ namespace IS {
 	void Transform::setWorldPosition(float x, float y) { // set T
 		world_position.x = x;
 		world_position.y = y;
+		MarkDirty();
 	}
 
 	void Transform::setRotation(float angle, float angleSpeed) { // set R
 		rotation = angle;
 		angle_speed = angleSpeed;
+		MarkDirty();
 	}
 
 	void Transform::setScaling(float width, float height) { // set S
 		scaling.x = width;
 		scaling.y = height;
+		MarkDirty();
 	}
 
 	void Transform::setScaling(Vector2D vec)
 	{
 		scaling = vec;
+		MarkDirty();
 	}
 
 	void Transform::Move(Vector2D const& val) {
 		world_position.x += val.x;
 		world_position.y += val.y;
+		MarkDirty();
 	}
 
 	glm::mat4 Transform::Return3DXformMatrix() {
@@ -120,6 +126,36 @@ namespace IS {
 		return ISGraphics::cameras3D[Camera3D::mActiveCamera].getCameraToNDCXform() * world_to_cam_xform;
 	}
 
+	bool Transform::UpdateModelXform() {
+		if (mCachedVersion == mVersion)
+			return false;
+
+		// same as Return3DXformMatrix() without the camera, the quad spans [-1, 1] so scale by half
+		float angle_rad = glm::radians(rotation);
+		float sin_angle = sinf(angle_rad);
+		float cos_angle = cosf(angle_rad);
+		float model_scale_x = scaling.x / 2.f;
+		float model_scale_y = scaling.y / 2.f;
+		mdl_rot_scale = { model_scale_x * cos_angle, model_scale_x * sin_angle, model_scale_y * -sin_angle, model_scale_y * cos_angle };
+		mdl_translation = { world_position.x, world_position.y };
+
+		mCachedVersion = mVersion;
+		++mdl_version;
+		return true;
+	}
+
+	bool Transform::Follow(Transform const& other) {
+		angle_speed = other.angle_speed;
+		if (mVersion == other.mVersion)
+			return false;
+
+		world_position = other.world_position;
+		rotation = other.rotation;
+		scaling = other.scaling;
+		mVersion = other.mVersion;
+		return true;
+	}
+
 	glm::mat4 Transform::GetCameraToWorldTransform()
 	{
 		// convert angle to radians
@@ -143,10 +179,32 @@ namespace IS {
 
 	std::pair<double, double> Transform::GetMousePosition() {
 
+		// Get normalized device coordinates
+		std::pair<float, float> ndc = GetMouseNDC();
+		glm::vec4 ndcCoords{ ndc.first, ndc.second, 1.f, 1.f };
+
+		// Retrieve the active camera and its inverse NDC transformation matrix.
+		auto cameraInUse = ISGraphics::cameras3D[Camera3D::mActiveCamera];
+		glm::mat4 ndcToCam = glm::inverse(cameraInUse.getCameraToNDCXform());
+
+		// Transform the ndcCoords to world coordinates using the inverse NDC transformation matrix.
+		glm::vec4 worldPos = ndcToCam * ndcCoords;
+
+		//IS_CORE_WARN("World mouse X: {}, Y: {}", worldPos.x, worldPos.y);
+		return { worldPos.x, worldPos.y };
+	}
+
+	std::pair<float, float> Transform::GetMouseNDC() {
+
+		// replays supply the recorded cursor instead of the live one
+		float replayX, replayY;
+		if (ReplayManager::Instance().GetReplayMouseNDC(replayX, replayY))
+			return { replayX, replayY };
+
 		// get engine instance
 		InsightEngine& engine = InsightEngine::Instance();
 
-		double xPos, yPos; // for mouse pos
+		double xPos{}, yPos{}; // for mouse pos, stays in the corner without a window
 		float width, height; // for scaling
 
 		auto window = engine.GetSystem<WindowSystem>("Window");
@@ -168,7 +226,8 @@ namespace IS {
 		else
 		{
 			// Use GLFW to get the mouse position.
-			glfwGetCursorPos(window->GetNativeWindow(), &xPos, &yPos);
+			if (GLFWwindow* native_window = window->GetNativeWindow())
+				glfwGetCursorPos(native_window, &xPos, &yPos);
 			// Determine the rendering dimensions based on fullscreen or windowed mode.
 			// if (engine.IsFullScreen())
 			// {
@@ -182,7 +241,8 @@ namespace IS {
 			// }
 		}
 #else
-		glfwGetCursorPos(window->GetNativeWindow(), &xPos, &yPos);
+		if (GLFWwindow* native_window = window->GetNativeWindow())
+			glfwGetCursorPos(native_window, &xPos, &yPos);
 		int w, h;
 		engine.GetWindowSize(w, h);
 		width = static_cast<float>(w);
@@ -193,17 +253,7 @@ namespace IS {
 		float ndcX = static_cast<float>(2 * xPos) / width - 1.f;
 		float ndcY = (engine.mRenderGUI ? 1 : -1) * (static_cast<float>(2 * yPos) / height - 1.f);
 
-		glm::vec4 ndcCoords{ ndcX, ndcY, 1.f, 1.f };
-
-		// Retrieve the active camera and its inverse NDC transformation matrix.
-		auto cameraInUse = ISGraphics::cameras3D[Camera3D::mActiveCamera];
-		glm::mat4 ndcToCam = glm::inverse(cameraInUse.getCameraToNDCXform());
-
-		// Transform the ndcCoords to world coordinates using the inverse NDC transformation matrix.
-		glm::vec4 worldPos = ndcToCam * ndcCoords;
-
-		//IS_CORE_WARN("World mouse X: {}, Y: {}", worldPos.x, worldPos.y);
-		return { worldPos.x, worldPos.y };
+		return { ndcX, ndcY };
 	}
 
 	Json::Value Transform::Serialize() {
@@ -236,6 +286,7 @@ namespace IS {
 		// Deserializing scaling
 		scaling.x = data["TransformScalingX"].asFloat();
 		scaling.y = data["TransformScalingY"].asFloat();
+		MarkDirty();
 
 		// Note: Not deserializing mdl_to_ndc_xform since matrix deserialization can be complex and depends on specifics
 	}
@@ -24,6 +24,7 @@
 #include "Engine/Core/CoreEngine.h"
 #include <glm/glm.hpp>
 #include "glm/gtc/matrix_transform.hpp"
+#include <atomic>
 
 namespace IS {
 
@@ -36,8 +37,10 @@ namespace IS {
 		Vec2D scaling{};		// x = width, y = height
 		Mtx33 mdl_to_ndc_xform{}; // identity matrix default
 
-		// 3D cam test
-		glm::mat4 mdl_to_3dcam_to_ndc_xform{};
+		// Cached 2D model transform (translate * rotate * scale, no camera), rebuilt by UpdateModelXform() when the version changes
+		glm::vec4 mdl_rot_scale{ 1.f, 0.f, 0.f, 1.f }; // 2x2 rotation and scale, column major
+		glm::vec2 mdl_translation{};	// translation of the model
+		uint32_t mdl_version{};			// incremented every time the cached transform is rebuilt
 
 		/*!
 		 * \brief Gets the type of the Transform component.
@@ -160,6 +163,30 @@ namespace IS {
 		 */
 		glm::mat4 Return3DXformMatrix();
 
+		/*!
+		 * \brief Rebuilds the cached 2D model transform if the position, rotation or scaling changed.
+		 *
+		 * The camera is not part of the cached transform, so camera movement does not dirty it.
+		 *
+		 * \return True if the cached transform was rebuilt, false if it was still valid.
+		 */
+		bool UpdateModelXform();
+
+		/*!
+		 * \brief Marks the transform as changed, so its cached model transform is rebuilt.
+		 *
+		 * The setters call it. Code writing world_position, rotation or scaling directly must call it too.
+		 */
+		void MarkDirty() { mVersion = NextVersion(); }
+
+		/*!
+		 * \brief Copies the position, rotation and scaling of another transform if it changed since the last copy.
+		 *
+		 * \param other The transform to follow.
+		 * \return True if the values were copied.
+		 */
+		bool Follow(Transform const& other);
+
 		/**
 		 * @brief Gets the transformation matrix from camera space to world space.
 		 *
@@ -177,6 +204,13 @@ namespace IS {
 		 */
 		static std::pair<double, double> GetMousePosition();
 
+		/**
+		 * \brief Gets the current mouse position in normalized device coordinates.
+		 *
+		 * \return A pair representing the x and y NDC of the mouse cursor.
+		 */
+		static std::pair<float, float> GetMouseNDC();
+
 		/*!
 		 * \brief Serialize the Transform object to a JSON representation.
 		 *
@@ -197,6 +231,13 @@ namespace IS {
 
 		// not in use
 		// std::vector<Vector2D> GetSquareTransformVertices();
+
+	private:
+		static uint64_t NextVersion() { return sVersionCounter.fetch_add(1, std::memory_order_relaxed) + 1; }
+
+		static inline std::atomic<uint64_t> sVersionCounter{};	// Versions handed out so far, shared so equal versions mean equal values
+		uint64_t mVersion{ NextVersion() };						// Changed by every write of position, rotation or scaling
+		uint64_t mCachedVersion{};								// Version the cached model transform was built from
 	};
 
 	/**
@@ -22,64 +22,69 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+#include <cmath>
+
 namespace IS {
+    VideoPlayer::VideoReaderState::~VideoReaderState() {
+        // a player destroyed without cleanup() still stops its thread
+        if (decode_thread.joinable()) {
+            {
+                std::lock_guard lock(mutex);
+                quit = true;
+            }
+            wake.notify_all();
+            decode_thread.join();
+        }
+    }
+
     void VideoPlayer::initVideoPlayer(float widthScalar, float heightScalar, float xPosScalar, float yPosScalar, bool loop) {
         avformat_network_init();
 
-        // Reset video texture ID and frame buffer pointers.
+        // Reset video texture ID and the reader state.
         textureID = 0;
-        frameBuffer = nullptr;
-
-        // Reset FFmpeg's format and codec contexts.
-        state.av_format_ctx = nullptr;
-        state.av_codec_ctx = nullptr;
-
-        // Allocate space for a frame and a packet.
-        state.av_frame = nullptr;
-        state.av_packet = nullptr;
-
-        // Allocate space for software scaling context.
-        state.sws_scaler_ctx = nullptr;
+        state = std::make_unique<VideoReaderState>();
 
         // Set video looping and scaling attributes.
-        state.toLoop = loop;
-        state.scaleX = widthScalar;
-        state.scaleY = heightScalar;
-        state.transX = xPosScalar;
-        state.transY = yPosScalar;
+        state->toLoop = loop;
+        state->scaleX = widthScalar;
+        state->scaleY = heightScalar;
+        state->transX = xPosScalar;
+        state->transY = yPosScalar;
     }
 
 
     void VideoPlayer::loadVideo(const std::string& filepath) {
+        if (!state) return;
         cleanup(); // Ensure previous resources are released
 
         // Open video file and check if it's successful.
-        if (avformat_open_input(&state.av_format_ctx, filepath.c_str(), nullptr, nullptr) != 0) {
+        if (avformat_open_input(&state->av_format_ctx, filepath.c_str(), nullptr, nullptr) != 0) {
             IS_CORE_ERROR("Failed to open video file: {}", filepath);
             return;
         }
 
         // Retrieve stream information.
-        if (avformat_find_stream_info(state.av_format_ctx, nullptr) < 0) {
+        if (avformat_find_stream_info(state->av_format_ctx, nullptr) < 0) {
             IS_CORE_ERROR("Failed to find stream information");
             return;
         }
 
         // Find the first video stream.
-        state.video_stream_index = -1;
-        for (unsigned int i = 0; i < state.av_format_ctx->nb_streams; i++) {
-            if (state.av_format_ctx->streams[i]->codecpar->codec_type == AVMEDIA_TYPE_VIDEO) {
-                state.video_stream_index = i;
+        state->video_stream_index = -1;
+        for (unsigned int i = 0; i < state->av_format_ctx->nb_streams; i++) {
+            if (state->av_format_ctx->streams[i]->codecpar->codec_type == AVMEDIA_TYPE_VIDEO) {
+                state->video_stream_index = i;
                 break;
             }
         }
-        if (state.video_stream_index == -1) {
+        if (state->video_stream_index == -1) {
             IS_CORE_ERROR("Failed to find a video stream");
             return;
         }
 
         // Set up the codec context for the video stream.
-        AVCodecParameters* codec_params = state.av_format_ctx->streams[state.video_stream_index]->codecpar;
+        AVStream* stream = state->av_format_ctx->streams[state->video_stream_index];
+        AVCodecParameters* codec_params = stream->codecpar;
         const AVCodec* codec = avcodec_find_decoder(codec_params->codec_id);
         if (!codec) {
             IS_CORE_ERROR("Unsupported codec!");
@@ -87,114 +92,114 @@ namespace IS {
         }
 
         // Allocate video codec context.
-        state.av_codec_ctx = avcodec_alloc_context3(codec);
-        if (!state.av_codec_ctx) {
+        state->av_codec_ctx = avcodec_alloc_context3(codec);
+        if (!state->av_codec_ctx) {
             IS_CORE_ERROR("Failed to allocate codec context");
             return;
         }
 
         // Copy codec parameters to codec context.
-        if (avcodec_parameters_to_context(state.av_codec_ctx, codec_params) < 0) {
+        if (avcodec_parameters_to_context(state->av_codec_ctx, codec_params) < 0) {
             IS_CORE_ERROR("Failed to copy codec parameters");
             return;
         }
 
         // Open codec for decoding.
-        if (avcodec_open2(state.av_codec_ctx, codec, nullptr) < 0) {
+        if (avcodec_open2(state->av_codec_ctx, codec, nullptr) < 0) {
             IS_CORE_ERROR("Failed to open codec");
             return;
         }
 
         // Allocate memory for AVFrame and AVPacket.
-        state.av_frame = av_frame_alloc();
-        state.av_packet = av_packet_alloc();
-        if (!state.av_frame || !state.av_packet) {
+        state->av_frame = av_frame_alloc();
+        state->av_packet = av_packet_alloc();
+        if (!state->av_frame || !state->av_packet) {
             IS_CORE_ERROR("Failed to allocate frame or packet");
             return;
         }
 
-        // Set video dimensions from codec context.
-        state.width = state.av_codec_ctx->width;
-        state.height = state.av_codec_ctx->height;
+        // Set video dimensions and timing from the stream.
+        state->width = state->av_codec_ctx->width;
+        state->height = state->av_codec_ctx->height;
+        state->time_base = stream->time_base;
+        if (stream->avg_frame_rate.num != 0 && stream->avg_frame_rate.den != 0) {
+            state->frameDuration = av_q2d(av_inv_q(stream->avg_frame_rate));
+        }
+        else if (state->av_codec_ctx->framerate.num != 0 && state->av_codec_ctx->framerate.den != 0) {
+            state->frameDuration = av_q2d(av_inv_q(state->av_codec_ctx->framerate));
+        }
 
         prepareFrameBufferAndTexture();
         prepareScalerContext();
+
+        // from here on the decode thread owns the FFmpeg contexts
+        state->decode_thread = std::thread(decodeLoop, std::ref(*state));
     }
 
     void VideoPlayer::update(double deltaTime) {
-        // Skip update if there's no video or if the video is not playing.
-        if (!state.av_format_ctx || !state.av_codec_ctx || !state.playing) return;
-
-        // Accumulate passed time.
-        state.timeSinceLastFrame += deltaTime;
-
-        // Calculate frame duration based on the video's framerate
-        if (state.frameDuration == 0.0 && state.av_codec_ctx->framerate.num != 0) {
-            state.frameDuration = av_q2d(av_inv_q(state.av_codec_ctx->framerate));
-        }
-
-        // Only attempt to decode and display a new frame if enough time has passed
-        if (state.timeSinceLastFrame >= state.frameDuration) {
-            // Reset the timer for the next frame
-            state.timeSinceLastFrame -= state.frameDuration;
-
-            // Receiving and decoding
-            int response = av_read_frame(state.av_format_ctx, state.av_packet);
-
-            if (response == AVERROR_EOF) {
-                if (state.toLoop) {
-                    av_seek_frame(state.av_format_ctx, state.video_stream_index, 0, AVSEEK_FLAG_FRAME);
-                    avcodec_flush_buffers(state.av_codec_ctx);
+        // Skip update if there's no video.
+        if (!state || !state->pixels) return;
+
+        bool freed = false;
+        size_t present = RING_SIZE;
+        {
+            std::lock_guard lock(state->mutex);
+
+            // slots whose copy into the texture finished go back to the decoder
+            for (FrameSlot& slot : state->slots) {
+                if (slot.state == SlotState::Uploaded && glClientWaitSync(slot.fence, 0, 0) != GL_TIMEOUT_EXPIRED) {
+                    glDeleteSync(slot.fence);
+                    slot.fence = nullptr;
+                    slot.state = SlotState::Free;
+                    freed = true;
                 }
-                else {
-                    state.playing = false;
-                }
-                return; // Exit if not looping
             }
 
-            // Check packet from the correct stream and decode.
-            if (response >= 0 && state.av_packet->stream_index == state.video_stream_index) {
-                response = avcodec_send_packet(state.av_codec_ctx, state.av_packet);
-                if (response < 0) {
-                    IS_CORE_ERROR("Error sending packet to decoder: {}", response);
-                    return;
-                }
+            if (state->playing) {
+                state->video_clock += deltaTime;
 
-                // Loop to ensure all available frames are read.
-                while (response >= 0) {
-                    response = avcodec_receive_frame(state.av_codec_ctx, state.av_frame);
-                    if (response == AVERROR(EAGAIN)) {
-                        break;
-                    }
-                    else if (response < 0) {
-                        IS_CORE_ERROR("Error receiving frame from decoder: {}", response);
-                        return;
+                // newest due frame wins, the ones it overtakes are dropped without an upload
+                for (size_t i = 0; i < RING_SIZE; ++i) {
+                    FrameSlot& slot = state->slots[state->read_slot];
+                    if (slot.state != SlotState::Ready) break;
+                    if (slot.generation == state->generation && slot.pts > state->video_clock) break;
+
+                    if (slot.generation == state->generation) {
+                        if (present != RING_SIZE) {
+                            state->slots[present].state = SlotState::Free;
+                        }
+                        present = state->read_slot;
                     }
-                    // Frame is ready
-                    if (state.av_frame->data[0] != nullptr) {
-                        // Update texture with the new frame
-                        updateTexture();
-                        break; // Display one frame per update, based on deltaTime
+                    else {
+                        slot.state = SlotState::Free; // decoded before a restart
                     }
+                    freed = true;
+                    state->read_slot = (state->read_slot + 1) % RING_SIZE;
+                }
+
+                // a video that does not loop stops once its last frame was shown
+                if (present == RING_SIZE && state->end_of_stream && !state->toLoop &&
+                    state->slots[state->read_slot].state != SlotState::Ready) {
+                    state->playing = false;
                 }
             }
-            av_packet_unref(state.av_packet); // Release resources
         }
-        // No else part needed; if not enough time has passed, simply skip frame decoding
+        if (freed) {
+            state->wake.notify_one();
+        }
+
+        if (present != RING_SIZE) {
+            updateTexture(present);
+        }
     }
 
     void VideoPlayer::render() {
-        // Don't render if there's no frame, framebuffer, or texture, or if video is not playing.
-        if (!state.av_frame || !frameBuffer || !textureID || !state.playing) return;
-
-        // Update and bind the texture
-        glBindTexture(GL_TEXTURE_2D, textureID);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, state.width, state.height, 0, GL_RGB, GL_UNSIGNED_BYTE, frameBuffer);
-        glBindTexture(GL_TEXTURE_2D, 0);
+        // Don't render if there's no frame or texture, or if video is not playing.
+        if (!state || !state->has_frame || !textureID || !state->playing) return;
 
         // Setup transformation and rendering
-        glm::mat4 transform = glm::translate(glm::mat4(1.0f), glm::vec3(state.transX, state.transY, 0.0f)) *
-            glm::scale(glm::mat4(1.0f), glm::vec3(state.scaleX, state.scaleY, 1.0f));
+        glm::mat4 transform = glm::translate(glm::mat4(1.0f), glm::vec3(state->transX, state->transY, 0.0f)) *
+            glm::scale(glm::mat4(1.0f), glm::vec3(state->scaleX, state->scaleY, 1.0f));
         ISGraphics::videoShader.use();
 
         // Pass transformation matrix to shader.
@@ -217,10 +222,6 @@ namespace IS {
             IS_CORE_ERROR({ "uScreenTexture Uniform for video player not found, shader compilation failed?" });
         }
 
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, textureID);
-        glUniform1i(glGetUniformLocation(ISGraphics::videoShader.getHandle(), "uScreenTexture"), 0);
-
         // Render the video quad.
         glBindVertexArray(ISGraphics::meshes[6].vao_ID);
         glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
@@ -230,100 +231,260 @@ namespace IS {
     }
 
     void VideoPlayer::cleanup() {
+        if (!state) return;
+
+        // Stop the decode thread before freeing what it uses.
+        if (state->decode_thread.joinable()) {
+            {
+                std::lock_guard lock(state->mutex);
+                state->quit = true;
+            }
+            state->wake.notify_all();
+            state->decode_thread.join();
+            state->quit = false;
+        }
+
         // Free the frame and packet if they've been allocated.
-        if (state.av_frame) {
-            av_frame_free(&state.av_frame);
+        if (state->av_frame) {
+            av_frame_free(&state->av_frame);
         }
-        if (state.av_packet) {
-            av_packet_free(&state.av_packet);
+        if (state->av_packet) {
+            av_packet_free(&state->av_packet);
         }
         // Close and free the codec context if it exists.
-        if (state.av_codec_ctx) {
-            avcodec_close(state.av_codec_ctx);
-            avcodec_free_context(&state.av_codec_ctx);
+        if (state->av_codec_ctx) {
+            avcodec_close(state->av_codec_ctx);
+            avcodec_free_context(&state->av_codec_ctx);
         }
         // Close the format context if it's open.
-        if (state.av_format_ctx) {
-            avformat_close_input(&state.av_format_ctx);
+        if (state->av_format_ctx) {
+            avformat_close_input(&state->av_format_ctx);
         }
         // Free the scaling context if it's been set up.
-        if (state.sws_scaler_ctx) {
-            sws_freeContext(state.sws_scaler_ctx);
+        if (state->sws_scaler_ctx) {
+            sws_freeContext(state->sws_scaler_ctx);
+            state->sws_scaler_ctx = nullptr;
+        }
+        // Delete the fences, unpack buffer and texture if they've been created.
+        for (FrameSlot& slot : state->slots) {
+            if (slot.fence) {
+                glDeleteSync(slot.fence);
+            }
+            slot = FrameSlot{};
+        }
+        if (state->pbo) {
+            glUnmapNamedBuffer(state->pbo);
+            glDeleteBuffers(1, &state->pbo);
+            state->pbo = 0;
+            state->pixels = nullptr;
         }
-        // Delete the OpenGL texture if it's been created.
         if (textureID) {
             glDeleteTextures(1, &textureID);
+            textureID = 0;
         }
-        // Free the framebuffer if it's been allocated.
-        if (frameBuffer) {
-            av_free(frameBuffer);
-        }
+        state->read_slot = state->write_slot = 0;
+        state->end_of_stream = false;
+        state->has_frame = false;
+        state->video_clock = 0.0;
     }
 
     void VideoPlayer::prepareFrameBufferAndTexture() {
-        // Free any existing buffer to avoid memory leaks.
-        if (frameBuffer) {
-            av_free(frameBuffer);
-        }
-        // Allocate a new framebuffer suitable for the video size and format.
-        frameBuffer = static_cast<uint8_t*>(av_malloc(av_image_get_buffer_size(AV_PIX_FMT_RGB24, state.width, state.height, 1)));
-
         if (textureID != 0) {
             glDeleteTextures(1, &textureID); // Delete existing texture if it exists
         }
-        glGenTextures(1, &textureID);
-        glBindTexture(GL_TEXTURE_2D, textureID);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        glBindTexture(GL_TEXTURE_2D, 0);
+        glCreateTextures(GL_TEXTURE_2D, 1, &textureID);
+        glTextureStorage2D(textureID, 1, GL_RGB8, state->width, state->height);
+        glTextureParameteri(textureID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTextureParameteri(textureID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+        // The decode thread writes converted frames straight into this buffer, it stays mapped.
+        state->frame_size = static_cast<size_t>(av_image_get_buffer_size(AV_PIX_FMT_RGB24, state->width, state->height, 1));
+        GLbitfield const flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glCreateBuffers(1, &state->pbo);
+        glNamedBufferStorage(state->pbo, static_cast<GLsizeiptr>(state->frame_size * RING_SIZE), nullptr, flags);
+        state->pixels = static_cast<uint8_t*>(glMapNamedBufferRange(state->pbo, 0, static_cast<GLsizeiptr>(state->frame_size * RING_SIZE), flags));
+        if (!state->pixels) {
+            IS_CORE_ERROR("Failed to map the video unpack buffer");
+        }
     }
 
     void VideoPlayer::prepareScalerContext() {
-        if (state.sws_scaler_ctx) {
-            sws_freeContext(state.sws_scaler_ctx); // Free old context if it exists
+        if (state->sws_scaler_ctx) {
+            sws_freeContext(state->sws_scaler_ctx); // Free old context if it exists
         }
         // Set up a new scaler context for converting video frames.
-        state.sws_scaler_ctx = sws_getContext(state.width, state.height, state.av_codec_ctx->pix_fmt,
-            state.width, state.height, AV_PIX_FMT_RGB24, SWS_BILINEAR, nullptr, nullptr, nullptr);
+        state->sws_scaler_ctx = sws_getContext(state->width, state->height, state->av_codec_ctx->pix_fmt,
+            state->width, state->height, AV_PIX_FMT_RGB24, SWS_BILINEAR, nullptr, nullptr, nullptr);
+    }
+
+    void VideoPlayer::updateTexture(size_t slot) {
+        // Copy from the unpack buffer, the GPU reads the slot after this returns.
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, state->pbo);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // RGB rows are not 4 byte aligned
+        glTextureSubImage2D(textureID, 0, 0, 0, state->width, state->height, GL_RGB, GL_UNSIGNED_BYTE,
+                            reinterpret_cast<void const*>(slot * state->frame_size));
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+        std::lock_guard lock(state->mutex);
+        state->slots[slot].fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        state->slots[slot].state = SlotState::Uploaded;
+        state->has_frame = true;
     }
 
-    void VideoPlayer::updateTexture() {
-        // Skip update if there is no scaler context or frame to update.
-        if (!state.sws_scaler_ctx) return;
+    void VideoPlayer::decodeLoop(VideoReaderState& state) {
+        IS_PROFILE_THREAD("Video Decode");
+        IS_MEMORY_THREAD(MemoryTag::Graphics);
+        uint32_t generation = state.generation;
+        bool draining = false;
+        double first_pts = NAN;     // Stream timestamp of the first frame, playback starts at 0
+        double loop_offset = 0.0;   // Length of the loops played so far
+        double last_pts = 0.0;
+
+        std::unique_lock lock(state.mutex);
+        while (true) {
+            state.wake.wait(lock, [&] {
+                return state.quit || state.generation != generation ||
+                    (!state.end_of_stream && state.slots[state.write_slot].state == SlotState::Free);
+            });
+            if (state.quit) {
+                return;
+            }
+
+            if (state.generation != generation) {
+                generation = state.generation;
+                state.end_of_stream = false;
+                lock.unlock();
+                rewind(state);
+                draining = false;
+                first_pts = NAN;
+                loop_offset = last_pts = 0.0;
+                lock.lock();
+                continue;
+            }
+
+            size_t const slot = state.write_slot;
+            lock.unlock();
 
-        // Destination for the converted frame data.
-        uint8_t* dest[1] = { frameBuffer }; // Destination for the RGB data
-        int lineSize[1] = { 3 * state.width }; // RGB stride
+            bool decoded = decodeNextFrame(state, draining);
+            if (!decoded && state.toLoop) {
+                rewind(state);
+                draining = false;
+                first_pts = NAN;
+                loop_offset = last_pts + state.frameDuration;
+                decoded = decodeNextFrame(state, draining);
+            }
 
-        // Convert the video frame to RGB format and update the frame buffer.
-        sws_scale(state.sws_scaler_ctx, (const uint8_t* const*)state.av_frame->data, state.av_frame->linesize,
-            0, state.height, dest, lineSize);
+            if (decoded) {
+                // best effort timestamp covers streams without pts, otherwise count frames
+                int64_t timestamp = state.av_frame->best_effort_timestamp;
+                double pts = timestamp != AV_NOPTS_VALUE ? timestamp * av_q2d(state.time_base) : NAN;
+                if (std::isnan(first_pts)) {
+                    first_pts = std::isnan(pts) ? 0.0 : pts;
+                }
+                pts = std::isnan(pts) ? last_pts + state.frameDuration : loop_offset + pts - first_pts;
+                last_pts = pts;
+
+                // Convert the video frame to RGB straight into the ring slot.
+                uint8_t* dest[1] = { state.pixels + slot * state.frame_size };
+                int lineSize[1] = { 3 * state.width }; // RGB stride
+                {
+                    IS_PROFILE_SCOPE("Convert Frame");
+                    sws_scale(state.sws_scaler_ctx, state.av_frame->data, state.av_frame->linesize,
+                        0, state.height, dest, lineSize);
+                }
+                av_frame_unref(state.av_frame);
+
+                lock.lock();
+                if (state.generation == generation) {
+                    state.slots[slot].pts = pts;
+                    state.slots[slot].generation = generation;
+                    state.slots[slot].state = SlotState::Ready;
+                    state.write_slot = (slot + 1) % RING_SIZE;
+                }
+            }
+            else {
+                lock.lock();
+                state.end_of_stream = true;
+            }
+        }
+    }
+
+    bool VideoPlayer::decodeNextFrame(VideoReaderState& state, bool& draining) {
+        IS_PROFILE_FUNCTION();
+        while (true) {
+            int response = avcodec_receive_frame(state.av_codec_ctx, state.av_frame);
+            if (response >= 0) {
+                return true;
+            }
+            if (response == AVERROR_EOF) {
+                return false;
+            }
+            if (response != AVERROR(EAGAIN)) {
+                IS_CORE_ERROR("Error receiving frame from decoder: {}", response);
+                return false;
+            }
+
+            // the decoder wants more input
+            if (draining) {
+                return false;
+            }
+            response = av_read_frame(state.av_format_ctx, state.av_packet);
+            if (response < 0) {
+                // end of file, flush the frames still inside the decoder
+                avcodec_send_packet(state.av_codec_ctx, nullptr);
+                draining = true;
+                continue;
+            }
+            if (state.av_packet->stream_index == state.video_stream_index) {
+                response = avcodec_send_packet(state.av_codec_ctx, state.av_packet);
+                if (response < 0) {
+                    IS_CORE_ERROR("Error sending packet to decoder: {}", response);
+                }
+            }
+            av_packet_unref(state.av_packet);
+        }
+    }
+
+    void VideoPlayer::rewind(VideoReaderState& state) {
+        av_seek_frame(state.av_format_ctx, state.video_stream_index, 0, AVSEEK_FLAG_BACKWARD);
+        avcodec_flush_buffers(state.av_codec_ctx);
     }
 
     void VideoPlayer::createAndLoadVideo(const std::string& filepath, float widthScalar, float heightScalar, float xPosScalar, float yPosScalar, bool loop) {
+        // videos decode into textures, there is nowhere to play them without a context
+        if (!ISGraphics::HasContext()) {
+            return;
+        }
+
         VideoPlayer video;
         video.initVideoPlayer(widthScalar, heightScalar, xPosScalar, yPosScalar, loop);
         video.loadVideo(filepath);
 
-        ISGraphics::videos.emplace_back(video);
+        ISGraphics::videos.emplace_back(std::move(video));
     }
 
     void VideoPlayer::pauseVideo(int index) {
-        if (index < ISGraphics::videos.size() && index >= 0)
-            ISGraphics::videos[index].state.playing = false;
+        if (index < ISGraphics::videos.size() && index >= 0 && ISGraphics::videos[index].state)
+            ISGraphics::videos[index].state->playing = false;
     }
 
     void VideoPlayer::resumeVideo(int index) {
-        if (index < ISGraphics::videos.size() && index >= 0)
-            ISGraphics::videos[index].state.playing = true;
+        if (index < ISGraphics::videos.size() && index >= 0 && ISGraphics::videos[index].state)
+            ISGraphics::videos[index].state->playing = true;
     }
 
     void VideoPlayer::restartVideo(int index) {
-        if (index < ISGraphics::videos.size() && index >= 0)
-            // seek to first frame
-            av_seek_frame(ISGraphics::videos[index].state.av_format_ctx, 
-                          ISGraphics::videos[index].state.video_stream_index, 0, 
-                          AVSEEK_FLAG_FRAME);
+        if (index < ISGraphics::videos.size() && index >= 0 && ISGraphics::videos[index].state) {
+            // the decode thread seeks to the first frame, frames decoded before are dropped
+            VideoReaderState& state = *ISGraphics::videos[index].state;
+            {
+                std::lock_guard lock(state.mutex);
+                ++state.generation;
+            }
+            state.wake.notify_one();
+            state.video_clock = 0.0;
+        }
     }
 
     void VideoPlayer::unloadVideos() {
@@ -19,7 +19,12 @@
 #ifndef GAM200_INSIGHT_ENGINE_GRAPHICS_SYSTEM_VIDEOPLAYER_H
 #define GAM200_INSIGHT_ENGINE_GRAPHICS_SYSTEM_VIDEOPLAYER_H
 
+#include <array>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <glad/glad.h>
 // #include "Graphics/Core/Graphics.h"
 
@@ -32,11 +37,20 @@ extern "C" {
 }
 
 namespace IS {
+    /**
+     * Each loaded video decodes on its own thread. The thread converts frames to RGB
+     * straight into a ring of slots in a persistently mapped pixel unpack buffer, so the
+     * main thread never touches pixel data: presenting a frame is picking the newest
+     * slot whose timestamp has been reached and issuing a texture copy from it.
+     */
     class VideoPlayer {
     public:
+        static constexpr size_t RING_SIZE = 4; // converted frames buffered ahead of presentation
 
         VideoPlayer() = default;
         ~VideoPlayer() = default;
+        VideoPlayer(VideoPlayer&&) noexcept = default;
+        VideoPlayer& operator=(VideoPlayer&&) noexcept = default;
 
 
         /**
@@ -61,7 +75,8 @@ namespace IS {
         void loadVideo(const std::string& filepath);
 
         /**
-         * Updates the video player state, should be called every frame.
+         * Advances the presentation clock and presents the newest decoded frame that is
+         * due, should be called every frame.
          *
          * @param deltaTime Time elapsed since the last frame.
          */
@@ -78,7 +93,7 @@ namespace IS {
         void cleanup();
 
         /**
-         * Prepares the frame buffer and texture for video rendering.
+         * Prepares the texture and the pixel unpack buffer ring for video rendering.
          */
         void prepareFrameBufferAndTexture();
 
@@ -88,9 +103,11 @@ namespace IS {
         void prepareScalerContext();
 
         /**
-         * Updates the texture with the current video frame.
+         * Copies a decoded frame from its ring slot into the texture.
+         *
+         * @param slot The ring slot holding the frame.
          */
-        void updateTexture();
+        void updateTexture(size_t slot);
 
         // static helper functions for C#
 
@@ -140,6 +157,16 @@ namespace IS {
         static void playVideos(double deltaTime);
 
     private:
+        enum class SlotState { Free, Ready, Uploaded };
+
+        struct FrameSlot {
+            SlotState state = SlotState::Free;
+            double pts = 0.0;           // Presentation time in seconds from the start of playback
+            uint32_t generation = 0;    // Restart count the frame was decoded in
+            GLsync fence{};             // Signals when the texture copy from the slot is done
+        };
+
+        // Heap allocated and shared with the decode thread, so the player itself can move
         struct VideoReaderState {
             int width{}, height{};
             AVRational time_base{};
@@ -150,21 +177,57 @@ namespace IS {
             AVPacket* av_packet{};
             SwsContext* sws_scaler_ctx{};
             float scaleX{}, scaleY{}, transX{}, transY{};
-
-            // to sync video with framerate
-            double frame_last_pts = 0; // Last presentation timestamp for the frame
-            double frame_last_delay = 40e-3; // Initial assumption of frame delay (25 fps)
-            double video_clock = 0; // Video clock to track actual video time
-            bool frame_ready = false;
+            double frameDuration = 40e-3; // Duration of a single frame (25 fps until the stream says otherwise)
             bool toLoop = true;
+
+            // main thread only
             bool playing = true;
+            bool has_frame = false;     // A frame has been copied into the texture
+            double video_clock = 0;     // Presentation clock, seconds since the start of playback
+            size_t read_slot = 0;       // Next slot to present
+            GLuint pbo{};
+
+            // shared with the decode thread, guarded by mutex
+            std::thread decode_thread;
+            std::mutex mutex;
+            std::condition_variable wake;
+            std::array<FrameSlot, RING_SIZE> slots{};
+            size_t write_slot = 0;      // Next slot the decode thread fills
+            uint32_t generation = 0;    // Bumped by a restart
+            bool quit = false;
+            bool end_of_stream = false;
+            uint8_t* pixels{};          // Mapped unpack buffer, RING_SIZE frames of frame_size bytes
+            size_t frame_size{};
+
+            ~VideoReaderState();
+        };
+
+        /**
+         * Body of the decode thread, fills free ring slots until told to quit.
+         *
+         * @param state The state of the video.
+         */
+        static void decodeLoop(VideoReaderState& state);
+
+        /**
+         * Decodes the next frame of the stream into av_frame, on the decode thread.
+         *
+         * @param state The state of the video.
+         * @param draining Set once the decoder has been told the stream ended.
+         * @return True if a frame was decoded, false at the end of the stream.
+         */
+        static bool decodeNextFrame(VideoReaderState& state, bool& draining);
+
+        /**
+         * Seeks back to the first frame, on the decode thread.
+         *
+         * @param state The state of the video.
+         */
+        static void rewind(VideoReaderState& state);
 
-            double timeSinceLastFrame = 0.0; // Time elapsed since the last frame was shown
-            double frameDuration = 0.0;      // Duration of a single frame
-        } state;
+        std::unique_ptr<VideoReaderState> state;
 
         GLuint textureID{};
-        unsigned char* frameBuffer{};
 
         //void closeVideo();
     };
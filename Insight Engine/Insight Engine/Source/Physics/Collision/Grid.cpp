@@ -252,6 +252,7 @@ namespace IS
 			// update body and trans position with velocity and dt
 			body.mBodyTransform.world_position += body.mVelocity * dt;
 			trans.world_position = body.mBodyTransform.world_position;
+			trans.MarkDirty();
 
 			float angle = trans.getRotation();
 			angle += body.mAngularVelocity * dt * 10.f;
@@ -0,0 +1,446 @@
+/*!
+ * \file StaticGeometry.cpp
+ * \author Wu Zekai, zekai.wu@digipen.edu
+ * \par Course: CSD2451
+ * \date 19-10-2026
+ * \brief
+ * This source file contains the implementation of the StaticGeometry class, which
+ * merges static tile colliders into boxes, traces their outline into polygon chains,
+ * and saves the result with the scene.
+ *
+ * \copyright
+ * All content (C) 2024 DigiPen Institute of Technology Singapore.
+ * All rights reserved.
+ * Reproduction or disclosure of this file or its contents without the prior written
+ * consent of DigiPen Institute of Technology is prohibited.
+ *____________________________________________________________________________*/
+
+ /*                                                                   includes
+ ----------------------------------------------------------------------------- */
+#include "Pch.h"
+#include "StaticGeometry.h"
+#include "Collider.h"
+#include "Physics/Dynamics/Body.h"
+#include "Graphics/System/Light.h"
+#include "Graphics/System/Sprite.h"
+#include "Engine/Scripting/ScriptManager.h"
+#include "Engine/Systems/Category/Category.h"
+
+#include <algorithm>
+#include <map>
+
+namespace IS
+{
+	float StaticGeometry::mSnapTolerance = 0.5f;
+	bool StaticGeometry::mShowChains = false;
+
+	namespace
+	{
+		// Edge directions of the outline, in counter-clockwise order
+		enum EdgeDirection { EDGE_RIGHT = 0, EDGE_UP, EDGE_LEFT, EDGE_DOWN };
+
+		// A boundary edge between an occupied and an empty cell, stored as grid point indices
+		struct BoundaryEdge
+		{
+			int start;
+			int end;
+			int direction;
+			bool used;
+		};
+	}
+
+	void StaticGeometry::Bake()
+	{
+		auto& engine = InsightEngine::Instance();
+
+		// collect the entities in a fixed order so the bake result does not depend on the hash map order
+		std::vector<Entity> entities;
+		entities.reserve(engine.GetEntitiesAlive().size());
+		for (auto const& [entity, name] : engine.GetEntitiesAlive())
+			entities.emplace_back(entity);
+		std::sort(entities.begin(), entities.end());
+
+		// candidate boxes grouped by category and restitution, so grounds and walls keep their own colliders and bounce
+		std::map<std::pair<std::string, float>, std::vector<Box>> groups;
+		std::vector<Entity> sources;
+
+		for (Entity entity : entities)
+		{
+			if (!engine.HasComponent<Transform>(entity) || !engine.HasComponent<Collider>(entity) ||
+				!engine.HasComponent<RigidBody>(entity) || engine.HasComponent<ScriptComponent>(entity))
+				continue;
+
+			auto& trans = engine.GetComponent<Transform>(entity);
+			auto& collider = engine.GetComponent<Collider>(entity);
+			auto& body = engine.GetComponent<RigidBody>(entity);
+
+			if (body.mBodyType != BodyType::Static || !collider.mResponseEnable ||
+				!collider.IsBoxColliderEnable() || collider.IsCircleColliderEnable())
+				continue;
+
+			// only axis aligned boxes can be merged without changing their shape
+			float quarter_turns = trans.rotation / 90.f;
+			if (std::abs(quarter_turns - std::round(quarter_turns)) > 0.001f)
+				continue;
+
+			collider.UpdateCollider(trans);
+			Vector2D min = collider.mBoxCollider.transformedVertices[0];
+			Vector2D max = min;
+			for (auto const& vertex : collider.mBoxCollider.transformedVertices)
+			{
+				min.x = std::min(min.x, vertex.x);
+				min.y = std::min(min.y, vertex.y);
+				max.x = std::max(max.x, vertex.x);
+				max.y = std::max(max.y, vertex.y);
+			}
+
+			Box box(Snap(min.x), Snap(min.y), Snap(max.x), Snap(max.y));
+			if (box.max.x <= box.min.x || box.max.y <= box.min.y)
+				continue;
+
+			std::string category = engine.HasComponent<Category>(entity) ? engine.GetComponent<Category>(entity).mCategory : "";
+			groups[{ category, body.mRestitution }].emplace_back(box);
+			sources.emplace_back(entity);
+		}
+
+		if (sources.empty())
+		{
+			IS_CORE_WARN("No static box colliders to bake!");
+			return;
+		}
+
+		// strip the tile colliders, previously baked entities are rebuilt from scratch
+		size_t tile_count = 0;
+		for (Entity entity : sources)
+		{
+			if (IsBakedEntity(entity) || engine.GetEntityName(entity) == BAKED_ENTITY_NAME)
+			{
+				engine.DeleteEntity(entity);
+				continue;
+			}
+			engine.RemoveComponent<Collider>(entity);
+			engine.RemoveComponent<RigidBody>(entity);
+			++tile_count;
+		}
+
+		mBoxes.clear();
+		mBakedEntities.clear();
+		std::vector<Box> all_boxes;
+
+		for (auto const& [group, boxes] : groups)
+		{
+			auto const& [category, restitution] = group;
+			all_boxes.insert(all_boxes.end(), boxes.begin(), boxes.end());
+
+			for (Box const& box : MergeBoxes(BuildGrid(boxes)))
+			{
+				Vector2D center = (box.min + box.max) * 0.5f;
+				Vector2D size = box.max - box.min;
+
+				Entity baked = engine.CreateEntity(BAKED_ENTITY_NAME);
+				engine.AddComponentAndUpdateSignature<Transform>(baked, Transform(center, 0.f, size));
+				RigidBody body;
+				body.CreateStaticBody(center, restitution);
+				engine.AddComponentAndUpdateSignature<RigidBody>(baked, body);
+				Collider collider;
+				collider.UpdateCollider(engine.GetComponent<Transform>(baked));
+				engine.AddComponentAndUpdateSignature<Collider>(baked, collider);
+				if (!category.empty())
+				{
+					Category cate;
+					cate.mCategory = category;
+					engine.AddComponentAndUpdateSignature<Category>(baked, cate);
+				}
+
+				mBoxes.emplace_back(box);
+				mBakedEntities.insert(baked);
+			}
+		}
+
+		// outline of everything baked, regardless of category, for lights and navigation
+		mChains = TraceChains(BuildGrid(all_boxes));
+		mSourceCount = tile_count;
+
+		IS_CORE_INFO("Baked {} static colliders into {} boxes and {} chains ({} segments)",
+					 all_boxes.size(), mBoxes.size(), mChains.size(), GetSegmentCount());
+	}
+
+	void StaticGeometry::Clear()
+	{
+		mChains.clear();
+		mBoxes.clear();
+		mBakedEntities.clear();
+		mSourceCount = 0;
+	}
+
+	bool StaticGeometry::IsPointBlocked(Vector2D const& position) const
+	{
+		for (Box const& box : mBoxes)
+		{
+			if (position.x >= box.min.x && position.x <= box.max.x &&
+				position.y >= box.min.y && position.y <= box.max.y)
+				return true;
+		}
+		return false;
+	}
+
+	void StaticGeometry::AddLineSegmentsForLights() const
+	{
+		for (BakedChain const& chain : mChains)
+		{
+			size_t count = chain.vertices.size();
+			for (size_t i = 0; i < count; ++i)
+			{
+				Vector2D const& va = chain.vertices[i];
+				Vector2D const& vb = chain.vertices[(i + 1) % count];
+				Light::shadowLineSegments.emplace_back(va.x, va.y, vb.x, vb.y);
+			}
+		}
+	}
+
+	void StaticGeometry::DrawChains() const
+	{
+		if (!mShowChains)
+			return;
+
+		// draw chains in cyan
+		for (BakedChain const& chain : mChains)
+		{
+			size_t count = chain.vertices.size();
+			for (size_t i = 0; i < count; ++i)
+				Sprite::drawDebugLine(chain.vertices[i], chain.vertices[(i + 1) % count], { 0.f, 1.f, 1.f });
+		}
+	}
+
+	size_t StaticGeometry::GetSegmentCount() const
+	{
+		size_t count = 0;
+		for (BakedChain const& chain : mChains)
+			count += chain.vertices.size();
+		return count;
+	}
+
+	Json::Value StaticGeometry::Serialize() const
+	{
+		Json::Value data;
+
+		Json::Value chains(Json::arrayValue);
+		for (BakedChain const& chain : mChains)
+		{
+			Json::Value vertices(Json::arrayValue);
+			for (Vector2D const& vertex : chain.vertices)
+			{
+				vertices.append(vertex.x);
+				vertices.append(vertex.y);
+			}
+			chains.append(vertices);
+		}
+		data["Chains"] = chains;
+
+		Json::Value boxes(Json::arrayValue);
+		for (Box const& box : mBoxes)
+		{
+			Json::Value value(Json::arrayValue);
+			value.append(box.min.x);
+			value.append(box.min.y);
+			value.append(box.max.x);
+			value.append(box.max.y);
+			boxes.append(value);
+		}
+		data["Boxes"] = boxes;
+
+		return data;
+	}
+
+	void StaticGeometry::Deserialize(Json::Value const& data)
+	{
+		Clear();
+
+		for (auto const& vertices : data["Chains"])
+		{
+			BakedChain chain;
+			for (Json::ArrayIndex i = 0; i + 1 < vertices.size(); i += 2)
+				chain.vertices.emplace_back(vertices[i].asFloat(), vertices[i + 1].asFloat());
+			if (chain.vertices.size() >= 3)
+				mChains.emplace_back(std::move(chain));
+		}
+
+		for (auto const& value : data["Boxes"])
+		{
+			if (value.size() == 4)
+				mBoxes.emplace_back(value[0].asFloat(), value[1].asFloat(), value[2].asFloat(), value[3].asFloat());
+		}
+
+		// entity ids are not kept across save and load, find the merged colliders by name
+		for (auto const& [entity, name] : InsightEngine::Instance().GetEntitiesAlive())
+		{
+			if (name == BAKED_ENTITY_NAME)
+				mBakedEntities.insert(entity);
+		}
+	}
+
+	StaticGeometry::OccupancyGrid StaticGeometry::BuildGrid(std::vector<Box> const& boxes) const
+	{
+		OccupancyGrid grid;
+		for (Box const& box : boxes)
+		{
+			grid.xs.emplace_back(box.min.x);
+			grid.xs.emplace_back(box.max.x);
+			grid.ys.emplace_back(box.min.y);
+			grid.ys.emplace_back(box.max.y);
+		}
+		std::sort(grid.xs.begin(), grid.xs.end());
+		grid.xs.erase(std::unique(grid.xs.begin(), grid.xs.end()), grid.xs.end());
+		std::sort(grid.ys.begin(), grid.ys.end());
+		grid.ys.erase(std::unique(grid.ys.begin(), grid.ys.end()), grid.ys.end());
+
+		if (grid.xs.size() < 2 || grid.ys.size() < 2)
+			return grid;
+
+		grid.cells.assign(static_cast<size_t>(grid.Cols()) * grid.Rows(), 0);
+		for (Box const& box : boxes)
+		{
+			// coordinates are snapped, so the box edges are exactly in the lists
+			int col_begin = static_cast<int>(std::lower_bound(grid.xs.begin(), grid.xs.end(), box.min.x) - grid.xs.begin());
+			int col_end = static_cast<int>(std::lower_bound(grid.xs.begin(), grid.xs.end(), box.max.x) - grid.xs.begin());
+			int row_begin = static_cast<int>(std::lower_bound(grid.ys.begin(), grid.ys.end(), box.min.y) - grid.ys.begin());
+			int row_end = static_cast<int>(std::lower_bound(grid.ys.begin(), grid.ys.end(), box.max.y) - grid.ys.begin());
+
+			for (int row = row_begin; row < row_end; ++row)
+				for (int col = col_begin; col < col_end; ++col)
+					grid.cells[static_cast<size_t>(row) * grid.Cols() + col] = 1;
+		}
+		return grid;
+	}
+
+	std::vector<Box> StaticGeometry::MergeBoxes(OccupancyGrid const& grid) const
+	{
+		std::vector<Box> merged;
+		if (grid.cells.empty())
+			return merged;
+
+		std::vector<char> used(grid.cells.size(), 0);
+		auto free_cell = [&](int col, int row) {
+			return grid.At(col, row) && !used[static_cast<size_t>(row) * grid.Cols() + col];
+		};
+
+		for (int row = 0; row < grid.Rows(); ++row)
+		{
+			for (int col = 0; col < grid.Cols(); ++col)
+			{
+				if (!free_cell(col, row))
+					continue;
+
+				// grow along the row first, then grow upwards while the whole span is free
+				int width = 1;
+				while (free_cell(col + width, row))
+					++width;
+
+				int height = 1;
+				for (bool span_free = true; span_free; )
+				{
+					for (int i = 0; i < width && span_free; ++i)
+						span_free = free_cell(col + i, row + height);
+					if (span_free)
+						++height;
+				}
+
+				for (int j = 0; j < height; ++j)
+					for (int i = 0; i < width; ++i)
+						used[static_cast<size_t>(row + j) * grid.Cols() + col + i] = 1;
+
+				merged.emplace_back(grid.xs[col], grid.ys[row], grid.xs[col + width], grid.ys[row + height]);
+			}
+		}
+		return merged;
+	}
+
+	std::vector<BakedChain> StaticGeometry::TraceChains(OccupancyGrid const& grid) const
+	{
+		std::vector<BakedChain> chains;
+		if (grid.cells.empty())
+			return chains;
+
+		int points_per_row = grid.Cols() + 1;
+		auto point = [points_per_row](int col, int row) { return row * points_per_row + col; };
+
+		// collect the boundary edges, oriented so the solid side is on the left
+		std::vector<BoundaryEdge> edges;
+		std::vector<std::vector<int>> outgoing(static_cast<size_t>(points_per_row) * (grid.Rows() + 1));
+		auto add_edge = [&](int start, int end, int direction) {
+			outgoing[start].emplace_back(static_cast<int>(edges.size()));
+			edges.push_back({ start, end, direction, false });
+		};
+
+		for (int row = 0; row < grid.Rows(); ++row)
+		{
+			for (int col = 0; col < grid.Cols(); ++col)
+			{
+				if (!grid.At(col, row))
+					continue;
+				if (!grid.At(col, row - 1)) add_edge(point(col, row), point(col + 1, row), EDGE_RIGHT);
+				if (!grid.At(col + 1, row)) add_edge(point(col + 1, row), point(col + 1, row + 1), EDGE_UP);
+				if (!grid.At(col, row + 1)) add_edge(point(col + 1, row + 1), point(col, row + 1), EDGE_LEFT);
+				if (!grid.At(col - 1, row)) add_edge(point(col, row + 1), point(col, row), EDGE_DOWN);
+			}
+		}
+
+		// link the edges into loops, at a corner shared by two cells prefer turning left
+		for (size_t first = 0; first < edges.size(); ++first)
+		{
+			if (edges[first].used)
+				continue;
+
+			std::vector<int> loop_points;
+			std::vector<int> loop_directions;
+			int current = static_cast<int>(first);
+			while (current >= 0)
+			{
+				BoundaryEdge& edge = edges[current];
+				edge.used = true;
+				loop_points.emplace_back(edge.start);
+				loop_directions.emplace_back(edge.direction);
+				if (edge.end == edges[first].start)
+					break;
+
+				int next = -1;
+				for (int turn : { 1, 0, 3 })
+				{
+					for (int candidate : outgoing[edge.end])
+					{
+						if (!edges[candidate].used && edges[candidate].direction == (edge.direction + turn) % 4)
+						{
+							next = candidate;
+							break;
+						}
+					}
+					if (next >= 0)
+						break;
+				}
+				current = next;
+			}
+
+			// keep only the points where the direction changes
+			BakedChain chain;
+			size_t count = loop_points.size();
+			for (size_t i = 0; i < count; ++i)
+			{
+				if (loop_directions[(i + count - 1) % count] == loop_directions[i])
+					continue;
+				int col = loop_points[i] % points_per_row;
+				int row = loop_points[i] / points_per_row;
+				chain.vertices.emplace_back(grid.xs[col], grid.ys[row]);
+			}
+			if (chain.vertices.size() >= 3)
+				chains.emplace_back(std::move(chain));
+		}
+		return chains;
+	}
+
+	float StaticGeometry::Snap(float value) const
+	{
+		if (mSnapTolerance <= 0.f)
+			return value;
+		return std::round(value / mSnapTolerance) * mSnapTolerance;
+	}
+}
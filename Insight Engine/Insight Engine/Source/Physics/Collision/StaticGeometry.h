@@ -0,0 +1,211 @@
+/*!
+ * \file StaticGeometry.h
+ * \author Wu Zekai, zekai.wu@digipen.edu
+ * \par Course: CSD2451
+ * \date 19-10-2026
+ * \brief
+ * This header file contains the StaticGeometry class, which bakes the static box
+ * colliders of a level (wall tiles, platforms) into a minimal set of merged boxes
+ * for collision and closed polygon chains for light occluders and navigation.
+ *
+ * \copyright
+ * All content (C) 2024 DigiPen Institute of Technology Singapore.
+ * All rights reserved.
+ * Reproduction or disclosure of this file or its contents without the prior written
+ * consent of DigiPen Institute of Technology is prohibited.
+ *____________________________________________________________________________*/
+
+ /*                                                                   guard
+ ----------------------------------------------------------------------------- */
+#ifndef GAM200_INSIGHT_ENGINE_PHYSICS_COLLISION_STATIC_GEOMETRY_H
+#define GAM200_INSIGHT_ENGINE_PHYSICS_COLLISION_STATIC_GEOMETRY_H
+
+ /*                                                                   includes
+ ----------------------------------------------------------------------------- */
+#include "Engine/ECS/Entities.h"
+#include "Math/Vector2D.h"
+#include "Collision.h"
+
+#include <json/json.h>
+#include <string>
+#include <vector>
+#include <unordered_set>
+
+namespace IS
+{
+	/*!
+	 * \struct BakedChain
+	 * \brief A closed polygon chain traced around the outline of merged static geometry.
+	 *
+	 * Vertices are stored counter-clockwise (solid on the left) with collinear points removed.
+	 */
+	struct BakedChain
+	{
+		std::vector<Vector2D> vertices;					// Corner vertices of the outline
+	};
+
+	/*!
+	 * \class StaticGeometry
+	 * \brief Bakes static tile colliders into merged boxes and outline chains.
+	 *
+	 * Baking is an editor step. Every static, axis aligned box collider without a script is
+	 * merged with its neighbours of the same category and restitution into as few boxes as
+	 * possible, the merged boxes replace the tile colliders in the scene, and the outline of
+	 * all the baked geometry is traced into polygon chains that are saved with the scene.
+	 */
+	class StaticGeometry
+	{
+	public:
+		/*!
+		 * \brief Name given to the entities holding the merged colliders, used to find them again after loading a scene.
+		 */
+		static constexpr const char* BAKED_ENTITY_NAME = "[Baked] Static Geometry";
+
+		/*!
+		 * \brief Coordinates are snapped to this grid (world units) so tiles with tiny gaps still merge.
+		 */
+		static float mSnapTolerance;
+
+		/*!
+		 * \brief Flag to draw the baked chains in the scene.
+		 */
+		static bool mShowChains;
+
+		/*!
+		 * \brief Retrieves the singleton instance of StaticGeometry.
+		 * \return The singleton instance.
+		 */
+		static StaticGeometry& Instance() { static StaticGeometry instance; return instance; }
+
+		/*!
+		 * \brief Bakes the static geometry of the current scene.
+		 *
+		 * Tile entities that are merged lose their RigidBody and Collider components (their
+		 * Sprite is kept), and one entity per merged box is created in their place. Baking an
+		 * already baked scene picks up the previous merged boxes, so it can be rerun after
+		 * adding new tiles.
+		 */
+		void Bake();
+
+		/*!
+		 * \brief Clears the baked chains and the list of merged collider entities.
+		 */
+		void Clear();
+
+		/*!
+		 * \brief Checks if the current scene has baked geometry.
+		 * \return True if baked chains exist, false otherwise.
+		 */
+		bool IsBaked() const { return !mChains.empty(); }
+
+		/*!
+		 * \brief Checks if an entity is one of the merged collider entities created by a bake.
+		 * \param entity The entity to check.
+		 * \return True if the entity holds a baked collider, false otherwise.
+		 */
+		bool IsBakedEntity(Entity entity) const { return mBakedEntities.count(entity) != 0; }
+
+		/*!
+		 * \brief Checks if a world position lies inside the baked geometry, used to mark navigation obstacles.
+		 * \param position The world position to test.
+		 * \return True if the position is inside a merged box, false otherwise.
+		 */
+		bool IsPointBlocked(Vector2D const& position) const;
+
+		/*!
+		 * \brief Adds the segments of every baked chain to the shadow line segments of the lights.
+		 */
+		void AddLineSegmentsForLights() const;
+
+		/*!
+		 * \brief Draws the baked chains as debug lines if enabled.
+		 */
+		void DrawChains() const;
+
+		/*!
+		 * \brief Serializes the baked chains into a JSON value stored in the scene file.
+		 * \return The serialized data.
+		 */
+		Json::Value Serialize() const;
+
+		/*!
+		 * \brief Deserializes the baked chains from a scene file and relinks the merged collider entities.
+		 * \param data The serialized data.
+		 */
+		void Deserialize(Json::Value const& data);
+
+		/*!
+		 * \brief Gets the baked chains.
+		 * \return The list of baked chains.
+		 */
+		std::vector<BakedChain> const& GetChains() const { return mChains; }
+
+		/*!
+		 * \brief Gets the number of merged boxes of the current scene.
+		 * \return The number of merged boxes.
+		 */
+		size_t GetBoxCount() const { return mBoxes.size(); }
+
+		/*!
+		 * \brief Gets the number of segments in all the baked chains.
+		 * \return The number of segments.
+		 */
+		size_t GetSegmentCount() const;
+
+		/*!
+		 * \brief Gets the number of tile colliders that were replaced by the last bake.
+		 * \return The number of replaced colliders.
+		 */
+		size_t GetSourceCount() const { return mSourceCount; }
+
+	private:
+		/*!
+		 * \brief Occupancy grid over the compressed coordinates of a set of boxes.
+		 */
+		struct OccupancyGrid
+		{
+			std::vector<float> xs;						// Sorted unique x coordinates
+			std::vector<float> ys;						// Sorted unique y coordinates
+			std::vector<char> cells;					// (xs.size() - 1) * (ys.size() - 1) occupancy flags
+
+			int Cols() const { return static_cast<int>(xs.size()) - 1; }
+			int Rows() const { return static_cast<int>(ys.size()) - 1; }
+			bool At(int col, int row) const { return col >= 0 && row >= 0 && col < Cols() && row < Rows() && cells[static_cast<size_t>(row) * Cols() + col]; }
+		};
+
+		/*!
+		 * \brief Rasterizes a set of boxes into an occupancy grid.
+		 * \param boxes The boxes to rasterize.
+		 * \return The occupancy grid.
+		 */
+		OccupancyGrid BuildGrid(std::vector<Box> const& boxes) const;
+
+		/*!
+		 * \brief Greedily merges the occupied cells of a grid into as few boxes as possible.
+		 * \param grid The occupancy grid.
+		 * \return The merged boxes.
+		 */
+		std::vector<Box> MergeBoxes(OccupancyGrid const& grid) const;
+
+		/*!
+		 * \brief Traces the outline of the occupied cells of a grid into closed chains.
+		 * \param grid The occupancy grid.
+		 * \return The outline chains.
+		 */
+		std::vector<BakedChain> TraceChains(OccupancyGrid const& grid) const;
+
+		/*!
+		 * \brief Snaps a coordinate to the snap tolerance grid.
+		 * \param value The coordinate to snap.
+		 * \return The snapped coordinate.
+		 */
+		float Snap(float value) const;
+
+		std::vector<BakedChain> mChains;				// Outline chains of the baked geometry
+		std::vector<Box> mBoxes;						// Merged boxes of the baked geometry
+		std::unordered_set<Entity> mBakedEntities;		// Entities holding the merged colliders
+		size_t mSourceCount{};							// Number of tile colliders replaced by the last bake
+	};
+}
+
+#endif // !GAM200_INSIGHT_ENGINE_PHYSICS_COLLISION_STATIC_GEOMETRY_H
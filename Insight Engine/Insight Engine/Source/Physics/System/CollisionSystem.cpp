@@ -90,6 +90,11 @@ namespace IS
 
 	void CollisionSystem::NarrowPhase() 
 	{
+		// the grid emits pairs cell by cell, sort them so the resolve order only depends on the entities
+		if (Physics::mDeterministic)
+		{
+			std::sort(mContactPair.begin(), mContactPair.end());
+		}
 
 		for (int i = 0; i < mContactPair.size(); i++)
 		{
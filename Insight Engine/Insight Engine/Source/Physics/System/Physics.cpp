@@ -23,6 +23,7 @@
 #include "Graphics/System/Sprite.h"
 #include "Graphics/Core/Graphics.h"
 #include "Graphics/System/Light.h"
+#include "Physics/Collision/StaticGeometry.h"
 #include "../../Engine//Systems/Category/Category.h"
 
 namespace IS {
@@ -32,6 +33,7 @@ namespace IS {
 	bool Physics::mShowGrid = false;									// Flag indicating whether the grid will be drawn
 	bool Physics::mEnableImplicitGrid = false;							// Flag indicating whether implicit grid is enable
 	bool Physics::mExertingGravity = true;								// Flag indicating whether gravity is currently exerted
+	bool Physics::mDeterministic = false;								// Flag indicating whether the simulation must be reproducible
 	Vector2D Physics::mGravity = Vector2D(0.f, -981.f);					// Gravity of the world
 	std::set<Entity> Physics::PhysicsEnableList = std::set<Entity>();	// Enable entities list for physics
 	// Constructs a Physics instance
@@ -83,6 +85,12 @@ namespace IS {
 		}*/
 		//Loop using Fixed DT
 		//dt = static_cast<float>(InsightEngine::Instance().mFixedDeltaTime);
+
+		// baked static geometry only needs to add its outline once per frame
+		if (ISGraphics::mLightsOn) {
+			StaticGeometry::Instance().AddLineSegmentsForLights();
+		}
+
 		for (int step = 0; step < InsightEngine::Instance().GetCurrentNumberOfSteps(); ++step)
 		{
 			// physics update iteration
@@ -362,6 +370,11 @@ namespace IS {
 	// for shadow light rendering
 	void Physics::AddLineSegementsForLights(Entity const& entity)
 	{
+		// merged colliders are covered by the baked chains
+		if (StaticGeometry::Instance().IsBakedEntity(entity)) {
+			return;
+		}
+
 		auto& collider = InsightEngine::Instance().GetComponent<Collider>(entity);
 		auto& body = InsightEngine::Instance().GetComponent<RigidBody>(entity);
 		//auto& cate = InsightEngine::Instance().GetComponent<Category>(entity);
@@ -446,6 +459,7 @@ namespace IS {
 				//mImplicitGrid.UpdateCell(entity, time);
 				body.mPosition += body.mVelocity * time;
 				trans.world_position = body.mPosition;
+				trans.MarkDirty();
 				auto& sprite = InsightEngine::Instance().GetComponent<Sprite>(entity);
 				sprite.followTransform(trans);
 
@@ -88,6 +88,11 @@ namespace IS {
          */
         static bool mExertingGravity;
 
+        /*!
+         * \brief Boolean flag for deterministic simulation, contact pairs are sorted so the resolve order does not depend on the grid
+         */
+        static bool mDeterministic;
+
         /*!
          * \brief Gravity of the world
          */
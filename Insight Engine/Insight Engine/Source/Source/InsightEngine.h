@@ -37,6 +37,9 @@
 #include "../Engine/Systems/Category/Category.h"
 #include "../Engine/Systems/FSM/FSM.h"
 #include "../Engine/Scripting/SimpleArray.h"
+#include "Engine/Systems/Replay/Replay.h"
+#include "Engine/Systems/Benchmark/Benchmark.h"
+#include "Engine/Systems/Rewinder/Rewinder.h"
 
 
 using namespace IS;
@@ -62,6 +65,7 @@ void RegisterComponents() {
     engine.RegisterComponent<Light>();
     engine.RegisterComponent<Category>();
     engine.RegisterComponent<StateComponent>();
+    engine.RegisterComponent<RewinderComponent>();
 }
 
 // This is a helper function to register all systems
@@ -85,6 +89,7 @@ void RegisterSystems() {
     Signature sign_particle = engine.GenerateSignature<ParticleEmitter>();
     Signature sign_category = engine.GenerateSignature<Category>();
     Signature sign_state = engine.GenerateSignature<StateComponent>();
+    Signature sign_rewinder = engine.GenerateSignature<Transform, RewinderComponent>();
 
     // Register each system to Insight Engine
     auto insight_window = std::make_shared<WindowSystem>();
@@ -98,6 +103,7 @@ void RegisterSystems() {
     auto insight_guisystem = std::make_shared<GuiSystem>();
     auto insight_pathfinding = std::make_shared<Pathfinding>();
     auto insight_collision = std::make_shared<CollisionSystem>();
+    auto insight_rewinder = std::make_shared<Rewinder>();
     auto insight_particle = std::make_shared <ParticleSystem>();
     auto insight_category = std::make_shared<CategorySystem>();
     auto insight_statemanager = std::make_shared<StateManager>();
@@ -111,6 +117,7 @@ void RegisterSystems() {
     engine.AddSystem(insight_scriptmanager, sign_script);
     engine.AddSystem(insight_physics, sign_physics);
     engine.AddSystem(insight_collision, sign_collision);
+    engine.AddSystem(insight_rewinder, sign_rewinder);
     engine.AddSystem(insight_fsm, sign_fsm);
     engine.AddSystem(insight_guisystem, sign_gui);
     engine.AddSystem(insight_pathfinding, sign_pathfinding);
@@ -134,11 +141,59 @@ void EngineSetup() {
 }
 
 // The only function that main should ever call
-void RunInsightEngine() {
+void RunInsightEngine(int argc = 0, char* argv[] = nullptr) {
     
+#ifdef IS_MEMORY_TRACKING
+    // blocks allocated from here on and still held at exit are reported as leaks, the report runs
+    // after the engine and every singleton first used below are destroyed
+    MemoryTracker::Instance().MarkBaseline();
+#endif
+    IS_PROFILE_THREAD("Main");
+
+    // "-headless" runs without a window or graphics context, the systems are created knowing it
+    // "-profile [file]" captures a Chrome trace from startup to shutdown
+    std::string profile_out;
+    bool profile = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg(argv[i]);
+        if (arg == "-headless")
+            InsightEngine::Instance().mHeadless = true;
+        else if (arg == "-profile") {
+            profile = true;
+            if (i + 1 < argc && argv[i + 1][0] != '-')
+                profile_out = argv[++i];
+        }
+    }
+    if (profile)
+        Profiler::Instance().BeginCapture();
+
     //This is to set the flow of the engine
     EngineSetup();
+
+    // "-replay <file>" re-simulates a recorded session without rendering and exits
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::string(argv[i]) == "-replay")
+            ReplayManager::Instance().QueueReplay(argv[i + 1]);
+    }
+
+    // "-benchmark <scene|replay|bodies:N|sprites:N|particles:N|lights:N> [-frames N] [-benchmark-out <file>]"
+    // runs a workload for a fixed number of steps, writes a JSON report and exits
+    std::string benchmark, benchmark_out;
+    unsigned benchmark_frames = BenchmarkManager::DEFAULT_FRAMES;
+    for (int i = 1; i + 1 < argc; ++i) {
+        std::string arg(argv[i]);
+        if (arg == "-benchmark")
+            benchmark = argv[i + 1];
+        else if (arg == "-frames")
+            benchmark_frames = static_cast<unsigned>(std::strtoul(argv[i + 1], nullptr, 10));
+        else if (arg == "-benchmark-out")
+            benchmark_out = argv[i + 1];
+    }
+    if (!benchmark.empty())
+        BenchmarkManager::Instance().QueueBenchmark(benchmark, benchmark_frames, benchmark_out);
     InsightEngine::Instance().Run();
+    if (profile)
+        Profiler::Instance().EndCapture(profile_out);
     ScriptEngine::Shutdown();
     ClearSimpleArray();
     IS_CORE_WARN("Insight Engine has terminated!");
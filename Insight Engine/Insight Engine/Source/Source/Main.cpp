@@ -13,10 +13,10 @@
 #include "Debug/Utils/MemoryLeakCheck.h"
 #include "../Engine/Scripting/SimpleArray.h"
 
-int main() {
+int main(int argc, char* argv[]) {
     // Enable memory leaks check
     ENABLE_MEMORY_CHECK();
     // Run the engine
-    RunInsightEngine();
+    RunInsightEngine(argc, argv);
 }
 
@@ -42,6 +42,8 @@ Don't put too many files that will make you confuse. Mostly files like STL (stri
 #include "Debug/Logging/Log.h"
 #include "Debug/Utils/Assertion.h"
 #include "Debug/Profiling/Timer.h"
+#include "Debug/Profiling/Profiler.h"
+#include "Debug/Utils/MemoryTracker.h"
 #include "Utils.h"
 
 #endif //!GAM200_INSIGHT_ENGINE_PCH_H_
@@ -18,6 +18,8 @@
 #define GAM200_INSIGHT_ENGINE_SOURCE_MATH_RANDOM_H
 
 #include <random>
+#include <cstdint>
+#include <cstdlib>
 
 namespace IS {
 
@@ -31,6 +33,13 @@ namespace IS {
         float generate() {
             return distribution(generator);
         }
+
+        // reseed for deterministic replays, also seeds rand() used by the particles
+        void seed(uint32_t value) {
+            generator.seed(value);
+            distribution.reset();
+            std::srand(value);
+        }
     private:
         PRNG() {
             std::random_device rd;
@@ -38,7 +47,7 @@ namespace IS {
             distribution = std::uniform_real_distribution<float>(0.0f, 1.0f);
         }
 
-        std::default_random_engine generator;
+        std::mt19937 generator;
         std::uniform_real_distribution<float> distribution;
     };
 